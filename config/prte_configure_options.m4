@@ -187,6 +187,69 @@ AC_DEFINE_UNQUOTED([PRTE_ENABLE_PTY_SUPPORT], [$PRTE_ENABLE_PTY_SUPPORT],
                    [Whether user wants PTY support or not])
 
 
+#
+# Do we want a self-contained prted?
+#
+
+AC_MSG_CHECKING([if want a statically linked prted])
+AC_ARG_ENABLE([static-prted],
+    [AS_HELP_STRING([--enable-static-prted],
+                    [Link prted as a single self-contained executable with
+                     all MCA components built in, so that daemon startup
+                     does not scan or load any component libraries.
+                     Implies --disable-dlopen and requires static versions
+                     of all dependent libraries.  (default: disabled)])])
+if test "$enable_static_prted" = "yes" ; then
+    AC_MSG_RESULT([yes])
+    # an explicit --enable-dlopen would otherwise be silently ignored
+    if test "$enable_dlopen" = "yes" ; then
+        AC_MSG_WARN([--enable-static-prted requires all components to be])
+        AC_MSG_WARN([built into the executable, but --enable-dlopen was])
+        AC_MSG_WARN([also given. Please remove one of these options.])
+        AC_MSG_ERROR([Cannot continue])
+    fi
+    enable_dlopen=no
+    PRTE_PRTED_LDFLAGS="-all-static"
+else
+    AC_MSG_RESULT([no])
+    PRTE_PRTED_LDFLAGS=
+fi
+AC_SUBST(PRTE_PRTED_LDFLAGS)
+
+
+#
+# Do we want to build a set of MCA param defaults into the library?
+#
+
+AC_MSG_CHECKING([for frozen MCA param defaults])
+AC_ARG_WITH([frozen-mca-params],
+    [AS_HELP_STRING([--with-frozen-mca-params=FILE],
+                    [Build the MCA param defaults in FILE (same format as
+                     prte-mca-params.conf) into the library.  They replace
+                     the system-level prte-mca-params.conf, which is then
+                     not read at run time.])])
+PRTE_FROZEN_MCA_PARAMS=
+if test -n "$with_frozen_mca_params" && test "$with_frozen_mca_params" != "no" ; then
+    if test ! -r "$with_frozen_mca_params" ; then
+        AC_MSG_RESULT([not found])
+        AC_MSG_ERROR([Cannot read MCA param file $with_frozen_mca_params])
+    fi
+    # turn each "name = value" line into a "name", "value", pair -
+    # backslashes and quotes are escaped for C, and any dollar sign or
+    # backquote becomes an octal escape so the shell and config.status
+    # never see one
+    PRTE_FROZEN_MCA_PARAMS=$(sed -e 's/#.*$//' -e 's/\\/\\\\/g' -e 's/"/\\"/g' \
+        -e 's/\$/\\044/g' -e 's/`/\\140/g' \
+        -e 's/^@<:@ 	@:>@*\(@<:@^ 	=@:>@*\)@<:@ 	@:>@*=@<:@ 	@:>@*\(.*\)$/"\1", "\2",/' \
+        -e '/^"/!d' -e 's/@<:@ 	@:>@*",$/",/' "$with_frozen_mca_params" | tr '\n' ' ')
+    AC_MSG_RESULT([$with_frozen_mca_params])
+else
+    AC_MSG_RESULT([none])
+fi
+AC_DEFINE_UNQUOTED([PRTE_FROZEN_MCA_PARAMS], [$PRTE_FROZEN_MCA_PARAMS],
+                   [MCA param defaults built into the library as name, value pairs])
+
+
 #
 # Do we want to allow DLOPEN?
 #
@@ -0,0 +1,157 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Compare the cost of the checksum routines in src/util/crc.c against a
+ * plain memcpy, so the overhead of enabling the OOB and filem integrity
+ * checks (oob_tcp_checksum, filem_raw_checksum) can be judged on a given
+ * machine. Build it against a configured tree, e.g. from the top of the
+ * build directory:
+ *
+ *   cc -O2 -I. -I<srcdir> -Isrc/include -I<srcdir>/src/include \
+ *      <srcdir>/contrib/crc-bench.c <srcdir>/src/util/crc.c -o crc-bench
+ *
+ * Usage: crc-bench [size-in-bytes] [iterations]
+ */
+
+#include "prte_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "src/util/crc.h"
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1.0e9;
+}
+
+static volatile uint32_t sink;
+
+static void report(const char *name, double secs, size_t size, int iters, double base)
+{
+    double gbs = ((double) size * iters) / secs / 1.0e9;
+
+    if (0.0 < base) {
+        printf("%-28s %8.2f GB/s  %7.2fx memcpy\n", name, gbs, secs / base);
+    } else {
+        printf("%-28s %8.2f GB/s\n", name, gbs);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t size = 16384;
+    int iters = 20000, i;
+    unsigned char *src, *dst;
+    double start, tcopy, t;
+    uint32_t hw = 0, sw = 0;
+    bool have_hw;
+
+    if (1 < argc) {
+        size = strtoul(argv[1], NULL, 10);
+    }
+    if (2 < argc) {
+        iters = atoi(argv[2]);
+    }
+    if (0 == size || 0 >= iters) {
+        fprintf(stderr, "Usage: %s [size-in-bytes] [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    src = malloc(size);
+    dst = malloc(size);
+    if (NULL == src || NULL == dst) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    for (i = 0; i < (int) size; i++) {
+        src[i] = (unsigned char) (i * 131 + 7);
+    }
+
+    have_hw = prte_crc32c_hw_available();
+    printf("buffer %lu bytes, %d iterations, CRC32C hardware path %s\n", (unsigned long) size,
+           iters, have_hw ? "available" : "not available");
+
+    start = now();
+    for (i = 0; i < iters; i++) {
+        memcpy(dst, src, size);
+        sink = dst[i % size];
+    }
+    tcopy = now() - start;
+    report("memcpy", tcopy, size, iters, 0.0);
+
+    start = now();
+    for (i = 0; i < iters; i++) {
+        sink = prte_uicrc(src, size);
+    }
+    report("crc32 (byte table)", now() - start, size, iters, tcopy);
+
+    start = now();
+    for (i = 0; i < iters; i++) {
+        sink = prte_bcopy_uicrc(src, dst, size, size);
+    }
+    report("copy+crc32 (byte table)", now() - start, size, iters, tcopy);
+
+    start = now();
+    for (i = 0; i < iters; i++) {
+        sink = (uint32_t) prte_csum(src, size);
+    }
+    report("additive csum", now() - start, size, iters, tcopy);
+
+    if (have_hw) {
+        start = now();
+        for (i = 0; i < iters; i++) {
+            sink = prte_crc32c(src, size);
+        }
+        report("crc32c (hardware)", now() - start, size, iters, tcopy);
+
+        start = now();
+        for (i = 0; i < iters; i++) {
+            sink = prte_bcopy_crc32c(src, dst, size);
+        }
+        t = now() - start;
+        report("copy+crc32c (hardware)", t, size, iters, tcopy);
+
+        start = now();
+        for (i = 0; i < iters; i++) {
+            memcpy(dst, src, size);
+            sink = prte_crc32c(dst, size);
+        }
+        report("memcpy then crc32c (hw)", now() - start, size, iters, tcopy);
+        hw = prte_crc32c(src, size);
+    }
+
+    prte_crc32c_use_hw(false);
+    start = now();
+    for (i = 0; i < iters; i++) {
+        sink = prte_crc32c(src, size);
+    }
+    report("crc32c (slicing table)", now() - start, size, iters, tcopy);
+
+    start = now();
+    for (i = 0; i < iters; i++) {
+        sink = prte_bcopy_crc32c(src, dst, size);
+    }
+    report("copy+crc32c (slicing table)", now() - start, size, iters, tcopy);
+    sw = prte_crc32c(src, size);
+
+    /* every path must agree, including the standard check value */
+    if (0xe3069283 != prte_crc32c("123456789", 9) || (have_hw && hw != sw)
+        || 0 != memcmp(src, dst, size)) {
+        fprintf(stderr, "CRC32C self-check FAILED\n");
+        return 1;
+    }
+
+    free(src);
+    free(dst);
+    return 0;
+}
@@ -0,0 +1,183 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure what the verbose output call sites on the OOB and IOF
+ * message paths cost per message, comparing pmix_output_verbose()
+ * against prte_output_verbose() from src/util/output.c. Each simulated
+ * message copies a payload and passes through the number of verbose
+ * sites that prte_oob_tcp_recv_handler/send_msg (OOB) or the IOF read
+ * handlers hit per message. The disabled cases show the message rate
+ * with verbosity off; the enabled cases compare formatting each line
+ * at the call site with capturing it in the prte_output_trace buffer.
+ *
+ * This is a microbenchmark: the "message" is a memcpy of the payload
+ * followed by the verbose sites, with no sockets, event loop or
+ * buffer packing. The speedups it reports bound what the output
+ * change can save per message; they are not rates the real OOB or
+ * IOF paths reach, where that other work dominates.
+ *
+ * Build it against a configured tree, e.g. from the top of the build
+ * directory:
+ *
+ *   cc -O2 -I. -I<srcdir> -Isrc/include -I<srcdir>/src/include \
+ *      <pmix-cppflags> <srcdir>/contrib/output-bench.c \
+ *      <srcdir>/src/util/output.c <pmix-ldflags> -lpmix -o output-bench
+ *
+ * Usage: output-bench [messages] [payload-bytes] 2>/dev/null
+ */
+
+#include "prte_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "src/util/output.h"
+
+/* verbose sites hit per message */
+#define OOB_SITES 8
+#define IOF_SITES 3
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1.0e9;
+}
+
+/* stand-in for PRTE_NAME_PRINT - formats into a rotating buffer */
+static const char *name_print(int rank)
+{
+    static char bufs[16][48];
+    static int n = 0;
+    char *b = bufs[n++ % 16];
+
+    snprintf(b, sizeof(bufs[0]), "[prterun-node-12345@0,%d]", rank);
+    return b;
+}
+
+static unsigned char *src, *dst;
+static size_t payload;
+static int stream;
+
+#define MSG_LOOP(sites, call)                                  \
+    do {                                                       \
+        int _s;                                                \
+        memcpy(dst, src, payload);                             \
+        for (_s = 0; _s < (sites); _s++) {                     \
+            call;                                              \
+        }                                                      \
+    } while (0)
+
+static double run_none(int msgs, int sites)
+{
+    double start = now();
+    int m;
+
+    for (m = 0; m < msgs; m++) {
+        MSG_LOOP(sites, __asm__ __volatile__("" ::: "memory"));
+    }
+    return now() - start;
+}
+
+static double run_pmix(int msgs, int sites, int level)
+{
+    double start = now();
+    int m;
+
+    for (m = 0; m < msgs; m++) {
+        MSG_LOOP(sites, pmix_output_verbose(level, stream,
+                                            "%s oob:tcp:recv:handler read %d bytes from %s",
+                                            name_print(0), (int) payload, name_print(m)));
+    }
+    return now() - start;
+}
+
+static double run_prte(int msgs, int sites, int level)
+{
+    double start = now();
+    int m;
+
+    for (m = 0; m < msgs; m++) {
+        MSG_LOOP(sites, prte_output_verbose(level, stream,
+                                            "%s oob:tcp:recv:handler read %d bytes from %s",
+                                            name_print(0), (int) payload, name_print(m)));
+    }
+    return now() - start;
+}
+
+static void report(const char *name, double secs, int msgs, double base)
+{
+    double rate = (double) msgs / secs;
+
+    if (0.0 < base) {
+        printf("%-36s %10.0f msgs/s  %6.2fx\n", name, rate, base / secs);
+    } else {
+        printf("%-36s %10.0f msgs/s\n", name, rate);
+    }
+}
+
+static void path(const char *label, int msgs, int sites)
+{
+    double tnone, tpmix, t;
+
+    printf("%s path: %d verbose sites per message\n", label, sites);
+    tnone = run_none(msgs, sites);
+    report("  no logging", tnone, msgs, 0.0);
+
+    /* verbosity off - the usual production setting */
+    prte_output_verbose_refresh();
+    tpmix = run_pmix(msgs, sites, 5);
+    report("  disabled, pmix_output_verbose", tpmix, msgs, 0.0);
+    t = run_prte(msgs, sites, 5);
+    report("  disabled, prte_output_verbose", t, msgs, tpmix);
+
+    /* verbosity on - fewer messages as every line is output */
+    msgs /= 100;
+    pmix_output_set_verbosity(stream, 5);
+    prte_output_verbose_refresh();
+    tpmix = run_pmix(msgs, sites, 5);
+    report("  enabled, formatted at call site", tpmix, msgs, 0.0);
+    prte_output_trace_open(msgs * sites, NULL);
+    t = run_prte(msgs, sites, 5);
+    report("  enabled, prte_output_trace", t, msgs, tpmix);
+    prte_output_trace_close();
+    pmix_output_set_verbosity(stream, 0);
+}
+
+int main(int argc, char **argv)
+{
+    int msgs = 2000000;
+
+    payload = 256;
+    if (1 < argc) {
+        msgs = atoi(argv[1]);
+    }
+    if (2 < argc) {
+        payload = strtoul(argv[2], NULL, 10);
+    }
+    src = calloc(1, payload);
+    dst = calloc(1, payload);
+    if (NULL == src || NULL == dst) {
+        return 1;
+    }
+
+    pmix_output_init();
+    stream = pmix_output_open(NULL);
+    pmix_output_set_verbosity(stream, 0);
+
+    printf("%d messages of %lu bytes\n", msgs, (unsigned long) payload);
+    path("OOB", msgs, OOB_SITES);
+    path("IOF", msgs, IOF_SITES);
+
+    pmix_output_close(stream);
+    free(src);
+    free(dst);
+    return 0;
+}
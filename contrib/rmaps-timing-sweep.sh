@@ -0,0 +1,54 @@
+#!/bin/bash
+#
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+# Sweep the mapper across simulated allocations and report the time
+# spent in each mapping phase. Nothing is launched - the node pool is
+# fabricated by the ras/simulator component and the mapping is computed
+# against either the local topology or the given hwloc XML file.
+#
+# Usage: rmaps-timing-sweep.sh [topology.xml]
+#
+# The sweep can be narrowed by setting any of the following in the
+# environment (space-separated lists):
+#   NODES    - number of simulated nodes
+#   PPN      - procs (and slots) per node
+#   MAPBY    - mapping policies
+#   RANKBY   - ranking policies
+#   BINDTO   - binding policies
+
+NODES=${NODES:-"16 256 1024 4096"}
+PPN=${PPN:-"1 16 64"}
+MAPBY=${MAPBY:-"slot node package core"}
+RANKBY=${RANKBY:-"slot fill span"}
+BINDTO=${BINDTO:-"none core package"}
+
+topo_args=""
+if test -n "$1" ; then
+    topo_args="--prtemca hwloc_use_topo_file $1"
+fi
+
+for nodes in $NODES ; do
+    for ppn in $PPN ; do
+        np=$((nodes * ppn))
+        for mapby in $MAPBY ; do
+            for rankby in $RANKBY ; do
+                for bindto in $BINDTO ; do
+                    echo "=== nodes=$nodes ppn=$ppn map-by=$mapby rank-by=$rankby bind-to=$bindto"
+                    prterun --do-not-launch \
+                        --prtemca ras simulator \
+                        --prtemca ras_simulator_num_nodes $nodes \
+                        --prtemca ras_simulator_slots $ppn \
+                        --prtemca rmaps_base_report_timings 1 \
+                        $topo_args \
+                        --map-by $mapby --rank-by $rankby --bind-to $bindto \
+                        -n $np hostname 2>&1 | grep "rmaps:timing"
+                done
+            done
+        done
+    done
+done
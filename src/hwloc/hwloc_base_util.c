@@ -48,8 +48,14 @@
 #if HAVE_FCNTL_H
 #    include <fcntl.h>
 #endif
+#ifdef HAVE_SYS_TIME_H
+#    include <sys/time.h>
+#endif
+#include <ctype.h>
+#include <stdio.h>
 
 #include "src/include/constants.h"
+#include "src/include/hash_string.h"
 #include "src/pmix/pmix-internal.h"
 #include "src/runtime/prte_globals.h"
 #include "src/threads/pmix_tsd.h"
@@ -270,9 +276,246 @@ static void fill_cache_line_size(void)
     }
 }
 
+/* signature of the topology loaded from (or stored in) the node-local
+ * cache - saves us from walking the tree again to regenerate it */
+static char *cached_topo_sig = NULL;
+
+/* construct the key identifying the topology we would discover on this
+ * node: the boot ID changes on every reboot, the hwloc version determines
+ * what gets discovered, and the allowed cpus/mems reflect any cgroup we
+ * were launched into */
+static char *topo_cache_key(void)
+{
+    FILE *fp;
+    char *line = NULL, *cpus = NULL, *mems = NULL, *key, *ptr;
+    char bootid[64];
+    size_t len = 0;
+
+    fp = fopen("/proc/sys/kernel/random/boot_id", "r");
+    if (NULL == fp) {
+        return NULL;
+    }
+    if (NULL == fgets(bootid, sizeof(bootid), fp)) {
+        fclose(fp);
+        return NULL;
+    }
+    fclose(fp);
+    if (NULL != (ptr = strchr(bootid, '\n'))) {
+        *ptr = '\0';
+    }
+
+    fp = fopen("/proc/self/status", "r");
+    if (NULL != fp) {
+        while (0 < getline(&line, &len, fp)) {
+            if (NULL != (ptr = strchr(line, '\n'))) {
+                *ptr = '\0';
+            }
+            if (0 == strncmp(line, "Cpus_allowed_list:", strlen("Cpus_allowed_list:"))) {
+                ptr = line + strlen("Cpus_allowed_list:");
+                while (isspace(*ptr)) {
+                    ++ptr;
+                }
+                cpus = strdup(ptr);
+            } else if (0 == strncmp(line, "Mems_allowed_list:", strlen("Mems_allowed_list:"))) {
+                ptr = line + strlen("Mems_allowed_list:");
+                while (isspace(*ptr)) {
+                    ++ptr;
+                }
+                mems = strdup(ptr);
+            }
+        }
+        free(line);
+        fclose(fp);
+    }
+
+    pmix_asprintf(&key, "%s:%x:%x:%s:%s", bootid, (unsigned) HWLOC_API_VERSION,
+                  (unsigned) hwloc_get_api_version(),
+                  (NULL == cpus) ? "all" : cpus,
+                  (NULL == mems) ? "all" : mems);
+    if (NULL != cpus) {
+        free(cpus);
+    }
+    if (NULL != mems) {
+        free(mems);
+    }
+    return key;
+}
+
+/* hwloc does not include the binding support in its XML output, so
+ * record the cpubind and membind support flags the topology reported
+ * when it was discovered as a hex string of the raw flag bytes */
+static char *topo_support_string(hwloc_topology_t topo)
+{
+    const struct hwloc_topology_support *support;
+    const unsigned char *cpu, *mem;
+    char *str;
+    size_t n, len;
+
+    support = hwloc_topology_get_support(topo);
+    cpu = (const unsigned char *) support->cpubind;
+    mem = (const unsigned char *) support->membind;
+    len = 2 * (sizeof(*support->cpubind) + sizeof(*support->membind)) + 2;
+    str = (char *) malloc(len);
+    if (NULL == str) {
+        return NULL;
+    }
+    len = 0;
+    for (n = 0; n < sizeof(*support->cpubind); n++) {
+        len += sprintf(str + len, "%02x", cpu[n]);
+    }
+    str[len++] = ':';
+    for (n = 0; n < sizeof(*support->membind); n++) {
+        len += sprintf(str + len, "%02x", mem[n]);
+    }
+    str[len] = '\0';
+    return str;
+}
+
+/* read the next line of the cache companion file, without its newline */
+static char *topo_cache_line(FILE *fp)
+{
+    char *line = NULL, *ptr;
+    size_t len = 0;
+
+    if (0 >= getline(&line, &len, fp)) {
+        free(line);
+        return NULL;
+    }
+    if (NULL != (ptr = strchr(line, '\n'))) {
+        *ptr = '\0';
+    }
+    return line;
+}
+
+/* the cache consists of two files: the topology itself in XML format,
+ * and a companion file holding the key on the first line, the
+ * topology signature on the second, and the binding support flags on
+ * the third. The companion is written last, so its presence with a
+ * matching key means the XML is complete */
+static int topo_cache_load(char *key, char *xmlfile, char *sigfile)
+{
+    FILE *fp;
+    char *line, *sig = NULL, *support = NULL, *loaded;
+
+    fp = fopen(sigfile, "r");
+    if (NULL == fp) {
+        return PRTE_ERR_NOT_FOUND;
+    }
+    if (NULL != (line = topo_cache_line(fp))) {
+        if (0 == strcmp(line, key)) {
+            if (NULL != (sig = topo_cache_line(fp))) {
+                support = topo_cache_line(fp);
+            }
+        } else {
+            pmix_output_verbose(2, prte_hwloc_base_output,
+                                "hwloc:base topology cache key mismatch - ignoring %s",
+                                xmlfile);
+        }
+        free(line);
+    }
+    fclose(fp);
+    if (NULL == sig || NULL == support) {
+        if (NULL != sig) {
+            free(sig);
+        }
+        return PRTE_ERR_NOT_FOUND;
+    }
+
+    if (0 != hwloc_topology_init(&prte_hwloc_topology)) {
+        free(sig);
+        free(support);
+        return PRTE_ERR_NOT_SUPPORTED;
+    }
+    if (0 != hwloc_topology_set_xml(prte_hwloc_topology, xmlfile) ||
+        0 != prte_hwloc_base_topology_set_flags(prte_hwloc_topology,
+                                                HWLOC_TOPOLOGY_FLAG_IS_THISSYSTEM, true) ||
+        0 != hwloc_topology_load(prte_hwloc_topology)) {
+        hwloc_topology_destroy(prte_hwloc_topology);
+        prte_hwloc_topology = NULL;
+        free(sig);
+        free(support);
+        return PRTE_ERR_NOT_FOUND;
+    }
+
+    /* as we told hwloc this is our own system, it sets up the
+     * binding support itself - make sure it matches what was
+     * reported when the topology was discovered, otherwise fall
+     * back to discovery so we don't misreport what we can bind */
+    loaded = topo_support_string(prte_hwloc_topology);
+    if (NULL == loaded || 0 != strcmp(loaded, support)) {
+        pmix_output_verbose(2, prte_hwloc_base_output,
+                            "hwloc:base topology cache binding support mismatch - ignoring %s",
+                            xmlfile);
+        hwloc_topology_destroy(prte_hwloc_topology);
+        prte_hwloc_topology = NULL;
+        if (NULL != loaded) {
+            free(loaded);
+        }
+        free(sig);
+        free(support);
+        return PRTE_ERR_NOT_FOUND;
+    }
+    free(loaded);
+    free(support);
+
+    cached_topo_sig = sig;
+    return PRTE_SUCCESS;
+}
+
+static void topo_cache_store(char *key, char *xmlfile, char *sigfile)
+{
+    FILE *fp;
+    char *tmp, *support;
+    int rc;
+
+    if (NULL == (support = topo_support_string(prte_hwloc_topology))) {
+        return;
+    }
+    if (PMIX_SUCCESS != pmix_os_dirpath_create(prte_hwloc_base_topo_cache_dir, S_IRWXU)) {
+        pmix_output_verbose(2, prte_hwloc_base_output,
+                            "hwloc:base cannot create topology cache dir %s",
+                            prte_hwloc_base_topo_cache_dir);
+        free(support);
+        return;
+    }
+
+    /* write to a temporary file and rename it into place so that
+     * other daemons on this node never see a partial file */
+    pmix_asprintf(&tmp, "%s.%lu", xmlfile, (unsigned long) getpid());
+#if HWLOC_API_VERSION < 0x20000
+    rc = hwloc_topology_export_xml(prte_hwloc_topology, tmp);
+#else
+    rc = hwloc_topology_export_xml(prte_hwloc_topology, tmp, 0);
+#endif
+    if (0 != rc || 0 != rename(tmp, xmlfile)) {
+        unlink(tmp);
+        free(tmp);
+        free(support);
+        return;
+    }
+    free(tmp);
+
+    pmix_asprintf(&tmp, "%s.%lu", sigfile, (unsigned long) getpid());
+    fp = fopen(tmp, "w");
+    if (NULL == fp) {
+        free(tmp);
+        free(support);
+        return;
+    }
+    rc = fprintf(fp, "%s\n%s\n%s\n", key, cached_topo_sig, support);
+    if (0 != fclose(fp) || 0 > rc || 0 != rename(tmp, sigfile)) {
+        unlink(tmp);
+    }
+    free(tmp);
+    free(support);
+}
+
 int prte_hwloc_base_get_topology(void)
 {
     int rc;
+    char *key = NULL, *xmlfile = NULL, *sigfile = NULL;
+    uint32_t hash;
+    struct timeval start, stop;
 
     pmix_output_verbose(2, prte_hwloc_base_output,
                         "hwloc:base:get_topology");
@@ -282,15 +525,60 @@ int prte_hwloc_base_get_topology(void)
         return PRTE_SUCCESS;
     }
 
+    if (NULL != cached_topo_sig) {
+        free(cached_topo_sig);
+        cached_topo_sig = NULL;
+    }
+
+    gettimeofday(&start, NULL);
     if (NULL == prte_hwloc_base_topo_file) {
+        if (NULL != prte_hwloc_base_topo_cache_dir &&
+            NULL != (key = topo_cache_key())) {
+            PRTE_HASH_STR(key, hash);
+            pmix_asprintf(&xmlfile, "%s/prte-topo.%lu.%08x.xml", prte_hwloc_base_topo_cache_dir,
+                          (unsigned long) geteuid(), hash);
+            pmix_asprintf(&sigfile, "%s/prte-topo.%lu.%08x.sig", prte_hwloc_base_topo_cache_dir,
+                          (unsigned long) geteuid(), hash);
+            if (PRTE_SUCCESS == topo_cache_load(key, xmlfile, sigfile)) {
+                gettimeofday(&stop, NULL);
+                pmix_output_verbose(1, prte_hwloc_base_output,
+                                    "hwloc:base loaded topology from cache %s in %ld usec",
+                                    xmlfile,
+                                    (long) ((stop.tv_sec - start.tv_sec) * 1000000 +
+                                            (stop.tv_usec - start.tv_usec)));
+                free(key);
+                free(xmlfile);
+                free(sigfile);
+                fill_cache_line_size();
+                return PRTE_SUCCESS;
+            }
+        }
         pmix_output_verbose(1, prte_hwloc_base_output,
                             "hwloc:base discovering topology");
         if (0 != hwloc_topology_init(&prte_hwloc_topology) ||
             0 != prte_hwloc_base_topology_set_flags(prte_hwloc_topology, 0, true) ||
             0 != hwloc_topology_load(prte_hwloc_topology)) {
             PRTE_ERROR_LOG(PRTE_ERR_NOT_SUPPORTED);
+            if (NULL != key) {
+                free(key);
+                free(xmlfile);
+                free(sigfile);
+            }
             return PRTE_ERR_NOT_SUPPORTED;
         }
+        gettimeofday(&stop, NULL);
+        pmix_output_verbose(1, prte_hwloc_base_output,
+                            "hwloc:base discovered topology in %ld usec",
+                            (long) ((stop.tv_sec - start.tv_sec) * 1000000 +
+                                    (stop.tv_usec - start.tv_usec)));
+        if (NULL != key) {
+            /* compute the signature now so it can be stored with the topology */
+            cached_topo_sig = prte_hwloc_base_get_topo_signature(prte_hwloc_topology);
+            topo_cache_store(key, xmlfile, sigfile);
+            free(key);
+            free(xmlfile);
+            free(sigfile);
+        }
     } else {
         pmix_output_verbose(1, prte_hwloc_base_output,
                             "hwloc:base loading topology from file %s",
@@ -319,6 +607,10 @@ int prte_hwloc_base_set_topology(char *topofile)
     if (NULL != prte_hwloc_topology) {
         hwloc_topology_destroy(prte_hwloc_topology);
     }
+    if (NULL != cached_topo_sig) {
+        free(cached_topo_sig);
+        cached_topo_sig = NULL;
+    }
     if (0 != hwloc_topology_init(&prte_hwloc_topology)) {
         return PRTE_ERR_NOT_SUPPORTED;
     }
@@ -1473,6 +1765,12 @@ char *prte_hwloc_base_get_topo_signature(hwloc_topology_t topo)
     unsigned i;
     hwloc_bitmap_t complete, allowed;
 
+    /* if our own topology came from the node-local cache, then
+     * its signature came with it */
+    if (topo == prte_hwloc_topology && NULL != cached_topo_sig) {
+        return strdup(cached_topo_sig);
+    }
+
     nnuma = prte_hwloc_base_get_nbobjs_by_type(topo, HWLOC_OBJ_NUMANODE, 0);
     npackage = prte_hwloc_base_get_nbobjs_by_type(topo, HWLOC_OBJ_PACKAGE, 0);
     nl3 = prte_hwloc_base_get_nbobjs_by_type(topo, HWLOC_OBJ_L3CACHE, 3);
@@ -421,6 +421,16 @@ static inline uint16_t ntohs(uint16_t netvar)
 #        define PF_INET6 PF_UNSPEC
 #    endif
 
+/* nanoseconds of a struct stat's modification time - zero
+   where the platform only records whole seconds */
+#    if defined(HAVE_STRUCT_STAT_ST_MTIM)
+#        define PRTE_STAT_MTIME_NSEC(s) ((long) (s)->st_mtim.tv_nsec)
+#    elif defined(HAVE_STRUCT_STAT_ST_MTIMESPEC)
+#        define PRTE_STAT_MTIME_NSEC(s) ((long) (s)->st_mtimespec.tv_nsec)
+#    else
+#        define PRTE_STAT_MTIME_NSEC(s) 0L
+#    endif
+
 #    if defined(__APPLE__) && defined(HAVE_INTTYPES_H)
 /* Prior to Mac OS X 10.3, the length modifier "ll" wasn't
    supported, but "q" was for long long.  This isn't ANSI
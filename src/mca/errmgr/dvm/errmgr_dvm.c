@@ -82,6 +82,7 @@ static void proc_errors(int fd, short args, void *cbdata);
 static void check_send_notification(prte_job_t *jdata,
                                     prte_proc_t *proc,
                                     pmix_status_t event);
+static void lost_daemon(prte_proc_t *daemon);
 
 static int init(void)
 {
@@ -217,6 +218,39 @@ static void job_errors(int fd, short args, void *cbdata)
     PMIX_RELEASE(caddy);
 }
 
+/* the DVM has routed around a lost daemon - take its node out
+ * of service and fail the procs that were running on it so
+ * their jobs are handled just as if the procs had died */
+static void lost_daemon(prte_proc_t *daemon)
+{
+    prte_node_t *node = daemon->node;
+    prte_proc_t *pptr;
+    int i;
+
+    pmix_output_verbose(1, prte_errmgr_base_framework.framework_output,
+                        "%s errmgr:dvm: daemon %s on node %s lost - DVM repaired in %.3f msec",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&daemon->name),
+                        (NULL == node) ? "UNKNOWN" : node->name, prte_rml_base.heal_msec);
+    if (NULL == node) {
+        return;
+    }
+    node->state = PRTE_NODE_STATE_DOWN;
+    PRTE_FLAG_UNSET(node, PRTE_NODE_FLAG_DAEMON_LAUNCHED);
+
+    for (i = 0; i < node->procs->size; i++) {
+        pptr = (prte_proc_t *) pmix_pointer_array_get_item(node->procs, i);
+        if (NULL == pptr || pptr == daemon ||
+            !PRTE_FLAG_TEST(pptr, PRTE_PROC_FLAG_ALIVE)) {
+            continue;
+        }
+        PRTE_FLAG_UNSET(pptr, PRTE_PROC_FLAG_ALIVE);
+        if (0 == pptr->exit_code) {
+            pptr->exit_code = PRTE_ERR_COMM_FAILURE;
+        }
+        PRTE_ACTIVATE_PROC_STATE(&pptr->name, PRTE_PROC_STATE_LIFELINE_LOST);
+    }
+}
+
 static void proc_errors(int fd, short args, void *cbdata)
 {
     prte_state_caddy_t *caddy = (prte_state_caddy_t *) cbdata;
@@ -267,6 +301,15 @@ static void proc_errors(int fd, short args, void *cbdata)
             PRTE_FLAG_UNSET(pptr, PRTE_PROC_FLAG_ALIVE);
             /* update the state */
             pptr->state = state;
+            if (prte_rml_base.self_heal &&
+                !prte_prteds_term_ordered && !prte_abnormal_term_ordered) {
+                /* route around the lost daemon and keep the DVM alive - the
+                 * daemon count is left alone as the routing tree is laid out
+                 * over the original ranks */
+                prte_rml_route_lost(proc->rank);
+                lost_daemon(pptr);
+                goto cleanup;
+            }
             /* adjust our num_procs */
             --prte_process_info.num_daemons;
             /* if we have ordered prteds to terminate or abort
@@ -427,6 +470,29 @@ keep_going:
         }
         break;
 
+    case PRTE_PROC_STATE_LIFELINE_LOST:
+        /* the daemon hosting this proc was lost */
+        PMIX_OUTPUT_VERBOSE((5, prte_errmgr_base_framework.framework_output,
+                             "%s errmgr:dvm: proc %s lost with its daemon",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(proc)));
+        if (flag) {
+            /* send out a notification if one is requested */
+            check_send_notification(jdata, pptr, PMIX_ERR_LOST_CONNECTION);
+        } else {
+            if (!PRTE_FLAG_TEST(jdata, PRTE_JOB_FLAG_ABORTED)) {
+                jdata->state = PRTE_JOB_STATE_COMM_FAILED;
+                /* point to the first rank to cause the problem */
+                prte_set_attribute(&jdata->attributes, PRTE_JOB_ABORTED_PROC, PRTE_ATTR_LOCAL, pptr,
+                                   PMIX_POINTER);
+                /* retain the object so it doesn't get free'd */
+                PMIX_RETAIN(pptr);
+                PRTE_FLAG_SET(jdata, PRTE_JOB_FLAG_ABORTED);
+                jdata->exit_code = pptr->exit_code;
+                _terminate_job(jdata->nspace);
+            }
+        }
+        break;
+
     case PRTE_PROC_STATE_TERM_WO_SYNC:
         PMIX_OUTPUT_VERBOSE((5, prte_errmgr_base_framework.framework_output,
                              "%s errmgr:dvm: proc %s terminated without sync",
@@ -57,6 +57,8 @@ PRTE_EXPORT extern int prte_ess_base_num_procs;
 PRTE_EXPORT extern char *prte_ess_base_nspace;
 PRTE_EXPORT extern char *prte_ess_base_vpid;
 PRTE_EXPORT extern pmix_list_t prte_ess_base_signals;
+PRTE_EXPORT extern bool prte_ess_base_deferred_open;
+PRTE_EXPORT extern bool prte_ess_base_report_timings;
 
 /*
  * Internal helper functions used by components
@@ -67,6 +69,10 @@ PRTE_EXPORT int prte_ess_base_std_prolog(void);
 
 PRTE_EXPORT int prte_ess_base_prted_setup(void);
 PRTE_EXPORT int prte_ess_base_prted_finalize(void);
+/* open the frameworks a daemon does not need until it launches
+ * procs - a no-op if they are already open or on the DVM master.
+ * Call it before first touching rtc, rmaps or filem state */
+PRTE_EXPORT int prte_ess_base_prted_open_deferred(void);
 
 PRTE_EXPORT int prte_ess_base_setup_signals(char *signals);
 
@@ -52,6 +52,8 @@ int prte_ess_base_num_procs = -1;
 char *prte_ess_base_nspace = NULL;
 char *prte_ess_base_vpid = NULL;
 pmix_list_t prte_ess_base_signals = PMIX_LIST_STATIC_INIT;
+bool prte_ess_base_deferred_open = false;
+bool prte_ess_base_report_timings = false;
 
 static char *forwarded_signals = NULL;
 
@@ -92,6 +94,19 @@ static int prte_ess_base_register(pmix_mca_base_register_flag_t flags)
     pmix_mca_base_var_register_synonym(ret, "prte", "ess", "hnp", "forward_signals",
                                        PMIX_MCA_BASE_VAR_SYN_FLAG_DEPRECATED);
 
+    prte_ess_base_deferred_open = false;
+    (void) pmix_mca_base_var_register("prte", "ess", "base", "deferred_open",
+                                      "Have daemons open the rtc, rmaps and filem frameworks after "
+                                      "calling back to the DVM master instead of during startup",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &prte_ess_base_deferred_open);
+
+    prte_ess_base_report_timings = false;
+    (void) pmix_mca_base_var_register("prte", "ess", "base", "report_timings",
+                                      "Report the time spent in each phase of daemon startup",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &prte_ess_base_report_timings);
+
     return PRTE_SUCCESS;
 }
 
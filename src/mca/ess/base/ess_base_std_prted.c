@@ -31,6 +31,9 @@
 
 #include <stdio.h>
 #include <sys/types.h>
+#ifdef HAVE_SYS_TIME_H
+#    include <sys/time.h>
+#endif
 #ifdef HAVE_FCNTL_H
 #    include <fcntl.h>
 #endif
@@ -70,6 +73,7 @@
 #include "src/runtime/prte_quit.h"
 #include "src/runtime/prte_wait.h"
 #include "src/util/name_fns.h"
+#include "src/util/output.h"
 #include "src/util/session_dir.h"
 #include "src/util/pmix_show_help.h"
 
@@ -86,6 +90,27 @@ static void shutdown_signal(int fd, short flags, void *arg);
 static void epipe_signal_callback(int fd, short flags, void *arg);
 static void signal_forward_callback(int fd, short event, void *arg);
 static prte_event_t *forward_signals_events = NULL;
+static bool deferred_opened = false;
+static bool deferred_pending = false;
+static prte_event_t deferred_ev;
+static void open_deferred_cb(int fd, short flags, void *arg);
+
+static void report_phase(const char *phase, struct timeval *prev)
+{
+    struct timeval now;
+    char *elapsed;
+
+    if (!prte_ess_base_report_timings) {
+        return;
+    }
+    gettimeofday(&now, NULL);
+    elapsed = prte_pretty_print_timing(now.tv_sec - prev->tv_sec,
+                                       now.tv_usec - prev->tv_usec);
+    pmix_output(0, "[timing] %s prted setup %s: %s",
+                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), phase, elapsed);
+    free(elapsed);
+    *prev = now;
+}
 
 static void setup_sighandler(int signal, prte_event_t *ev, prte_event_cbfunc_t cbfunc)
 {
@@ -110,8 +135,11 @@ int prte_ess_base_prted_setup(void)
     prte_ess_base_signal_t *sig;
     int idx;
     pmix_value_t val;
+    struct timeval start, phase;
 
     plm_in_use = false;
+    gettimeofday(&start, NULL);
+    phase = start;
 
     /* setup callback for SIGPIPE */
     setup_sighandler(SIGPIPE, &epipe_handler, epipe_signal_callback);
@@ -169,6 +197,7 @@ int prte_ess_base_prted_setup(void)
             break;
         }
     }
+    report_phase("topology", &phase);
 
     /* define the HNP name */
     PMIX_LOAD_PROCID(PRTE_PROC_MY_HNP, PRTE_PROC_MY_NAME->nspace, 0);
@@ -213,6 +242,7 @@ int prte_ess_base_prted_setup(void)
             goto error;
         }
     }
+    report_phase("state/errmgr/plm", &phase);
 
     /* Setup the job data object for the daemons */
     /* create and store the job data object */
@@ -292,6 +322,7 @@ int prte_ess_base_prted_setup(void)
             }
         }
     }
+    report_phase("session dir", &phase);
 
     /* setup the PMIx server - we need this here in case the
      * communications infrastructure wants to register
@@ -370,6 +401,7 @@ int prte_ess_base_prted_setup(void)
         }
         PMIX_VALUE_DESTRUCT(&val);
     }
+    report_phase("pmix server/oob", &phase);
 
     /* select the errmgr */
     if (PRTE_SUCCESS != (ret = prte_errmgr_base_select())) {
@@ -405,35 +437,23 @@ int prte_ess_base_prted_setup(void)
         error = "prte_odls_base_select";
         goto error;
     }
-    /* Open/select the rtc */
-    if (PRTE_SUCCESS
-        != (ret = pmix_mca_base_framework_open(&prte_rtc_base_framework,
-                                               PMIX_MCA_BASE_OPEN_DEFAULT))) {
-        PRTE_ERROR_LOG(ret);
-        error = "prte_rtc_base_open";
-        goto error;
-    }
-    if (PRTE_SUCCESS != (ret = prte_rtc_base_select())) {
-        PRTE_ERROR_LOG(ret);
-        error = "prte_rtc_base_select";
-        goto error;
-    }
-    if (PRTE_SUCCESS
-        != (ret = pmix_mca_base_framework_open(&prte_rmaps_base_framework,
-                                               PMIX_MCA_BASE_OPEN_DEFAULT))) {
-        PRTE_ERROR_LOG(ret);
-        error = "prte_rmaps_base_open";
-        goto error;
-    }
-    if (PRTE_SUCCESS != (ret = prte_rmaps_base_select())) {
-        PRTE_ERROR_LOG(ret);
-        error = "prte_rmaps_base_select";
-        goto error;
+    report_phase("grpcomm/odls", &phase);
+
+    /* rtc, rmaps and filem are not needed to wire up, so
+     * they can be opened once we have called back */
+    if (prte_ess_base_deferred_open) {
+        prte_event_set(prte_event_base, &deferred_ev, -1, PRTE_EV_WRITE, open_deferred_cb, NULL);
+        prte_event_active(&deferred_ev, PRTE_EV_WRITE, 1);
+        deferred_pending = true;
+    } else if (PRTE_SUCCESS != (ret = prte_ess_base_prted_open_deferred())) {
+        /* the open already barked */
+        PMIX_RELEASE(jdata);
+        return ret;
     }
 
-    /* if a topology file was given, then the rmaps framework open
-     * will have reset our topology. Ensure we always get the right
-     * one by setting our node topology afterwards
+    /* record our node topology - this no longer waits for the
+     * rmaps framework to be opened, which may be deferred until
+     * after we call back and only reads the topology anyway
      */
     t = PMIX_NEW(prte_topology_t);
     t->topo = prte_hwloc_topology;
@@ -485,6 +505,61 @@ int prte_ess_base_prted_setup(void)
         error = "prte_iof_base_select";
         goto error;
     }
+    report_phase("plm/iof", &phase);
+    report_phase("total", &start);
+
+    return PRTE_SUCCESS;
+
+error:
+    pmix_show_help("help-prte-runtime.txt", "prte_init:startup:internal-failure", true,
+                   error, PRTE_ERROR_NAME(ret), ret);
+    /* remove our use of the session directory tree */
+    PMIX_RELEASE(jdata);
+    return PRTE_ERR_SILENT;
+}
+
+int prte_ess_base_prted_open_deferred(void)
+{
+    int ret;
+    char *error = NULL;
+    struct timeval start;
+
+    /* the DVM master opens everything during its own setup */
+    if (deferred_opened || PRTE_PROC_IS_MASTER) {
+        return PRTE_SUCCESS;
+    }
+    deferred_opened = true;
+    if (deferred_pending) {
+        prte_event_del(&deferred_ev);
+        deferred_pending = false;
+    }
+    gettimeofday(&start, NULL);
+
+    /* Open/select the rtc */
+    if (PRTE_SUCCESS
+        != (ret = pmix_mca_base_framework_open(&prte_rtc_base_framework,
+                                               PMIX_MCA_BASE_OPEN_DEFAULT))) {
+        PRTE_ERROR_LOG(ret);
+        error = "prte_rtc_base_open";
+        goto error;
+    }
+    if (PRTE_SUCCESS != (ret = prte_rtc_base_select())) {
+        PRTE_ERROR_LOG(ret);
+        error = "prte_rtc_base_select";
+        goto error;
+    }
+    if (PRTE_SUCCESS
+        != (ret = pmix_mca_base_framework_open(&prte_rmaps_base_framework,
+                                               PMIX_MCA_BASE_OPEN_DEFAULT))) {
+        PRTE_ERROR_LOG(ret);
+        error = "prte_rmaps_base_open";
+        goto error;
+    }
+    if (PRTE_SUCCESS != (ret = prte_rmaps_base_select())) {
+        PRTE_ERROR_LOG(ret);
+        error = "prte_rmaps_base_select";
+        goto error;
+    }
     /* setup the FileM */
     if (PRTE_SUCCESS
         != (ret = pmix_mca_base_framework_open(&prte_filem_base_framework,
@@ -498,17 +573,27 @@ int prte_ess_base_prted_setup(void)
         error = "prte_filem_base_select";
         goto error;
     }
-
+    report_phase("rtc/rmaps/filem", &start);
+    prte_output_verbose_refresh();
     return PRTE_SUCCESS;
 
 error:
     pmix_show_help("help-prte-runtime.txt", "prte_init:startup:internal-failure", true,
                    error, PRTE_ERROR_NAME(ret), ret);
-    /* remove our use of the session directory tree */
-    PMIX_RELEASE(jdata);
     return PRTE_ERR_SILENT;
 }
 
+static void open_deferred_cb(int fd, short flags, void *arg)
+{
+    PRTE_HIDE_UNUSED_PARAMS(fd, flags, arg);
+
+    deferred_pending = false;
+    if (PRTE_SUCCESS != prte_ess_base_prted_open_deferred()) {
+        PRTE_UPDATE_EXIT_STATUS(PRTE_ERROR_DEFAULT_EXIT_CODE);
+        PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
+    }
+}
+
 int prte_ess_base_prted_finalize(void)
 {
     prte_ess_base_signal_t *sig;
@@ -529,6 +614,10 @@ int prte_ess_base_prted_finalize(void)
         forward_signals_events = NULL;
         signals_set = false;
     }
+    if (deferred_pending) {
+        prte_event_del(&deferred_ev);
+        deferred_pending = false;
+    }
 
     if (NULL != prte_errmgr.finalize) {
         prte_errmgr.finalize();
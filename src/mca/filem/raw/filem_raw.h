@@ -18,6 +18,9 @@
 
 #include "prte_config.h"
 
+#include <sys/types.h>
+#include <time.h>
+
 #include "src/class/pmix_object.h"
 #include "src/event/event-internal.h"
 #include "src/mca/mca.h"
@@ -30,9 +33,21 @@ PRTE_MODULE_EXPORT extern prte_filem_base_component_t prte_mca_filem_raw_compone
 PRTE_EXPORT extern prte_filem_base_module_t prte_filem_raw_module;
 
 extern bool prte_filem_raw_flatten_trees;
+extern bool prte_filem_raw_checksum;
+extern bool prte_filem_raw_cache;
+extern char *prte_filem_raw_cache_dir;
+extern size_t prte_filem_raw_cache_max;
 
 #define PRTE_FILEM_RAW_CHUNK_MAX 16384
 
+/* commands leading each message on the FILEM_BASE tag */
+#define PRTE_FILEM_RAW_CHUNK    0
+#define PRTE_FILEM_RAW_MANIFEST 1
+
+/* commands leading each message on the FILEM_BASE_RESP tag */
+#define PRTE_FILEM_RAW_ACK  0
+#define PRTE_FILEM_RAW_NEED 1
+
 /* local classes */
 typedef struct {
     pmix_list_item_t super;
@@ -56,6 +71,17 @@ typedef struct {
     int32_t nchunk;
     int status;
     pmix_rank_t nrecvd;
+    /* content key identifying the file in the daemon caches */
+    char *key;
+    uint64_t size;
+    time_t mtime;
+    long mtime_nsec;
+    ino_t ino;
+    /* manifest responses and the daemons that asked for the data */
+    pmix_rank_t nresp;
+    pmix_rank_t ntargets;
+    pmix_rank_t *targets;
+    bool started;
 } prte_filem_raw_xfer_t;
 PMIX_CLASS_DECLARATION(prte_filem_raw_xfer_t);
 
@@ -68,9 +94,11 @@ typedef struct {
     char *file;
     char *top;
     char *fullpath;
+    char *key;
     int32_t type;
     char **link_pts;
     pmix_list_t outputs;
+    int status;
 } prte_filem_raw_incoming_t;
 PMIX_CLASS_DECLARATION(prte_filem_raw_incoming_t);
 
@@ -37,6 +37,10 @@ static int filem_raw_close(void);
 static int filem_raw_query(pmix_mca_base_module_t **module, int *priority);
 
 bool prte_filem_raw_flatten_trees = false;
+bool prte_filem_raw_checksum = false;
+bool prte_filem_raw_cache = true;
+char *prte_filem_raw_cache_dir = NULL;
+size_t prte_filem_raw_cache_max = 4096;
 
 prte_filem_base_component_t prte_mca_filem_raw_component = {
     PRTE_FILEM_BASE_VERSION_2_0_0,
@@ -65,6 +69,37 @@ static int filem_raw_register(void)
                                                 PMIX_MCA_BASE_VAR_TYPE_BOOL,
                                                 &prte_filem_raw_flatten_trees);
 
+    prte_filem_raw_checksum = false;
+    (void) pmix_mca_base_component_var_register(c, "checksum",
+                                                "Send a CRC32C with each chunk of a prepositioned file so "
+                                                "the daemons can detect corruption in transit",
+                                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                                &prte_filem_raw_checksum);
+
+    prte_filem_raw_cache = true;
+    (void) pmix_mca_base_component_var_register(c, "cache",
+                                                "Keep prepositioned files in a per-daemon cache keyed by their "
+                                                "content so later jobs only transfer files a daemon does not "
+                                                "already hold",
+                                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                                &prte_filem_raw_cache);
+
+    prte_filem_raw_cache_dir = NULL;
+    (void) pmix_mca_base_component_var_register(c, "cache_dir",
+                                                "Directory holding the file cache on each node - if not given, "
+                                                "the cache is kept in the daemon's session directory and "
+                                                "discarded when the DVM terminates",
+                                                PMIX_MCA_BASE_VAR_TYPE_STRING,
+                                                &prte_filem_raw_cache_dir);
+
+    prte_filem_raw_cache_max = 4096;
+    (void) pmix_mca_base_component_var_register(c, "cache_max",
+                                                "Largest total size (in MB) of the files held in the cache on "
+                                                "each node - the least recently used files are removed to stay "
+                                                "below it (0 = no limit)",
+                                                PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                                &prte_filem_raw_cache_max);
+
     return PRTE_SUCCESS;
 }
 
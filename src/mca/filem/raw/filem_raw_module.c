@@ -37,6 +37,7 @@
 #include "src/class/pmix_list.h"
 #include "src/event/event-internal.h"
 
+#include "src/util/crc.h"
 #include "src/util/pmix_argv.h"
 #include "src/util/pmix_basename.h"
 #include "src/util/pmix_os_dirpath.h"
@@ -55,6 +56,7 @@
 #include "src/util/name_fns.h"
 #include "src/util/proc_info.h"
 #include "src/util/session_dir.h"
+#include "src/util/sha256.h"
 
 #include "src/mca/filem/base/base.h"
 #include "src/mca/filem/filem.h"
@@ -85,8 +87,10 @@ prte_filem_base_module_t prte_filem_raw_module = {.filem_init = raw_init,
 static pmix_list_t outbound_files;
 static pmix_list_t incoming_files;
 static pmix_list_t positioned_files;
+static char *cache_root = NULL;
 
 static void send_chunk(int fd, short argc, void *cbdata);
+static void file_complete(prte_filem_raw_incoming_t *sink);
 static void recv_files(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
                        prte_rml_tag_t tag, void *cbdata);
 static void recv_ack(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
@@ -131,13 +135,304 @@ static int raw_finalize(void)
         }
         PMIX_DESTRUCT(&positioned_files);
     }
+    if (NULL != cache_root) {
+        free(cache_root);
+        cache_root = NULL;
+    }
+
+    return PRTE_SUCCESS;
+}
+
+/* The file cache holds one copy of each file this daemon has received,
+ * named by a key formed from the SHA-256 digest of its contents, its size
+ * and its mtime - CRC32C only guards the chunks in transit. Cached files
+ * are read-only and are copied in and out rather than linked, so a job
+ * gets the same file modes as an uncached transfer and can never modify
+ * the copy a later job will be given. The least recently used files are
+ * removed once the cache grows past prte_filem_raw_cache_max MB.
+ */
+static char *cache_path(const char *key)
+{
+    char *dir;
+    int rc;
+
+    if (!prte_filem_raw_cache || NULL == key) {
+        return NULL;
+    }
+    if (NULL == cache_root) {
+        if (NULL != prte_filem_raw_cache_dir) {
+            dir = strdup(prte_filem_raw_cache_dir);
+        } else if (NULL != prte_process_info.top_session_dir) {
+            dir = pmix_os_path(false, prte_process_info.top_session_dir, "filem-cache", NULL);
+        } else {
+            return NULL;
+        }
+        if (PMIX_SUCCESS != (rc = pmix_os_dirpath_create(dir, S_IRWXU))) {
+            /* run without a cache on this node */
+            PMIX_OUTPUT_VERBOSE((1, prte_filem_base_framework.framework_output,
+                                 "%s filem:raw: cannot create cache directory %s - caching disabled",
+                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), dir));
+            free(dir);
+            prte_filem_raw_cache = false;
+            return NULL;
+        }
+        cache_root = dir;
+    }
+    return pmix_os_path(false, cache_root, key, NULL);
+}
+
+static int copy_file(const char *src, const char *dst, mode_t mode)
+{
+    unsigned char data[PRTE_FILEM_RAW_CHUNK_MAX];
+    ssize_t nbytes, nw, off;
+    int in, out, rc = PRTE_SUCCESS;
+
+    if (0 > (in = open(src, O_RDONLY))) {
+        return PRTE_ERR_FILE_OPEN_FAILURE;
+    }
+    if (0 > (out = open(dst, O_WRONLY | O_CREAT | O_TRUNC, mode))) {
+        close(in);
+        return PRTE_ERR_FILE_OPEN_FAILURE;
+    }
+    while (0 != (nbytes = read(in, data, sizeof(data)))) {
+        if (0 > nbytes) {
+            if (EINTR == errno) {
+                continue;
+            }
+            rc = PRTE_ERR_FILE_READ_FAILURE;
+            break;
+        }
+        for (off = 0; off < nbytes; off += nw) {
+            nw = write(out, &data[off], nbytes - off);
+            if (0 > nw) {
+                if (EINTR == errno) {
+                    nw = 0;
+                    continue;
+                }
+                rc = PRTE_ERR_FILE_WRITE_FAILURE;
+                break;
+            }
+        }
+        if (PRTE_SUCCESS != rc) {
+            break;
+        }
+    }
+    close(in);
+    close(out);
+    if (PRTE_SUCCESS != rc) {
+        unlink(dst);
+    }
+    return rc;
+}
+
+/* the mode an uncached transfer gives the file - see recv_files */
+static mode_t target_mode(int32_t type)
+{
+    return (PRTE_FILEM_TYPE_EXE == type) ? S_IRWXU : (S_IRUSR | S_IWUSR);
+}
+
+/* place the cached copy of a file at its target location, if we have it */
+static int cache_fetch(prte_filem_raw_incoming_t *incoming, uint64_t size)
+{
+    struct stat buf;
+    char *path;
+    int rc;
+
+    if (NULL == (path = cache_path(incoming->key))) {
+        return PRTE_ERR_NOT_FOUND;
+    }
+    if (0 != stat(path, &buf) || (uint64_t) buf.st_size != size) {
+        free(path);
+        return PRTE_ERR_NOT_FOUND;
+    }
+    /* remove any prior copy at the target */
+    unlink(incoming->fullpath);
+    rc = copy_file(path, incoming->fullpath, target_mode(incoming->type));
+    if (PRTE_SUCCESS == rc) {
+        /* mark it as recently used so it is the last to be evicted */
+        (void) utimensat(AT_FDCWD, path, NULL, 0);
+    }
+    PMIX_OUTPUT_VERBOSE((1, prte_filem_base_framework.framework_output,
+                         "%s filem:raw: %s file %s from cache %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                         (PRTE_SUCCESS == rc) ? "positioned" : "failed to position",
+                         incoming->file, path));
+    free(path);
+    return rc;
+}
+
+typedef struct {
+    char *path;
+    off_t size;
+    time_t mtime;
+} cache_entry_t;
+
+static int cache_entry_cmp(const void *a, const void *b)
+{
+    const cache_entry_t *ea = (const cache_entry_t *) a;
+    const cache_entry_t *eb = (const cache_entry_t *) b;
+
+    return (ea->mtime < eb->mtime) ? -1 : ((ea->mtime > eb->mtime) ? 1 : 0);
+}
+
+/* evict the least recently used files until the cache fits its limit */
+static void cache_trim(void)
+{
+    DIR *dir;
+    struct dirent *ent;
+    struct stat buf;
+    cache_entry_t *entries = NULL, *tmp;
+    size_t n, nentries = 0, size = 0;
+    uint64_t total = 0, limit;
+    char *path;
+
+    if (0 == prte_filem_raw_cache_max || NULL == cache_root) {
+        return;
+    }
+    limit = (uint64_t) prte_filem_raw_cache_max * 1024 * 1024;
+    if (NULL == (dir = opendir(cache_root))) {
+        return;
+    }
+    while (NULL != (ent = readdir(dir))) {
+        /* skip "." and "..", and copies still being written */
+        if (NULL != strchr(ent->d_name, '.')) {
+            continue;
+        }
+        path = pmix_os_path(false, cache_root, ent->d_name, NULL);
+        if (0 != stat(path, &buf) || !S_ISREG(buf.st_mode)) {
+            free(path);
+            continue;
+        }
+        if (nentries == size) {
+            size = (0 == size) ? 16 : 2 * size;
+            tmp = (cache_entry_t *) realloc(entries, size * sizeof(cache_entry_t));
+            if (NULL == tmp) {
+                free(path);
+                break;
+            }
+            entries = tmp;
+        }
+        entries[nentries].path = path;
+        entries[nentries].size = buf.st_size;
+        entries[nentries].mtime = buf.st_mtime;
+        total += buf.st_size;
+        nentries++;
+    }
+    closedir(dir);
+
+    if (limit < total) {
+        qsort(entries, nentries, sizeof(cache_entry_t), cache_entry_cmp);
+        for (n = 0; n < nentries && limit < total; n++) {
+            if (0 == unlink(entries[n].path)) {
+                PMIX_OUTPUT_VERBOSE((1, prte_filem_base_framework.framework_output,
+                                     "%s filem:raw: evicted %s from cache",
+                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), entries[n].path));
+                total -= entries[n].size;
+            }
+        }
+    }
+    for (n = 0; n < nentries; n++) {
+        free(entries[n].path);
+    }
+    free(entries);
+}
+
+/* add a newly received file to the cache */
+static void cache_store(prte_filem_raw_incoming_t *sink)
+{
+    struct stat buf;
+    char *path, *tmp;
+    mode_t mode;
+
+    if (NULL == (path = cache_path(sink->key))) {
+        return;
+    }
+    if (0 == stat(path, &buf)) {
+        /* already have it */
+        free(path);
+        return;
+    }
+    /* copy it in under a temporary name so a partial
+     * copy can never be found under the key */
+    mode = (PRTE_FILEM_TYPE_EXE == sink->type) ? (S_IRUSR | S_IXUSR) : S_IRUSR;
+    pmix_asprintf(&tmp, "%s.%s", path, PMIX_RANK_PRINT(PRTE_PROC_MY_NAME->rank));
+    if (PRTE_SUCCESS != copy_file(sink->fullpath, tmp, mode) || 0 != rename(tmp, path)) {
+        unlink(tmp);
+        free(tmp);
+        free(path);
+        return;
+    }
+    free(tmp);
+    PMIX_OUTPUT_VERBOSE((1, prte_filem_base_framework.framework_output,
+                         "%s filem:raw: cached file %s as %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), sink->file, path));
+    free(path);
+    cache_trim();
+}
+
+/* compute the cache key of a file we are about to position, reusing
+ * the key computed for an earlier job if the file is unchanged */
+static int file_key(prte_filem_raw_xfer_t *xfer)
+{
+    struct stat buf;
+    prte_filem_raw_xfer_t *xptr;
+    unsigned char *data;
+    ssize_t nbytes;
+    prte_sha256_t sha;
+    unsigned char digest[PRTE_SHA256_DIGEST_LENGTH];
+    char hex[2 * PRTE_SHA256_DIGEST_LENGTH + 1];
+    int n;
+
+    if (0 != fstat(xfer->fd, &buf)) {
+        return PRTE_ERR_FILE_OPEN_FAILURE;
+    }
+    xfer->size = buf.st_size;
+    xfer->mtime = buf.st_mtime;
+    xfer->mtime_nsec = PRTE_STAT_MTIME_NSEC(&buf);
+    xfer->ino = buf.st_ino;
+
+    PMIX_LIST_FOREACH(xptr, &positioned_files, prte_filem_raw_xfer_t) {
+        if (NULL != xptr->key && 0 == strcmp(xptr->src, xfer->src) &&
+            xptr->size == xfer->size && xptr->mtime == xfer->mtime &&
+            xptr->mtime_nsec == xfer->mtime_nsec && xptr->ino == xfer->ino) {
+            xfer->key = strdup(xptr->key);
+            return PRTE_SUCCESS;
+        }
+    }
+
+    data = (unsigned char *) malloc(1024 * 1024);
+    if (NULL == data) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    prte_sha256_init(&sha);
+    while (0 != (nbytes = read(xfer->fd, data, 1024 * 1024))) {
+        if (0 > nbytes) {
+            if (EAGAIN == errno || EINTR == errno) {
+                continue;
+            }
+            free(data);
+            return PRTE_ERR_FILE_READ_FAILURE;
+        }
+        prte_sha256_update(&sha, data, nbytes);
+    }
+    free(data);
+    if (0 != lseek(xfer->fd, 0, SEEK_SET)) {
+        return PRTE_ERR_FILE_READ_FAILURE;
+    }
+    prte_sha256_final(&sha, digest);
+    for (n = 0; n < PRTE_SHA256_DIGEST_LENGTH; n++) {
+        snprintf(&hex[2 * n], 3, "%02x", digest[n]);
+    }
 
+    pmix_asprintf(&xfer->key, "%s-%llx-%llx", hex,
+                  (unsigned long long) xfer->size, (unsigned long long) xfer->mtime);
     return PRTE_SUCCESS;
 }
 
 static void xfer_complete(int status, prte_filem_raw_xfer_t *xfer)
 {
     prte_filem_raw_outbound_t *outbound = xfer->outbound;
+    prte_filem_raw_xfer_t *xptr, *next;
 
     /* transfer the status, if not success */
     if (PRTE_SUCCESS != status) {
@@ -146,6 +441,13 @@ static void xfer_complete(int status, prte_filem_raw_xfer_t *xfer)
 
     /* this transfer is complete - remove it from list */
     pmix_list_remove_item(&outbound->xfers, &xfer->super);
+    /* a re-sent file replaces the record of any earlier copy */
+    PMIX_LIST_FOREACH_SAFE(xptr, next, &positioned_files, prte_filem_raw_xfer_t) {
+        if (0 == strcmp(xptr->src, xfer->src)) {
+            pmix_list_remove_item(&positioned_files, &xptr->super);
+            PMIX_RELEASE(xptr);
+        }
+    }
     /* add it to the list of files that have been positioned */
     pmix_list_append(&positioned_files, &xfer->super);
 
@@ -161,16 +463,105 @@ static void xfer_complete(int status, prte_filem_raw_xfer_t *xfer)
     }
 }
 
+static prte_filem_raw_xfer_t *find_xfer(char *file)
+{
+    prte_filem_raw_outbound_t *outbound;
+    prte_filem_raw_xfer_t *xfer;
+
+    PMIX_LIST_FOREACH(outbound, &outbound_files, prte_filem_raw_outbound_t) {
+        PMIX_LIST_FOREACH(xfer, &outbound->xfers, prte_filem_raw_xfer_t) {
+            if (0 == strcmp(file, xfer->file)) {
+                return xfer;
+            }
+        }
+    }
+    return NULL;
+}
+
+/* once every daemon has answered the manifest, send the file
+ * to those that don't have it in their cache */
+static void start_xfer(prte_filem_raw_xfer_t *xfer)
+{
+    if (xfer->started || xfer->nresp < prte_process_info.num_daemons) {
+        return;
+    }
+    xfer->started = true;
+
+    if (0 == xfer->ntargets) {
+        PMIX_OUTPUT_VERBOSE((1, prte_filem_base_framework.framework_output,
+                             "%s filem:raw: file %s is cached on all daemons",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), xfer->file));
+        close(xfer->fd);
+        xfer->fd = -1;
+        return;
+    }
+    if (xfer->ntargets == prte_process_info.num_daemons) {
+        /* everyone needs it - use the xcast */
+        free(xfer->targets);
+        xfer->targets = NULL;
+        xfer->ntargets = 0;
+    }
+    PMIX_OUTPUT_VERBOSE((1, prte_filem_base_framework.framework_output,
+                         "%s filem:raw: sending file %s to %d daemons",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), xfer->file,
+                         (int) ((NULL == xfer->targets) ? prte_process_info.num_daemons
+                                                        : xfer->ntargets)));
+    PRTE_PMIX_THREADSHIFT(xfer, prte_event_base, send_chunk);
+}
+
 static void recv_ack(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
                      prte_rml_tag_t tag, void *cbdata)
 {
-    pmix_list_item_t *item, *itm;
-    prte_filem_raw_outbound_t *outbound;
     prte_filem_raw_xfer_t *xfer;
     char *file;
     int st, n, rc;
+    int32_t i, nfiles;
+    uint8_t cmd;
     PRTE_HIDE_UNUSED_PARAMS(status, tag, cbdata);
 
+    n = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &cmd, &n, PMIX_UINT8);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+
+    if (PRTE_FILEM_RAW_NEED == cmd) {
+        /* the daemon is missing these files */
+        n = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &nfiles, &n, PMIX_INT32);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return;
+        }
+        for (i = 0; i < nfiles; i++) {
+            n = 1;
+            rc = PMIx_Data_unpack(NULL, buffer, &file, &n, PMIX_STRING);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                return;
+            }
+            PMIX_OUTPUT_VERBOSE((1, prte_filem_base_framework.framework_output,
+                                 "%s filem:raw: %s needs file %s",
+                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(sender), file));
+            xfer = find_xfer(file);
+            free(file);
+            if (NULL == xfer || xfer->started) {
+                continue;
+            }
+            if (NULL == xfer->targets) {
+                xfer->targets = (pmix_rank_t *) malloc(prte_process_info.num_daemons
+                                                       * sizeof(pmix_rank_t));
+            }
+            if (xfer->ntargets < prte_process_info.num_daemons) {
+                xfer->targets[xfer->ntargets++] = sender->rank;
+            }
+            xfer->nresp++;
+            start_xfer(xfer);
+        }
+        return;
+    }
+
     /* unpack the file */
     n = 1;
     rc = PMIx_Data_unpack(NULL, buffer, &file, &n, PMIX_STRING);
@@ -192,31 +583,84 @@ static void recv_ack(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(sender), file, st));
 
     /* find the corresponding outbound object */
-    for (item = pmix_list_get_first(&outbound_files); item != pmix_list_get_end(&outbound_files);
-         item = pmix_list_get_next(item)) {
-        outbound = (prte_filem_raw_outbound_t *) item;
-        for (itm = pmix_list_get_first(&outbound->xfers);
-             itm != pmix_list_get_end(&outbound->xfers); itm = pmix_list_get_next(itm)) {
-            xfer = (prte_filem_raw_xfer_t *) itm;
-            if (0 == strcmp(file, xfer->file)) {
-                /* if the status isn't success, record it */
-                if (0 != st) {
-                    xfer->status = st;
-                }
-                /* track number of respondents */
-                xfer->nrecvd++;
-                /* if all daemons have responded, then this is complete */
-                if (xfer->nrecvd == prte_process_info.num_daemons) {
-                    PMIX_OUTPUT_VERBOSE((1, prte_filem_base_framework.framework_output,
-                                         "%s filem:raw: xfer complete for file %s status %d",
-                                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), file, xfer->status));
-                    xfer_complete(xfer->status, xfer);
-                }
-                free(file);
-                return;
-            }
+    xfer = find_xfer(file);
+    free(file);
+    if (NULL == xfer) {
+        return;
+    }
+    /* if the status isn't success, record it */
+    if (0 != st) {
+        xfer->status = st;
+    }
+    /* track number of respondents */
+    xfer->nrecvd++;
+    if (!xfer->started) {
+        /* the daemon had it in its cache */
+        xfer->nresp++;
+        start_xfer(xfer);
+    }
+    /* if all daemons have responded, then this is complete */
+    if (xfer->nrecvd == prte_process_info.num_daemons) {
+        PMIX_OUTPUT_VERBOSE((1, prte_filem_base_framework.framework_output,
+                             "%s filem:raw: xfer complete for file %s status %d",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), xfer->file, xfer->status));
+        xfer_complete(xfer->status, xfer);
+    }
+}
+
+static int send_manifest(prte_filem_raw_outbound_t *outbound)
+{
+    pmix_data_buffer_t buf;
+    prte_grpcomm_signature_t *sig;
+    prte_filem_raw_xfer_t *xfer;
+    uint8_t cmd = PRTE_FILEM_RAW_MANIFEST;
+    int32_t nfiles;
+    int rc;
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    rc = PMIx_Data_pack(NULL, &buf, &cmd, 1, PMIX_UINT8);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_DESTRUCT(&buf);
+        return prte_pmix_convert_status(rc);
+    }
+    nfiles = pmix_list_get_size(&outbound->xfers);
+    rc = PMIx_Data_pack(NULL, &buf, &nfiles, 1, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_DESTRUCT(&buf);
+        return prte_pmix_convert_status(rc);
+    }
+    PMIX_LIST_FOREACH(xfer, &outbound->xfers, prte_filem_raw_xfer_t) {
+        rc = PMIx_Data_pack(NULL, &buf, &xfer->file, 1, PMIX_STRING);
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, &buf, &xfer->type, 1, PMIX_INT32);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, &buf, &xfer->key, 1, PMIX_STRING);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, &buf, &xfer->size, 1, PMIX_UINT64);
         }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_DESTRUCT(&buf);
+            return prte_pmix_convert_status(rc);
+        }
+    }
+
+    /* goes to all daemons */
+    sig = PMIX_NEW(prte_grpcomm_signature_t);
+    sig->signature = (pmix_proc_t *) malloc(sizeof(pmix_proc_t));
+    sig->sz = 1;
+    PMIX_LOAD_PROCID(&sig->signature[0], PRTE_PROC_MY_NAME->nspace, PMIX_RANK_WILDCARD);
+    rc = prte_grpcomm.xcast(sig, PRTE_RML_TAG_FILEM_BASE, &buf);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
     }
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+    PMIX_RELEASE(sig);
+    return rc;
 }
 
 static int raw_preposition_files(prte_job_t *jdata,
@@ -228,7 +672,7 @@ static int raw_preposition_files(prte_job_t *jdata,
     prte_filem_base_file_set_t *fs;
     int fd;
     prte_filem_raw_xfer_t *xfer, *xptr;
-    int flags, i, j;
+    int flags, i, j, rc;
     char **files = NULL;
     prte_filem_raw_outbound_t *outbound, *optr;
     char *cptr, *nxt, *filestring;
@@ -401,10 +845,13 @@ static int raw_preposition_files(prte_job_t *jdata,
                              "%s filem:raw: checking prepositioning of file %s",
                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), fs->local_target));
 
-        /* have we already sent this file? */
+        /* have we already sent this file? If we are caching, the
+         * manifest is always sent so that daemons added since then,
+         * or a file that has since changed, are caught
+         */
         already_sent = false;
         for (itm = pmix_list_get_first(&positioned_files);
-             !already_sent && itm != pmix_list_get_end(&positioned_files);
+             !prte_filem_raw_cache && !already_sent && itm != pmix_list_get_end(&positioned_files);
              itm = pmix_list_get_next(itm)) {
             xptr = (prte_filem_raw_xfer_t *) itm;
             if (0 == strcmp(fs->local_target, xptr->src)) {
@@ -513,7 +960,20 @@ static int raw_preposition_files(prte_job_t *jdata,
         xfer->app_idx = fs->app_idx;
         xfer->outbound = outbound;
         pmix_list_append(&outbound->xfers, &xfer->super);
-        PRTE_PMIX_THREADSHIFT(xfer, prte_event_base, send_chunk);
+        if (prte_filem_raw_cache) {
+            /* the daemons will tell us if they need it */
+            if (PRTE_SUCCESS != (rc = file_key(xfer))) {
+                PRTE_ERROR_LOG(rc);
+                PMIX_RELEASE(item);
+                PMIX_LIST_DESTRUCT(&fsets);
+                pmix_list_remove_item(&outbound_files, &outbound->super);
+                PMIX_RELEASE(outbound);
+                return rc;
+            }
+        } else {
+            xfer->started = true;
+            PRTE_PMIX_THREADSHIFT(xfer, prte_event_base, send_chunk);
+        }
         PMIX_RELEASE(item);
     }
     PMIX_DESTRUCT(&fsets);
@@ -533,6 +993,14 @@ static int raw_preposition_files(prte_job_t *jdata,
         return PRTE_SUCCESS;
     }
 
+    if (prte_filem_raw_cache) {
+        if (PRTE_SUCCESS != (rc = send_manifest(outbound))) {
+            pmix_list_remove_item(&outbound_files, &outbound->super);
+            PMIX_RELEASE(outbound);
+            return rc;
+        }
+    }
+
     if (0 < pmix_output_get_verbosity(prte_filem_base_framework.framework_output)) {
         pmix_output(0, "%s Files to be positioned:", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
         for (itm2 = pmix_list_get_first(&outbound->xfers);
@@ -710,6 +1178,11 @@ static void send_chunk(int xxx, short argc, void *cbdata)
     int rc;
     pmix_data_buffer_t chunk;
     prte_grpcomm_signature_t *sig;
+    bool csummed = prte_filem_raw_checksum;
+    uint32_t csum;
+    uint8_t cmd = PRTE_FILEM_RAW_CHUNK;
+    pmix_data_buffer_t *buf;
+    pmix_rank_t n;
     PRTE_HIDE_UNUSED_PARAMS(xxx, argc);
 
     PMIX_ACQUIRE_OBJECT(rev);
@@ -753,10 +1226,19 @@ static void send_chunk(int xxx, short argc, void *cbdata)
 
     /* package it for transmission */
     PMIX_DATA_BUFFER_CONSTRUCT(&chunk);
+    rc = PMIx_Data_pack(NULL, &chunk, &cmd, 1, PMIX_UINT8);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        close(fd);
+        rev->fd = -1;
+        PMIX_DATA_BUFFER_DESTRUCT(&chunk);
+        return;
+    }
     rc = PMIx_Data_pack(NULL, &chunk, &rev->file, 1, PMIX_STRING);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         close(fd);
+        rev->fd = -1;
         PMIX_DATA_BUFFER_DESTRUCT(&chunk);
         return;
     }
@@ -764,6 +1246,7 @@ static void send_chunk(int xxx, short argc, void *cbdata)
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         close(fd);
+        rev->fd = -1;
         PMIX_DATA_BUFFER_DESTRUCT(&chunk);
         return;
     }
@@ -771,6 +1254,7 @@ static void send_chunk(int xxx, short argc, void *cbdata)
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         close(fd);
+        rev->fd = -1;
         PMIX_DATA_BUFFER_DESTRUCT(&chunk);
         return;
     }
@@ -780,24 +1264,65 @@ static void send_chunk(int xxx, short argc, void *cbdata)
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             close(fd);
+            rev->fd = -1;
             PMIX_DATA_BUFFER_DESTRUCT(&chunk);
             return;
         }
     }
-
-    /* goes to all daemons */
-    sig = PMIX_NEW(prte_grpcomm_signature_t);
-    sig->signature = (pmix_proc_t *) malloc(sizeof(pmix_proc_t));
-    sig->sz = 1;
-    PMIX_LOAD_PROCID(&sig->signature[0], PRTE_PROC_MY_NAME->nspace, PMIX_RANK_WILDCARD);
-    if (PRTE_SUCCESS != (rc = prte_grpcomm.xcast(sig, PRTE_RML_TAG_FILEM_BASE, &chunk))) {
-        PRTE_ERROR_LOG(rc);
-        PMIX_DATA_BUFFER_DESTRUCT(&chunk);
+    /* flag whether a checksum of the data follows */
+    rc = PMIx_Data_pack(NULL, &chunk, &csummed, 1, PMIX_BOOL);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
         close(fd);
+        rev->fd = -1;
+        PMIX_DATA_BUFFER_DESTRUCT(&chunk);
         return;
     }
-    PMIX_DATA_BUFFER_DESTRUCT(&chunk);
-    PMIX_RELEASE(sig);
+    if (csummed) {
+        csum = prte_crc32c(data, numbytes);
+        rc = PMIx_Data_pack(NULL, &chunk, &csum, 1, PMIX_UINT32);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            close(fd);
+            rev->fd = -1;
+            PMIX_DATA_BUFFER_DESTRUCT(&chunk);
+            return;
+        }
+    }
+
+    if (NULL != rev->targets) {
+        /* only the daemons missing it from their cache get it */
+        for (n = 0; n < rev->ntargets; n++) {
+            PMIX_DATA_BUFFER_CREATE(buf);
+            rc = PMIx_Data_copy_payload(buf, &chunk);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                PMIX_DATA_BUFFER_RELEASE(buf);
+                continue;
+            }
+            PRTE_RML_SEND(rc, rev->targets[n], buf, PRTE_RML_TAG_FILEM_BASE);
+            if (PRTE_SUCCESS != rc) {
+                PRTE_ERROR_LOG(rc);
+                PMIX_DATA_BUFFER_RELEASE(buf);
+            }
+        }
+        PMIX_DATA_BUFFER_DESTRUCT(&chunk);
+    } else {
+        /* goes to all daemons */
+        sig = PMIX_NEW(prte_grpcomm_signature_t);
+        sig->signature = (pmix_proc_t *) malloc(sizeof(pmix_proc_t));
+        sig->sz = 1;
+        PMIX_LOAD_PROCID(&sig->signature[0], PRTE_PROC_MY_NAME->nspace, PMIX_RANK_WILDCARD);
+        if (PRTE_SUCCESS != (rc = prte_grpcomm.xcast(sig, PRTE_RML_TAG_FILEM_BASE, &chunk))) {
+            PRTE_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_DESTRUCT(&chunk);
+            close(fd);
+            rev->fd = -1;
+            return;
+        }
+        PMIX_DATA_BUFFER_DESTRUCT(&chunk);
+        PMIX_RELEASE(sig);
+    }
     rev->nchunk++;
 
     /* if num_bytes was zero, then we need to terminate the event
@@ -805,6 +1330,7 @@ static void send_chunk(int xxx, short argc, void *cbdata)
      */
     if (0 == numbytes) {
         close(fd);
+        rev->fd = -1;
         return;
     } else {
         /* restart the read event */
@@ -817,9 +1343,16 @@ static void send_chunk(int xxx, short argc, void *cbdata)
 static void send_complete(char *file, int status)
 {
     pmix_data_buffer_t *buf;
+    uint8_t cmd = PRTE_FILEM_RAW_ACK;
     int rc;
 
     PMIX_DATA_BUFFER_CREATE(buf);
+    rc = PMIx_Data_pack(NULL, buf, &cmd, 1, PMIX_UINT8);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        return;
+    }
     rc = PMIx_Data_pack(NULL, buf, &file, 1, PMIX_STRING);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
@@ -839,6 +1372,33 @@ static void send_complete(char *file, int status)
     }
 }
 
+static void send_need(char **files)
+{
+    pmix_data_buffer_t *buf;
+    uint8_t cmd = PRTE_FILEM_RAW_NEED;
+    int32_t nfiles = PMIX_ARGV_COUNT_COMPAT(files);
+    int rc;
+
+    PMIX_DATA_BUFFER_CREATE(buf);
+    rc = PMIx_Data_pack(NULL, buf, &cmd, 1, PMIX_UINT8);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buf, &nfiles, 1, PMIX_INT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buf, files, nfiles, PMIX_STRING);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        return;
+    }
+    PRTE_RML_SEND(rc, PRTE_PROC_MY_HNP->rank, buf, PRTE_RML_TAG_FILEM_BASE_RESP);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_RELEASE(buf);
+    }
+}
+
 /* This is a little tricky as the name of the archive doesn't
  * necessarily have anything to do with the paths inside it -
  * so we have to first query the archive to retrieve that info
@@ -897,19 +1457,160 @@ static int link_archive(prte_filem_raw_incoming_t *inbnd)
     return PRTE_SUCCESS;
 }
 
+static prte_filem_raw_incoming_t *find_incoming(char *file, int32_t type)
+{
+    prte_filem_raw_incoming_t *incoming;
+
+    PMIX_LIST_FOREACH(incoming, &incoming_files, prte_filem_raw_incoming_t) {
+        if (0 == strcmp(file, incoming->file)) {
+            return incoming;
+        }
+    }
+    /* nope - add it */
+    PMIX_OUTPUT_VERBOSE((1, prte_filem_base_framework.framework_output,
+                         "%s filem:raw: adding file %s to incoming list",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), file));
+    incoming = PMIX_NEW(prte_filem_raw_incoming_t);
+    incoming->file = strdup(file);
+    incoming->type = type;
+    pmix_list_append(&incoming_files, &incoming->super);
+    return incoming;
+}
+
+/* define where the file is to be placed and clear the way for it */
+static int setup_target(prte_filem_raw_incoming_t *incoming)
+{
+    char *tmp, *cptr;
+    int rc;
+
+    /* separate out the top-level directory of the target */
+    tmp = strdup(incoming->file);
+    if (NULL != (cptr = strchr(tmp, '/'))) {
+        *cptr = '\0';
+    }
+    /* save it */
+    if (NULL != incoming->top) {
+        free(incoming->top);
+    }
+    incoming->top = tmp;
+    /* define the full path to where we will put it */
+    if (NULL != incoming->fullpath) {
+        free(incoming->fullpath);
+    }
+    incoming->fullpath = pmix_os_path(false, prte_process_info.top_session_dir,
+                                      incoming->file, NULL);
+    /* a prior copy may be a link into the cache, so it
+     * must be removed rather than overwritten */
+    unlink(incoming->fullpath);
+    /* create the path to the target, if not already existing */
+    tmp = pmix_dirname(incoming->fullpath);
+    if (PMIX_SUCCESS != (rc = pmix_os_dirpath_create(tmp, S_IRWXU))) {
+        PMIX_ERROR_LOG(rc);
+        free(tmp);
+        return prte_pmix_convert_status(rc);
+    }
+    free(tmp);
+    return PRTE_SUCCESS;
+}
+
+/* the HNP has told us which files the job needs - position
+ * those we have cached and ask for the rest */
+static void recv_manifest(pmix_data_buffer_t *buffer)
+{
+    prte_filem_raw_incoming_t *incoming;
+    int32_t i, n, nfiles, type;
+    char *file, *key, **need = NULL;
+    uint64_t size;
+    int rc;
+
+    n = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &nfiles, &n, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        send_complete(NULL, rc);
+        return;
+    }
+    for (i = 0; i < nfiles; i++) {
+        n = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &file, &n, PMIX_STRING);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            break;
+        }
+        key = NULL;
+        n = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &type, &n, PMIX_INT32);
+        if (PMIX_SUCCESS == rc) {
+            n = 1;
+            rc = PMIx_Data_unpack(NULL, buffer, &key, &n, PMIX_STRING);
+        }
+        if (PMIX_SUCCESS == rc) {
+            n = 1;
+            rc = PMIx_Data_unpack(NULL, buffer, &size, &n, PMIX_UINT64);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            send_complete(file, rc);
+            free(file);
+            if (NULL != key) {
+                free(key);
+            }
+            break;
+        }
+
+        /* start afresh for this copy of the file */
+        incoming = find_incoming(file, type);
+        incoming->type = type;
+        incoming->status = PRTE_SUCCESS;
+        PMIX_ARGV_FREE_COMPAT(incoming->link_pts);
+        incoming->link_pts = NULL;
+        if (NULL != incoming->key) {
+            free(incoming->key);
+        }
+        incoming->key = key;
+
+        if (PRTE_SUCCESS != setup_target(incoming)) {
+            send_complete(file, PRTE_ERR_FILE_WRITE_FAILURE);
+        } else if (PRTE_SUCCESS == cache_fetch(incoming, size)) {
+            file_complete(incoming);
+        } else {
+            PMIX_ARGV_APPEND_NOSIZE_COMPAT(&need, file);
+        }
+        free(file);
+    }
+
+    if (NULL != need) {
+        send_need(need);
+        PMIX_ARGV_FREE_COMPAT(need);
+    }
+}
+
 static void recv_files(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
                        prte_rml_tag_t tag, void *cbdata)
 {
-    char *file, *session_dir;
+    char *file;
     int32_t nchunk, n, nbytes;
     unsigned char data[PRTE_FILEM_RAW_CHUNK_MAX];
     int rc;
     prte_filem_raw_output_t *output;
-    prte_filem_raw_incoming_t *ptr, *incoming;
-    pmix_list_item_t *item;
-    int32_t type;
-    char *cptr;
-    PRTE_HIDE_UNUSED_PARAMS(status, sender, tag, cbdata);
+    prte_filem_raw_incoming_t *incoming;
+    int32_t type = PRTE_FILEM_TYPE_FILE;
+    bool csummed;
+    uint32_t csum = 0;
+    uint8_t cmd;
+    PRTE_HIDE_UNUSED_PARAMS(status, tag, cbdata);
+
+    n = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &cmd, &n, PMIX_UINT8);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        send_complete(NULL, rc);
+        return;
+    }
+    if (PRTE_FILEM_RAW_MANIFEST == cmd) {
+        recv_manifest(buffer);
+        return;
+    }
 
     /* unpack the data */
     n = 1;
@@ -952,61 +1653,45 @@ static void recv_files(int status, pmix_proc_t *sender, pmix_data_buffer_t *buff
             return;
         }
     }
+    n = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &csummed, &n, PMIX_BOOL);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        send_complete(file, rc);
+        free(file);
+        return;
+    }
+    if (csummed) {
+        n = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &csum, &n, PMIX_UINT32);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            send_complete(file, rc);
+            free(file);
+            return;
+        }
+    }
 
     PMIX_OUTPUT_VERBOSE((1, prte_filem_base_framework.framework_output,
                          "%s filem:raw: received chunk %d for file %s containing %d bytes",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), nchunk, file, nbytes));
 
     /* do we already have this file on our list of incoming? */
-    incoming = NULL;
-    for (item = pmix_list_get_first(&incoming_files); item != pmix_list_get_end(&incoming_files);
-         item = pmix_list_get_next(item)) {
-        ptr = (prte_filem_raw_incoming_t *) item;
-        if (0 == strcmp(file, ptr->file)) {
-            incoming = ptr;
-            break;
-        }
-    }
-    if (NULL == incoming) {
-        /* nope - add it */
-        PMIX_OUTPUT_VERBOSE((1, prte_filem_base_framework.framework_output,
-                             "%s filem:raw: adding file %s to incoming list",
-                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), file));
-        incoming = PMIX_NEW(prte_filem_raw_incoming_t);
-        incoming->file = strdup(file);
-        incoming->type = type;
-        pmix_list_append(&incoming_files, &incoming->super);
-    }
+    incoming = find_incoming(file, type);
 
     /* if this is the first chunk, we need to open the file descriptor */
     if (0 == nchunk) {
-        /* separate out the top-level directory of the target */
-        char *tmp;
-        tmp = strdup(file);
-        if (NULL != (cptr = strchr(tmp, '/'))) {
-            *cptr = '\0';
-        }
-        /* save it */
-        incoming->top = strdup(tmp);
-        free(tmp);
-        /* define the full path to where we will put it */
-        session_dir = prte_process_info.top_session_dir;
-
-        incoming->fullpath = pmix_os_path(false, session_dir, file, NULL);
-
-        PMIX_OUTPUT_VERBOSE((1, prte_filem_base_framework.framework_output,
-                             "%s filem:raw: opening target file %s",
-                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), incoming->fullpath));
-        /* create the path to the target, if not already existing */
-        tmp = pmix_dirname(incoming->fullpath);
-        if (PMIX_SUCCESS != (rc = pmix_os_dirpath_create(tmp, S_IRWXU))) {
-            PMIX_ERROR_LOG(rc);
+        incoming->type = type;
+        if (PRTE_SUCCESS != (rc = setup_target(incoming))) {
             send_complete(file, PRTE_ERR_FILE_WRITE_FAILURE);
             free(file);
-            free(tmp);
+            pmix_list_remove_item(&incoming_files, &incoming->super);
             PMIX_RELEASE(incoming);
             return;
         }
+        PMIX_OUTPUT_VERBOSE((1, prte_filem_base_framework.framework_output,
+                             "%s filem:raw: opening target file %s",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), incoming->fullpath));
         /* open the file descriptor for writing */
         if (PRTE_FILEM_TYPE_EXE == type) {
             if (0
@@ -1015,7 +1700,6 @@ static void recv_files(int status, pmix_proc_t *sender, pmix_data_buffer_t *buff
                             incoming->fullpath);
                 send_complete(file, PRTE_ERR_FILE_WRITE_FAILURE);
                 free(file);
-                free(tmp);
                 return;
             }
         } else {
@@ -1025,14 +1709,19 @@ static void recv_files(int status, pmix_proc_t *sender, pmix_data_buffer_t *buff
                             incoming->fullpath);
                 send_complete(file, PRTE_ERR_FILE_WRITE_FAILURE);
                 free(file);
-                free(tmp);
                 return;
             }
         }
-        free(tmp);
         incoming->pending = true;
         PRTE_PMIX_THREADSHIFT(incoming, prte_event_base, write_handler);
     }
+    /* once a chunk has been found corrupt, the rest of the file
+     * is discarded - only the final zero-byte chunk is passed on
+     * so the failure gets reported */
+    if (PRTE_SUCCESS != incoming->status && 0 < nbytes) {
+        free(file);
+        return;
+    }
     /* create an output object for this data */
     output = PMIX_NEW(prte_filem_raw_output_t);
     if (0 < nbytes) {
@@ -1040,7 +1729,19 @@ static void recv_files(int status, pmix_proc_t *sender, pmix_data_buffer_t *buff
          * the zero bytes so the fd can be closed
          * after it writes everything out
          */
-        memcpy(output->data, data, nbytes);
+        if (csummed) {
+            /* verify the chunk while copying it */
+            if (csum != prte_bcopy_crc32c(data, output->data, nbytes)) {
+                pmix_show_help("help-prte-filem-raw.txt", "checksum-mismatch", true,
+                               prte_process_info.nodename, file, nchunk, PRTE_NAME_PRINT(sender));
+                incoming->status = PRTE_ERR_COMM_FAILURE;
+                PMIX_RELEASE(output);
+                free(file);
+                return;
+            }
+        } else {
+            memcpy(output->data, data, nbytes);
+        }
     }
     output->numbytes = nbytes;
 
@@ -1057,15 +1758,82 @@ static void recv_files(int status, pmix_proc_t *sender, pmix_data_buffer_t *buff
     free(file);
 }
 
+static void file_complete(prte_filem_raw_incoming_t *sink)
+{
+    char *dirname, *cmd;
+    char homedir[MAXPATHLEN];
+    int rc;
+
+    if (PRTE_SUCCESS != sink->status) {
+        /* part of the file was corrupted in transit - don't
+         * leave a damaged copy behind for anyone to use */
+        unlink(sink->fullpath);
+        send_complete(sink->file, sink->status);
+        return;
+    }
+    /* keep a copy for later jobs */
+    cache_store(sink);
+    if (PRTE_FILEM_TYPE_FILE == sink->type || PRTE_FILEM_TYPE_EXE == sink->type) {
+        /* just link to the top as this will be the
+         * name we will want in each proc's session dir
+         */
+        PMIX_ARGV_APPEND_NOSIZE_COMPAT(&sink->link_pts, sink->top);
+        send_complete(sink->file, PRTE_SUCCESS);
+    } else {
+        /* unarchive the file */
+        if (PRTE_FILEM_TYPE_TAR == sink->type) {
+            pmix_asprintf(&cmd, "tar xf %s", sink->file);
+        } else if (PRTE_FILEM_TYPE_BZIP == sink->type) {
+            pmix_asprintf(&cmd, "tar xjf %s", sink->file);
+        } else if (PRTE_FILEM_TYPE_GZIP == sink->type) {
+            pmix_asprintf(&cmd, "tar xzf %s", sink->file);
+        } else {
+            PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+            send_complete(sink->file, PRTE_ERR_FILE_WRITE_FAILURE);
+            return;
+        }
+        if (NULL == getcwd(homedir, sizeof(homedir))) {
+            PRTE_ERROR_LOG(PRTE_ERROR);
+            send_complete(sink->file, PRTE_ERR_FILE_WRITE_FAILURE);
+            return;
+        }
+        dirname = pmix_dirname(sink->fullpath);
+        if (0 != chdir(dirname)) {
+            PRTE_ERROR_LOG(PRTE_ERROR);
+            send_complete(sink->file, PRTE_ERR_FILE_WRITE_FAILURE);
+            return;
+        }
+        PMIX_OUTPUT_VERBOSE((1, prte_filem_base_framework.framework_output,
+                             "%s write:handler unarchiving file %s with cmd: %s",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), sink->file, cmd));
+        if (0 != system(cmd)) {
+            PRTE_ERROR_LOG(PRTE_ERROR);
+            send_complete(sink->file, PRTE_ERR_FILE_WRITE_FAILURE);
+            return;
+        }
+        if (0 != chdir(homedir)) {
+            PRTE_ERROR_LOG(PRTE_ERROR);
+            send_complete(sink->file, PRTE_ERR_FILE_WRITE_FAILURE);
+            return;
+        }
+        free(dirname);
+        free(cmd);
+        /* setup the link points */
+        if (PRTE_SUCCESS != (rc = link_archive(sink))) {
+            PRTE_ERROR_LOG(rc);
+            send_complete(sink->file, PRTE_ERR_FILE_WRITE_FAILURE);
+        } else {
+            send_complete(sink->file, PRTE_SUCCESS);
+        }
+    }
+}
+
 static void write_handler(int fd, short event, void *cbdata)
 {
     prte_filem_raw_incoming_t *sink = (prte_filem_raw_incoming_t *) cbdata;
     pmix_list_item_t *item;
     prte_filem_raw_output_t *output;
     int num_written;
-    char *dirname, *cmd;
-    char homedir[MAXPATHLEN];
-    int rc;
     PRTE_HIDE_UNUSED_PARAMS(fd, event);
 
     PMIX_ACQUIRE_OBJECT(sink);
@@ -1087,59 +1855,8 @@ static void write_handler(int fd, short event, void *cbdata)
             /* close the file descriptor */
             close(sink->fd);
             sink->fd = -1;
-            if (PRTE_FILEM_TYPE_FILE == sink->type || PRTE_FILEM_TYPE_EXE == sink->type) {
-                /* just link to the top as this will be the
-                 * name we will want in each proc's session dir
-                 */
-                PMIX_ARGV_APPEND_NOSIZE_COMPAT(&sink->link_pts, sink->top);
-                send_complete(sink->file, PRTE_SUCCESS);
-            } else {
-                /* unarchive the file */
-                if (PRTE_FILEM_TYPE_TAR == sink->type) {
-                    pmix_asprintf(&cmd, "tar xf %s", sink->file);
-                } else if (PRTE_FILEM_TYPE_BZIP == sink->type) {
-                    pmix_asprintf(&cmd, "tar xjf %s", sink->file);
-                } else if (PRTE_FILEM_TYPE_GZIP == sink->type) {
-                    pmix_asprintf(&cmd, "tar xzf %s", sink->file);
-                } else {
-                    PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
-                    send_complete(sink->file, PRTE_ERR_FILE_WRITE_FAILURE);
-                    return;
-                }
-                if (NULL == getcwd(homedir, sizeof(homedir))) {
-                    PRTE_ERROR_LOG(PRTE_ERROR);
-                    send_complete(sink->file, PRTE_ERR_FILE_WRITE_FAILURE);
-                    return;
-                }
-                dirname = pmix_dirname(sink->fullpath);
-                if (0 != chdir(dirname)) {
-                    PRTE_ERROR_LOG(PRTE_ERROR);
-                    send_complete(sink->file, PRTE_ERR_FILE_WRITE_FAILURE);
-                    return;
-                }
-                PMIX_OUTPUT_VERBOSE((1, prte_filem_base_framework.framework_output,
-                                     "%s write:handler unarchiving file %s with cmd: %s",
-                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), sink->file, cmd));
-                if (0 != system(cmd)) {
-                    PRTE_ERROR_LOG(PRTE_ERROR);
-                    send_complete(sink->file, PRTE_ERR_FILE_WRITE_FAILURE);
-                    return;
-                }
-                if (0 != chdir(homedir)) {
-                    PRTE_ERROR_LOG(PRTE_ERROR);
-                    send_complete(sink->file, PRTE_ERR_FILE_WRITE_FAILURE);
-                    return;
-                }
-                free(dirname);
-                free(cmd);
-                /* setup the link points */
-                if (PRTE_SUCCESS != (rc = link_archive(sink))) {
-                    PRTE_ERROR_LOG(rc);
-                    send_complete(sink->file, PRTE_ERR_FILE_WRITE_FAILURE);
-                } else {
-                    send_complete(sink->file, PRTE_SUCCESS);
-                }
-            }
+            PMIX_RELEASE(output);
+            file_complete(sink);
             return;
         }
         num_written = write(sink->fd, output->data, output->numbytes);
@@ -1198,6 +1915,15 @@ static void xfer_construct(prte_filem_raw_xfer_t *ptr)
     ptr->nchunk = 0;
     ptr->status = PRTE_SUCCESS;
     ptr->nrecvd = 0;
+    ptr->key = NULL;
+    ptr->size = 0;
+    ptr->mtime = 0;
+    ptr->mtime_nsec = 0;
+    ptr->ino = 0;
+    ptr->nresp = 0;
+    ptr->ntargets = 0;
+    ptr->targets = NULL;
+    ptr->started = false;
 }
 static void xfer_destruct(prte_filem_raw_xfer_t *ptr)
 {
@@ -1210,6 +1936,15 @@ static void xfer_destruct(prte_filem_raw_xfer_t *ptr)
     if (NULL != ptr->file) {
         free(ptr->file);
     }
+    if (NULL != ptr->key) {
+        free(ptr->key);
+    }
+    if (NULL != ptr->targets) {
+        free(ptr->targets);
+    }
+    if (0 <= ptr->fd) {
+        close(ptr->fd);
+    }
 }
 PMIX_CLASS_INSTANCE(prte_filem_raw_xfer_t,
                     pmix_list_item_t,
@@ -1238,8 +1973,10 @@ static void in_construct(prte_filem_raw_incoming_t *ptr)
     ptr->file = NULL;
     ptr->top = NULL;
     ptr->fullpath = NULL;
+    ptr->key = NULL;
     ptr->link_pts = NULL;
     PMIX_CONSTRUCT(&ptr->outputs, pmix_list_t);
+    ptr->status = PRTE_SUCCESS;
 }
 static void in_destruct(prte_filem_raw_incoming_t *ptr)
 {
@@ -1258,6 +1995,9 @@ static void in_destruct(prte_filem_raw_incoming_t *ptr)
     if (NULL != ptr->fullpath) {
         free(ptr->fullpath);
     }
+    if (NULL != ptr->key) {
+        free(ptr->key);
+    }
     PMIX_ARGV_FREE_COMPAT(ptr->link_pts);
     PMIX_LIST_DESTRUCT(&ptr->outputs);
 }
@@ -172,6 +172,9 @@ static void ccon(prte_grpcomm_coll_t *p)
     p->cbfunc = NULL;
     p->cbdata = NULL;
     p->buffers = NULL;
+    p->rollup = NULL;
+    PMIX_CONSTRUCT(&p->contributed, pmix_bitmap_t);
+    p->complete = false;
 }
 static void cdes(prte_grpcomm_coll_t *p)
 {
@@ -182,6 +185,10 @@ static void cdes(prte_grpcomm_coll_t *p)
     PMIX_LIST_DESTRUCT(&p->addmembers);
     free(p->dmns);
     free(p->buffers);
+    if (NULL != p->rollup) {
+        PMIX_DATA_BUFFER_RELEASE(p->rollup);
+    }
+    PMIX_DESTRUCT(&p->contributed);
 }
 PMIX_CLASS_INSTANCE(prte_grpcomm_coll_t,
                     pmix_list_item_t,
@@ -59,9 +59,14 @@ static void allgather_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *
                            prte_rml_tag_t tag, void *cbdata);
 static void barrier_release(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
                             prte_rml_tag_t tag, void *cbdata);
+static void route_healed(pmix_rank_t lost, bool reparented);
+static bool track_contributors(prte_grpcomm_coll_t *coll);
 
 /* internal variables */
 static pmix_list_t tracker;
+/* xcast sequence - stamped by the HNP so that daemons can drop
+ * relays replayed to them after the routing tree was repaired */
+static uint32_t xcast_seq = 0;
 
 /**
  * Initialize the module
@@ -78,6 +83,8 @@ static int init(void)
     /* setup recv for barrier release */
     PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_COLL_RELEASE,
                   PRTE_RML_PERSISTENT, barrier_release, NULL);
+    /* track changes to the routing tree */
+    prte_rml_heal_register(route_healed);
 
     return PRTE_SUCCESS;
 }
@@ -110,6 +117,7 @@ static int allgather(prte_grpcomm_coll_t *coll,
                      prte_pmix_mdx_caddy_t *cd)
 {
     int rc;
+    int32_t ncontrib = 0;
     pmix_data_buffer_t *relay;
 
     PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
@@ -137,6 +145,20 @@ static int allgather(prte_grpcomm_coll_t *coll,
         return prte_pmix_convert_status(rc);
     }
 
+    /* pack whose contribution this is */
+    if (track_contributors(coll)) {
+        ncontrib = 1;
+    }
+    rc = PMIx_Data_pack(NULL, relay, &ncontrib, 1, PMIX_INT32);
+    if (PMIX_SUCCESS == rc && 0 < ncontrib) {
+        rc = PMIx_Data_pack(NULL, relay, &PRTE_PROC_MY_NAME->rank, 1, PMIX_PROC_RANK);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(relay);
+        return prte_pmix_convert_status(rc);
+    }
+
     /* pass along the payload */
     rc = PMIx_Data_copy_payload(relay, cd->buf);
     if (PMIX_SUCCESS != rc) {
@@ -163,26 +185,421 @@ static int allgather(prte_grpcomm_coll_t *coll,
     return rc;
 }
 
+/* contributions are tracked per daemon when self-healing so that
+ * a rollup resent after the routing tree was repaired is counted
+ * once - bootstrap collectives report directly to the DVM controller
+ * and are simply counted */
+static bool track_contributors(prte_grpcomm_coll_t *coll)
+{
+    return prte_rml_base.self_heal && 0 == coll->sig->bootstrap;
+}
+
+static int pack_contributors(pmix_data_buffer_t *buf, prte_grpcomm_coll_t *coll)
+{
+    pmix_rank_t *ranks = NULL;
+    int32_t n, ncontrib = 0;
+    int rc;
+
+    if (track_contributors(coll)) {
+        ranks = (pmix_rank_t *) malloc(prte_process_info.num_daemons * sizeof(pmix_rank_t));
+        if (NULL == ranks) {
+            PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        for (n = 0; n < (int32_t) prte_process_info.num_daemons; n++) {
+            if (pmix_bitmap_is_set_bit(&coll->contributed, n)) {
+                ranks[ncontrib] = n;
+                ++ncontrib;
+            }
+        }
+    }
+    rc = PMIx_Data_pack(NULL, buf, &ncontrib, 1, PMIX_INT32);
+    if (PMIX_SUCCESS == rc && 0 < ncontrib) {
+        rc = PMIx_Data_pack(NULL, buf, ranks, ncontrib, PMIX_PROC_RANK);
+    }
+    if (NULL != ranks) {
+        free(ranks);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    return PRTE_SUCCESS;
+}
+
+/* see if everyone has reported - returns true exactly once */
+static bool coll_complete(prte_grpcomm_coll_t *coll)
+{
+    prte_routed_tree_t *child;
+    pmix_rank_t rank;
+    size_t n;
+
+    if (coll->complete) {
+        return false;
+    }
+    if (!track_contributors(coll)) {
+        if (coll->nreported != coll->nexpected) {
+            return false;
+        }
+        coll->complete = true;
+        return true;
+    }
+    /* every participant in our part of the tree must have
+     * contributed, unless the tree was routed around it */
+    for (n = 0; n < coll->ndmns; n++) {
+        rank = (NULL == coll->dmns) ? (pmix_rank_t) n : coll->dmns[n];
+        if (pmix_bitmap_is_set_bit(&coll->contributed, rank) ||
+            prte_rml_rank_lost(rank)) {
+            continue;
+        }
+        if (rank == PRTE_PROC_MY_NAME->rank) {
+            return false;
+        }
+        PMIX_LIST_FOREACH(child, &prte_rml_base.children, prte_routed_tree_t) {
+            if (rank == child->rank ||
+                pmix_bitmap_is_set_bit(&child->relatives, rank)) {
+                return false;
+            }
+        }
+    }
+    coll->complete = true;
+    return true;
+}
+
+/* the collective is complete - release it if we are the DVM
+ * controller, otherwise pass the rollup to our parent */
+static void coll_release(prte_grpcomm_coll_t *coll, pmix_info_t *info, size_t ninfo)
+{
+    int rc;
+    size_t n, m;
+    bool found;
+    pmix_list_t nmlist;
+    prte_namelist_t *nm, *nm2;
+    pmix_data_array_t darray;
+    pmix_info_t infostat;
+    pmix_byte_object_t ctrlsbo;
+    pmix_data_buffer_t ctrlbuf;
+    pmix_data_buffer_t *reply;
+    pmix_proc_t *addmembers;
+
+    if (PRTE_PROC_IS_MASTER) {
+        PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
+                             "%s grpcomm:direct allgather HNP reports complete",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
+        /* the allgather is complete - send the xcast */
+        PMIX_DATA_BUFFER_CREATE(reply);
+
+        /* if we were asked to provide a context id, do so */
+        if (coll->assignID) {
+            coll->sig->ctxid = prte_grpcomm_base.context_id;
+            --prte_grpcomm_base.context_id;
+            coll->sig->ctxid_assigned = true;
+        }
+
+        if (NULL != coll->sig->groupID) {
+            // construct the final membership
+            PMIX_CONSTRUCT(&nmlist, pmix_list_t);
+            // sadly, an exhaustive search
+            for (m=0; m < coll->sig->sz; m++) {
+                found = false;
+                PMIX_LIST_FOREACH(nm, &nmlist, prte_namelist_t) {
+                    if (PMIX_CHECK_PROCID(&coll->sig->signature[m], &nm->name)) {
+                        // if the new one is rank=WILDCARD, then ensure
+                        // we keep it as wildcard
+                        if (PMIX_RANK_WILDCARD == coll->sig->signature[m].rank) {
+                            nm->name.rank = PMIX_RANK_WILDCARD;
+                        }
+                        found = true;
+                        break;
+                    }
+                }
+                if (!found) {
+                    nm = PMIX_NEW(prte_namelist_t);
+                    memcpy(&nm->name, &coll->sig->signature[m], sizeof(pmix_proc_t));
+                    pmix_list_append(&nmlist, &nm->super);
+                }
+            }
+            // now check any added members
+            PMIX_LIST_FOREACH(nm, &coll->addmembers, prte_namelist_t) {
+                found = false;
+                PMIX_LIST_FOREACH(nm2, &nmlist, prte_namelist_t) {
+                    if (PMIX_CHECK_PROCID(&nm->name, &nm2->name)) {
+                        // if the new one is rank=WILDCARD, then ensure
+                        // we keep it as wildcard
+                        if (PMIX_RANK_WILDCARD == nm->name.rank) {
+                            nm2->name.rank = PMIX_RANK_WILDCARD;
+                        }
+                        found = true;
+                        break;
+                    }
+                }
+                if (!found) {
+                    nm2 = PMIX_NEW(prte_namelist_t);
+                    memcpy(&nm2->name, &nm->name, sizeof(pmix_proc_t));
+                    pmix_list_append(&nmlist, &nm2->super);
+                }
+            }
+            // create the array of members
+            coll->sig->nfinal = pmix_list_get_size(&nmlist);
+            PMIX_PROC_CREATE(coll->sig->finalmembership, coll->sig->nfinal);
+            m = 0;
+            PMIX_LIST_FOREACH(nm, &nmlist, prte_namelist_t) {
+                memcpy(&coll->sig->finalmembership[m], &nm->name, sizeof(pmix_proc_t));
+                ++m;
+            }
+            PMIX_LIST_DESTRUCT(&nmlist);
+
+            /* sort the procs so everyone gets the same order */
+            qsort(coll->sig->finalmembership, coll->sig->nfinal, sizeof(pmix_proc_t), pmix_util_compare_proc);
+        }
+
+        /* pack the signature */
+        rc = prte_grpcomm_sig_pack(reply, coll->sig);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_RELEASE(reply);
+            return;
+        }
+        /* pack the status */
+        rc = PMIx_Data_pack(NULL, reply, &coll->status, 1, PMIX_INT32);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_RELEASE(reply);
+            return;
+        }
+        /* add some values to the payload in the bucket */
+        PMIX_DATA_BUFFER_CONSTRUCT(&ctrlbuf);
+
+        /* if we assigned a context id, include it in the bucket as well */
+        if (coll->assignID) {
+            PMIX_INFO_LOAD(&infostat, PMIX_GROUP_CONTEXT_ID, &coll->sig->ctxid, PMIX_SIZE);
+            rc = PMIx_Data_pack(NULL, &ctrlbuf, &infostat, 1, PMIX_INFO);
+            PMIX_INFO_DESTRUCT(&infostat);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                PMIX_DATA_BUFFER_RELEASE(reply);
+                PMIX_DATA_BUFFER_DESTRUCT(&ctrlbuf);
+                return;
+            }
+        }
+        /* if this is a group operation, provide group info */
+        if (NULL != coll->sig->groupID) {
+            // provide the group ID
+            PMIX_INFO_LOAD(&infostat, PMIX_GROUP_ID, coll->sig->groupID, PMIX_STRING);
+            rc = PMIx_Data_pack(NULL, &ctrlbuf, &infostat, 1, PMIX_INFO);
+            PMIX_INFO_DESTRUCT(&infostat);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                PMIX_DATA_BUFFER_RELEASE(reply);
+                PMIX_DATA_BUFFER_DESTRUCT(&ctrlbuf);
+                return;
+            }
+            // provide the final membership in an attribute
+            darray.type = PMIX_PROC;
+            darray.array = coll->sig->finalmembership;
+            darray.size = coll->sig->nfinal;
+            PMIX_INFO_LOAD(&infostat, PMIX_GROUP_MEMBERSHIP, &darray, PMIX_DATA_ARRAY); // copies array
+            // do not destruct the array
+            rc = PMIx_Data_pack(NULL, &ctrlbuf, &infostat, 1, PMIX_INFO);
+            PMIX_INFO_DESTRUCT(&infostat);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                PMIX_DATA_BUFFER_RELEASE(reply);
+                PMIX_DATA_BUFFER_DESTRUCT(&ctrlbuf);
+                return;
+            }
+            // provide the add-members in an attribute
+            if (0 < pmix_list_get_size(&coll->addmembers)) {
+                m = pmix_list_get_size(&coll->addmembers);
+                PMIX_PROC_CREATE(addmembers, m);
+                // create the array of add-members
+                n = 0;
+                PMIX_LIST_FOREACH(nm, &coll->addmembers, prte_namelist_t) {
+                    memcpy(&addmembers[n], &nm->name, sizeof(pmix_proc_t));
+                    ++n;
+                }
+                darray.type = PMIX_PROC;
+                darray.array = addmembers;
+                darray.size = m;
+                PMIX_INFO_LOAD(&infostat, PMIX_GROUP_ADD_MEMBERS, &darray, PMIX_DATA_ARRAY); // copies array
+                PMIX_DATA_ARRAY_DESTRUCT(&darray);
+                rc = PMIx_Data_pack(NULL, &ctrlbuf, &infostat, 1, PMIX_INFO);
+                PMIX_INFO_DESTRUCT(&infostat);
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_ERROR_LOG(rc);
+                    PMIX_DATA_BUFFER_RELEASE(reply);
+                    PMIX_DATA_BUFFER_DESTRUCT(&ctrlbuf);
+                    return;
+                }
+            }
+        }
+
+        // pack the ctrl object
+        PMIX_DATA_BUFFER_UNLOAD(&ctrlbuf, ctrlsbo.bytes, ctrlsbo.size);
+        PMIX_DATA_BUFFER_DESTRUCT(&ctrlbuf);
+        rc = PMIx_Data_pack(NULL, reply, &ctrlsbo, 1, PMIX_BYTE_OBJECT);
+        PMIX_BYTE_OBJECT_DESTRUCT(&ctrlsbo);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_RELEASE(reply);
+            return;
+        }
+
+        /* transfer the collected bucket */
+        rc = PMIx_Data_copy_payload(reply, &coll->bucket);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_RELEASE(reply);
+            return;
+        }
+
+        /* send the release via xcast */
+        (void) prte_grpcomm.xcast(coll->sig, PRTE_RML_TAG_COLL_RELEASE, reply);
+    } else {
+        PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
+                             "%s grpcomm:direct allgather rollup complete - sending to %s",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_PARENT)));
+        PMIX_DATA_BUFFER_CREATE(reply);
+        /* pack the signature */
+        rc = prte_grpcomm_sig_pack(reply, coll->sig);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_RELEASE(reply);
+            return;
+        }
+        /* pass along the ctrls - we have updated the values
+         * we collected along the way */
+        rc = prte_pack_ctrl_options(&ctrlsbo, info, ninfo);
+        if (PRTE_SUCCESS != rc) {
+            PMIX_DATA_BUFFER_RELEASE(reply);
+            return;
+        }
+        rc = PMIx_Data_pack(NULL, reply, &ctrlsbo, 1, PMIX_BYTE_OBJECT);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_RELEASE(reply);
+            PMIx_Byte_object_destruct(&ctrlsbo);
+            return;
+        }
+        PMIx_Byte_object_destruct(&ctrlsbo);
+        /* pass along whose contributions are in the bucket */
+        rc = pack_contributors(reply, coll);
+        if (PRTE_SUCCESS != rc) {
+            PMIX_DATA_BUFFER_RELEASE(reply);
+            return;
+        }
+
+        /* transfer the collected bucket */
+        rc = PMIx_Data_copy_payload(reply, &coll->bucket);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_RELEASE(reply);
+            return;
+        }
+        /* keep a copy in case our parent is lost before
+         * the collective is released */
+        if (prte_rml_base.self_heal) {
+            PMIX_DATA_BUFFER_CREATE(coll->rollup);
+            rc = PMIx_Data_copy_payload(coll->rollup, reply);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                PMIX_DATA_BUFFER_RELEASE(coll->rollup);
+            }
+        }
+        /* send the info to our parent */
+        PRTE_RML_SEND(rc, PRTE_PROC_MY_PARENT->rank, reply,
+                      PRTE_RML_TAG_ALLGATHER_DIRECT);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_RELEASE(reply);
+            return;
+        }
+    }
+}
+
+/* the routing tree was repaired around a lost daemon - recount the
+ * contributions each collective in flight expects from our new set
+ * of children, complete any that were only waiting on the lost
+ * daemon, and resend any rollup we already passed to a parent
+ * that may never have forwarded it */
+static void route_healed(pmix_rank_t lost, bool reparented)
+{
+    prte_grpcomm_coll_t *coll;
+    pmix_data_buffer_t *relay;
+    pmix_info_t *info;
+    size_t n;
+    int rc;
+
+    PMIX_LIST_FOREACH(coll, &prte_grpcomm_base.ongoing, prte_grpcomm_coll_t)
+    {
+        if (0 < coll->sig->bootstrap) {
+            /* everyone reports directly to the DVM controller */
+            continue;
+        }
+        coll->nexpected = prte_rml_get_num_contributors(coll->dmns, coll->ndmns);
+        if (NULL == coll->dmns) {
+            /* all daemons participate */
+            coll->nexpected++;
+        }
+        for (n = 0; NULL != coll->dmns && n < coll->ndmns; n++) {
+            if (coll->dmns[n] == PRTE_PROC_MY_NAME->rank) {
+                coll->nexpected++;
+                break;
+            }
+        }
+        PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
+                             "%s grpcomm:direct lost %s - collective now expects %d reported %d",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_VPID_PRINT(lost),
+                             (int) coll->nexpected, (int) coll->nreported));
+        /* the lost daemon may have been the only one we were
+         * still waiting on - pass along the collected ctrls */
+        if (coll_complete(coll)) {
+            PMIX_INFO_CREATE(info, 3);
+            PMIX_INFO_LOAD(&info[0], PMIX_TIMEOUT, &coll->timeout, PMIX_INT);
+            PMIX_INFO_LOAD(&info[1], PMIX_LOCAL_COLLECTIVE_STATUS, &coll->status, PMIX_STATUS);
+            PMIX_INFO_LOAD(&info[2], PMIX_GROUP_ASSIGN_CONTEXT_ID, &coll->assignID, PMIX_BOOL);
+            coll_release(coll, info, 3);
+            PMIX_INFO_FREE(info, 3);
+            continue;
+        }
+        /* our parent will drop anything it already holds */
+        if (!reparented || NULL == coll->rollup) {
+            continue;
+        }
+        PMIX_DATA_BUFFER_CREATE(relay);
+        rc = PMIx_Data_copy_payload(relay, coll->rollup);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_RELEASE(relay);
+            continue;
+        }
+        PRTE_RML_SEND(rc, PRTE_PROC_MY_PARENT->rank, relay,
+                      PRTE_RML_TAG_ALLGATHER_DIRECT);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_RELEASE(relay);
+        }
+    }
+}
+
 static void allgather_recv(int status, pmix_proc_t *sender,
                            pmix_data_buffer_t *buffer,
                            prte_rml_tag_t tag, void *cbdata)
 {
-    int32_t cnt;
+    int32_t cnt, ncontrib;
     int rc, timeout;
     size_t n, ninfo, m;
     bool assignID = false;
     bool found;
-    pmix_list_t nmlist;
-    prte_namelist_t *nm, *nm2;
-    pmix_data_array_t darray;
+    prte_namelist_t *nm;
     pmix_status_t st;
-    pmix_info_t *info, infostat;
+    pmix_info_t *info = NULL;
+    pmix_rank_t *contrib;
     prte_grpcomm_signature_t *sig = NULL;
     pmix_byte_object_t ctrlsbo;
     pmix_data_buffer_t ctrlbuf;
-    pmix_data_buffer_t *reply;
     prte_grpcomm_coll_t *coll;
-    pmix_proc_t *addmembers;
     PRTE_HIDE_UNUSED_PARAMS(status, tag, cbdata);
 
     PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
@@ -242,6 +659,46 @@ static void allgather_recv(int status, pmix_proc_t *sender,
     }
     PMIX_DATA_BUFFER_DESTRUCT(&ctrlbuf);
 
+    /* unpack whose contributions are in the payload */
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &ncontrib, &cnt, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(sig);
+        return;
+    }
+    if (0 < ncontrib) {
+        contrib = (pmix_rank_t *) malloc(ncontrib * sizeof(pmix_rank_t));
+        cnt = ncontrib;
+        rc = PMIx_Data_unpack(NULL, buffer, contrib, &cnt, PMIX_PROC_RANK);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            free(contrib);
+            PMIX_RELEASE(sig);
+            return;
+        }
+        /* a rollup travels as a unit, so if we already hold any
+         * of these contributions then this is a rollup resent
+         * after the routing tree was repaired and we hold them all */
+        for (m = 0; m < (size_t) ncontrib; m++) {
+            if (pmix_bitmap_is_set_bit(&coll->contributed, contrib[m])) {
+                PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
+                                     "%s grpcomm:direct allgather dropping duplicate rollup from %s",
+                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(sender)));
+                free(contrib);
+                if (NULL != info) {
+                    PMIX_INFO_FREE(info, ninfo);
+                }
+                PMIX_RELEASE(sig);
+                return;
+            }
+        }
+        for (m = 0; m < (size_t) ncontrib; m++) {
+            pmix_bitmap_set_bit(&coll->contributed, contrib[m]);
+        }
+        free(contrib);
+    }
+
     /* cycle thru the ctrls to look for keys we support */
     for (n=0; n < ninfo; n++) {
         if (PMIX_CHECK_KEY(&info[n], PMIX_TIMEOUT)) {
@@ -322,241 +779,10 @@ static void allgather_recv(int status, pmix_proc_t *sender,
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int) coll->nexpected,
                          (int) coll->nreported));
 
-    /* see if everyone has reported */
-    if (coll->nreported == coll->nexpected) {
-        if (PRTE_PROC_IS_MASTER) {
-            PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
-                                 "%s grpcomm:direct allgather HNP reports complete",
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
-            /* the allgather is complete - send the xcast */
-            PMIX_DATA_BUFFER_CREATE(reply);
-
-            /* if we were asked to provide a context id, do so */
-            if (assignID) {
-                coll->sig->ctxid = prte_grpcomm_base.context_id;
-                --prte_grpcomm_base.context_id;
-                coll->sig->ctxid_assigned = true;
-            }
-
-            if (NULL != coll->sig->groupID) {
-                // construct the final membership
-                PMIX_CONSTRUCT(&nmlist, pmix_list_t);
-                // sadly, an exhaustive search
-                for (m=0; m < coll->sig->sz; m++) {
-                    found = false;
-                    PMIX_LIST_FOREACH(nm, &nmlist, prte_namelist_t) {
-                        if (PMIX_CHECK_PROCID(&coll->sig->signature[m], &nm->name)) {
-                            // if the new one is rank=WILDCARD, then ensure
-                            // we keep it as wildcard
-                            if (PMIX_RANK_WILDCARD == coll->sig->signature[m].rank) {
-                                nm->name.rank = PMIX_RANK_WILDCARD;
-                            }
-                            found = true;
-                            break;
-                        }
-                    }
-                    if (!found) {
-                        nm = PMIX_NEW(prte_namelist_t);
-                        memcpy(&nm->name, &coll->sig->signature[m], sizeof(pmix_proc_t));
-                        pmix_list_append(&nmlist, &nm->super);
-                    }
-                }
-                // now check any added members
-                PMIX_LIST_FOREACH(nm, &coll->addmembers, prte_namelist_t) {
-                    found = false;
-                    PMIX_LIST_FOREACH(nm2, &nmlist, prte_namelist_t) {
-                        if (PMIX_CHECK_PROCID(&nm->name, &nm2->name)) {
-                            // if the new one is rank=WILDCARD, then ensure
-                            // we keep it as wildcard
-                            if (PMIX_RANK_WILDCARD == nm->name.rank) {
-                                nm2->name.rank = PMIX_RANK_WILDCARD;
-                            }
-                            found = true;
-                            break;
-                        }
-                    }
-                    if (!found) {
-                        nm2 = PMIX_NEW(prte_namelist_t);
-                        memcpy(&nm2->name, &nm->name, sizeof(pmix_proc_t));
-                        pmix_list_append(&nmlist, &nm2->super);
-                    }
-                }
-                // create the array of members
-                coll->sig->nfinal = pmix_list_get_size(&nmlist);
-                PMIX_PROC_CREATE(coll->sig->finalmembership, coll->sig->nfinal);
-                m = 0;
-                PMIX_LIST_FOREACH(nm, &nmlist, prte_namelist_t) {
-                    memcpy(&coll->sig->finalmembership[m], &nm->name, sizeof(pmix_proc_t));
-                    ++m;
-                }
-                PMIX_LIST_DESTRUCT(&nmlist);
-
-                /* sort the procs so everyone gets the same order */
-                qsort(coll->sig->finalmembership, coll->sig->nfinal, sizeof(pmix_proc_t), pmix_util_compare_proc);
-            }
-
-            /* pack the signature */
-            rc = prte_grpcomm_sig_pack(reply, coll->sig);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DATA_BUFFER_RELEASE(reply);
-                PMIX_RELEASE(sig);
-                return;
-            }
-            /* pack the status */
-            rc = PMIx_Data_pack(NULL, reply, &coll->status, 1, PMIX_INT32);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DATA_BUFFER_RELEASE(reply);
-                PMIX_RELEASE(sig);
-                return;
-            }
-            /* add some values to the payload in the bucket */
-            PMIX_DATA_BUFFER_CONSTRUCT(&ctrlbuf);
-
-            /* if we assigned a context id, include it in the bucket as well */
-            if (assignID) {
-                PMIX_INFO_LOAD(&infostat, PMIX_GROUP_CONTEXT_ID, &coll->sig->ctxid, PMIX_SIZE);
-                rc = PMIx_Data_pack(NULL, &ctrlbuf, &infostat, 1, PMIX_INFO);
-                PMIX_INFO_DESTRUCT(&infostat);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_DATA_BUFFER_RELEASE(reply);
-                    PMIX_DATA_BUFFER_DESTRUCT(&ctrlbuf);
-                    PMIX_RELEASE(sig);
-                    return;
-                }
-            }
-            /* if this is a group operation, provide group info */
-            if (NULL != coll->sig->groupID) {
-                // provide the group ID
-                PMIX_INFO_LOAD(&infostat, PMIX_GROUP_ID, sig->groupID, PMIX_STRING);
-                rc = PMIx_Data_pack(NULL, &ctrlbuf, &infostat, 1, PMIX_INFO);
-                PMIX_INFO_DESTRUCT(&infostat);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_DATA_BUFFER_RELEASE(reply);
-                    PMIX_DATA_BUFFER_DESTRUCT(&ctrlbuf);
-                    PMIX_RELEASE(sig);
-                    return;
-                }
-                // provide the final membership in an attribute
-                darray.type = PMIX_PROC;
-                darray.array = coll->sig->finalmembership;
-                darray.size = coll->sig->nfinal;
-                PMIX_INFO_LOAD(&infostat, PMIX_GROUP_MEMBERSHIP, &darray, PMIX_DATA_ARRAY); // copies array
-                // do not destruct the array
-                rc = PMIx_Data_pack(NULL, &ctrlbuf, &infostat, 1, PMIX_INFO);
-                PMIX_INFO_DESTRUCT(&infostat);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_DATA_BUFFER_RELEASE(reply);
-                    PMIX_DATA_BUFFER_DESTRUCT(&ctrlbuf);
-                    PMIX_RELEASE(sig);
-                    return;
-                }
-                // provide the add-members in an attribute
-                if (0 < pmix_list_get_size(&coll->addmembers)) {
-                    m = pmix_list_get_size(&coll->addmembers);
-                    PMIX_PROC_CREATE(addmembers, m);
-                    // create the array of add-members
-                    n = 0;
-                    PMIX_LIST_FOREACH(nm, &coll->addmembers, prte_namelist_t) {
-                        memcpy(&addmembers[n], &nm->name, sizeof(pmix_proc_t));
-                        ++n;
-                    }
-                    darray.type = PMIX_PROC;
-                    darray.array = addmembers;
-                    darray.size = m;
-                    PMIX_INFO_LOAD(&infostat, PMIX_GROUP_ADD_MEMBERS, &darray, PMIX_DATA_ARRAY); // copies array
-                    PMIX_DATA_ARRAY_DESTRUCT(&darray);
-                    rc = PMIx_Data_pack(NULL, &ctrlbuf, &infostat, 1, PMIX_INFO);
-                    PMIX_INFO_DESTRUCT(&infostat);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_DATA_BUFFER_RELEASE(reply);
-                        PMIX_DATA_BUFFER_DESTRUCT(&ctrlbuf);
-                        PMIX_RELEASE(sig);
-                        return;
-                    }
-                }
-            }
-
-            // pack the ctrl object
-            PMIX_DATA_BUFFER_UNLOAD(&ctrlbuf, ctrlsbo.bytes, ctrlsbo.size);
-            PMIX_DATA_BUFFER_DESTRUCT(&ctrlbuf);
-            rc = PMIx_Data_pack(NULL, reply, &ctrlsbo, 1, PMIX_BYTE_OBJECT);
-            PMIX_BYTE_OBJECT_DESTRUCT(&ctrlsbo);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DATA_BUFFER_RELEASE(reply);
-                PMIX_RELEASE(sig);
-                return;
-            }
-
-            /* transfer the collected bucket */
-            rc = PMIx_Data_copy_payload(reply, &coll->bucket);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DATA_BUFFER_RELEASE(reply);
-                PMIX_RELEASE(sig);
-                return;
-            }
-
-            /* send the release via xcast */
-            (void) prte_grpcomm.xcast(sig, PRTE_RML_TAG_COLL_RELEASE, reply);
-        } else {
-            PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
-                                 "%s grpcomm:direct allgather rollup complete - sending to %s",
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_PARENT)));
-            PMIX_DATA_BUFFER_CREATE(reply);
-            /* pack the signature */
-            rc = prte_grpcomm_sig_pack(reply, sig);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DATA_BUFFER_RELEASE(reply);
-                PMIX_RELEASE(sig);
-                return;
-            }
-            PMIX_RELEASE(sig);
-            sig = NULL;
-            /* pass along the ctrls - we have updated the values
-             * we collected along the way */
-            rc = prte_pack_ctrl_options(&ctrlsbo, info, ninfo);
-            if (PRTE_SUCCESS != rc) {
-                PMIX_DATA_BUFFER_RELEASE(reply);
-                return;
-            }
-            rc = PMIx_Data_pack(NULL, reply, &ctrlsbo, 1, PMIX_BYTE_OBJECT);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DATA_BUFFER_RELEASE(reply);
-                PMIx_Byte_object_destruct(&ctrlsbo);
-                return;
-            }
-            PMIx_Byte_object_destruct(&ctrlsbo);
-
-            /* transfer the collected bucket */
-            rc = PMIx_Data_copy_payload(reply, &coll->bucket);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DATA_BUFFER_RELEASE(reply);
-                return;
-            }
-            /* send the info to our parent */
-            PRTE_RML_SEND(rc, PRTE_PROC_MY_PARENT->rank, reply,
-                          PRTE_RML_TAG_ALLGATHER_DIRECT);
-            if (PRTE_SUCCESS != rc) {
-                PRTE_ERROR_LOG(rc);
-                PMIX_DATA_BUFFER_RELEASE(reply);
-                return;
-            }
-        }
-    }
-    if (NULL != sig) {
-        PMIX_RELEASE(sig);
+    if (coll_complete(coll)) {
+        coll_release(coll, info, ninfo);
     }
+    PMIX_RELEASE(sig);
 }
 
 static void xcast_recv(int status, pmix_proc_t *sender,
@@ -575,15 +801,42 @@ static void xcast_recv(int status, pmix_proc_t *sender,
     pmix_byte_object_t bo, pbo;
     pmix_value_t val;
     pmix_proc_t dmn;
+    uint32_t seq;
     PRTE_HIDE_UNUSED_PARAMS(status, sender, tg, cbdata);
 
     PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
                          "%s grpcomm:direct:xcast:recv: with %d bytes",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int) buffer->bytes_used));
 
+    if (PRTE_PROC_IS_MASTER) {
+        seq = ++xcast_seq;
+    } else {
+        cnt = 1;
+        ret = PMIx_Data_unpack(NULL, buffer, &seq, &cnt, PMIX_UINT32);
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+            PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
+            return;
+        }
+        if (seq <= xcast_seq) {
+            /* already have it */
+            PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
+                                 "%s grpcomm:direct:xcast:recv: dropping duplicate %u",
+                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), seq));
+            return;
+        }
+        xcast_seq = seq;
+    }
+
     /* we need a passthru buffer to send to our children - we leave it
      * as compressed data */
     PMIX_DATA_BUFFER_CREATE(rly);
+    ret = PMIx_Data_pack(NULL, rly, &seq, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        PMIX_DATA_BUFFER_RELEASE(rly);
+        return;
+    }
     ret = PMIx_Data_copy_payload(rly, buffer);
     if (PMIX_SUCCESS != ret) {
         PMIX_ERROR_LOG(ret);
@@ -104,6 +104,13 @@ typedef struct {
     pmix_bitmap_t distance_mask_recv;
     /* received buckets */
     pmix_data_buffer_t **buffers;
+    /* copy of our rollup, kept for resend if our parent is lost */
+    pmix_data_buffer_t *rollup;
+    /* daemons whose contributions are in the bucket - only
+     * tracked when self-healing, so rollups resent after the
+     * routing tree was repaired are only counted once */
+    pmix_bitmap_t contributed;
+    bool complete;
     /* callback function */
     prte_grpcomm_cbfunc_t cbfunc;
     /* user-provided callback data */
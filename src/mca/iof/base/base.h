@@ -49,6 +49,7 @@
 #include <signal.h>
 
 #include "src/class/pmix_bitmap.h"
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
 #include "src/event/event-internal.h"
 #include "src/mca/mca.h"
@@ -124,6 +125,7 @@ typedef struct {
     prte_iof_sink_t *stdinev;
     prte_iof_read_event_t *revstdout;
     prte_iof_read_event_t *revstderr;
+    bool local_only;  // output is written on this node and not forwarded
 } prte_iof_proc_t;
 PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_iof_proc_t);
 
@@ -131,6 +133,7 @@ typedef struct {
     pmix_list_item_t super;
     char data[PRTE_IOF_BASE_TAGGED_OUT_MAX];
     int numbytes;
+    uint64_t seq;  // wildcard stdin segment, or zero if untracked
 } prte_iof_write_output_t;
 PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_iof_write_output_t);
 
@@ -150,6 +153,8 @@ static inline bool prte_iof_base_fd_always_ready(int fd)
 }
 
 #define PRTE_IOF_SINK_BLOCKSIZE (1024)
+/* max number of queued fragments handed to a single writev */
+#define PRTE_IOF_SINK_MAX_IOV 64
 
 #define PRTE_IOF_SINK_ACTIVATE(wev)                                    \
     do {                                                               \
@@ -238,20 +243,66 @@ static inline bool prte_iof_base_fd_always_ready(int fd)
         }                                                                                     \
     } while (0);
 
+/* Wildcard stdin is broadcast in segments of at most PRTE_IOF_BASE_MSG_MAX
+ * bytes, each carrying a sequence number. Every daemon returns to its
+ * parent in the routing tree a cumulative credit - the highest segment
+ * that it, and every child that has reported, has written to its local
+ * procs. The HNP allows at most prte_iof_base_stdin_window segments to
+ * be outstanding beyond the credit it holds for the whole tree.
+ */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_rank_t rank;
+    uint64_t seq;
+} prte_iof_credit_t;
+PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_iof_credit_t);
+
+typedef struct {
+    uint64_t received;   // highest segment delivered to our local procs
+    uint64_t reported;   // highest credit returned to our parent
+    uint64_t flush;      // report as soon as we have written this segment
+    bool joined;         // we have reported at least once
+    pmix_list_t credits; // prte_iof_credit_t reported by our children
+} prte_iof_stdin_state_t;
+
 PRTE_EXPORT int prte_iof_base_flush(void);
 
 PRTE_EXPORT extern int prte_iof_base_output_limit;
+PRTE_EXPORT extern bool prte_iof_base_local_file_output;
+PRTE_EXPORT extern int prte_iof_base_stdin_window;
 
 /* base functions */
 PRTE_EXPORT int prte_iof_base_write_output(const pmix_proc_t *name, prte_iof_tag_t stream,
                                            const unsigned char *data, int numbytes,
                                            prte_iof_write_event_t *channel);
+PRTE_EXPORT int prte_iof_base_write_stdin(const pmix_proc_t *name, const unsigned char *data,
+                                          int numbytes, uint64_t seq,
+                                          prte_iof_write_event_t *channel);
 PRTE_EXPORT void prte_iof_base_write_handler(int fd, short event, void *cbdata);
 
 PRTE_EXPORT void prte_iof_base_output(const pmix_proc_t *source,
                                       pmix_iof_channel_t channel,
                                       char *string);
 
+/* proc tracking - the list holds the procs, the index finds them by name */
+PRTE_EXPORT prte_iof_proc_t *prte_iof_base_proc_find(pmix_hash_table_t *index,
+                                                     const pmix_proc_t *name);
+PRTE_EXPORT prte_iof_proc_t *prte_iof_base_proc_add(pmix_list_t *procs, pmix_hash_table_t *index,
+                                                    const pmix_proc_t *name);
+PRTE_EXPORT void prte_iof_base_proc_remove(pmix_list_t *procs, pmix_hash_table_t *index,
+                                           prte_iof_proc_t *proct);
+
+/* windowed stdin support */
+PRTE_EXPORT void prte_iof_base_stdin_construct(prte_iof_stdin_state_t *st);
+PRTE_EXPORT void prte_iof_base_stdin_destruct(prte_iof_stdin_state_t *st);
+PRTE_EXPORT int prte_iof_base_stdin_segment(prte_iof_stdin_state_t *st, pmix_list_t *procs,
+                                            const pmix_proc_t *target,
+                                            pmix_data_buffer_t *buffer);
+PRTE_EXPORT int prte_iof_base_stdin_credit(prte_iof_stdin_state_t *st, pmix_rank_t child,
+                                           pmix_data_buffer_t *buffer);
+PRTE_EXPORT uint64_t prte_iof_base_stdin_level(prte_iof_stdin_state_t *st, pmix_list_t *procs);
+PRTE_EXPORT void prte_iof_base_stdin_report(prte_iof_stdin_state_t *st, pmix_list_t *procs);
+
 END_C_DECLS
 
 #endif /* MCA_IOF_BASE_H */
@@ -36,6 +36,7 @@
 #include "src/util/pmix_basename.h"
 #include "src/util/pmix_os_dirpath.h"
 #include "src/util/pmix_output.h"
+#include "src/util/output.h"
 
 #include "src/rml/rml.h"
 #include "src/runtime/prte_globals.h"
@@ -60,6 +61,8 @@ prte_iof_base_module_t prte_iof = {0};
  */
 
 int prte_iof_base_output_limit = 0;
+bool prte_iof_base_local_file_output = false;
+int prte_iof_base_stdin_window = 64;
 
 static int prte_iof_base_register(pmix_mca_base_register_flag_t flags)
 {
@@ -72,6 +75,26 @@ static int prte_iof_base_register(pmix_mca_base_register_flag_t flags)
                                       PMIX_MCA_BASE_VAR_TYPE_INT,
                                       &prte_iof_base_output_limit);
 
+    prte_iof_base_local_file_output = false;
+    (void) pmix_mca_base_var_register("prte", "iof", "base", "local_file_output",
+                                      "When a job's output goes only to files (i.e., file or "
+                                      "directory output with nocopy), write it on the node "
+                                      "where each proc runs and do not forward it to the DVM master",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &prte_iof_base_local_file_output);
+
+    prte_iof_base_stdin_window = 64;
+    (void) pmix_mca_base_var_register("prte", "iof", "base", "stdin_window",
+                                      "Maximum number of stdin segments (of up to 4kB each) "
+                                      "that may be in flight to the daemons when stdin is "
+                                      "forwarded to all procs of a job - further input is "
+                                      "held until the daemons have written what they have",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &prte_iof_base_stdin_window);
+    if (prte_iof_base_stdin_window < 1) {
+        prte_iof_base_stdin_window = 1;
+    }
+
     return PRTE_SUCCESS;
 }
 
@@ -139,6 +162,7 @@ static void prte_iof_base_proc_construct(prte_iof_proc_t *ptr)
     ptr->stdinev = NULL;
     ptr->revstdout = NULL;
     ptr->revstderr = NULL;
+    ptr->local_only = false;
 }
 static void prte_iof_base_proc_destruct(prte_iof_proc_t *ptr)
 {
@@ -167,7 +191,7 @@ static void prte_iof_base_sink_construct(prte_iof_sink_t *ptr)
 static void prte_iof_base_sink_destruct(prte_iof_sink_t *ptr)
 {
     if (NULL != ptr->wev) {
-        PMIX_OUTPUT_VERBOSE((20, prte_iof_base_framework.framework_output,
+        PRTE_OUTPUT_VERBOSE((20, prte_iof_base_framework.framework_output,
                              "%s iof: closing sink for process %s on fd %d",
                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&ptr->name),
                              ptr->wev->fd));
@@ -196,7 +220,7 @@ static void prte_iof_base_read_event_destruct(prte_iof_read_event_t *rev)
 
     if (0 <= rev->fd) {
         prte_event_free(rev->ev);
-        PMIX_OUTPUT_VERBOSE((20, prte_iof_base_framework.framework_output,
+        PRTE_OUTPUT_VERBOSE((20, prte_iof_base_framework.framework_output,
                              "%s iof: closing fd %d for process %s",
                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), rev->fd,
                              (NULL == proct) ? "UNKNOWN" : PRTE_NAME_PRINT(&proct->name)));
@@ -234,7 +258,7 @@ static void prte_iof_base_write_event_destruct(prte_iof_write_event_t *wev)
         free(wev->ev);
     }
     if (2 < wev->fd) {
-        PMIX_OUTPUT_VERBOSE((20, prte_iof_base_framework.framework_output,
+        PRTE_OUTPUT_VERBOSE((20, prte_iof_base_framework.framework_output,
                              "%s iof: closing fd %d for write event",
                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), wev->fd));
         close(wev->fd);
@@ -245,7 +269,21 @@ PMIX_CLASS_INSTANCE(prte_iof_write_event_t, pmix_list_item_t,
                     prte_iof_base_write_event_construct,
                     prte_iof_base_write_event_destruct);
 
-PMIX_CLASS_INSTANCE(prte_iof_write_output_t, pmix_list_item_t, NULL, NULL);
+static void prte_iof_base_write_output_construct(prte_iof_write_output_t *output)
+{
+    output->numbytes = 0;
+    output->seq = 0;
+}
+PMIX_CLASS_INSTANCE(prte_iof_write_output_t, pmix_list_item_t,
+                    prte_iof_base_write_output_construct, NULL);
+
+static void prte_iof_base_credit_construct(prte_iof_credit_t *cr)
+{
+    cr->rank = PMIX_RANK_INVALID;
+    cr->seq = 0;
+}
+PMIX_CLASS_INSTANCE(prte_iof_credit_t, pmix_list_item_t,
+                    prte_iof_base_credit_construct, NULL);
 
 static void pdcon(prte_iof_deliver_t *p)
 {
@@ -36,8 +36,12 @@
 #endif
 #include <errno.h>
 #include <time.h>
+#ifdef HAVE_SYS_UIO_H
+#    include <sys/uio.h>
+#endif
 
 #include "src/util/pmix_output.h"
+#include "src/util/output.h"
 
 #include "src/mca/errmgr/errmgr.h"
 #include "src/mca/state/state.h"
@@ -47,15 +51,13 @@
 
 #include "src/mca/iof/base/base.h"
 
-int prte_iof_base_write_output(const pmix_proc_t *name, prte_iof_tag_t stream,
-                               const unsigned char *data, int numbytes,
-                               prte_iof_write_event_t *channel)
+static int write_output(const pmix_proc_t *name, const unsigned char *data, int numbytes,
+                        uint64_t seq, prte_iof_write_event_t *channel)
 {
     prte_iof_write_output_t *output;
     int num_buffered;
-    PRTE_HIDE_UNUSED_PARAMS(stream);
 
-    PMIX_OUTPUT_VERBOSE(
+    PRTE_OUTPUT_VERBOSE(
         (1, prte_iof_base_framework.framework_output,
          "%s write:output setting up to write %d bytes to stdin for %s on fd %d",
          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), numbytes,
@@ -77,6 +79,7 @@ int prte_iof_base_write_output(const pmix_proc_t *name, prte_iof_tag_t stream,
         memcpy(output->data, data, numbytes);
     }
     output->numbytes = numbytes;
+    output->seq = seq;
     /* add this data to the write list for this fd */
     pmix_list_append(&channel->outputs, &output->super);
 
@@ -86,7 +89,7 @@ int prte_iof_base_write_output(const pmix_proc_t *name, prte_iof_tag_t stream,
     /* is the write event issued? */
     if (!channel->pending) {
         /* issue it */
-        PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+        PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                              "%s write:output adding write event",
                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
         PRTE_IOF_SINK_ACTIVATE(channel);
@@ -95,33 +98,64 @@ int prte_iof_base_write_output(const pmix_proc_t *name, prte_iof_tag_t stream,
     return num_buffered;
 }
 
+int prte_iof_base_write_output(const pmix_proc_t *name, prte_iof_tag_t stream,
+                               const unsigned char *data, int numbytes,
+                               prte_iof_write_event_t *channel)
+{
+    PRTE_HIDE_UNUSED_PARAMS(stream);
+
+    return write_output(name, data, numbytes, 0, channel);
+}
+
+/* same as above, but tag the data with the wildcard stdin segment it
+ * came from so the credit we return reflects what was actually written */
+int prte_iof_base_write_stdin(const pmix_proc_t *name, const unsigned char *data,
+                              int numbytes, uint64_t seq,
+                              prte_iof_write_event_t *channel)
+{
+    return write_output(name, data, numbytes, seq, channel);
+}
+
 void prte_iof_base_write_handler(int _fd, short event, void *cbdata)
 {
     prte_iof_sink_t *sink = (prte_iof_sink_t *) cbdata;
     prte_iof_write_event_t *wev = sink->wev;
-    pmix_list_item_t *item;
     prte_iof_write_output_t *output;
-    int num_written, total_written = 0;
+    struct iovec iov[PRTE_IOF_SINK_MAX_IOV];
+    int niov;
+    ssize_t num_written;
+    int total_written = 0;
     PRTE_HIDE_UNUSED_PARAMS(_fd, event);
 
     PMIX_ACQUIRE_OBJECT(sink);
 
-    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                          "%s write:handler writing data to %d", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                          wev->fd));
 
-    while (NULL != (item = pmix_list_remove_first(&wev->outputs))) {
-        output = (prte_iof_write_output_t *) item;
-        if (0 == output->numbytes) {
+    while (!pmix_list_is_empty(&wev->outputs)) {
+        /* gather whatever has queued up so it goes out in a
+         * single system call */
+        niov = 0;
+        PMIX_LIST_FOREACH(output, &wev->outputs, prte_iof_write_output_t)
+        {
+            if (0 == output->numbytes || PRTE_IOF_SINK_MAX_IOV == niov) {
+                break;
+            }
+            iov[niov].iov_base = output->data;
+            iov[niov].iov_len = output->numbytes;
+            ++niov;
+        }
+        if (0 == niov) {
             /* indicates we are to close this stream */
+            output = (prte_iof_write_output_t *) pmix_list_remove_first(&wev->outputs);
+            PMIX_RELEASE(output);
             PMIX_RELEASE(sink);
             return;
         }
-        num_written = write(wev->fd, output->data, output->numbytes);
+        num_written = writev(wev->fd, iov, niov);
         if (num_written < 0) {
             if (EAGAIN == errno || EINTR == errno) {
-                /* push this item back on the front of the list */
-                pmix_list_prepend(&wev->outputs, item);
                 /* if the list is getting too large, abort */
                 if (prte_iof_base_output_limit < (int)pmix_list_get_size(&wev->outputs)) {
                     pmix_output(0, "IO Forwarding is running too far behind - something is "
@@ -137,30 +171,35 @@ void prte_iof_base_write_handler(int _fd, short event, void *cbdata)
             /* otherwise, something bad happened so all we can do is abort
              * this attempt
              */
-            PMIX_RELEASE(output);
             goto ABORT;
-        } else if (num_written < output->numbytes) {
-            /* incomplete write - adjust data to avoid duplicate output */
-            memmove(output->data, &output->data[num_written], output->numbytes - num_written);
-            /* adjust the number of bytes remaining to be written */
-            output->numbytes -= num_written;
-            /* push this item back on the front of the list */
-            pmix_list_prepend(&wev->outputs, item);
-            /* if the list is getting too large, abort */
-            if (prte_iof_base_output_limit < (int)pmix_list_get_size(&wev->outputs)) {
-                pmix_output(0, "IO Forwarding is running too far behind - something is blocking us "
-                               "from writing");
-                PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
-                goto ABORT;
+        }
+        total_written += num_written;
+
+        /* release everything that went out */
+        while (0 < num_written) {
+            output = (prte_iof_write_output_t *) pmix_list_get_first(&wev->outputs);
+            if (num_written < output->numbytes) {
+                /* incomplete write - adjust data to avoid duplicate output */
+                memmove(output->data, &output->data[num_written], output->numbytes - num_written);
+                /* adjust the number of bytes remaining to be written */
+                output->numbytes -= num_written;
+                /* if the list is getting too large, abort */
+                if (prte_iof_base_output_limit < (int)pmix_list_get_size(&wev->outputs)) {
+                    pmix_output(0, "IO Forwarding is running too far behind - something is blocking us "
+                                   "from writing");
+                    PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
+                    goto ABORT;
+                }
+                /* leave the write event running so it will call us again
+                 * when the fd is ready
+                 */
+                goto NEXT_CALL;
             }
-            /* leave the write event running so it will call us again
-             * when the fd is ready
-             */
-            goto NEXT_CALL;
+            num_written -= output->numbytes;
+            pmix_list_remove_first(&wev->outputs);
+            PMIX_RELEASE(output);
         }
-        PMIX_RELEASE(output);
 
-        total_written += num_written;
         if (wev->always_writable && (PRTE_IOF_SINK_BLOCKSIZE <= total_written)) {
             /* If this is a regular file it will never tell us it will block
              * Write no more than PRTE_IOF_REGULARF_BLOCK at a time allowing
@@ -0,0 +1,327 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <string.h>
+
+#include "src/pmix/pmix-internal.h"
+#include "src/util/pmix_output.h"
+#include "src/util/output.h"
+
+#include "src/mca/errmgr/errmgr.h"
+#include "src/rml/rml.h"
+#include "src/runtime/prte_globals.h"
+#include "src/util/name_fns.h"
+#include "src/util/proc_info.h"
+
+#include "src/mca/iof/base/base.h"
+
+/* the index is keyed on the whole pmix_proc_t, so clear
+ * the unused part of the nspace to get a stable key */
+static void proc_key(pmix_proc_t *key, const pmix_proc_t *name)
+{
+    memset(key, 0, sizeof(pmix_proc_t));
+    PMIX_LOAD_PROCID(key, name->nspace, name->rank);
+}
+
+prte_iof_proc_t *prte_iof_base_proc_find(pmix_hash_table_t *index,
+                                         const pmix_proc_t *name)
+{
+    pmix_proc_t key;
+    void *ptr;
+
+    proc_key(&key, name);
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(index, &key, sizeof(key), &ptr)) {
+        return (prte_iof_proc_t *) ptr;
+    }
+    return NULL;
+}
+
+prte_iof_proc_t *prte_iof_base_proc_add(pmix_list_t *procs, pmix_hash_table_t *index,
+                                        const pmix_proc_t *name)
+{
+    prte_iof_proc_t *proct;
+    pmix_proc_t key;
+
+    /* do we already have this process? */
+    proct = prte_iof_base_proc_find(index, name);
+    if (NULL != proct) {
+        return proct;
+    }
+
+    proct = PMIX_NEW(prte_iof_proc_t);
+    PMIX_XFER_PROCID(&proct->name, name);
+    pmix_list_append(procs, &proct->super);
+    proc_key(&key, name);
+    pmix_hash_table_set_value_ptr(index, &key, sizeof(key), proct);
+    return proct;
+}
+
+/* the caller retains the reference that was held by the list */
+void prte_iof_base_proc_remove(pmix_list_t *procs, pmix_hash_table_t *index,
+                               prte_iof_proc_t *proct)
+{
+    pmix_proc_t key;
+
+    pmix_list_remove_item(procs, &proct->super);
+    proc_key(&key, &proct->name);
+    pmix_hash_table_remove_value_ptr(index, &key, sizeof(key));
+}
+
+void prte_iof_base_stdin_construct(prte_iof_stdin_state_t *st)
+{
+    st->received = 0;
+    st->reported = 0;
+    st->flush = 0;
+    st->joined = false;
+    PMIX_CONSTRUCT(&st->credits, pmix_list_t);
+}
+
+void prte_iof_base_stdin_destruct(prte_iof_stdin_state_t *st)
+{
+    PMIX_LIST_DESTRUCT(&st->credits);
+}
+
+/* the stream is starting - every child we have now must return
+ * credit before the tree can move past it */
+static void expect_children(prte_iof_stdin_state_t *st)
+{
+    prte_routed_tree_t *child;
+    prte_iof_credit_t *cr;
+    bool found;
+
+    PMIX_LIST_FOREACH(child, &prte_rml_base.children, prte_routed_tree_t)
+    {
+        found = false;
+        PMIX_LIST_FOREACH(cr, &st->credits, prte_iof_credit_t)
+        {
+            if (cr->rank == child->rank) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            cr = PMIX_NEW(prte_iof_credit_t);
+            cr->rank = child->rank;
+            cr->seq = 0;
+            pmix_list_append(&st->credits, &cr->super);
+        }
+    }
+}
+
+/* deliver a wildcard stdin segment to all local procs of the
+ * target job that asked for stdin - the segment number and flush
+ * flag follow the target name in the buffer */
+int prte_iof_base_stdin_segment(prte_iof_stdin_state_t *st, pmix_list_t *procs,
+                                const pmix_proc_t *target, pmix_data_buffer_t *buffer)
+{
+    unsigned char data[PRTE_IOF_BASE_MSG_MAX];
+    prte_iof_proc_t *proct;
+    int32_t count, numbytes;
+    uint64_t seq;
+    bool flush;
+    pmix_status_t rc;
+
+    count = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &seq, &count, PMIX_UINT64);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    count = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &flush, &count, PMIX_BOOL);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    numbytes = PRTE_IOF_BASE_MSG_MAX;
+    rc = PMIx_Data_unpack(NULL, buffer, data, &numbytes, PMIX_BYTE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+                         "%s iof:base stdin segment %lu (%d bytes) for %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (unsigned long) seq, numbytes,
+                         PRTE_NAME_PRINT(target)));
+
+    if (seq <= st->received) {
+        /* already have it */
+        return PRTE_SUCCESS;
+    }
+
+    PMIX_LIST_FOREACH(proct, procs, prte_iof_proc_t)
+    {
+        if (!PMIX_CHECK_NSPACE(target->nspace, proct->name.nspace) ||
+            NULL == proct->stdinev || NULL == proct->stdinev->wev) {
+            continue;
+        }
+        /* send the bytes down the pipe - we even send 0 byte events
+         * down the pipe so it forces out any preceding data before
+         * closing the output stream
+         */
+        prte_iof_base_write_stdin(&proct->name, data, numbytes, seq, proct->stdinev->wev);
+    }
+
+    if (0 == st->received) {
+        expect_children(st);
+    }
+    st->received = seq;
+    if (flush) {
+        st->flush = seq;
+    }
+    return PRTE_SUCCESS;
+}
+
+int prte_iof_base_stdin_credit(prte_iof_stdin_state_t *st, pmix_rank_t child,
+                               pmix_data_buffer_t *buffer)
+{
+    prte_iof_credit_t *cr;
+    int32_t count;
+    uint64_t seq;
+    pmix_status_t rc;
+
+    count = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &seq, &count, PMIX_UINT64);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+
+    PRTE_OUTPUT_VERBOSE((5, prte_iof_base_framework.framework_output,
+                         "%s iof:base stdin credit %lu from %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (unsigned long) seq,
+                         PRTE_VPID_PRINT(child)));
+
+    PMIX_LIST_FOREACH(cr, &st->credits, prte_iof_credit_t)
+    {
+        if (cr->rank == child) {
+            if (cr->seq < seq) {
+                cr->seq = seq;
+            }
+            return PRTE_SUCCESS;
+        }
+    }
+    cr = PMIX_NEW(prte_iof_credit_t);
+    cr->rank = child;
+    cr->seq = seq;
+    pmix_list_append(&st->credits, &cr->super);
+    return PRTE_SUCCESS;
+}
+
+/* the highest segment written by us and by every child - a child
+ * that was in the tree when the stream began counts as having written
+ * nothing until it reports, while one that joined the DVM afterwards
+ * is only counted from its first report (it returns credit as soon
+ * as it sees a segment) so it cannot stall a stream it never saw */
+uint64_t prte_iof_base_stdin_level(prte_iof_stdin_state_t *st, pmix_list_t *procs)
+{
+    prte_iof_proc_t *proct;
+    prte_iof_write_output_t *output;
+    prte_routed_tree_t *child;
+    prte_iof_credit_t *cr;
+    uint64_t level = st->received;
+
+    /* anything still queued to a local proc has not been written */
+    PMIX_LIST_FOREACH(proct, procs, prte_iof_proc_t)
+    {
+        if (NULL == proct->stdinev || NULL == proct->stdinev->wev) {
+            continue;
+        }
+        PMIX_LIST_FOREACH(output, &proct->stdinev->wev->outputs, prte_iof_write_output_t)
+        {
+            if (0 < output->seq) {
+                if (output->seq - 1 < level) {
+                    level = output->seq - 1;
+                }
+                break;
+            }
+        }
+    }
+
+    PMIX_LIST_FOREACH(child, &prte_rml_base.children, prte_routed_tree_t)
+    {
+        PMIX_LIST_FOREACH(cr, &st->credits, prte_iof_credit_t)
+        {
+            if (cr->rank == child->rank) {
+                if (cr->seq < level) {
+                    level = cr->seq;
+                }
+                break;
+            }
+        }
+    }
+    return level;
+}
+
+/* return credit to our parent - we join as soon as we see the first
+ * segment so our parent starts counting us, and then report every
+ * eighth of a window, or as soon as we have written the segment that
+ * filled the HNP's window */
+void prte_iof_base_stdin_report(prte_iof_stdin_state_t *st, pmix_list_t *procs)
+{
+    pmix_data_buffer_t *buf;
+    prte_iof_tag_t tag = PRTE_IOF_CREDIT;
+    prte_rml_tag_t rtag;
+    uint64_t level, batch;
+    int rc;
+
+    if (0 == st->received) {
+        return;
+    }
+    level = prte_iof_base_stdin_level(st, procs);
+    batch = prte_iof_base_stdin_window / 8;
+    if (0 == batch) {
+        batch = 1;
+    }
+    if (st->joined) {
+        if (level <= st->reported) {
+            return;
+        }
+        if (level - st->reported < batch && level < st->flush) {
+            return;
+        }
+    }
+
+    PMIX_DATA_BUFFER_CREATE(buf);
+    rc = PMIx_Data_pack(NULL, buf, &tag, 1, PMIX_UINT16);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        return;
+    }
+    rc = PMIx_Data_pack(NULL, buf, &level, 1, PMIX_UINT64);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        return;
+    }
+
+    PRTE_OUTPUT_VERBOSE((5, prte_iof_base_framework.framework_output,
+                         "%s iof:base returning stdin credit %lu to %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (unsigned long) level,
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_PARENT)));
+
+    /* the HNP listens for daemons on a different tag */
+    if (PRTE_PROC_MY_PARENT->rank == PRTE_PROC_MY_HNP->rank) {
+        rtag = PRTE_RML_TAG_IOF_HNP;
+    } else {
+        rtag = PRTE_RML_TAG_IOF_PROXY;
+    }
+    PRTE_RML_SEND(rc, PRTE_PROC_MY_PARENT->rank, buf, rtag);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        return;
+    }
+    st->joined = true;
+    st->reported = level;
+}
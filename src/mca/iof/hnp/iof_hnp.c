@@ -28,6 +28,7 @@
 #include "prte_config.h"
 #include "constants.h"
 #include "src/util/pmix_output.h"
+#include "src/util/output.h"
 
 #include <errno.h>
 #ifdef HAVE_UNISTD_H
@@ -76,6 +77,8 @@ static int finalize(void);
 
 static int push_stdin(const pmix_proc_t *dst_name, uint8_t *data, size_t sz);
 
+static int stdin_wait(pmix_op_cbfunc_t cbfunc, void *cbdata);
+
 /* The API's in this module are solely used to support LOCAL
  * procs - i.e., procs that are co-located to the HNP. Remote
  * procs interact with the HNP's IOF via the HNP's receive function,
@@ -89,9 +92,30 @@ prte_iof_base_module_t prte_iof_hnp_module = {
     .close = hnp_close,
     .complete = hnp_complete,
     .finalize = finalize,
-    .push_stdin = push_stdin
+    .push_stdin = push_stdin,
+    .stdin_wait = stdin_wait
 };
 
+static void segcon(prte_iof_hnp_segment_t *p)
+{
+    p->data = NULL;
+    p->numbytes = 0;
+}
+static void segdes(prte_iof_hnp_segment_t *p)
+{
+    if (NULL != p->data) {
+        free(p->data);
+    }
+}
+PMIX_CLASS_INSTANCE(prte_iof_hnp_segment_t, pmix_list_item_t, segcon, segdes);
+
+static void wcon(prte_iof_hnp_waiter_t *p)
+{
+    p->cbfunc = NULL;
+    p->cbdata = NULL;
+}
+PMIX_CLASS_INSTANCE(prte_iof_hnp_waiter_t, pmix_list_item_t, wcon, NULL);
+
 /* Initialize the module */
 static int init(void)
 {
@@ -100,8 +124,19 @@ static int init(void)
      */
     PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_IOF_HNP,
                   PRTE_RML_PERSISTENT, prte_iof_hnp_recv, NULL);
+    /* and our own copy of any stdin we broadcast */
+    PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_IOF_PROXY,
+                  PRTE_RML_PERSISTENT, prte_iof_hnp_stdin_recv, NULL);
 
     PMIX_CONSTRUCT(&prte_mca_iof_hnp_component.procs, pmix_list_t);
+    PMIX_CONSTRUCT(&prte_mca_iof_hnp_component.index, pmix_hash_table_t);
+    pmix_hash_table_init(&prte_mca_iof_hnp_component.index, 256);
+
+    prte_iof_base_stdin_construct(&prte_mca_iof_hnp_component.stdin_state);
+    prte_mca_iof_hnp_component.stdin_seq = 0;
+    prte_mca_iof_hnp_component.stdin_acked = 0;
+    PMIX_CONSTRUCT(&prte_mca_iof_hnp_component.stdin_held, pmix_list_t);
+    PMIX_CONSTRUCT(&prte_mca_iof_hnp_component.stdin_waiters, pmix_list_t);
 
     return PRTE_SUCCESS;
 }
@@ -118,24 +153,14 @@ static int hnp_push(const pmix_proc_t *dst_name, prte_iof_tag_t src_tag, int fd)
         return PRTE_SUCCESS;
     }
 
-    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                          "%s iof:hnp pushing fd %d for process %s",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), fd, PRTE_NAME_PRINT(dst_name)));
 
-    /* do we already have this process in our list? */
-    PMIX_LIST_FOREACH(proct, &prte_mca_iof_hnp_component.procs, prte_iof_proc_t)
-    {
-        if (PMIX_CHECK_PROCID(&proct->name, dst_name)) {
-            /* found it */
-            goto SETUP;
-        }
-    }
-    /* if we get here, then we don't yet have this proc in our list */
-    proct = PMIX_NEW(prte_iof_proc_t);
-    PMIX_XFER_PROCID(&proct->name, dst_name);
-    pmix_list_append(&prte_mca_iof_hnp_component.procs, &proct->super);
+    /* get the tracker for this process, creating it if necessary */
+    proct = prte_iof_base_proc_add(&prte_mca_iof_hnp_component.procs,
+                                   &prte_mca_iof_hnp_component.index, dst_name);
 
-SETUP:
     /* for stdout/stderr, set the file descriptor to non-blocking - do this before we setup
      * and activate the read event in case it fires right away
      */
@@ -175,6 +200,47 @@ SETUP:
     return PRTE_SUCCESS;
 }
 
+#define STDIN_WINDOW_OPEN                                                       \
+    (prte_mca_iof_hnp_component.stdin_seq - prte_mca_iof_hnp_component.stdin_acked \
+     < (uint64_t) prte_iof_base_stdin_window)
+
+static int stdin_send(const pmix_proc_t *target, unsigned char *data, int numbytes)
+{
+    uint64_t seq;
+    bool flush;
+
+    seq = ++prte_mca_iof_hnp_component.stdin_seq;
+    /* ask the daemons to report as soon as they have written the
+     * segment that fills the window so we are not left waiting on
+     * credit they are holding back */
+    flush = !STDIN_WINDOW_OPEN;
+    return prte_iof_hnp_send_stdin_segment(target, seq, flush, data, numbytes);
+}
+
+/* send one segment of wildcard stdin now if the window has room,
+ * otherwise hold a copy until the daemons have caught up */
+static int stdin_segment(const pmix_proc_t *target, uint8_t *data, int numbytes)
+{
+    prte_iof_hnp_segment_t *seg;
+
+    if (pmix_list_is_empty(&prte_mca_iof_hnp_component.stdin_held) && STDIN_WINDOW_OPEN) {
+        return stdin_send(target, data, numbytes);
+    }
+
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+                         "%s iof:hnp stdin window full - holding %d bytes",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), numbytes));
+    seg = PMIX_NEW(prte_iof_hnp_segment_t);
+    PMIX_XFER_PROCID(&seg->target, target);
+    if (0 < numbytes) {
+        seg->data = (unsigned char *) malloc(numbytes);
+        memcpy(seg->data, data, numbytes);
+    }
+    seg->numbytes = numbytes;
+    pmix_list_append(&prte_mca_iof_hnp_component.stdin_held, &seg->super);
+    return PRTE_SUCCESS;
+}
+
 /* Push data to stdin of a client process
  *
  * (a) a specific name, usually vpid=0; or
@@ -186,28 +252,34 @@ static int push_stdin(const pmix_proc_t *dst_name, uint8_t *data, size_t sz)
 {
     pmix_proc_t p;
     prte_iof_proc_t *proct;
-    int rc;
+    size_t offset = 0;
+    int rc, numbytes;
 
     /* don't do this if the dst vpid is invalid */
     if (PMIX_RANK_INVALID == dst_name->rank) {
         return PRTE_SUCCESS;
     }
 
-    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                          "%s iof:hnp pushing stdin to process %s (size %zu)",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(dst_name), sz));
 
     /* if I am the DVM master and this is a wildcard name, then we have to
-     * broadcast this to all daemons */
+     * broadcast this to all daemons - do so in segments the daemons
+     * can take in one piece. If the connection closed, sz will be zero
+     * and we send a single empty segment to close the procs' stdin */
     if (PMIX_RANK_WILDCARD == dst_name->rank) {
-        PMIX_LOAD_PROCID(&p, PRTE_PROC_MY_NAME->nspace, PMIX_RANK_WILDCARD);
-        rc = prte_iof_hnp_send_data_to_endpoint(&p, dst_name,
-                                                PRTE_IOF_STDIN,
-                                                data, sz);
-        if (PRTE_SUCCESS != rc) {
-            PRTE_ERROR_LOG(rc);
-            return rc;
-        }
+        do {
+            numbytes = (PRTE_IOF_BASE_MSG_MAX < sz - offset) ? PRTE_IOF_BASE_MSG_MAX
+                                                             : (int) (sz - offset);
+            rc = stdin_segment(dst_name, (0 == sz) ? NULL : &data[offset], numbytes);
+            if (PRTE_SUCCESS != rc) {
+                PRTE_ERROR_LOG(rc);
+                return rc;
+            }
+            offset += numbytes;
+        } while (offset < sz);
+        return PRTE_SUCCESS;
     }
 
     /* lookup the daemon hosting the target proc */
@@ -228,46 +300,94 @@ static int push_stdin(const pmix_proc_t *dst_name, uint8_t *data, size_t sz)
          * sent - this will tell the daemon to close
          * the fd for stdin to that proc
          */
-        rc = prte_iof_hnp_send_data_to_endpoint(&p, dst_name,
-                                                PRTE_IOF_STDIN,
-                                                data, sz);
-        if (PRTE_SUCCESS != rc) {
-            PRTE_ERROR_LOG(rc);
-        }
-        return rc;
+        do {
+            numbytes = (PRTE_IOF_BASE_MSG_MAX < sz - offset) ? PRTE_IOF_BASE_MSG_MAX
+                                                             : (int) (sz - offset);
+            rc = prte_iof_hnp_send_data_to_endpoint(&p, dst_name, PRTE_IOF_STDIN,
+                                                    (0 == sz) ? NULL : &data[offset],
+                                                    numbytes);
+            if (PRTE_SUCCESS != rc) {
+                PRTE_ERROR_LOG(rc);
+                return rc;
+            }
+            offset += numbytes;
+        } while (offset < sz);
+        return PRTE_SUCCESS;
     }
 
-    /* local proc - see if we have this process in our list */
-    PMIX_LIST_FOREACH(proct, &prte_mca_iof_hnp_component.procs, prte_iof_proc_t)
-    {
-        if (PMIX_CHECK_PROCID(&proct->name, dst_name)) {
-            /* did they direct that the data go to this proc? */
-            if (NULL == proct->stdinev) {
-                /* nope - ignore it */
-                continue;
-            }
+    /* local proc - see if we have this process */
+    proct = prte_iof_base_proc_find(&prte_mca_iof_hnp_component.index, dst_name);
+    /* did they direct that the data go to this proc? */
+    if (NULL == proct || NULL == proct->stdinev) {
+        /* nope - ignore it */
+        return PRTE_SUCCESS;
+    }
 
-            /* send the bytes down the pipe - we even send 0 byte events
-             * down the pipe so it forces out any preceding data before
-             * closing the output stream
-             */
-            if (NULL != proct->stdinev->wev) {
-                if (PRTE_IOF_MAX_INPUT_BUFFERS < prte_iof_base_write_output(&proct->name,
-                                                                            PRTE_IOF_STDIN, data, sz,
-                                                                            proct->stdinev->wev)) {
-                    /* getting too backed up - stop the read event for now if it is still active */
-
-                    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
-                                         "buffer backed up - holding"));
-                    return PRTE_ERR_OUT_OF_RESOURCE;
-                }
-            }
+    /* send the bytes down the pipe - we even send 0 byte events
+     * down the pipe so it forces out any preceding data before
+     * closing the output stream
+     */
+    if (NULL != proct->stdinev->wev) {
+        if (PRTE_IOF_MAX_INPUT_BUFFERS < prte_iof_base_write_output(&proct->name,
+                                                                    PRTE_IOF_STDIN, data, sz,
+                                                                    proct->stdinev->wev)) {
+            /* getting too backed up - stop the read event for now if it is still active */
+
+            PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+                                 "buffer backed up - holding"));
+            return PRTE_ERR_OUT_OF_RESOURCE;
         }
     }
 
     return PRTE_SUCCESS;
 }
 
+/* hold the completion of a stdin push while the window is full
+ * so the source of the data stops sending until we drain */
+static int stdin_wait(pmix_op_cbfunc_t cbfunc, void *cbdata)
+{
+    prte_iof_hnp_waiter_t *w;
+
+    if (pmix_list_is_empty(&prte_mca_iof_hnp_component.stdin_held) && STDIN_WINDOW_OPEN) {
+        return PRTE_OPERATION_SUCCEEDED;
+    }
+    w = PMIX_NEW(prte_iof_hnp_waiter_t);
+    w->cbfunc = cbfunc;
+    w->cbdata = cbdata;
+    pmix_list_append(&prte_mca_iof_hnp_component.stdin_waiters, &w->super);
+    return PRTE_SUCCESS;
+}
+
+/* collect the credit now held for the whole tree, send whatever
+ * that makes room for and release the pushes we held */
+void prte_iof_hnp_stdin_progress(void)
+{
+    prte_iof_hnp_segment_t *seg;
+    prte_iof_hnp_waiter_t *w;
+    uint64_t level;
+
+    level = prte_iof_base_stdin_level(&prte_mca_iof_hnp_component.stdin_state,
+                                      &prte_mca_iof_hnp_component.procs);
+    if (level > prte_mca_iof_hnp_component.stdin_acked) {
+        prte_mca_iof_hnp_component.stdin_acked = level;
+    }
+
+    while (STDIN_WINDOW_OPEN &&
+           NULL != (seg = (prte_iof_hnp_segment_t *)
+                              pmix_list_remove_first(&prte_mca_iof_hnp_component.stdin_held))) {
+        stdin_send(&seg->target, seg->data, seg->numbytes);
+        PMIX_RELEASE(seg);
+    }
+    if (!pmix_list_is_empty(&prte_mca_iof_hnp_component.stdin_held) || !STDIN_WINDOW_OPEN) {
+        return;
+    }
+    while (NULL != (w = (prte_iof_hnp_waiter_t *)
+                            pmix_list_remove_first(&prte_mca_iof_hnp_component.stdin_waiters))) {
+        w->cbfunc(PMIX_SUCCESS, w->cbdata);
+        PMIX_RELEASE(w);
+    }
+}
+
 /*
  * Since we are the HNP, the only "pull" call comes from a local
  * process so we can record the file descriptor for its stdin.
@@ -283,7 +403,7 @@ static int hnp_pull(const pmix_proc_t *dst_name, prte_iof_tag_t src_tag, int fd)
         return PRTE_ERR_NOT_SUPPORTED;
     }
 
-    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                          "%s iof:hnp pulling fd %d for process %s",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), fd, PRTE_NAME_PRINT(dst_name)));
 
@@ -298,20 +418,10 @@ static int hnp_pull(const pmix_proc_t *dst_name, prte_iof_tag_t src_tag, int fd)
         fcntl(fd, F_SETFL, flags);
     }
 
-    /* do we already have this process in our list? */
-    PMIX_LIST_FOREACH(proct, &prte_mca_iof_hnp_component.procs, prte_iof_proc_t)
-    {
-        if (PMIX_CHECK_PROCID(&proct->name, dst_name)) {
-            /* found it */
-            goto SETUP;
-        }
-    }
-    /* if we get here, then we don't yet have this proc in our list */
-    proct = PMIX_NEW(prte_iof_proc_t);
-    PMIX_XFER_PROCID(&proct->name, dst_name);
-    pmix_list_append(&prte_mca_iof_hnp_component.procs, &proct->super);
+    /* get the tracker for this process, creating it if necessary */
+    proct = prte_iof_base_proc_add(&prte_mca_iof_hnp_component.procs,
+                                   &prte_mca_iof_hnp_component.index, dst_name);
 
-SETUP:
     PRTE_IOF_SINK_DEFINE(&proct->stdinev, dst_name, fd, PRTE_IOF_STDIN, stdin_write_handler);
     PMIX_XFER_PROCID(&proct->stdinev->daemon, PRTE_PROC_MY_NAME);
     PRTE_IOF_SINK_ACTIVATE(proct->stdinev->wev);
@@ -327,39 +437,40 @@ static int hnp_close(const pmix_proc_t *peer, prte_iof_tag_t source_tag)
 {
     prte_iof_proc_t *proct;
 
-    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                          "%s iof:hnp closing connection to process %s",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(peer)));
 
-    PMIX_LIST_FOREACH(proct, &prte_mca_iof_hnp_component.procs, prte_iof_proc_t)
-    {
-        if (PMIX_CHECK_PROCID(&proct->name, peer)) {
-            if (PRTE_IOF_STDIN & source_tag) {
-                if (NULL != proct->stdinev) {
-                    PMIX_RELEASE(proct->stdinev);
-                }
-                proct->stdinev = NULL;
-            }
-            if ((PRTE_IOF_STDOUT & source_tag) || (PRTE_IOF_STDMERGE & source_tag)) {
-                if (NULL != proct->revstdout) {
-                    PMIX_RELEASE(proct->revstdout);
-                }
-                proct->revstdout = NULL;
-            }
-            if (PRTE_IOF_STDERR & source_tag) {
-                if (NULL != proct->revstderr) {
-                    PMIX_RELEASE(proct->revstderr);
-                }
-                proct->revstderr = NULL;
-            }
-            /* if we closed them all, then remove this proc */
-            if (NULL == proct->stdinev && NULL == proct->revstdout && NULL == proct->revstderr) {
-                pmix_list_remove_item(&prte_mca_iof_hnp_component.procs, &proct->super);
-                PMIX_RELEASE(proct);
-            }
-            break;
+    proct = prte_iof_base_proc_find(&prte_mca_iof_hnp_component.index, peer);
+    if (NULL == proct) {
+        return PRTE_SUCCESS;
+    }
+    if (PRTE_IOF_STDIN & source_tag) {
+        if (NULL != proct->stdinev) {
+            PMIX_RELEASE(proct->stdinev);
         }
+        proct->stdinev = NULL;
     }
+    if ((PRTE_IOF_STDOUT & source_tag) || (PRTE_IOF_STDMERGE & source_tag)) {
+        if (NULL != proct->revstdout) {
+            PMIX_RELEASE(proct->revstdout);
+        }
+        proct->revstdout = NULL;
+    }
+    if (PRTE_IOF_STDERR & source_tag) {
+        if (NULL != proct->revstderr) {
+            PMIX_RELEASE(proct->revstderr);
+        }
+        proct->revstderr = NULL;
+    }
+    /* if we closed them all, then remove this proc */
+    if (NULL == proct->stdinev && NULL == proct->revstdout && NULL == proct->revstderr) {
+        prte_iof_base_proc_remove(&prte_mca_iof_hnp_component.procs,
+                                  &prte_mca_iof_hnp_component.index, proct);
+        PMIX_RELEASE(proct);
+    }
+    /* a proc that was holding up the stdin window may be gone */
+    prte_iof_hnp_stdin_progress();
     return PRTE_SUCCESS;
 }
 
@@ -371,7 +482,8 @@ static void hnp_complete(const prte_job_t *jdata)
     PMIX_LIST_FOREACH_SAFE(proct, next, &prte_mca_iof_hnp_component.procs, prte_iof_proc_t)
     {
         if (PMIX_CHECK_NSPACE(jdata->nspace, proct->name.nspace)) {
-            pmix_list_remove_item(&prte_mca_iof_hnp_component.procs, &proct->super);
+            prte_iof_base_proc_remove(&prte_mca_iof_hnp_component.procs,
+                                      &prte_mca_iof_hnp_component.index, proct);
             if (NULL != proct->revstdout) {
                 PMIX_RELEASE(proct->revstdout);
             }
@@ -383,11 +495,25 @@ static void hnp_complete(const prte_job_t *jdata)
             PMIX_RELEASE(proct);
         }
     }
+    prte_iof_hnp_stdin_progress();
 }
 
 static int finalize(void)
 {
+    prte_iof_hnp_waiter_t *w;
+
+    PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_IOF_PROXY);
+    /* the held pushes will never drain - let their sources know */
+    while (NULL != (w = (prte_iof_hnp_waiter_t *)
+                            pmix_list_remove_first(&prte_mca_iof_hnp_component.stdin_waiters))) {
+        w->cbfunc(PMIX_ERR_IOF_FAILURE, w->cbdata);
+        PMIX_RELEASE(w);
+    }
     PMIX_DESTRUCT(&prte_mca_iof_hnp_component.procs);
+    PMIX_DESTRUCT(&prte_mca_iof_hnp_component.index);
+    prte_iof_base_stdin_destruct(&prte_mca_iof_hnp_component.stdin_state);
+    PMIX_LIST_DESTRUCT(&prte_mca_iof_hnp_component.stdin_held);
+    PMIX_LIST_DESTRUCT(&prte_mca_iof_hnp_component.stdin_waiters);
     return PRTE_SUCCESS;
 }
 
@@ -401,11 +527,12 @@ static void stdin_write_handler(int fd, short event, void *cbdata)
     pmix_list_item_t *item;
     prte_iof_write_output_t *output;
     int num_written, total_written = 0;
+    bool tracked = false;
     PRTE_HIDE_UNUSED_PARAMS(fd, event);
 
     PMIX_ACQUIRE_OBJECT(sink);
 
-    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                          "%s hnp:stdin:write:handler writing %d data to %d",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                          (int)pmix_list_get_size(&wev->outputs), wev->fd));
@@ -425,13 +552,13 @@ static void stdin_write_handler(int fd, short event, void *cbdata)
             /* this indicates we are to close the fd - there is
              * nothing to write
              */
-            PMIX_OUTPUT_VERBOSE((20, prte_iof_base_framework.framework_output,
+            PRTE_OUTPUT_VERBOSE((20, prte_iof_base_framework.framework_output,
                                  "%s iof:hnp closing fd %d on write event due to zero bytes output",
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), wev->fd));
             goto finish;
         }
         num_written = write(wev->fd, output->data, output->numbytes);
-        PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+        PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                              "%s hnp:stdin:write:handler wrote %d bytes",
                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), num_written));
         if (num_written < 0) {
@@ -447,13 +574,13 @@ static void stdin_write_handler(int fd, short event, void *cbdata)
              * error and abort
              */
             PMIX_RELEASE(output);
-            PMIX_OUTPUT_VERBOSE(
+            PRTE_OUTPUT_VERBOSE(
                 (20, prte_iof_base_framework.framework_output,
                  "%s iof:hnp closing fd %d on write event due to negative bytes written",
                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), wev->fd));
             goto finish;
         } else if (num_written < output->numbytes) {
-            PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+            PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                                  "%s hnp:stdin:write:handler incomplete write %d - adjusting data",
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), num_written));
             /* incomplete write - adjust data to avoid duplicate output */
@@ -465,6 +592,9 @@ static void stdin_write_handler(int fd, short event, void *cbdata)
              */
             goto re_enter;
         }
+        if (0 < output->seq) {
+            tracked = true;
+        }
         PMIX_RELEASE(output);
 
         total_written += num_written;
@@ -482,10 +612,15 @@ check:
         /* the sink has already been closed and everything was written, time to release it */
         PMIX_RELEASE(sink);
     }
+    if (tracked) {
+        /* we wrote some wildcard stdin - see if that returns credit */
+        prte_iof_hnp_stdin_progress();
+    }
     return;
 
 finish:
     PMIX_RELEASE(wev);
     sink->wev = NULL;
+    prte_iof_hnp_stdin_progress();
     return;
 }
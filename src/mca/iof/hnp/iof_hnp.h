@@ -64,15 +64,40 @@ BEGIN_C_DECLS
 struct prte_mca_iof_hnp_component_t {
     prte_iof_base_component_t super;
     pmix_list_t procs;
+    pmix_hash_table_t index;
     prte_event_t stdinsig;
+    /* wildcard stdin window */
+    prte_iof_stdin_state_t stdin_state;
+    uint64_t stdin_seq;         // last segment sent
+    uint64_t stdin_acked;       // credited by the whole routing tree
+    pmix_list_t stdin_held;     // prte_iof_hnp_segment_t waiting for the window
+    pmix_list_t stdin_waiters;  // prte_iof_hnp_waiter_t pushes held until it drains
 };
 typedef struct prte_mca_iof_hnp_component_t prte_mca_iof_hnp_component_t;
 
+typedef struct {
+    pmix_list_item_t super;
+    pmix_proc_t target;
+    unsigned char *data;
+    int numbytes;
+} prte_iof_hnp_segment_t;
+PMIX_CLASS_DECLARATION(prte_iof_hnp_segment_t);
+
+typedef struct {
+    pmix_list_item_t super;
+    pmix_op_cbfunc_t cbfunc;
+    void *cbdata;
+} prte_iof_hnp_waiter_t;
+PMIX_CLASS_DECLARATION(prte_iof_hnp_waiter_t);
+
 PRTE_MODULE_EXPORT extern prte_mca_iof_hnp_component_t prte_mca_iof_hnp_component;
 extern prte_iof_base_module_t prte_iof_hnp_module;
 
 void prte_iof_hnp_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
                        prte_rml_tag_t tag, void *cbdata);
+void prte_iof_hnp_stdin_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
+                             prte_rml_tag_t tag, void *cbdata);
+void prte_iof_hnp_stdin_progress(void);
 
 void prte_iof_hnp_read_local_handler(int fd, short event, void *cbdata);
 void prte_iof_hnp_stdin_cb(int fd, short event, void *cbdata);
@@ -82,6 +107,8 @@ int prte_iof_hnp_send_data_to_endpoint(const pmix_proc_t *host,
                                        const pmix_proc_t *target,
                                        prte_iof_tag_t tag,
                                        unsigned char *data, int numbytes);
+int prte_iof_hnp_send_stdin_segment(const pmix_proc_t *target, uint64_t seq, bool flush,
+                                    unsigned char *data, int numbytes);
 
 END_C_DECLS
 
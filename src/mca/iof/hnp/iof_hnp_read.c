@@ -43,6 +43,7 @@
 #include "src/runtime/prte_wait.h"
 #include "src/threads/pmix_threads.h"
 #include "src/util/name_fns.h"
+#include "src/util/output.h"
 
 #include "src/mca/iof/base/base.h"
 #include "src/mca/iof/iof.h"
@@ -86,7 +87,7 @@ void prte_iof_hnp_read_local_handler(int fd, short event, void *cbdata)
     memset(data, 0, PRTE_IOF_BASE_MSG_MAX);
     numbytes = read(fd, data, sizeof(data));
 
-    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                          "%s read %d bytes from %s of %s",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), numbytes,
                          (PRTE_IOF_STDOUT & rev->tag) ? "stdout"
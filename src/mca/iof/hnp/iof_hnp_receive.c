@@ -47,6 +47,7 @@
 #include "src/runtime/prte_globals.h"
 #include "src/threads/pmix_threads.h"
 #include "src/util/name_fns.h"
+#include "src/util/output.h"
 
 #include "src/mca/iof/base/base.h"
 #include "src/mca/iof/iof.h"
@@ -72,13 +73,12 @@ void prte_iof_hnp_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buff
     prte_iof_tag_t stream;
     int32_t count, numbytes;
     int rc;
-    prte_iof_proc_t *proct;
     pmix_iof_channel_t pchan;
     prte_iof_deliver_t *p;
     pmix_status_t prc;
     PRTE_HIDE_UNUSED_PARAMS(status, tag, cbdata);
 
-    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                          "%s received IOF msg from proc %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                          PRTE_NAME_PRINT(sender)));
 
@@ -90,6 +90,15 @@ void prte_iof_hnp_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buff
         goto CLEAN_RETURN;
     }
 
+    /* a daemon returning credit for the stdin it has written */
+    if (PRTE_IOF_CREDIT == stream) {
+        if (PRTE_SUCCESS == prte_iof_base_stdin_credit(&prte_mca_iof_hnp_component.stdin_state,
+                                                       sender->rank, buffer)) {
+            prte_iof_hnp_stdin_progress();
+        }
+        goto CLEAN_RETURN;
+    }
+
     /* get name of the process whose io we are discussing */
     count = 1;
     rc = PMIx_Data_unpack(NULL, buffer, &origin, &count, PMIX_PROC);
@@ -98,7 +107,7 @@ void prte_iof_hnp_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buff
         goto CLEAN_RETURN;
     }
 
-    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                          "%s received IOF cmd for source %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                          PRTE_NAME_PRINT(&origin)));
 
@@ -124,25 +133,14 @@ void prte_iof_hnp_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buff
     }
     p->bo.size = numbytes;
 
-    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                          "%s unpacked %d bytes from remote proc %s",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), numbytes, PRTE_NAME_PRINT(&origin)));
 
-    /* do we already have this process in our list? */
-    PMIX_LIST_FOREACH(proct, &prte_mca_iof_hnp_component.procs, prte_iof_proc_t)
-    {
-        if (PMIX_CHECK_PROCID(&proct->name, &origin)) {
-            /* found it */
-            goto NSTEP;
-        }
-    }
-
-    /* if we get here, then we don't yet have this proc in our list */
-    proct = PMIX_NEW(prte_iof_proc_t);
-    PMIX_XFER_PROCID(&proct->name, &origin);
-    pmix_list_append(&prte_mca_iof_hnp_component.procs, &proct->super);
+    /* make sure we are tracking this process */
+    (void) prte_iof_base_proc_add(&prte_mca_iof_hnp_component.procs,
+                                  &prte_mca_iof_hnp_component.index, &origin);
 
-NSTEP:
     pchan = 0;
     if (PRTE_IOF_STDOUT & stream) {
         pchan |= PMIX_FWD_STDOUT_CHANNEL;
@@ -163,3 +161,38 @@ NSTEP:
 CLEAN_RETURN:
     return;
 }
+
+/* our own copy of the wildcard stdin we broadcast - deliver it to
+ * any local procs just as the daemons do */
+void prte_iof_hnp_stdin_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
+                             prte_rml_tag_t tag, void *cbdata)
+{
+    prte_iof_tag_t stream;
+    pmix_proc_t target;
+    int32_t count;
+    int rc;
+    PRTE_HIDE_UNUSED_PARAMS(status, sender, tag, cbdata);
+
+    count = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &stream, &count, PMIX_UINT16);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    if (PRTE_IOF_STDIN != stream) {
+        PRTE_ERROR_LOG(PRTE_ERR_COMM_FAILURE);
+        return;
+    }
+    count = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &target, &count, PMIX_PROC);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+
+    if (PRTE_SUCCESS == prte_iof_base_stdin_segment(&prte_mca_iof_hnp_component.stdin_state,
+                                                    &prte_mca_iof_hnp_component.procs,
+                                                    &target, buffer)) {
+        prte_iof_hnp_stdin_progress();
+    }
+}
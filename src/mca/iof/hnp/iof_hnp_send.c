@@ -36,6 +36,7 @@
 #include "src/pmix/pmix-internal.h"
 #include "src/runtime/prte_globals.h"
 #include "src/util/name_fns.h"
+#include "src/util/output.h"
 
 #include "src/mca/iof/base/base.h"
 #include "src/mca/iof/iof.h"
@@ -49,7 +50,6 @@ int prte_iof_hnp_send_data_to_endpoint(const pmix_proc_t *host,
 {
     pmix_data_buffer_t *buf;
     int rc;
-    prte_grpcomm_signature_t sig;
 
     /* if the host is a daemon and we are in the process of aborting,
      * then ignore this request. We leave it alone if the host is not
@@ -92,19 +92,6 @@ int prte_iof_hnp_send_data_to_endpoint(const pmix_proc_t *host,
         return rc;
     }
 
-    /* if the target is wildcard, then this needs to go to everyone - xcast it */
-    if (PMIX_CHECK_NSPACE(PRTE_PROC_MY_NAME->nspace, host->nspace)
-        && PMIX_RANK_WILDCARD == host->rank) {
-        /* xcast this to everyone - the local daemons will know how to handle it */
-        PMIX_PROC_CREATE(sig.signature, 1);
-        sig.sz = 1;
-        PMIX_LOAD_PROCID(&sig.signature[0], PRTE_PROC_MY_NAME->nspace, PMIX_RANK_WILDCARD);
-        (void) prte_grpcomm.xcast(&sig, PRTE_RML_TAG_IOF_PROXY, buf);
-        PMIX_DATA_BUFFER_RELEASE(buf);
-        PMIX_PROC_FREE(sig.signature, 1);
-        return PRTE_SUCCESS;
-    }
-
     /* send the buffer to the host - this is either a daemon or
      * a tool that requested IOF
      */
@@ -117,3 +104,65 @@ int prte_iof_hnp_send_data_to_endpoint(const pmix_proc_t *host,
 
     return PRTE_SUCCESS;
 }
+
+/* broadcast one segment of wildcard stdin down the routing tree */
+int prte_iof_hnp_send_stdin_segment(const pmix_proc_t *target, uint64_t seq, bool flush,
+                                    unsigned char *data, int numbytes)
+{
+    pmix_data_buffer_t *buf;
+    prte_iof_tag_t tag = PRTE_IOF_STDIN;
+    prte_grpcomm_signature_t sig;
+    int rc;
+
+    if (prte_dvm_abort_ordered) {
+        return PRTE_SUCCESS;
+    }
+
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+                         "%s iof:hnp sending stdin segment %lu (%d bytes) for %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (unsigned long) seq, numbytes,
+                         PRTE_NAME_PRINT(target)));
+
+    PMIX_DATA_BUFFER_CREATE(buf);
+    rc = PMIx_Data_pack(NULL, buf, &tag, 1, PMIX_UINT16);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        return rc;
+    }
+    rc = PMIx_Data_pack(NULL, buf, (void*)target, 1, PMIX_PROC);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        return rc;
+    }
+    rc = PMIx_Data_pack(NULL, buf, &seq, 1, PMIX_UINT64);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        return rc;
+    }
+    rc = PMIx_Data_pack(NULL, buf, &flush, 1, PMIX_BOOL);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        return rc;
+    }
+    /* pack the data - if numbytes is zero, we will pack zero bytes */
+    rc = PMIx_Data_pack(NULL, buf, data, numbytes, PMIX_BYTE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        return rc;
+    }
+
+    /* xcast this to everyone, including ourselves - the daemons
+     * will know how to handle it */
+    PMIX_PROC_CREATE(sig.signature, 1);
+    sig.sz = 1;
+    PMIX_LOAD_PROCID(&sig.signature[0], PRTE_PROC_MY_NAME->nspace, PMIX_RANK_WILDCARD);
+    rc = prte_grpcomm.xcast(&sig, PRTE_RML_TAG_IOF_PROXY, buf);
+    PMIX_DATA_BUFFER_RELEASE(buf);
+    PMIX_PROC_FREE(sig.signature, 1);
+    return rc;
+}
@@ -159,6 +159,14 @@ typedef int (*prte_iof_base_close_fn_t)(const pmix_proc_t *peer, prte_iof_tag_t
 
 typedef int (*prte_iof_base_push_stdin_fn_t)(const pmix_proc_t *dst_name, uint8_t *data, size_t sz);
 
+/**
+ * Hold the completion of a stdin push until the stdin window has
+ * drained. Returns PRTE_SUCCESS if cbfunc will be called later, or
+ * PRTE_OPERATION_SUCCEEDED if there is room and the caller should
+ * complete the operation itself. Optional - may be NULL.
+ */
+typedef int (*prte_iof_base_stdin_wait_fn_t)(pmix_op_cbfunc_t cbfunc, void *cbdata);
+
 /* Flag that a job is complete */
 typedef void (*prte_iof_base_complete_fn_t)(const prte_job_t *jdata);
 
@@ -176,6 +184,7 @@ struct prte_iof_base_module_2_0_0_t {
     prte_iof_base_complete_fn_t complete;
     prte_iof_base_finalize_fn_t finalize;
     prte_iof_base_push_stdin_fn_t push_stdin;
+    prte_iof_base_stdin_wait_fn_t stdin_wait;
 };
 
 typedef struct prte_iof_base_module_2_0_0_t prte_iof_base_module_2_0_0_t;
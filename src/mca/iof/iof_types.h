@@ -46,6 +46,8 @@ typedef uint16_t prte_iof_tag_t;
 /* flow control flags */
 #define PRTE_IOF_XON  0x1000
 #define PRTE_IOF_XOFF 0x2000
+/* stdin credit returned up the routing tree */
+#define PRTE_IOF_CREDIT 0x0200
 /* tool requests */
 #define PRTE_IOF_PULL  0x4000
 #define PRTE_IOF_CLOSE 0x8000
@@ -27,6 +27,7 @@
 #include "prte_config.h"
 #include "constants.h"
 #include "src/util/pmix_output.h"
+#include "src/util/output.h"
 
 #include <errno.h>
 #ifdef HAVE_UNISTD_H
@@ -99,7 +100,10 @@ static int init(void)
 
     /* setup the local global variables */
     PMIX_CONSTRUCT(&prte_mca_iof_prted_component.procs, pmix_list_t);
+    PMIX_CONSTRUCT(&prte_mca_iof_prted_component.index, pmix_hash_table_t);
+    pmix_hash_table_init(&prte_mca_iof_prted_component.index, 256);
     prte_mca_iof_prted_component.xoff = false;
+    prte_iof_base_stdin_construct(&prte_mca_iof_prted_component.stdin_state);
 
     return PRTE_SUCCESS;
 }
@@ -114,8 +118,9 @@ static int prted_push(const pmix_proc_t *dst_name, prte_iof_tag_t src_tag, int f
     int flags;
     prte_iof_proc_t *proct;
     prte_job_t *jobdat = NULL;
+    bool created = false, nocopy = false, *fptr = &nocopy;
 
-    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                          "%s iof:prted pushing fd %d for process %s",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), fd, PRTE_NAME_PRINT(dst_name)));
 
@@ -130,25 +135,28 @@ static int prted_push(const pmix_proc_t *dst_name, prte_iof_tag_t src_tag, int f
         fcntl(fd, F_SETFL, flags);
     }
 
-    /* do we already have this process in our list? */
-    PMIX_LIST_FOREACH(proct, &prte_mca_iof_prted_component.procs, prte_iof_proc_t)
-    {
-        if (PMIX_CHECK_PROCID(&proct->name, dst_name)) {
-            /* found it */
-            goto SETUP;
-        }
+    /* do we already have this process? */
+    proct = prte_iof_base_proc_find(&prte_mca_iof_prted_component.index, dst_name);
+    if (NULL == proct) {
+        proct = prte_iof_base_proc_add(&prte_mca_iof_prted_component.procs,
+                                       &prte_mca_iof_prted_component.index, dst_name);
+        created = true;
     }
-    /* if we get here, then we don't yet have this proc in our list */
-    proct = PMIX_NEW(prte_iof_proc_t);
-    PMIX_XFER_PROCID(&proct->name, dst_name);
-    pmix_list_append(&prte_mca_iof_prted_component.procs, &proct->super);
 
-SETUP:
     /* get the local jobdata for this proc */
     if (NULL == (jobdat = prte_get_job_data_object(proct->name.nspace))) {
         PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
         return PRTE_ERR_NOT_FOUND;
     }
+    /* if the output is only going to files, then the PMIx server
+     * here writes it and there is no reason to send it up the tree */
+    if (created && prte_iof_base_local_file_output &&
+        prte_get_attribute(&jobdat->attributes, PRTE_JOB_OUTPUT_NOCOPY, (void **) &fptr, PMIX_BOOL) &&
+        nocopy &&
+        (prte_get_attribute(&jobdat->attributes, PRTE_JOB_OUTPUT_TO_FILE, NULL, PMIX_STRING) ||
+         prte_get_attribute(&jobdat->attributes, PRTE_JOB_OUTPUT_TO_DIRECTORY, NULL, PMIX_STRING))) {
+        proct->local_only = true;
+    }
     /* define a read event and activate it */
     if (src_tag & PRTE_IOF_STDOUT) {
         PRTE_IOF_READ_EVENT(&proct->revstdout, proct, fd, PRTE_IOF_STDOUT,
@@ -189,7 +197,6 @@ SETUP:
 static int prted_pull(const pmix_proc_t *dst_name, prte_iof_tag_t src_tag, int fd)
 {
     prte_iof_proc_t *proct;
-    prte_ns_cmp_bitmask_t mask = PRTE_NS_CMP_ALL;
     int flags;
 
     /* this is a local call - only stdin is suppprted */
@@ -197,7 +204,7 @@ static int prted_pull(const pmix_proc_t *dst_name, prte_iof_tag_t src_tag, int f
         return PRTE_ERR_NOT_SUPPORTED;
     }
 
-    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                          "%s iof:prted pulling fd %d for process %s",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), fd, PRTE_NAME_PRINT(dst_name)));
 
@@ -212,20 +219,10 @@ static int prted_pull(const pmix_proc_t *dst_name, prte_iof_tag_t src_tag, int f
         fcntl(fd, F_SETFL, flags);
     }
 
-    /* do we already have this process in our list? */
-    PMIX_LIST_FOREACH(proct, &prte_mca_iof_prted_component.procs, prte_iof_proc_t)
-    {
-        if (PRTE_EQUAL == prte_util_compare_name_fields(mask, &proct->name, dst_name)) {
-            /* found it */
-            goto SETUP;
-        }
-    }
-    /* if we get here, then we don't yet have this proc in our list */
-    proct = PMIX_NEW(prte_iof_proc_t);
-    PMIX_XFER_PROCID(&proct->name, dst_name);
-    pmix_list_append(&prte_mca_iof_prted_component.procs, &proct->super);
+    /* get the tracker for this process, creating it if necessary */
+    proct = prte_iof_base_proc_add(&prte_mca_iof_prted_component.procs,
+                                   &prte_mca_iof_prted_component.index, dst_name);
 
-SETUP:
     PRTE_IOF_SINK_DEFINE(&proct->stdinev, dst_name, fd, PRTE_IOF_STDIN, stdin_write_handler);
 
     return PRTE_SUCCESS;
@@ -240,35 +237,36 @@ static int prted_close(const pmix_proc_t *peer, prte_iof_tag_t source_tag)
 {
     prte_iof_proc_t *proct;
 
-    PMIX_LIST_FOREACH(proct, &prte_mca_iof_prted_component.procs, prte_iof_proc_t)
-    {
-        if (PMIX_CHECK_PROCID(&proct->name, peer)) {
-            if (PRTE_IOF_STDIN & source_tag) {
-                if (NULL != proct->stdinev) {
-                    PMIX_RELEASE(proct->stdinev);
-                }
-                proct->stdinev = NULL;
-            }
-            if ((PRTE_IOF_STDOUT & source_tag) || (PRTE_IOF_STDMERGE & source_tag)) {
-                if (NULL != proct->revstdout) {
-                    PMIX_RELEASE(proct->revstdout);
-                }
-                proct->revstdout = NULL;
-            }
-            if (PRTE_IOF_STDERR & source_tag) {
-                if (NULL != proct->revstderr) {
-                    PMIX_RELEASE(proct->revstderr);
-                }
-                proct->revstderr = NULL;
-            }
-            /* if we closed them all, then remove this proc */
-            if (NULL == proct->stdinev && NULL == proct->revstdout && NULL == proct->revstderr) {
-                pmix_list_remove_item(&prte_mca_iof_prted_component.procs, &proct->super);
-                PMIX_RELEASE(proct);
-            }
-            break;
+    proct = prte_iof_base_proc_find(&prte_mca_iof_prted_component.index, peer);
+    if (NULL == proct) {
+        return PRTE_SUCCESS;
+    }
+    if (PRTE_IOF_STDIN & source_tag) {
+        if (NULL != proct->stdinev) {
+            PMIX_RELEASE(proct->stdinev);
         }
+        proct->stdinev = NULL;
     }
+    if ((PRTE_IOF_STDOUT & source_tag) || (PRTE_IOF_STDMERGE & source_tag)) {
+        if (NULL != proct->revstdout) {
+            PMIX_RELEASE(proct->revstdout);
+        }
+        proct->revstdout = NULL;
+    }
+    if (PRTE_IOF_STDERR & source_tag) {
+        if (NULL != proct->revstderr) {
+            PMIX_RELEASE(proct->revstderr);
+        }
+        proct->revstderr = NULL;
+    }
+    /* if we closed them all, then remove this proc */
+    if (NULL == proct->stdinev && NULL == proct->revstdout && NULL == proct->revstderr) {
+        prte_iof_base_proc_remove(&prte_mca_iof_prted_component.procs,
+                                  &prte_mca_iof_prted_component.index, proct);
+        PMIX_RELEASE(proct);
+    }
+    /* a proc that was holding up our stdin credit may be gone */
+    prte_iof_prted_stdin_progress();
 
     return PRTE_SUCCESS;
 }
@@ -281,15 +279,19 @@ static void prted_complete(const prte_job_t *jdata)
     PMIX_LIST_FOREACH_SAFE(proct, next, &prte_mca_iof_prted_component.procs, prte_iof_proc_t)
     {
         if (PMIX_CHECK_NSPACE(jdata->nspace, proct->name.nspace)) {
-            pmix_list_remove_item(&prte_mca_iof_prted_component.procs, &proct->super);
+            prte_iof_base_proc_remove(&prte_mca_iof_prted_component.procs,
+                                      &prte_mca_iof_prted_component.index, proct);
             PMIX_RELEASE(proct);
         }
     }
+    prte_iof_prted_stdin_progress();
 }
 
 static int finalize(void)
 {
     PMIX_LIST_DESTRUCT(&prte_mca_iof_prted_component.procs);
+    PMIX_DESTRUCT(&prte_mca_iof_prted_component.index);
+    prte_iof_base_stdin_destruct(&prte_mca_iof_prted_component.stdin_state);
 
     /* Cancel the RML receive */
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_IOF_PROXY);
@@ -303,11 +305,12 @@ static void stdin_write_handler(int _fd, short event, void *cbdata)
     pmix_list_item_t *item;
     prte_iof_write_output_t *output;
     int num_written;
+    bool tracked = false;
     PRTE_HIDE_UNUSED_PARAMS(_fd, event);
 
     PMIX_ACQUIRE_OBJECT(sink);
 
-    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                          "%s prted:stdin:write:handler writing data to %d",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), wev->fd));
 
@@ -319,16 +322,17 @@ static void stdin_write_handler(int _fd, short event, void *cbdata)
             /* this indicates we are to close the fd - there is
              * nothing to write
              */
-            PMIX_OUTPUT_VERBOSE(
+            PRTE_OUTPUT_VERBOSE(
                 (20, prte_iof_base_framework.framework_output,
                  "%s iof:prted closing fd %d on write event due to zero bytes output",
                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), wev->fd));
             PMIX_RELEASE(wev);
             sink->wev = NULL;
+            prte_iof_prted_stdin_progress();
             return;
         }
         num_written = write(wev->fd, output->data, output->numbytes);
-        PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+        PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                              "%s prted:stdin:write:handler wrote %d bytes",
                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), num_written));
         if (num_written < 0) {
@@ -345,7 +349,7 @@ static void stdin_write_handler(int _fd, short event, void *cbdata)
              * error and abort
              */
             PMIX_RELEASE(output);
-            PMIX_OUTPUT_VERBOSE(
+            PRTE_OUTPUT_VERBOSE(
                 (20, prte_iof_base_framework.framework_output,
                  "%s iof:prted closing fd %d on write event due to negative bytes written",
                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), wev->fd));
@@ -356,9 +360,10 @@ static void stdin_write_handler(int _fd, short event, void *cbdata)
                 prte_mca_iof_prted_component.xoff = true;
                 prte_iof_prted_send_xonxoff(PRTE_IOF_XOFF);
             }
+            prte_iof_prted_stdin_progress();
             return;
         } else if (num_written < output->numbytes) {
-            PMIX_OUTPUT_VERBOSE(
+            PRTE_OUTPUT_VERBOSE(
                 (1, prte_iof_base_framework.framework_output,
                  "%s prted:stdin:write:handler incomplete write %d - adjusting data",
                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), num_written));
@@ -372,10 +377,17 @@ static void stdin_write_handler(int _fd, short event, void *cbdata)
             PRTE_IOF_SINK_ACTIVATE(wev);
             goto CHECK;
         }
+        if (0 < output->seq) {
+            tracked = true;
+        }
         PMIX_RELEASE(output);
     }
 
 CHECK:
+    if (tracked) {
+        /* we wrote some wildcard stdin - see if that returns credit */
+        prte_iof_prted_stdin_progress();
+    }
     if (prte_mca_iof_prted_component.xoff) {
         /* if we have told the HNP to stop reading stdin, see if
          * the proc has absorbed enough to justify restart
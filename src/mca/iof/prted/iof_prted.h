@@ -52,8 +52,10 @@
 
 #include "prte_config.h"
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
 
+#include "src/mca/iof/base/base.h"
 #include "src/mca/iof/iof.h"
 #include "src/rml/rml_types.h"
 
@@ -65,7 +67,9 @@ BEGIN_C_DECLS
 struct prte_mca_iof_prted_component_t {
     prte_iof_base_component_t super;
     pmix_list_t procs;
+    pmix_hash_table_t index;
     bool xoff;
+    prte_iof_stdin_state_t stdin_state;
 };
 typedef struct prte_mca_iof_prted_component_t prte_mca_iof_prted_component_t;
 
@@ -77,6 +81,7 @@ void prte_iof_prted_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *bu
 
 void prte_iof_prted_read_handler(int fd, short event, void *data);
 void prte_iof_prted_send_xonxoff(prte_iof_tag_t tag);
+void prte_iof_prted_stdin_progress(void);
 
 END_C_DECLS
 
@@ -39,6 +39,7 @@
 #include "src/runtime/prte_globals.h"
 #include "src/threads/pmix_threads.h"
 #include "src/util/name_fns.h"
+#include "src/util/output.h"
 
 #include "src/mca/iof/base/base.h"
 #include "src/mca/iof/iof.h"
@@ -80,7 +81,7 @@ void prte_iof_prted_read_handler(int fd, short event, void *cbdata)
     /* read up to the fragment size */
     numbytes = read(fd, data, sizeof(data));
 
-    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                          "%s read %d bytes from %s of %s",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), numbytes,
                          (PRTE_IOF_STDOUT & rev->tag) ? "stdout"
@@ -129,6 +130,12 @@ void prte_iof_prted_read_handler(int fd, short event, void *cbdata)
         PMIX_RELEASE(p);
     }
 
+    if (proct->local_only) {
+        /* nobody upstream needs it */
+        PRTE_IOF_READ_ACTIVATE(rev);
+        return;
+    }
+
     /* prep the buffer */
     PMIX_DATA_BUFFER_CREATE(buf);
 
@@ -163,7 +170,7 @@ void prte_iof_prted_read_handler(int fd, short event, void *cbdata)
     }
 
     /* start non-blocking RML call to forward received data */
-    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                          "%s iof:prted:read handler sending %d bytes to HNP",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), numbytes));
 
@@ -38,6 +38,7 @@
 #include "src/rml/rml.h"
 #include "src/runtime/prte_globals.h"
 #include "src/util/name_fns.h"
+#include "src/util/output.h"
 
 #include "src/mca/iof/base/base.h"
 #include "src/mca/iof/iof_types.h"
@@ -61,7 +62,7 @@ void prte_iof_prted_send_xonxoff(prte_iof_tag_t tag)
         return;
     }
 
-    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output, "%s sending %s",
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output, "%s sending %s",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                          (PRTE_IOF_XON == tag) ? "xon" : "xoff"));
 
@@ -73,13 +74,22 @@ void prte_iof_prted_send_xonxoff(prte_iof_tag_t tag)
     }
 }
 
+/* return whatever stdin credit we now hold to our parent */
+void prte_iof_prted_stdin_progress(void)
+{
+    prte_iof_base_stdin_report(&prte_mca_iof_prted_component.stdin_state,
+                               &prte_mca_iof_prted_component.procs);
+}
+
 /*
  * The only messages coming to an prted are either:
  *
  * (a) stdin, which is to be copied to whichever local
  *     procs "pull'd" a copy
  *
- * (b) flow control messages
+ * (b) stdin credit returned by our children in the routing tree
+ *
+ * (c) flow control messages
  */
 void prte_iof_prted_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
                          prte_rml_tag_t tag, void *cbdata)
@@ -90,7 +100,7 @@ void prte_iof_prted_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *bu
     pmix_proc_t target;
     prte_iof_proc_t *proct;
     int rc;
-    PRTE_HIDE_UNUSED_PARAMS(status, sender, tag, cbdata);
+    PRTE_HIDE_UNUSED_PARAMS(status, tag, cbdata);
 
     /* see what stream generated this data */
     count = 1;
@@ -100,6 +110,15 @@ void prte_iof_prted_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *bu
         return;
     }
 
+    /* one of our children returning stdin credit */
+    if (PRTE_IOF_CREDIT == stream) {
+        if (PRTE_SUCCESS == prte_iof_base_stdin_credit(&prte_mca_iof_prted_component.stdin_state,
+                                                       sender->rank, buffer)) {
+            prte_iof_prted_stdin_progress();
+        }
+        return;
+    }
+
     /* if this isn't stdin, then we have an error */
     if (PRTE_IOF_STDIN != stream) {
         PRTE_ERROR_LOG(PRTE_ERR_COMM_FAILURE);
@@ -114,6 +133,17 @@ void prte_iof_prted_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *bu
         return;
     }
 
+    /* stdin for all procs of a job comes down the routing tree in
+     * numbered segments - our credit paces the HNP */
+    if (PMIX_RANK_WILDCARD == target.rank) {
+        if (PRTE_SUCCESS == prte_iof_base_stdin_segment(&prte_mca_iof_prted_component.stdin_state,
+                                                        &prte_mca_iof_prted_component.procs,
+                                                        &target, buffer)) {
+            prte_iof_prted_stdin_progress();
+        }
+        return;
+    }
+
     /* unpack the data */
     numbytes = PRTE_IOF_BASE_MSG_MAX;
     rc = PMIx_Data_unpack(NULL, buffer, data, &numbytes, PMIX_BYTE);
@@ -123,40 +153,31 @@ void prte_iof_prted_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *bu
     }
     /* numbytes will contain the actual #bytes that were sent */
 
-    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                          "%s unpacked %d bytes for local proc %s",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), numbytes, PRTE_NAME_PRINT(&target)));
 
-    /* cycle through our list of procs */
-    PMIX_LIST_FOREACH(proct, &prte_mca_iof_prted_component.procs, prte_iof_proc_t)
-    {
-        /* is this intended for this jobid? */
-        if (PMIX_CHECK_NSPACE(target.nspace, proct->name.nspace)) {
-            /* yes - is this intended for all vpids or this vpid? */
-            if (PMIX_CHECK_RANK(target.rank, proct->name.rank)) {
-                PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
-                                     "%s writing data to local proc %s",
-                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                     PRTE_NAME_PRINT(&proct->name)));
-                if (NULL == proct->stdinev) {
-                    continue;
-                }
-                /* send the bytes down the pipe - we even send 0 byte events
-                 * down the pipe so it forces out any preceding data before
-                 * closing the output stream
-                 */
-                if (PRTE_IOF_MAX_INPUT_BUFFERS < prte_iof_base_write_output(&target, stream, data,
-                                                                            numbytes,
-                                                                            proct->stdinev->wev)) {
-                    /* getting too backed up - tell the HNP to hold off any more input if we
-                     * haven't already told it
-                     */
-                    if (!prte_mca_iof_prted_component.xoff) {
-                        prte_mca_iof_prted_component.xoff = true;
-                        prte_iof_prted_send_xonxoff(PRTE_IOF_XOFF);
-                    }
-                }
-            }
+    proct = prte_iof_base_proc_find(&prte_mca_iof_prted_component.index, &target);
+    if (NULL == proct || NULL == proct->stdinev) {
+        return;
+    }
+    PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+                         "%s writing data to local proc %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                         PRTE_NAME_PRINT(&proct->name)));
+    /* send the bytes down the pipe - we even send 0 byte events
+     * down the pipe so it forces out any preceding data before
+     * closing the output stream
+     */
+    if (PRTE_IOF_MAX_INPUT_BUFFERS < prte_iof_base_write_output(&target, stream, data,
+                                                                numbytes,
+                                                                proct->stdinev->wev)) {
+        /* getting too backed up - tell the HNP to hold off any more input if we
+         * haven't already told it
+         */
+        if (!prte_mca_iof_prted_component.xoff) {
+            prte_mca_iof_prted_component.xoff = true;
+            prte_iof_prted_send_xonxoff(PRTE_IOF_XOFF);
         }
     }
 }
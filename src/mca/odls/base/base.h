@@ -58,6 +58,7 @@ typedef struct {
     bool signal_direct_children_only;
     pmix_lock_t lock;
     char *exec_agent;
+    bool simulate_launch;
 } prte_odls_globals_t;
 
 PRTE_EXPORT extern prte_odls_globals_t prte_odls_globals;
@@ -45,6 +45,9 @@
 #include <pmix_server.h>
 #include <signal.h>
 #include <time.h>
+#ifdef HAVE_SYS_TIME_H
+#    include <sys/time.h>
+#endif
 
 #include "prte_stdint.h"
 #include "src/hwloc/hwloc-internal.h"
@@ -149,6 +152,33 @@ done:
     PRTE_PMIX_WAKEUP_THREAD(&cd->lock);
 }
 
+/* when the DVM was expanded using deltas, the daemons added for one
+ * session are only given the jobs of that session */
+static bool job_needed(prte_job_t *jdata, prte_job_t *jptr)
+{
+    if (!prte_util_nidmap_partial || NULL == jdata->session || NULL == jptr->session) {
+        return true;
+    }
+    return prte_sessions_related(jdata->session, jptr->session)
+           || prte_sessions_related(jptr->session, jdata->session);
+}
+
+static void mark_nodes(prte_job_t *jptr, pmix_bitmap_t *nodes)
+{
+    prte_node_t *node;
+    int n;
+
+    if (NULL == jptr->map) {
+        return;
+    }
+    for (n = 0; n < jptr->map->nodes->size; n++) {
+        node = (prte_node_t *) pmix_pointer_array_get_item(jptr->map->nodes, n);
+        if (NULL != node) {
+            pmix_bitmap_set_bit(nodes, node->index);
+        }
+    }
+}
+
 /* IT IS CRITICAL THAT ANY CHANGE IN THE ORDER OF THE INFO PACKED IN
  * THIS FUNCTION BE REFLECTED IN THE CONSTRUCT_CHILD_LIST PARSER BELOW
  */
@@ -171,6 +201,10 @@ int prte_odls_base_default_get_add_procs_data(pmix_data_buffer_t *buffer, pmix_n
     pmix_byte_object_t pbo;
     void *ilist, *mlist;
     pmix_data_array_t darray;
+    struct timeval start, stop;
+    size_t used;
+    pmix_bitmap_t nodes;
+    bool partial;
 
     /* get the job data pointer */
     if (NULL == (jdata = prte_get_job_data_object(job))) {
@@ -185,10 +219,38 @@ int prte_odls_base_default_get_add_procs_data(pmix_data_buffer_t *buffer, pmix_n
         return PRTE_SUCCESS;
     }
 
+    /* if some daemons hold only part of the node map, pass
+     * the nodes used by the jobs in this message */
+    partial = prte_util_nidmap_partial;
+    rc = PMIx_Data_pack(NULL, buffer, &partial, 1, PMIX_BOOL);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    if (partial) {
+        PMIX_CONSTRUCT(&nodes, pmix_bitmap_t);
+        pmix_bitmap_init(&nodes, prte_node_pool->size);
+        mark_nodes(jdata, &nodes);
+        if (prte_get_attribute(&jdata->attributes, PRTE_JOB_LAUNCHED_DAEMONS, NULL, PMIX_BOOL)) {
+            for (i = 1; i < prte_job_data->size; i++) {
+                jptr = pmix_pointer_array_get_item(prte_job_data, i);
+                if (NULL != jptr && jptr != jdata && job_needed(jdata, jptr)) {
+                    mark_nodes(jptr, &nodes);
+                }
+            }
+        }
+        rc = prte_util_nidmap_create_delta(prte_node_pool, &nodes, buffer);
+        PMIX_DESTRUCT(&nodes);
+        if (PRTE_SUCCESS != rc) {
+            return rc;
+        }
+    }
+
     /* we need to ensure that any new daemons get a complete
      * copy of all active jobs so the grpcomm collectives can
      * properly work should a proc from one of the other jobs
-     * interact with this one */
+     * interact with this one - limited to the jobs of this
+     * session if the DVM was expanded using deltas */
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_LAUNCHED_DAEMONS, NULL, PMIX_BOOL)) {
         flag = 1;
         rc = PMIx_Data_pack(NULL, buffer, &flag, 1, PMIX_INT8);
@@ -203,7 +265,7 @@ int prte_odls_base_default_get_add_procs_data(pmix_data_buffer_t *buffer, pmix_n
                 continue;
             }
             /* skip the one we are launching now */
-            if (jptr != jdata) {
+            if (jptr != jdata && job_needed(jdata, jptr)) {
                 PMIX_DATA_BUFFER_CONSTRUCT(&priorjob);
                 /* pack the job struct */
                 rc = prte_job_pack(&priorjob, jptr);
@@ -269,11 +331,22 @@ int prte_odls_base_default_get_add_procs_data(pmix_data_buffer_t *buffer, pmix_n
     }
 
     /* pack the job struct */
+    gettimeofday(&start, NULL);
+    used = buffer->bytes_used;
     rc = prte_job_pack(buffer, jdata);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         return rc;
     }
+    if (1 <= pmix_output_get_verbosity(prte_odls_base_framework.framework_output)) {
+        gettimeofday(&stop, NULL);
+        tmp = prte_pretty_print_timing(stop.tv_sec - start.tv_sec, stop.tv_usec - start.tv_usec);
+        pmix_output(0, "%s odls:pack job %s with %lu procs: %lu bytes in %s",
+                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_JOBID_PRINT(jdata->nspace),
+                    (unsigned long) jdata->num_procs,
+                    (unsigned long) (buffer->bytes_used - used), tmp);
+        free(tmp);
+    }
 
     /* assemble the node and proc map info */
     list = NULL;
@@ -407,6 +480,7 @@ int prte_odls_base_default_construct_child_list(pmix_data_buffer_t *buffer, pmix
     prte_proc_t *pptr, *dmn;
     prte_app_context_t *app;
     int8_t flag;
+    bool partial;
     prte_pmix_lock_t lock;
     pmix_info_t *info = NULL;
     size_t ninfo = 0;
@@ -416,6 +490,7 @@ int prte_odls_base_default_construct_child_list(pmix_data_buffer_t *buffer, pmix
     size_t m;
     pmix_envar_t envt;
     char *tmp;
+    struct timeval start, stop;
 
     PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
                          "%s odls:constructing child list", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
@@ -427,6 +502,22 @@ int prte_odls_base_default_construct_child_list(pmix_data_buffer_t *buffer, pmix
     daemons = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
     PRTE_PMIX_CONSTRUCT_LOCK(&lock);
 
+    /* see if we were given an update to the node map */
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &partial, &cnt, PMIX_BOOL);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        rc = prte_pmix_convert_status(rc);
+        goto REPORT_ERROR;
+    }
+    if (partial) {
+        rc = prte_util_decode_nidmap(buffer);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            goto REPORT_ERROR;
+        }
+    }
+
     /* unpack the flag to see if new daemons were launched */
     cnt = 1;
     rc = PMIx_Data_unpack(NULL, buffer, &flag, &cnt, PMIX_INT8);
@@ -554,11 +645,20 @@ int prte_odls_base_default_construct_child_list(pmix_data_buffer_t *buffer, pmix
 
 next:
     /* unpack the job we are to launch */
+    gettimeofday(&start, NULL);
     rc = prte_job_unpack(buffer, &jdata);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         goto REPORT_ERROR;
     }
+    if (1 <= pmix_output_get_verbosity(prte_odls_base_framework.framework_output)) {
+        gettimeofday(&stop, NULL);
+        tmp = prte_pretty_print_timing(stop.tv_sec - start.tv_sec, stop.tv_usec - start.tv_usec);
+        pmix_output(0, "%s odls:unpack job %s with %lu procs in %s",
+                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_JOBID_PRINT(jdata->nspace),
+                    (unsigned long) jdata->num_procs, tmp);
+        free(tmp);
+    }
     if (PMIX_NSPACE_INVALID(jdata->nspace)) {
         PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
         rc = PRTE_ERR_BAD_PARAM;
@@ -1096,6 +1196,33 @@ void prte_odls_base_spawn_proc(int fd, short sd, void *cbdata)
         free(output);
     }
 
+    if (prte_odls_globals.simulate_launch) {
+        /* pretend the child was started and immediately exited normally.
+         * Closing the child's ends of the pipes lets the IOF see EOF and
+         * complete just as it would for a real process */
+        if (cd->opts.connect_stdin) {
+            close(cd->opts.p_stdin[0]);
+        }
+        close(cd->opts.p_stdout[1]);
+        close(cd->opts.p_stderr[1]);
+        if (!PRTE_FLAG_TEST(jobdat, PRTE_JOB_FLAG_FORWARD_OUTPUT)) {
+            /* the IOF was not given our ends of the pipes
+             * to close, so do it ourselves */
+            if (cd->opts.connect_stdin) {
+                close(cd->opts.p_stdin[1]);
+            }
+            close(cd->opts.p_stdout[0]);
+            close(cd->opts.p_stderr[0]);
+        }
+        PRTE_FLAG_SET(child, PRTE_PROC_FLAG_ALIVE);
+        PRTE_ACTIVATE_PROC_STATE(&child->name, PRTE_PROC_STATE_RUNNING);
+        PRTE_FLAG_SET(child, PRTE_PROC_FLAG_WAITPID);
+        prte_wait_cb_cancel(child);
+        PRTE_ACTIVATE_PROC_STATE(&child->name, PRTE_PROC_STATE_WAITPID_FIRED);
+        PMIX_RELEASE(cd);
+        return;
+    }
+
     if (PRTE_SUCCESS != (rc = cd->fork_local(cd))) {
         /* error message already output */
         state = PRTE_PROC_STATE_FAILED_TO_START;
@@ -79,7 +79,8 @@ prte_odls_globals_t prte_odls_globals = {
     .next_base = 0,
     .signal_direct_children_only = false,
     .lock = PMIX_LOCK_STATIC_INIT,
-    .exec_agent = NULL
+    .exec_agent = NULL,
+    .simulate_launch = false
 };
 
 static prte_event_base_t **prte_event_base_ptr = NULL;
@@ -119,6 +120,15 @@ static int prte_odls_base_register(pmix_mca_base_register_flag_t flags)
                                       PMIX_MCA_BASE_VAR_TYPE_STRING,
                                       &prte_odls_globals.exec_agent);
 
+    prte_odls_globals.simulate_launch = false;
+    (void) pmix_mca_base_var_register("prte", "odls", "base", "simulate_launch",
+                                      "Do not actually start application procs - report each as "
+                                      "having started and exited normally. Used with "
+                                      "ras_base_multiplier to exercise the launch and termination "
+                                      "paths of large simulated clusters",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &prte_odls_globals.simulate_launch);
+
     return PRTE_SUCCESS;
 }
 
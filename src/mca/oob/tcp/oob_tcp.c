@@ -53,6 +53,7 @@
 #include "src/util/pmix_if.h"
 #include "src/util/pmix_net.h"
 #include "src/util/pmix_output.h"
+#include "src/util/output.h"
 #include "src/util/pmix_show_help.h"
 
 #include "src/mca/errmgr/errmgr.h"
@@ -91,7 +92,7 @@ static void recv_handler(int sd, short flags, void *user);
  */
 static void accept_connection(const int accepted_fd, const struct sockaddr *addr)
 {
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s accept_connection: %s:%d\n", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         pmix_net_get_hostname(addr), pmix_net_get_port(addr));
 
@@ -109,7 +110,7 @@ static void ping(const pmix_proc_t *proc)
 {
     prte_oob_tcp_peer_t *peer;
 
-    pmix_output_verbose(2, prte_oob_base_framework.framework_output,
+    prte_output_verbose(2, prte_oob_base_framework.framework_output,
                         "%s:[%s:%d] processing ping to peer %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         __FILE__, __LINE__, PRTE_NAME_PRINT(proc));
 
@@ -120,7 +121,7 @@ static void ping(const pmix_proc_t *proc)
          * module can be found, the component can push back
          * to the framework so another component can try
          */
-        pmix_output_verbose(2, prte_oob_base_framework.framework_output,
+        prte_output_verbose(2, prte_oob_base_framework.framework_output,
                             "%s:[%s:%d] hop %s unknown", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                             __FILE__, __LINE__, PRTE_NAME_PRINT(proc));
         PRTE_ACTIVATE_TCP_MSG_ERROR(NULL, NULL, proc, prte_mca_oob_tcp_component_hop_unknown);
@@ -129,7 +130,7 @@ static void ping(const pmix_proc_t *proc)
 
     /* if we are already connected, there is nothing to do */
     if (MCA_OOB_TCP_CONNECTED == peer->state) {
-        pmix_output_verbose(2, prte_oob_base_framework.framework_output,
+        prte_output_verbose(2, prte_oob_base_framework.framework_output,
                             "%s:[%s:%d] already connected to peer %s",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), __FILE__, __LINE__,
                             PRTE_NAME_PRINT(proc));
@@ -138,7 +139,7 @@ static void ping(const pmix_proc_t *proc)
 
     /* if we are already connecting, there is nothing to do */
     if (MCA_OOB_TCP_CONNECTING == peer->state || MCA_OOB_TCP_CONNECT_ACK == peer->state) {
-        pmix_output_verbose(2, prte_oob_base_framework.framework_output,
+        prte_output_verbose(2, prte_oob_base_framework.framework_output,
                             "%s:[%s:%d] already connecting to peer %s",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), __FILE__, __LINE__,
                             PRTE_NAME_PRINT(proc));
@@ -173,7 +174,7 @@ static void send_nb(prte_rml_send_t *msg)
          * module can be found, the component can push back
          * to the framework so another component can try
          */
-        pmix_output_verbose(2, prte_oob_base_framework.framework_output,
+        prte_output_verbose(2, prte_oob_base_framework.framework_output,
                             "%s:[%s:%d] processing send to peer %s:%d seq_num = %d hop %s unknown",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), __FILE__, __LINE__,
                             PRTE_NAME_PRINT(&msg->dst), msg->tag, msg->seq_num,
@@ -183,7 +184,7 @@ static void send_nb(prte_rml_send_t *msg)
     }
 
 send:
-    pmix_output_verbose(2, prte_oob_base_framework.framework_output,
+    prte_output_verbose(2, prte_oob_base_framework.framework_output,
                         "%s:[%s:%d] processing send to peer %s:%d seq_num = %d via %s",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), __FILE__, __LINE__,
                         PRTE_NAME_PRINT(&msg->dst), msg->tag, msg->seq_num,
@@ -191,7 +192,7 @@ send:
 
     /* add the msg to the hop's send queue */
     if (MCA_OOB_TCP_CONNECTED == peer->state) {
-        pmix_output_verbose(2, prte_oob_base_framework.framework_output,
+        prte_output_verbose(2, prte_oob_base_framework.framework_output,
                             "%s tcp:send_nb: already connected to %s - queueing for send",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name));
         MCA_OOB_TCP_QUEUE_SEND(msg, peer);
@@ -209,7 +210,7 @@ send:
          * So throw us into an event that will create
          * the connection via a mini-state-machine :-)
          */
-        pmix_output_verbose(2, prte_oob_base_framework.framework_output,
+        prte_output_verbose(2, prte_oob_base_framework.framework_output,
                             "%s tcp:send_nb: initiating connection to %s",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name));
         peer->state = MCA_OOB_TCP_CONNECTING;
@@ -234,7 +235,7 @@ static void recv_handler(int sd, short flg, void *cbdata)
 
     PMIX_ACQUIRE_OBJECT(op);
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s:tcp:recv:handler called", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
 
     /* get the handshake */
@@ -64,6 +64,7 @@
 #    define MIN(a, b) ((a) < (b) ? (a) : (b))
 #endif
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
 #include "src/event/event-internal.h"
 #include "src/include/prte_socket_errno.h"
@@ -73,10 +74,12 @@
 #include "src/util/error.h"
 #include "src/util/pmix_net.h"
 #include "src/util/pmix_output.h"
+#include "src/util/output.h"
 #include "src/util/pmix_show_help.h"
 
 #include "src/mca/errmgr/errmgr.h"
 #include "src/mca/ess/ess.h"
+#include "src/mca/prtereachable/prtereachable.h"
 #include "src/rml/rml.h"
 #include "src/mca/state/state.h"
 #include "src/runtime/prte_globals.h"
@@ -159,6 +162,9 @@ static int tcp_component_open(void)
     prte_mca_oob_tcp_component.if_masks = NULL;
 
     PMIX_CONSTRUCT(&prte_mca_oob_tcp_component.local_ifs, pmix_list_t);
+    PMIX_CONSTRUCT(&prte_mca_oob_tcp_component.reachable, pmix_hash_table_t);
+    pmix_hash_table_init(&prte_mca_oob_tcp_component.reachable, 16);
+    prte_mca_oob_tcp_component.rail_load = NULL;
     return PRTE_SUCCESS;
 }
 
@@ -167,6 +173,23 @@ static int tcp_component_open(void)
  */
 static int tcp_component_close(void)
 {
+    prte_reachable_t *results;
+    void *key, *nptr;
+    size_t keysize;
+    int rc;
+
+    rc = pmix_hash_table_get_first_key_ptr(&prte_mca_oob_tcp_component.reachable, &key, &keysize,
+                                           (void **) &results, &nptr);
+    while (PMIX_SUCCESS == rc) {
+        PMIX_RELEASE(results);
+        rc = pmix_hash_table_get_next_key_ptr(&prte_mca_oob_tcp_component.reachable, &key,
+                                              &keysize, (void **) &results, nptr, &nptr);
+    }
+    PMIX_DESTRUCT(&prte_mca_oob_tcp_component.reachable);
+    if (NULL != prte_mca_oob_tcp_component.rail_load) {
+        free(prte_mca_oob_tcp_component.rail_load);
+        prte_mca_oob_tcp_component.rail_load = NULL;
+    }
     PMIX_LIST_DESTRUCT(&prte_mca_oob_tcp_component.local_ifs);
     PMIX_LIST_DESTRUCT(&prte_mca_oob_tcp_component.peers);
 
@@ -383,6 +406,30 @@ static int tcp_component_register(void)
                                                 PMIX_MCA_BASE_VAR_TYPE_INT,
                                                 &prte_mca_oob_tcp_component.max_recon_attempts);
 
+    prte_mca_oob_tcp_component.reachable_cache = true;
+    (void) pmix_mca_base_component_var_register(component, "reachable_cache",
+                                                "Reuse the reachability computed for a peer for any other peer "
+                                                "whose interfaces lie on the same set of subnets - only used "
+                                                "with the weighted prtereachable component",
+                                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                                &prte_mca_oob_tcp_component.reachable_cache);
+
+    prte_mca_oob_tcp_component.multirail = false;
+    (void) pmix_mca_base_component_var_register(component, "multirail",
+                                                "When several local interfaces reach a peer equally well, connect "
+                                                "through the one carrying the fewest peers so that traffic such as "
+                                                "file prepositioning is spread across all rails",
+                                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                                &prte_mca_oob_tcp_component.multirail);
+
+    prte_mca_oob_tcp_component.checksum = false;
+    (void) pmix_mca_base_component_var_register(component, "checksum",
+                                                "Send a CRC32C of each message payload so the receiver can "
+                                                "detect corruption in transit - checksums are verified "
+                                                "whenever a peer sends one, regardless of this setting",
+                                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                                &prte_mca_oob_tcp_component.checksum);
+
     return PRTE_SUCCESS;
 }
 
@@ -397,7 +444,7 @@ static int component_available(void)
     int i;
     bool keeploopback = false;
 
-    pmix_output_verbose(5, prte_oob_base_framework.framework_output,
+    prte_output_verbose(5, prte_oob_base_framework.framework_output,
                         "oob:tcp: component_available called");
 
     /* if we are the master, then check the interfaces for loopbacks
@@ -436,7 +483,7 @@ static int component_available(void)
 
         /* add this address to our connections */
         if (AF_INET == my_ss.ss_family) {
-            pmix_output_verbose(10, prte_oob_base_framework.framework_output,
+            prte_output_verbose(10, prte_oob_base_framework.framework_output,
                                 "%s oob:tcp:init adding %s to our list of %s connections",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                 pmix_net_get_hostname((struct sockaddr *) &my_ss),
@@ -445,7 +492,7 @@ static int component_available(void)
                                     pmix_net_get_hostname((struct sockaddr *) &my_ss));
         } else if (AF_INET6 == my_ss.ss_family) {
 #if PRTE_ENABLE_IPV6
-            pmix_output_verbose(10, prte_oob_base_framework.framework_output,
+            prte_output_verbose(10, prte_oob_base_framework.framework_output,
                                 "%s oob:tcp:init adding %s to our list of %s connections",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                 pmix_net_get_hostname((struct sockaddr *) &my_ss),
@@ -454,7 +501,7 @@ static int component_available(void)
                                     pmix_net_get_hostname((struct sockaddr *) &my_ss));
 #endif // PRTE_ENABLE_IPV6
         } else {
-            pmix_output_verbose(10, prte_oob_base_framework.framework_output,
+            prte_output_verbose(10, prte_oob_base_framework.framework_output,
                                 "%s oob:tcp:init ignoring %s from out list of connections",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                 pmix_net_get_hostname((struct sockaddr *) &my_ss));
@@ -502,7 +549,7 @@ static int component_startup(void)
 {
     int rc = PRTE_SUCCESS;
 
-    pmix_output_verbose(2, prte_oob_base_framework.framework_output, "%s TCP STARTUP",
+    prte_output_verbose(2, prte_oob_base_framework.framework_output, "%s TCP STARTUP",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
 
     /* if we are a daemon/HNP,
@@ -524,7 +571,7 @@ static void component_shutdown(void)
 {
     int i = 0, rc;
 
-    pmix_output_verbose(2, prte_oob_base_framework.framework_output, "%s TCP SHUTDOWN",
+    prte_output_verbose(2, prte_oob_base_framework.framework_output, "%s TCP SHUTDOWN",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
 
     if (PRTE_PROC_IS_MASTER && prte_mca_oob_tcp_component.listen_thread_active) {
@@ -539,19 +586,19 @@ static void component_shutdown(void)
         close(prte_mca_oob_tcp_component.stop_thread[1]);
 
     } else {
-        pmix_output_verbose(2, prte_oob_base_framework.framework_output, "no hnp or not active");
+        prte_output_verbose(2, prte_oob_base_framework.framework_output, "no hnp or not active");
     }
 
     /* cleanup listen event list */
     PMIX_LIST_DESTRUCT(&prte_mca_oob_tcp_component.listeners);
 
-    pmix_output_verbose(2, prte_oob_base_framework.framework_output, "%s TCP SHUTDOWN done",
+    prte_output_verbose(2, prte_oob_base_framework.framework_output, "%s TCP SHUTDOWN done",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
 }
 
 static int component_send(prte_rml_send_t *msg)
 {
-    pmix_output_verbose(5, prte_oob_base_framework.framework_output,
+    prte_output_verbose(5, prte_oob_base_framework.framework_output,
                         "%s oob:tcp:send_nb to peer %s:%d seq = %d",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&msg->dst), msg->tag,
                         msg->seq_num);
@@ -672,7 +719,7 @@ static int component_set_addr(pmix_proc_t *peer, char **uris)
     for (i = 0; NULL != uris[i]; i++) {
         tcpuri = strdup(uris[i]);
         if (NULL == tcpuri) {
-            pmix_output_verbose(2, prte_oob_base_framework.framework_output,
+            prte_output_verbose(2, prte_oob_base_framework.framework_output,
                                 "%s oob:tcp: out of memory", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
             continue;
         }
@@ -685,7 +732,7 @@ static int component_set_addr(pmix_proc_t *peer, char **uris)
             host = tcpuri + strlen("tcp6://");
 #else  // PRTE_ENABLE_IPV6
             /* we don't support this connection type */
-            pmix_output_verbose(2, prte_oob_base_framework.framework_output,
+            prte_output_verbose(2, prte_oob_base_framework.framework_output,
                                 "%s oob:tcp: address %s not supported",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), uris[i]);
             free(tcpuri);
@@ -693,7 +740,7 @@ static int component_set_addr(pmix_proc_t *peer, char **uris)
 #endif // PRTE_ENABLE_IPV6
         } else {
             /* not one of ours */
-            pmix_output_verbose(2, prte_oob_base_framework.framework_output,
+            prte_output_verbose(2, prte_oob_base_framework.framework_output,
                                 "%s oob:tcp: ignoring address %s",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), uris[i]);
             free(tcpuri);
@@ -701,7 +748,7 @@ static int component_set_addr(pmix_proc_t *peer, char **uris)
         }
 
         /* this one is ours - record the peer */
-        pmix_output_verbose(2, prte_oob_base_framework.framework_output,
+        prte_output_verbose(2, prte_oob_base_framework.framework_output,
                             "%s oob:tcp: working peer %s address %s",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(peer), uris[i]);
 
@@ -748,7 +795,7 @@ static int component_set_addr(pmix_proc_t *peer, char **uris)
         for (j = 0; NULL != addrs[j]; j++) {
             if (NULL == masks[j]) {
                 /* Missing mask information */
-                pmix_output_verbose(2, prte_oob_base_framework.framework_output,
+                prte_output_verbose(2, prte_oob_base_framework.framework_output,
                                     "%s oob:tcp: uri missing mask information.",
                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
                 return PRTE_ERR_TAKE_NEXT_OPTION;
@@ -779,7 +826,7 @@ static int component_set_addr(pmix_proc_t *peer, char **uris)
             if (NULL == (pr = prte_oob_tcp_peer_lookup(peer))) {
                 pr = PMIX_NEW(prte_oob_tcp_peer_t);
                 PMIX_XFER_PROCID(&pr->name, peer);
-                pmix_output_verbose(20, prte_oob_base_framework.framework_output,
+                prte_output_verbose(20, prte_oob_base_framework.framework_output,
                                     "%s SET_PEER ADDING PEER %s",
                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(peer));
                 pmix_list_append(&prte_mca_oob_tcp_component.peers, &pr->super);
@@ -798,7 +845,7 @@ static int component_set_addr(pmix_proc_t *peer, char **uris)
             }
             maddr->if_mask = atoi(masks[j]);
 
-            pmix_output_verbose(20, prte_oob_base_framework.framework_output,
+            prte_output_verbose(20, prte_oob_base_framework.framework_output,
                                 "%s set_peer: peer %s is listening on net %s port %s",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(peer),
                                 (NULL == host) ? "NULL" : host, (NULL == ports) ? "NULL" : ports);
@@ -835,7 +882,7 @@ void prte_mca_oob_tcp_component_set_module(int fd, short args, void *cbdata)
 
     PMIX_ACQUIRE_OBJECT(pop);
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s tcp:set_module called for peer %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         PRTE_NAME_PRINT(&pop->peer));
 
@@ -863,7 +910,7 @@ void prte_mca_oob_tcp_component_lost_connection(int fd, short args, void *cbdata
 
     PMIX_ACQUIRE_OBJECT(pop);
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s tcp:lost connection called for peer %s",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&pop->peer));
 
@@ -894,7 +941,7 @@ void prte_mca_oob_tcp_component_no_route(int fd, short args, void *cbdata)
 
     PMIX_ACQUIRE_OBJECT(mop);
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s tcp:no route called for peer %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         PRTE_NAME_PRINT(&mop->hop));
 
@@ -927,7 +974,7 @@ void prte_mca_oob_tcp_component_hop_unknown(int fd, short args, void *cbdata)
 
     PMIX_ACQUIRE_OBJECT(mop);
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s tcp:unknown hop called for peer %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         PRTE_NAME_PRINT(&mop->hop));
 
@@ -1004,7 +1051,7 @@ void prte_mca_oob_tcp_component_failed_to_connect(int fd, short args, void *cbda
 
     PMIX_ACQUIRE_OBJECT(pop);
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s tcp:failed_to_connect called for peer %s",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&pop->peer));
 
@@ -1015,7 +1062,7 @@ void prte_mca_oob_tcp_component_failed_to_connect(int fd, short args, void *cbda
     }
 
     /* activate the proc state */
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s tcp:failed_to_connect unable to reach peer %s",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&pop->peer));
 
@@ -1032,6 +1079,7 @@ static void peer_cons(prte_oob_tcp_peer_t *peer)
     peer->sd = -1;
     PMIX_CONSTRUCT(&peer->addrs, pmix_list_t);
     peer->active_addr = NULL;
+    peer->rail = -1;
     peer->state = MCA_OOB_TCP_UNCONNECTED;
     peer->num_retries = 0;
     PMIX_CONSTRUCT(&peer->send_queue, pmix_list_t);
@@ -1056,7 +1104,7 @@ static void peer_des(prte_oob_tcp_peer_t *peer)
         prte_event_del(&peer->timer_event);
     }
     if (0 <= peer->sd) {
-        pmix_output_verbose(2, prte_oob_base_framework.framework_output, "%s CLOSING SOCKET %d",
+        prte_output_verbose(2, prte_oob_base_framework.framework_output, "%s CLOSING SOCKET %d",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), peer->sd);
         CLOSE_THE_SOCKET(peer->sd);
     }
@@ -37,6 +37,7 @@
 
 #include "src/include/prte_stdatomic.h"
 #include "src/class/pmix_bitmap.h"
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
 #include "src/class/pmix_pointer_array.h"
 #include "src/event/event-internal.h"
@@ -77,6 +78,11 @@ typedef struct {
     /* connection support */
     pmix_list_t local_ifs; /**< prte list of local pmix_pif_t interfaces */
     char **if_masks;
+    bool reachable_cache;         /**< memoize reachability by remote subnet signature */
+    pmix_hash_table_t reachable;  /**< cached reachability matrices */
+    bool multirail;               /**< spread peers across equally-weighted local interfaces */
+    int *rail_load;               /**< number of peers connected through each local interface */
+    bool checksum;                /**< send a CRC32C of each message payload for verification */
     char *my_uri;                /**< uri for connecting to the TCP module */
     int num_hnp_ports;           /**< number of ports the HNP should listen on */
     pmix_list_t listeners;       /**< List of sockets being monitored by event or thread */
@@ -63,6 +63,7 @@
 #include "src/util/pmix_if.h"
 #include "src/util/pmix_net.h"
 #include "src/util/pmix_output.h"
+#include "src/util/output.h"
 #include "src/util/pmix_show_help.h"
 #include "types.h"
 
@@ -100,7 +101,7 @@ static int tcp_peer_create_socket(prte_oob_tcp_peer_t *peer, sa_family_t family)
         return PRTE_SUCCESS;
     }
 
-    PMIX_OUTPUT_VERBOSE((1, prte_oob_base_framework.framework_output,
+    PRTE_OUTPUT_VERBOSE((1, prte_oob_base_framework.framework_output,
                          "%s oob:tcp:peer creating socket to %s",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name))));
     peer->sd = socket(family, SOCK_STREAM, 0);
@@ -143,6 +144,145 @@ static int tcp_peer_create_socket(prte_oob_tcp_peer_t *peer, sa_family_t family)
     return PRTE_SUCCESS;
 }
 
+/* reachability signature of one remote interface - the weight the
+ * "weighted" reachable component assigns depends only on the address
+ * family, whether the address is public, and whether it shares a
+ * subnet with one of our interfaces (the remote bandwidth we pass it
+ * is always 1), so under that component peers with the same signature
+ * share the same answer */
+typedef struct {
+    uint16_t af_family;
+    uint8_t prefix;
+    uint8_t pub;
+    uint8_t net[16];
+} tcp_reach_sig_t;
+
+static void tcp_reach_sig(tcp_reach_sig_t *sig, pmix_pif_t *intf, int prefix)
+{
+    struct sockaddr *sa = (struct sockaddr *) &intf->if_addr;
+    size_t len = 0, n;
+    int bits;
+
+    memset(sig, 0, sizeof(*sig));
+    sig->af_family = intf->af_family;
+    /* mask with the finer of the remote mask and any local mask
+     * so that a subnet test against either one gives the same result */
+    sig->prefix = (intf->if_mask < (uint32_t) prefix) ? prefix : intf->if_mask;
+    if (AF_INET == intf->af_family) {
+        len = sizeof(struct in_addr);
+        memcpy(sig->net, &((struct sockaddr_in *) sa)->sin_addr, len);
+        sig->pub = pmix_net_addr_isipv4public(sa);
+#if PRTE_ENABLE_IPV6
+    } else if (AF_INET6 == intf->af_family) {
+        len = sizeof(struct in6_addr);
+        memcpy(sig->net, &((struct sockaddr_in6 *) sa)->sin6_addr, len);
+        sig->pub = !pmix_net_addr_isipv6linklocal(sa);
+#endif
+    }
+    for (n = 0; n < len; n++) {
+        bits = sig->prefix - 8 * (int) n;
+        if (bits <= 0) {
+            sig->net[n] = 0;
+        } else if (bits < 8) {
+            sig->net[n] &= (uint8_t) (0xff << (8 - bits));
+        }
+    }
+}
+
+static prte_reachable_t *tcp_reach_copy(prte_reachable_t *src)
+{
+    prte_reachable_t *dst;
+    int i;
+
+    dst = prte_reachable_allocate(src->num_local, src->num_remote);
+    if (NULL == dst) {
+        return NULL;
+    }
+    for (i = 0; i < src->num_local; i++) {
+        memcpy(dst->weights[i], src->weights[i], src->num_remote * sizeof(int));
+    }
+    return dst;
+}
+
+/* compute the reachability between our interfaces and those of a
+ * peer, reusing the answer for any earlier peer on the same subnets.
+ * Our own interfaces never change, so the remote signature alone
+ * identifies the result - but only for the weighted component, as
+ * others (e.g., netlink) look at more than the address. The caller
+ * owns the returned matrix. */
+static prte_reachable_t *tcp_reachable(pmix_list_t *local_list, pmix_list_t *remote_list)
+{
+    tcp_reach_sig_t *sig;
+    prte_reachable_t *results, *cached;
+    pmix_pif_t *intf;
+    int prefix4 = 0, prefix6 = 0;
+    size_t n, nsig;
+
+    nsig = pmix_list_get_size(remote_list);
+    if (!prte_mca_oob_tcp_component.reachable_cache || 0 == nsig
+        || NULL == prte_reachable_base_selected_component
+        || 0 != strcmp(prte_reachable_base_selected_component->base_version.pmix_mca_component_name,
+                       "weighted")) {
+        return prte_reachable.reachable(local_list, remote_list);
+    }
+
+    PMIX_LIST_FOREACH(intf, local_list, pmix_pif_t)
+    {
+        if (AF_INET == intf->af_family && prefix4 < (int) intf->if_mask) {
+            prefix4 = intf->if_mask;
+        } else if (AF_INET6 == intf->af_family && prefix6 < (int) intf->if_mask) {
+            prefix6 = intf->if_mask;
+        }
+    }
+    sig = (tcp_reach_sig_t *) malloc(nsig * sizeof(tcp_reach_sig_t));
+    if (NULL == sig) {
+        return prte_reachable.reachable(local_list, remote_list);
+    }
+    n = 0;
+    PMIX_LIST_FOREACH(intf, remote_list, pmix_pif_t)
+    {
+        tcp_reach_sig(&sig[n++], intf, (AF_INET == intf->af_family) ? prefix4 : prefix6);
+    }
+
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&prte_mca_oob_tcp_component.reachable, sig,
+                                                      nsig * sizeof(tcp_reach_sig_t),
+                                                      (void **) &cached)) {
+        prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+                            "%s prte_tcp_peer_try_connect: reusing cached reachability",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
+        free(sig);
+        return tcp_reach_copy(cached);
+    }
+
+    results = prte_reachable.reachable(local_list, remote_list);
+    if (NULL != results) {
+        cached = tcp_reach_copy(results);
+        if (NULL != cached) {
+            pmix_hash_table_set_value_ptr(&prte_mca_oob_tcp_component.reachable, sig,
+                                          nsig * sizeof(tcp_reach_sig_t), cached);
+        }
+    }
+    free(sig);
+    return results;
+}
+
+/* track how many peers are bound to each local interface */
+static void tcp_peer_set_rail(prte_oob_tcp_peer_t *peer, int rail)
+{
+    int *load = prte_mca_oob_tcp_component.rail_load;
+
+    if (NULL == load) {
+        return;
+    }
+    if (0 <= peer->rail) {
+        --load[peer->rail];
+    }
+    peer->rail = rail;
+    if (0 <= rail) {
+        ++load[rail];
+    }
+}
+
 /*
  * Try connecting to a peer - cycle across all known addresses
  * until one succeeds.
@@ -195,15 +335,25 @@ void prte_oob_tcp_peer_try_connect(int fd, short args, void *cbdata)
     local_if_count = pmix_list_get_size(local_list);
     remote_if_count = pmix_list_get_size(remote_list);
 
-    results = prte_reachable.reachable(local_list, remote_list);
+    results = tcp_reachable(local_list, remote_list);
+    if (NULL == results) {
+        pmix_output(0, "%s CANNOT COMPUTE REACHABILITY, OUT OF MEMORY",
+                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
+        PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_COMM_FAILED);
+        goto cleanup;
+    }
+    if (prte_mca_oob_tcp_component.multirail &&
+        NULL == prte_mca_oob_tcp_component.rail_load) {
+        prte_mca_oob_tcp_component.rail_load = (int *) calloc(local_if_count, sizeof(int));
+    }
 
     /* Find match, bind socket. If connect attempt failed, move to next */
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s prte_tcp_peer_try_connect: "
                         "attempting to connect to proc %s",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)));
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s prte_tcp_peer_try_connect: "
                         "attempting to connect to proc %s on socket %d",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)),
@@ -216,12 +366,17 @@ void prte_oob_tcp_peer_try_connect(int fd, short args, void *cbdata)
     while (!connected) {
         /* Select the best connection. This is not going to be a large
          * table and should only run once in the normal case, so no sorting
-         * is attempted.
+         * is attempted. If we are spreading peers across rails, break
+         * ties in favor of the least loaded local interface.
          */
         best = 0;
         for (i = 0; i < local_if_count; i++) {
             for (j = 0; j < remote_if_count; j++) {
-                if (best < results->weights[i][j]) {
+                if (best < results->weights[i][j] ||
+                    (0 < best && best == results->weights[i][j] &&
+                     NULL != prte_mca_oob_tcp_component.rail_load &&
+                     prte_mca_oob_tcp_component.rail_load[i] <
+                     prte_mca_oob_tcp_component.rail_load[best_i])) {
                     best = results->weights[i][j];
                     best_i = i;
                     best_j = j;
@@ -251,14 +406,14 @@ void prte_oob_tcp_peer_try_connect(int fd, short args, void *cbdata)
             ptr = ptr->pmix_list_next;
         }
         intf = (pmix_pif_t *) ptr;
-        pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+        prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                             "%s prte_tcp_peer_try_connect: "
                             "attempting to connect to proc %s on %s:%d - %d retries",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)),
                             pmix_net_get_hostname((struct sockaddr *) &addr->addr),
                             pmix_net_get_port((struct sockaddr *) &addr->addr), addr->retries);
         if (MCA_OOB_TCP_FAILED == addr->state) {
-            pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+            prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                                 "%s prte_tcp_peer_try_connect: %s:%d is down",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                 pmix_net_get_hostname((struct sockaddr *) &addr->addr),
@@ -266,7 +421,7 @@ void prte_oob_tcp_peer_try_connect(int fd, short args, void *cbdata)
             continue;
         }
         if (prte_mca_oob_tcp_component.max_retries < addr->retries) {
-            pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+            prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                                 "%s prte_tcp_peer_try_connect: %s:%d retries exceeded",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                 pmix_net_get_hostname((struct sockaddr *) &addr->addr),
@@ -324,6 +479,7 @@ void prte_oob_tcp_peer_try_connect(int fd, short args, void *cbdata)
             PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_COMM_FAILED);
             goto cleanup;
         }
+        tcp_peer_set_rail(peer, best_i);
 
     retry_connect:
         addr->retries++;
@@ -332,7 +488,7 @@ void prte_oob_tcp_peer_try_connect(int fd, short args, void *cbdata)
         if (rc < 0) {
             /* non-blocking so wait for completion */
             if (prte_socket_errno == EINPROGRESS || prte_socket_errno == EWOULDBLOCK) {
-                pmix_output_verbose(
+                prte_output_verbose(
                     OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                     "%s waiting for connect completion to %s - activating send event",
                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name));
@@ -353,7 +509,7 @@ void prte_oob_tcp_peer_try_connect(int fd, short args, void *cbdata)
              */
             if (ECONNABORTED == prte_socket_errno) {
                 if (addr->retries < prte_mca_oob_tcp_component.max_retries) {
-                    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT,
+                    prte_output_verbose(OOB_TCP_DEBUG_CONNECT,
                                         prte_oob_base_framework.framework_output,
                                         "%s connection aborted by OS to %s - retrying",
                                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
@@ -439,7 +595,7 @@ void prte_oob_tcp_peer_try_connect(int fd, short args, void *cbdata)
         goto cleanup;
     }
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s prte_tcp_peer_try_connect: "
                         "Connection to proc %s succeeded",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name));
@@ -484,7 +640,7 @@ cleanup:
     PMIX_RELEASE(op);
 out:
     if (NULL != results) {
-        free(results);
+        PMIX_RELEASE(results);
     }
     if (NULL != remote_list) {
         PMIX_RELEASE(remote_list);
@@ -502,7 +658,7 @@ static int tcp_peer_send_connect_ack(prte_oob_tcp_peer_t *peer)
     uint16_t ack_flag = htons(1);
     size_t sdsize, offset = 0;
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s SEND CONNECT ACK", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
 
     /* load the header */
@@ -511,6 +667,8 @@ static int tcp_peer_send_connect_ack(prte_oob_tcp_peer_t *peer)
     hdr.type = MCA_OOB_TCP_IDENT;
     hdr.tag = 0;
     hdr.seq_num = 0;
+    hdr.flags = 0;
+    hdr.csum = 0;
     memset(hdr.routed, 0, PRTE_MAX_RTD_SIZE + 1);
 
     /* payload size */
@@ -557,7 +715,7 @@ static int tcp_peer_send_connect_nack(int sd, pmix_proc_t *name)
     int rc = PRTE_SUCCESS;
     size_t sdsize, offset = 0;
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s SEND CONNECT NACK", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
 
     /* load the header */
@@ -566,6 +724,8 @@ static int tcp_peer_send_connect_nack(int sd, pmix_proc_t *name)
     hdr.type = MCA_OOB_TCP_IDENT;
     hdr.tag = 0;
     hdr.seq_num = 0;
+    hdr.flags = 0;
+    hdr.csum = 0;
     memset(hdr.routed, 0, PRTE_MAX_RTD_SIZE + 1);
 
     /* payload size */
@@ -630,7 +790,7 @@ void prte_oob_tcp_peer_complete_connect(prte_oob_tcp_peer_t *peer)
     int so_error = 0;
     prte_socklen_t so_length = sizeof(so_error);
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s:tcp:complete_connect called for peer %s on socket %d",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name), peer->sd);
 
@@ -645,12 +805,12 @@ void prte_oob_tcp_peer_complete_connect(prte_oob_tcp_peer_t *peer)
     }
 
     if (so_error == EINPROGRESS) {
-        pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+        prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                             "%s:tcp:send:handler still in progress",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
         return;
     } else if (so_error == ECONNREFUSED || so_error == ETIMEDOUT) {
-        pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+        prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                             "%s-%s tcp_peer_complete_connect: connection failed: %s (%d)",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)),
                             strerror(so_error), so_error);
@@ -660,7 +820,7 @@ void prte_oob_tcp_peer_complete_connect(prte_oob_tcp_peer_t *peer)
         /* No need to worry about the return code here - we return regardless
            at this point, and if an error did occur a message has already been
            printed for the user */
-        pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+        prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                             "%s-%s tcp_peer_complete_connect: "
                             "connection failed with error %d",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)),
@@ -669,14 +829,14 @@ void prte_oob_tcp_peer_complete_connect(prte_oob_tcp_peer_t *peer)
         return;
     }
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s tcp_peer_complete_connect: "
                         "sending ack to %s",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)));
 
     if (tcp_peer_send_connect_ack(peer) == PRTE_SUCCESS) {
         peer->state = MCA_OOB_TCP_CONNECT_ACK;
-        pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+        prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                             "%s tcp_peer_complete_connect: "
                             "setting read event on connection to %s",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)));
@@ -706,7 +866,7 @@ static int tcp_peer_send_blocking(int sd, void *data, size_t size)
 
     PMIX_ACQUIRE_OBJECT(ptr);
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s send blocking of %" PRIsize_t " bytes to socket %d",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), size, sd);
 
@@ -725,7 +885,7 @@ static int tcp_peer_send_blocking(int sd, void *data, size_t size)
         cnt += retval;
     }
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s blocking send complete to socket %d",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), sd);
 
@@ -741,7 +901,7 @@ static bool retry(prte_oob_tcp_peer_t *peer, int sd, bool fatal)
 {
     int cmpval;
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s SIMUL CONNECTION WITH %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         PRTE_NAME_PRINT(&peer->name));
     cmpval = prte_util_compare_name_fields(PRTE_NS_CMP_ALL, &peer->name, PRTE_PROC_MY_NAME);
@@ -800,7 +960,7 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t *pr, int sd, prte_oob
     uint16_t ack_flag;
     bool is_new = (NULL == pr);
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s RECV CONNECT ACK FROM %s ON SOCKET %d",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         (NULL == pr) ? "UNKNOWN" : PRTE_NAME_PRINT(&pr->name), sd);
@@ -823,14 +983,14 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t *pr, int sd, prte_oob
         }
     } else {
         /* unable to complete the recv */
-        pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+        prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                             "%s unable to complete recv of connect-ack from %s ON SOCKET %d",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                             (NULL == peer) ? "UNKNOWN" : PRTE_NAME_PRINT(&peer->name), sd);
         return PRTE_ERR_UNREACH;
     }
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s connect-ack recvd from %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         (NULL == peer) ? "UNKNOWN" : PRTE_NAME_PRINT(&peer->name));
 
@@ -867,7 +1027,7 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t *pr, int sd, prte_oob
     if (NULL == peer) {
         peer = prte_oob_tcp_peer_lookup(&hdr.origin);
         if (NULL == peer) {
-            pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+            prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                                 "%s prte_oob_tcp_recv_connect: connection from new peer",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
             peer = PMIX_NEW(prte_oob_tcp_peer_t);
@@ -889,7 +1049,7 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t *pr, int sd, prte_oob
         }
     }
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s connect-ack header from %s is okay", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         PRTE_NAME_PRINT(&peer->name));
 
@@ -901,7 +1061,7 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t *pr, int sd, prte_oob
     }
     if (!tcp_peer_recv_blocking(peer, sd, msg, hdr.nbytes)) {
         /* unable to complete the recv but should never happen */
-        pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+        prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                             "%s unable to complete recv of connect-ack from %s ON SOCKET %d",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name),
                             peer->sd);
@@ -986,7 +1146,7 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t *pr, int sd, prte_oob
     }
     free(msg);
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s connect-ack version from %s matches ours",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name));
 
@@ -1017,7 +1177,7 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t *pr, int sd, prte_oob
  */
 static void tcp_peer_connected(prte_oob_tcp_peer_t *peer)
 {
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s-%s tcp_peer_connected on socket %d", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         PRTE_NAME_PRINT(&(peer->name)), peer->sd);
 
@@ -1048,7 +1208,7 @@ static void tcp_peer_connected(prte_oob_tcp_peer_t *peer)
  */
 void prte_oob_tcp_peer_close(prte_oob_tcp_peer_t *peer)
 {
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s tcp_peer_close for %s sd %d state %s",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)),
                         peer->sd, prte_oob_tcp_state_print(peer->state));
@@ -1056,6 +1216,7 @@ void prte_oob_tcp_peer_close(prte_oob_tcp_peer_t *peer)
     /* release the socket */
     close(peer->sd);
     peer->sd = -1;
+    tcp_peer_set_rail(peer, -1);
 
     /* if we were CONNECTING, then we need to mark the address as
      * failed and cycle back to try the next address */
@@ -1115,7 +1276,7 @@ static bool tcp_peer_recv_blocking(prte_oob_tcp_peer_t *peer, int sd, void *data
     unsigned char *ptr = (unsigned char *) data;
     size_t cnt = 0;
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s waiting for connect ack from %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         (NULL == peer) ? "UNKNOWN" : PRTE_NAME_PRINT(&(peer->name)));
 
@@ -1124,7 +1285,7 @@ static bool tcp_peer_recv_blocking(prte_oob_tcp_peer_t *peer, int sd, void *data
 
         /* remote closed connection */
         if (retval == 0) {
-            pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+            prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                                 "%s-%s tcp_peer_recv_blocking: "
                                 "peer closed connection: peer state %d",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
@@ -1161,7 +1322,7 @@ static bool tcp_peer_recv_blocking(prte_oob_tcp_peer_t *peer, int sd, void *data
                        CONNECT_ACK and propogate the error up to
                        recv_connect_ack, who will try to establish the
                        connection again */
-                    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT,
+                    prte_output_verbose(OOB_TCP_DEBUG_CONNECT,
                                         prte_oob_base_framework.framework_output,
                                         "%s connect ack received error %s from %s",
                                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
@@ -1184,7 +1345,7 @@ static bool tcp_peer_recv_blocking(prte_oob_tcp_peer_t *peer, int sd, void *data
         cnt += retval;
     }
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s connect ack received from %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         (NULL == peer) ? "UNKNOWN" : PRTE_NAME_PRINT(&(peer->name)));
     return true;
@@ -1263,7 +1424,7 @@ void prte_oob_tcp_peer_dump(prte_oob_tcp_peer_t *peer, const char *msg)
 
 bool prte_oob_tcp_peer_accept(prte_oob_tcp_peer_t *peer)
 {
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s tcp:peer_accept called for peer %s in state %s on socket %d",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name),
                         prte_oob_tcp_state_print(peer->state), peer->sd);
@@ -1300,7 +1461,7 @@ bool prte_oob_tcp_peer_accept(prte_oob_tcp_peer_t *peer)
         return true;
     }
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s tcp:peer_accept ignored for peer %s in state %s on socket %d",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name),
                         prte_oob_tcp_state_print(peer->state), peer->sd);
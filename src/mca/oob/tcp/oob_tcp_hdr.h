@@ -44,6 +44,9 @@ typedef uint8_t prte_oob_tcp_msg_type_t;
 
 #define PRTE_MAX_RTD_SIZE 31
 
+/* header flags */
+#define MCA_OOB_TCP_FLAG_CSUM 0x01 /* csum holds the CRC32C of the payload */
+
 /* header for tcp msgs */
 typedef struct {
     /* the originator of the message - if we are routing,
@@ -65,6 +68,11 @@ typedef struct {
     uint32_t nbytes;
     /* type of message */
     prte_oob_tcp_msg_type_t type;
+    /* MCA_OOB_TCP_FLAG_* bits */
+    uint8_t flags;
+    /* CRC32C of the payload, if flagged - the receiver verifies
+     * it regardless of its own settings */
+    uint32_t csum;
     /* routed module to be used */
     char routed[PRTE_MAX_RTD_SIZE + 1];
 } prte_oob_tcp_hdr_t;
@@ -75,7 +83,8 @@ typedef struct {
     (h)->origin.rank = ntohl((h)->origin.rank); \
     (h)->dst.rank = ntohl((h)->dst.rank);       \
     (h)->tag = PRTE_RML_TAG_NTOH((h)->tag);     \
-    (h)->nbytes = ntohl((h)->nbytes);
+    (h)->nbytes = ntohl((h)->nbytes);           \
+    (h)->csum = ntohl((h)->csum);
 
 /**
  * Convert the message header to network byte order
@@ -84,6 +93,7 @@ typedef struct {
     (h)->origin.rank = htonl((h)->origin.rank); \
     (h)->dst.rank = htonl((h)->dst.rank);       \
     (h)->tag = PRTE_RML_TAG_HTON((h)->tag);     \
-    (h)->nbytes = htonl((h)->nbytes);
+    (h)->nbytes = htonl((h)->nbytes);           \
+    (h)->csum = htonl((h)->csum);
 
 #endif /* _MCA_OOB_TCP_HDR_H_ */
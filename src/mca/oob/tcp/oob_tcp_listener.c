@@ -58,6 +58,7 @@
 #include "src/util/pmix_if.h"
 #include "src/util/pmix_net.h"
 #include "src/util/pmix_output.h"
+#include "src/util/output.h"
 #include "src/util/pmix_show_help.h"
 
 #include "src/mca/errmgr/errmgr.h"
@@ -225,7 +226,7 @@ static int create_listen(void)
      * sockets to support more flexible wireup protocols
      */
     for (i = 0; i < PMIX_ARGV_COUNT_COMPAT(ports); i++) {
-        pmix_output_verbose(5, prte_oob_base_framework.framework_output,
+        prte_output_verbose(5, prte_oob_base_framework.framework_output,
                             "%s attempting to bind to IPv4 port %s",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), ports[i]);
         /* get the port number */
@@ -436,7 +437,7 @@ static int create_listen6(void)
      * sockets to support more flexible wireup protocols
      */
     for (i = 0; i < PMIX_ARGV_COUNT_COMPAT(ports); i++) {
-        pmix_output_verbose(5, prte_oob_base_framework.framework_output,
+        prte_output_verbose(5, prte_oob_base_framework.framework_output,
                             "%s attempting to bind to IPv6 port %s",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), ports[i]);
         /* get the port number */
@@ -677,7 +678,7 @@ static void *listen_thread(pmix_object_t *obj)
                     }
                 }
 
-                pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+                prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                                     "%s prte_oob_tcp_listen_thread: incoming connection: "
                                     "(%d, %d) %s:%d\n",
                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), pending_connection->fd,
@@ -725,7 +726,7 @@ done:
      * a separate connection harvesting thread. So switch over to the event
      * lib handler now
      */
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s prte_oob_tcp_listen_thread: switching to event lib",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
     /* setup to listen via event library */
@@ -753,7 +754,7 @@ static void connection_handler(int sd, short flags, void *cbdata)
 
     PMIX_ACQUIRE_OBJECT(new_connection);
 
-    pmix_output_verbose(4, prte_oob_base_framework.framework_output,
+    prte_output_verbose(4, prte_oob_base_framework.framework_output,
                         "%s connection_handler: working connection "
                         "(%d, %d) %s:%d\n",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), new_connection->fd, prte_socket_errno,
@@ -778,7 +779,7 @@ static void connection_event_handler(int incoming_sd, short flags, void *cbdata)
     PRTE_HIDE_UNUSED_PARAMS(flags, cbdata);
 
     sd = accept(incoming_sd, (struct sockaddr *) &addr, &addrlen);
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s connection_event_handler: working connection "
                         "(%d, %d) %s:%d\n",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), sd, prte_socket_errno,
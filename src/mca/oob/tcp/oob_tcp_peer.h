@@ -56,6 +56,7 @@ typedef struct {
     int sd;
     pmix_list_t addrs;
     prte_oob_tcp_addr_t *active_addr;
+    int rail; // index of the local interface we are bound to, -1 if untracked
     prte_oob_tcp_state_t state;
     int num_retries;
     prte_event_t send_event; /**< registration with event thread for send events */
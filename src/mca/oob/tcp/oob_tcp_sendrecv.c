@@ -58,9 +58,13 @@
 #include "prte_stdint.h"
 #include "src/event/event-internal.h"
 #include "src/mca/prtebacktrace/prtebacktrace.h"
+#include "src/util/crc.h"
 #include "src/util/error.h"
 #include "src/util/pmix_net.h"
 #include "src/util/pmix_output.h"
+#include "src/util/output.h"
+#include "src/util/pmix_show_help.h"
+#include "src/util/proc_info.h"
 #include "types.h"
 
 #include "src/mca/errmgr/errmgr.h"
@@ -205,14 +209,14 @@ void prte_oob_tcp_send_handler(int sd, short flags, void *cbdata)
     PMIX_ACQUIRE_OBJECT(peer);
     msg = peer->send_msg;
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s tcp:send_handler called to send to peer %s",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name));
 
     switch (peer->state) {
     case MCA_OOB_TCP_CONNECTING:
     case MCA_OOB_TCP_CLOSED:
-        pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+        prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                             "%s tcp:send_handler %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                             prte_oob_tcp_state_print(peer->state));
         prte_oob_tcp_peer_complete_connect(peer);
@@ -225,17 +229,17 @@ void prte_oob_tcp_send_handler(int sd, short flags, void *cbdata)
         }
         break;
     case MCA_OOB_TCP_CONNECTED:
-        pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+        prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                             "%s tcp:send_handler SENDING TO %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                             (NULL == peer->send_msg) ? "NULL" : PRTE_NAME_PRINT(&peer->name));
         if (NULL != msg) {
-            pmix_output_verbose(2, prte_oob_base_framework.framework_output,
+            prte_output_verbose(2, prte_oob_base_framework.framework_output,
                                 "oob:tcp:send_handler SENDING MSG");
             if (PRTE_SUCCESS == (rc = send_msg(peer, msg))) {
                 /* this msg is complete */
                 if (NULL != msg->data || NULL == msg->msg) {
                     /* the relay is complete - release the data */
-                    pmix_output_verbose(2, prte_oob_base_framework.framework_output,
+                    prte_output_verbose(2, prte_oob_base_framework.framework_output,
                                         "%s MESSAGE RELAY COMPLETE TO %s OF %d BYTES ON SOCKET %d",
                                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                         PRTE_NAME_PRINT(&(peer->name)),
@@ -244,7 +248,7 @@ void prte_oob_tcp_send_handler(int sd, short flags, void *cbdata)
                     peer->send_msg = NULL;
                 } else {
                     /* we are done - notify the RML */
-                    pmix_output_verbose(2, prte_oob_base_framework.framework_output,
+                    prte_output_verbose(2, prte_oob_base_framework.framework_output,
                                         "%s MESSAGE SEND COMPLETE TO %s OF %d BYTES ON SOCKET %d",
                                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                         PRTE_NAME_PRINT(&(peer->name)),
@@ -327,7 +331,7 @@ static int read_bytes(prte_oob_tcp_peer_t *peer)
              * the error back to the RML and let the caller know
              * to abort this message
              */
-            pmix_output_verbose(OOB_TCP_DEBUG_FAIL, prte_oob_base_framework.framework_output,
+            prte_output_verbose(OOB_TCP_DEBUG_FAIL, prte_oob_base_framework.framework_output,
                                 "%s-%s prte_oob_tcp_msg_recv: readv failed: %s (%d)",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)),
                                 strerror(prte_socket_errno), prte_socket_errno);
@@ -340,7 +344,7 @@ static int read_bytes(prte_oob_tcp_peer_t *peer)
             /* the remote peer closed the connection - report that condition
              * and let the caller know
              */
-            pmix_output_verbose(OOB_TCP_DEBUG_FAIL, prte_oob_base_framework.framework_output,
+            prte_output_verbose(OOB_TCP_DEBUG_FAIL, prte_oob_base_framework.framework_output,
                                 "%s-%s prte_oob_tcp_msg_recv: peer closed connection",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)));
             /* stop all events */
@@ -390,14 +394,14 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
 
     PMIX_ACQUIRE_OBJECT(peer);
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+    prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s:tcp:recv:handler called for peer %s",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name));
 
     switch (peer->state) {
     case MCA_OOB_TCP_CONNECT_ACK:
         if (PRTE_SUCCESS == (rc = prte_oob_tcp_peer_recv_connect_ack(peer, peer->sd, NULL))) {
-            pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+            prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                                 "%s:tcp:recv:handler starting send/recv events",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
             /* we connected! Start the send/recv events */
@@ -425,7 +429,7 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
             /* we get an unreachable error returned if a connection
              * completes but is rejected - otherwise, we don't want
              * to terminate as we might be retrying the connection */
-            pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+            prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                                 "%s UNABLE TO COMPLETE CONNECT ACK WITH %s",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name));
             prte_event_del(&peer->recv_event);
@@ -434,11 +438,11 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
         }
         break;
     case MCA_OOB_TCP_CONNECTED:
-        pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+        prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                             "%s:tcp:recv:handler CONNECTED", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
         /* allocate a new message and setup for recv */
         if (NULL == peer->recv_msg) {
-            pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+            prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                                 "%s:tcp:recv:handler allocate new recv msg",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
             peer->recv_msg = PMIX_NEW(prte_oob_tcp_recv_t);
@@ -454,7 +458,7 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
         }
         /* if the header hasn't been completely read, read it */
         if (!peer->recv_msg->hdr_recvd) {
-            pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+            prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                                 "%s:tcp:recv:handler read hdr", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
             if (PRTE_SUCCESS == (rc = read_bytes(peer))) {
                 /* completed reading the header */
@@ -463,14 +467,14 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
                 MCA_OOB_TCP_HDR_NTOH(&peer->recv_msg->hdr);
                 /* if this is a zero-byte message, then we are done */
                 if (0 == peer->recv_msg->hdr.nbytes) {
-                    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT,
+                    prte_output_verbose(OOB_TCP_DEBUG_CONNECT,
                                         prte_oob_base_framework.framework_output,
                                         "%s RECVD ZERO-BYTE MESSAGE FROM %s for tag %d",
                                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                         PRTE_NAME_PRINT(&peer->name), peer->recv_msg->hdr.tag);
                     peer->recv_msg->data = NULL; // make sure
                 } else {
-                    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT,
+                    prte_output_verbose(OOB_TCP_DEBUG_CONNECT,
                                         prte_oob_base_framework.framework_output,
                                         "%s:tcp:recv:handler allocate data region of size %lu",
                                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
@@ -487,7 +491,7 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
                 return;
             } else {
                 /* close the connection */
-                pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+                prte_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                                     "%s:tcp:recv:handler error reading bytes - closing connection",
                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
                 prte_oob_tcp_peer_close(peer);
@@ -502,17 +506,42 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
              */
             if (PRTE_SUCCESS == (rc = read_bytes(peer))) {
                 /* we recvd all of the message */
-                pmix_output_verbose(
+                prte_output_verbose(
                     OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                     "%s RECVD COMPLETE MESSAGE FROM %s (ORIGIN %s) OF %d BYTES FOR DEST %s TAG %d",
                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name),
                     PRTE_NAME_PRINT(&peer->recv_msg->hdr.origin), (int) peer->recv_msg->hdr.nbytes,
                     PRTE_NAME_PRINT(&peer->recv_msg->hdr.dst), peer->recv_msg->hdr.tag);
 
+                /* verify the payload if the sender checksummed it */
+                if ((MCA_OOB_TCP_FLAG_CSUM & peer->recv_msg->hdr.flags)
+                    && 0 < peer->recv_msg->hdr.nbytes) {
+                    uint32_t csum = prte_crc32c(peer->recv_msg->data,
+                                                peer->recv_msg->hdr.nbytes);
+                    if (csum != peer->recv_msg->hdr.csum) {
+                        /* the data cannot be trusted, and neither can anything
+                         * else on this stream - treat it like a failed read */
+                        pmix_show_help("help-oob-tcp.txt", "checksum-mismatch", true,
+                                       prte_process_info.nodename,
+                                       PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                                       PRTE_NAME_PRINT(&peer->name),
+                                       PRTE_NAME_PRINT(&peer->recv_msg->hdr.origin),
+                                       (int) peer->recv_msg->hdr.tag,
+                                       (unsigned long) peer->recv_msg->hdr.nbytes,
+                                       peer->recv_msg->hdr.csum, csum);
+                        free(peer->recv_msg->data);
+                        PMIX_RELEASE(peer->recv_msg);
+                        peer->recv_msg = NULL;
+                        prte_event_del(&peer->recv_event);
+                        PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_COMM_FAILED);
+                        return;
+                    }
+                }
+
                 /* am I the intended recipient (header was already converted back to host order)? */
                 if (PMIX_CHECK_PROCID(&peer->recv_msg->hdr.dst, PRTE_PROC_MY_NAME)) {
                     /* yes - post it to the RML for delivery */
-                    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT,
+                    prte_output_verbose(OOB_TCP_DEBUG_CONNECT,
                                         prte_oob_base_framework.framework_output,
                                         "%s DELIVERING TO RML tag = %d seq_num = %d",
                                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), peer->recv_msg->hdr.tag,
@@ -524,7 +553,7 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
                 } else {
                     /* promote this to the OOB as some other transport might
                      * be the next best hop */
-                    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT,
+                    prte_output_verbose(OOB_TCP_DEBUG_CONNECT,
                                         prte_oob_base_framework.framework_output,
                                         "%s TCP PROMOTING ROUTED MESSAGE FOR %s TO OOB",
                                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
@@ -541,6 +570,10 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
                         PMIX_ERROR_LOG(rc);
                     }
                     snd->seq_num = peer->recv_msg->hdr.seq_num;
+                    /* keep the originator's checksum so the final
+                     * recipient verifies the payload end to end */
+                    snd->flags = peer->recv_msg->hdr.flags;
+                    snd->csum = peer->recv_msg->hdr.csum;
                     snd->cbfunc = NULL;
                     snd->cbdata = NULL;
                     /* activate the OOB send state */
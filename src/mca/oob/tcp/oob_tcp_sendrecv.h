@@ -29,9 +29,11 @@
 #include "prte_config.h"
 
 #include "src/class/pmix_list.h"
+#include "src/util/crc.h"
 #include "src/util/pmix_string_copy.h"
 
 #include "oob_tcp.h"
+#include "oob_tcp_component.h"
 #include "oob_tcp_hdr.h"
 #include "src/rml/rml.h"
 #include "src/threads/pmix_threads.h"
@@ -89,6 +91,21 @@ PMIX_CLASS_DECLARATION(prte_oob_tcp_recv_t);
         PRTE_PMIX_THREADSHIFT((s), prte_event_base, prte_oob_tcp_queue_msg);    \
     } while (0)
 
+/* flag the header and record the CRC32C of the payload if
+ * integrity checking was requested - must be used while the
+ * header is still in host order
+ *
+ * h - pointer to the prte_oob_tcp_hdr_t
+ * d - pointer to the payload
+ */
+#define MCA_OOB_TCP_HDR_CSUM(h, d)                                     \
+    do {                                                               \
+        if (prte_mca_oob_tcp_component.checksum && 0 < (h)->nbytes) { \
+            (h)->flags |= MCA_OOB_TCP_FLAG_CSUM;                       \
+            (h)->csum = prte_crc32c((d), (h)->nbytes);                 \
+        }                                                              \
+    } while (0)
+
 /* queue a message to be sent by one of our modules - must
  * provide the following params:
  *
@@ -112,6 +129,14 @@ PMIX_CLASS_DECLARATION(prte_oob_tcp_recv_t);
         _s->msg = (m);                                                                         \
         /* set the total number of bytes to be sent */                                         \
         _s->hdr.nbytes = (m)->dbuf->bytes_used;                                                 \
+        if (MCA_OOB_TCP_FLAG_CSUM & (m)->flags) {                                              \
+            /* relaying - pass along the originator's checksum */                              \
+            _s->hdr.flags = (m)->flags;                                                        \
+            _s->hdr.csum = (m)->csum;                                                          \
+        } else {                                                                               \
+            /* checksum the payload if requested */                                            \
+            MCA_OOB_TCP_HDR_CSUM(&_s->hdr, (m)->dbuf->base_ptr);                               \
+        }                                                                                      \
         /* prep header for xmission */                                                         \
         MCA_OOB_TCP_HDR_HTON(&_s->hdr);                                                        \
         /* start the send with the header */                                                   \
@@ -144,6 +169,14 @@ PMIX_CLASS_DECLARATION(prte_oob_tcp_recv_t);
         _s->msg = (m);                                                                            \
         /* set the total number of bytes to be sent */                                            \
         _s->hdr.nbytes = (m)->dbuf->bytes_used;                                                    \
+        if (MCA_OOB_TCP_FLAG_CSUM & (m)->flags) {                                                 \
+            /* relaying - pass along the originator's checksum */                                 \
+            _s->hdr.flags = (m)->flags;                                                           \
+            _s->hdr.csum = (m)->csum;                                                             \
+        } else {                                                                                  \
+            /* checksum the payload if requested */                                               \
+            MCA_OOB_TCP_HDR_CSUM(&_s->hdr, (m)->dbuf->base_ptr);                                  \
+        }                                                                                         \
         /* prep header for xmission */                                                            \
         MCA_OOB_TCP_HDR_HTON(&_s->hdr);                                                           \
         /* start the send with the header */                                                      \
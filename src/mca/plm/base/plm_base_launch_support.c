@@ -43,6 +43,7 @@
 #include "src/include/hash_string.h"
 #include "src/pmix/pmix-internal.h"
 #include "src/prted/pmix/pmix_server.h"
+#include "src/prted/prted.h"
 
 #include "src/mca/errmgr/errmgr.h"
 #include "src/mca/ess/ess.h"
@@ -328,125 +329,35 @@ static void spawn_timeout_cb(int fd, short event, void *cbdata)
     }
 }
 
-static void stack_trace_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
-                             prte_rml_tag_t tag, void *cbdata)
+/* all daemons have returned their stack traces */
+static void stack_traces_done(void *cbdata)
 {
-    pmix_byte_object_t pbo;
-    pmix_data_buffer_t blob;
-    char *st, *st2;
-    int32_t cnt;
-    pmix_proc_t name;
-    char *hostname, *nspace;
-    pid_t pid;
-    prte_job_t *jdata = NULL;
+    prte_job_t *jdata = (prte_job_t *) cbdata;
     prte_timer_t *timer;
     prte_proc_t proc;
     pmix_pointer_array_t parray;
     int rc;
-    pmix_byte_object_t bo;
-
-    PMIX_DATA_BUFFER_CONSTRUCT(&blob);
-    PRTE_HIDE_UNUSED_PARAMS(status, tag, cbdata);
-
-    pmix_output_verbose(5, prte_plm_base_framework.framework_output,
-                        "%s: stacktrace recvd from %s",
-                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                        PRTE_NAME_PRINT(sender));
-
-    /* unpack the stack_trace blob */
-    cnt = 1;
-    rc = PMIx_Data_unpack(NULL, buffer, &nspace, &cnt, PMIX_STRING);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        PMIX_DATA_BUFFER_DESTRUCT(&blob);
-        return;
-    }
-    jdata = prte_get_job_data_object(nspace);
-    if (NULL == jdata) {
-        PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
-        free(nspace);
-        return;
-    }
-    free(nspace);
 
-    while (PMIX_SUCCESS == (rc = PMIx_Data_unpack(NULL, buffer, &pbo, &cnt, PMIX_BYTE_OBJECT))) {
-        PMIx_Data_load(&blob, &pbo);
-        /* first piece is the name of the process */
-        cnt = 1;
-        rc = PMIx_Data_unpack(NULL, &blob, &name, &cnt, PMIX_PROC);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_DATA_BUFFER_DESTRUCT(&blob);
-            goto DONE;
-        }
-        rc = PMIx_Data_unpack(NULL, &blob, &hostname, &cnt, PMIX_STRING);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_DATA_BUFFER_DESTRUCT(&blob);
-            goto DONE;
-        }
-        rc = PMIx_Data_unpack(NULL, &blob, &pid, &cnt, PMIX_PID);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_DATA_BUFFER_DESTRUCT(&blob);
-            goto DONE;
-        }
-        pmix_asprintf(&st, "STACK TRACE FOR PROC %s (%s, PID %lu)\n",
-                      PRTE_NAME_PRINT(&name), hostname,
-                      (unsigned long) pid);
-        PMIX_ARGV_APPEND_NOSIZE_COMPAT(&jdata->traces, st);
-        free(hostname);
-        free(st);
-        /* unpack the stack_trace until complete */
-        cnt = 1;
-        while (PRTE_SUCCESS == (rc = PMIx_Data_unpack(NULL, &blob, &st, &cnt, PMIX_STRING))) {
-            pmix_asprintf(&st2, "\t%s", st); // has its own newline
-            PMIX_ARGV_APPEND_NOSIZE_COMPAT(&jdata->traces, st2);
-            free(st);
-            free(st2);
-            cnt = 1;
-        }
-        if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
-            PMIX_ERROR_LOG(rc);
-        }
-        PMIX_DATA_BUFFER_DESTRUCT(&blob);
-        cnt = 1;
-    }
-    if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
-        PMIX_ERROR_LOG(rc);
+    timer = NULL;
+    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_TRACE_TIMEOUT_EVENT,
+                           (void **) &timer, PMIX_POINTER) &&
+        NULL != timer) {
+        prte_event_evtimer_del(timer->ev);
+        /* timer is an prte_timer_t object */
+        PMIX_RELEASE(timer);
+        prte_remove_attribute(&jdata->attributes, PRTE_JOB_TRACE_TIMEOUT_EVENT);
     }
+    prte_stack_trace_output(jdata->nspace);
 
-DONE:
-    jdata->ntraces++;
-    if (prte_process_info.num_daemons == jdata->ntraces) {
-        timer = NULL;
-        if (prte_get_attribute(&jdata->attributes, PRTE_JOB_TRACE_TIMEOUT_EVENT,
-                               (void **) &timer, PMIX_POINTER) &&
-            NULL != timer) {
-            prte_event_evtimer_del(timer->ev);
-            /* timer is an prte_timer_t object */
-            PMIX_RELEASE(timer);
-            prte_remove_attribute(&jdata->attributes, PRTE_JOB_TRACE_TIMEOUT_EVENT);
-        }
-        /* output the results - note that the output might need to go to a
-         * tool instead of just to stderr, so we use the PMIx IOF deliver
-         * function to ensure it gets where it needs to go */
-        PMIX_LOAD_PROCID(&name, jdata->nspace, PMIX_RANK_WILDCARD);
-        for (cnt=0; NULL != jdata->traces[cnt]; cnt++) {
-            bo.bytes = jdata->traces[cnt];
-            bo.size = strlen(jdata->traces[cnt]);
-            PMIx_server_IOF_deliver(&name, PMIX_FWD_STDERR_CHANNEL, &bo, NULL, 0, NULL, NULL);
-        }
-        /* abort the job */
-        PMIX_CONSTRUCT(&parray, pmix_pointer_array_t);
-        /* create an object */
-        PMIX_LOAD_PROCID(&proc.name, jdata->nspace, PMIX_RANK_WILDCARD);
-        cnt = pmix_pointer_array_add(&parray, &proc);
-        if (PRTE_SUCCESS != (rc = prte_plm.terminate_procs(&parray))) {
-            PRTE_ERROR_LOG(rc);
-        }
-        PMIX_DESTRUCT(&parray);
+    /* abort the job */
+    PMIX_CONSTRUCT(&parray, pmix_pointer_array_t);
+    /* create an object */
+    PMIX_LOAD_PROCID(&proc.name, jdata->nspace, PMIX_RANK_WILDCARD);
+    pmix_pointer_array_add(&parray, &proc);
+    if (PRTE_SUCCESS != (rc = prte_plm.terminate_procs(&parray))) {
+        PRTE_ERROR_LOG(rc);
     }
+    PMIX_DESTRUCT(&parray);
 }
 
 static void stack_trace_timeout(int sd, short args, void *cbdata)
@@ -467,6 +378,8 @@ static void stack_trace_timeout(int sd, short args, void *cbdata)
         PMIX_RELEASE(timer);
         prte_remove_attribute(&jdata->attributes, PRTE_JOB_TIMEOUT_EVENT);
     }
+    /* show what we did get */
+    prte_stack_trace_output(jdata->nspace);
 
     /* abort the job */
     PMIX_CONSTRUCT(&parray, pmix_pointer_array_t);
@@ -562,47 +475,14 @@ static void job_timeout_cb(int fd, short event, void *cbdata)
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_STACKTRACES, NULL, PMIX_BOOL)) {
         /* if they asked for stack_traces, attempt to get them, but timeout
          * if we cannot do so */
-        prte_daemon_cmd_flag_t command = PRTE_DAEMON_GET_STACK_TRACES;
-        pmix_data_buffer_t buffer;
-        prte_grpcomm_signature_t *sig;
-
         bo.bytes = "Waiting for stack traces (this may take a few moments)...\n";
         bo.size = strlen(bo.bytes);
         PMIx_server_IOF_deliver(&pc, PMIX_FWD_STDERR_CHANNEL, &bo, NULL, 0, NULL, NULL);
 
-        /* set the recv */
-        PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_STACK_TRACE,
-                      PRTE_RML_PERSISTENT, stack_trace_recv, NULL);
-
-        /* setup the buffer */
-        PMIX_DATA_BUFFER_CONSTRUCT(&buffer);
-        /* pack the command */
-        rc = PMIx_Data_pack(NULL, &buffer, &command, 1, PMIX_UINT8);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_DATA_BUFFER_DESTRUCT(&buffer);
-            goto giveup;
-        }
-        /* pack the jobid */
-        rc = PMIx_Data_pack(NULL, &buffer, &jdata->nspace, 1, PMIX_PROC_NSPACE);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_DATA_BUFFER_DESTRUCT(&buffer);
-            goto giveup;
-        }
-        /* goes to all daemons */
-        sig = PMIX_NEW(prte_grpcomm_signature_t);
-        sig->signature = (pmix_proc_t *) malloc(sizeof(pmix_proc_t));
-        PMIX_LOAD_PROCID(&sig->signature[0], PRTE_PROC_MY_NAME->nspace, PMIX_RANK_WILDCARD);
-        sig->sz = 1;
-        if (PRTE_SUCCESS != (rc = prte_grpcomm.xcast(sig, PRTE_RML_TAG_DAEMON, &buffer))) {
-            PRTE_ERROR_LOG(rc);
-            PMIX_DATA_BUFFER_DESTRUCT(&buffer);
+        rc = prte_stack_trace_request(jdata->nspace, stack_traces_done, jdata);
+        if (PRTE_SUCCESS != rc) {
             goto giveup;
         }
-        PMIX_DATA_BUFFER_DESTRUCT(&buffer);
-        /* maintain accounting */
-        PMIX_RELEASE(sig);
         /* we will terminate after we get the stack_traces, but set a timeout
          * just in case we never hear back from everyone */
         if (prte_stack_trace_wait_timeout > 0) {
@@ -2129,6 +2009,8 @@ int prte_plm_base_setup_virtual_machine(prte_job_t *jdata)
         daemons->map = PMIX_NEW(prte_job_map_t);
     }
     map = daemons->map;
+    /* any daemons we add start a new range of vpids */
+    map->daemon_vpid_start = PMIX_RANK_INVALID;
 
     /* if this job is being launched against a fixed DVM, then there is
      * nothing for us to do - the DVM will stand as is */
@@ -25,6 +25,7 @@
 BEGIN_C_DECLS
 
 PRTE_EXPORT extern pmix_mca_base_framework_t prte_prtereachable_base_framework;
+PRTE_EXPORT extern prte_reachable_base_component_t *prte_reachable_base_selected_component;
 
 /**
  * Select a prtereachable module
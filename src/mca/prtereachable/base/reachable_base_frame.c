@@ -30,6 +30,7 @@
 #include "src/mca/prtereachable/base/static-components.h"
 
 prte_reachable_base_module_t prte_reachable = {0};
+prte_reachable_base_component_t *prte_reachable_base_selected_component = NULL;
 
 static int prte_reachable_base_frame_register(pmix_mca_base_register_flag_t flags)
 {
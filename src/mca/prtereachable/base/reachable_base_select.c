@@ -44,6 +44,7 @@ int prte_reachable_base_select(void)
 
     /* Save the winner */
     prte_reachable = *best_module;
+    prte_reachable_base_selected_component = best_component;
 
     /* Initialize the winner */
     ret = prte_reachable.init();
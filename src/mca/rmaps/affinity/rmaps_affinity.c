@@ -0,0 +1,1189 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+#include "types.h"
+
+#include <errno.h>
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "src/hwloc/hwloc-internal.h"
+#include "src/util/bipartite_graph.h"
+#include "src/util/pmix_string_copy.h"
+
+#include "src/mca/errmgr/errmgr.h"
+#include "src/runtime/prte_globals.h"
+#include "src/util/name_fns.h"
+#include "src/util/proc_info.h"
+#include "src/util/pmix_show_help.h"
+
+#include "rmaps_affinity.h"
+#include "src/mca/rmaps/base/base.h"
+#include "src/mca/rmaps/base/rmaps_private.h"
+
+static int prte_rmaps_affinity_map(prte_job_t *jdata,
+                                   prte_rmaps_options_t *options);
+
+/* define the module */
+prte_rmaps_base_module_t prte_rmaps_affinity_module = {
+    .map_job = prte_rmaps_affinity_map
+};
+
+/* communication volume dominates the cost of a placement - the
+ * distance from a rank's compact location is only a tie-breaker */
+#define AFF_COMM_SCALE (1 << 16)
+
+/* costs saturate here rather than overflow - the headroom lets the
+ * assignment solver sum the costs along a path through the graph
+ * of any node with fewer than 32k procs and slots */
+#define AFF_COST_MAX (INT64_MAX >> 16)
+
+/* saturating arithmetic on non-negative costs */
+static inline int64_t aff_add(int64_t a, int64_t b)
+{
+    return (b > AFF_COST_MAX - a) ? AFF_COST_MAX : a + b;
+}
+
+static inline int64_t aff_mul(int64_t a, int64_t b)
+{
+    return (0 != a && b > AFF_COST_MAX / a) ? AFF_COST_MAX : a * b;
+}
+
+typedef prte_rmaps_affinity_comm_t aff_comm_t;
+
+/* the hardware objects of one node that ranks can be placed on */
+typedef struct {
+    hwloc_obj_t *objs;
+    int nobjs;
+    int cap;      // #slots per object
+    int nslots;
+    int64_t *dist;
+} aff_slots_t;
+
+/* the ranks being placed on one node, in rank order - local[]
+ * maps any rank in [base, base + range) to its index in ranks[],
+ * or -1 if the rank is on another node */
+typedef struct {
+    pmix_rank_t *ranks;
+    int nprocs;
+    pmix_rank_t base;
+    pmix_rank_t range;
+    int *local;
+} aff_block_t;
+
+#if PMIX_NUMERIC_VERSION < 0x00040205
+static char *pmix_getline(FILE *fp)
+{
+    char *ret, *buff;
+    char input[1024];
+
+    ret = fgets(input, 1024, fp);
+    if (NULL != ret) {
+        input[strlen(input) - 1] = '\0'; /* remove newline */
+        buff = strdup(input);
+        return buff;
+    }
+
+    return NULL;
+}
+#endif
+
+static void comm_free(aff_comm_t *comm)
+{
+    if (NULL != comm->start) {
+        free(comm->start);
+    }
+    if (NULL != comm->peer) {
+        free(comm->peer);
+    }
+    if (NULL != comm->weight) {
+        free(comm->weight);
+    }
+    memset(comm, 0, sizeof(aff_comm_t));
+}
+
+/* raw (rank, rank, weight) entries read from the matrix file */
+typedef struct {
+    pmix_rank_t *ri;
+    pmix_rank_t *rj;
+    int64_t *wt;
+    size_t n;
+    size_t size;
+    pmix_rank_t nranks;
+} aff_entries_t;
+
+static int add_entry(aff_entries_t *ent, pmix_rank_t r1, pmix_rank_t r2, int64_t w)
+{
+    void *tmp;
+
+    if (r1 == r2 || 0 == w) {
+        return PRTE_SUCCESS;
+    }
+    if (ent->n == ent->size) {
+        ent->size = (0 == ent->size) ? 256 : 2 * ent->size;
+        if (NULL == (tmp = realloc(ent->ri, ent->size * sizeof(pmix_rank_t)))) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        ent->ri = (pmix_rank_t *) tmp;
+        if (NULL == (tmp = realloc(ent->rj, ent->size * sizeof(pmix_rank_t)))) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        ent->rj = (pmix_rank_t *) tmp;
+        if (NULL == (tmp = realloc(ent->wt, ent->size * sizeof(int64_t)))) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        ent->wt = (int64_t *) tmp;
+    }
+    ent->ri[ent->n] = r1;
+    ent->rj[ent->n] = r2;
+    ent->wt[ent->n] = w;
+    ++ent->n;
+    if (ent->nranks <= r1) {
+        ent->nranks = r1 + 1;
+    }
+    if (ent->nranks <= r2) {
+        ent->nranks = r2 + 1;
+    }
+    return PRTE_SUCCESS;
+}
+
+/* return the next line that isn't a comment, along with its
+ * first non-blank character */
+static char *next_line(FILE *fp, char comment, bool skip_blank,
+                       int *lineno, char **ptr)
+{
+    char *line;
+
+    while (NULL != (line = pmix_getline(fp))) {
+        ++(*lineno);
+        *ptr = line;
+        while (isspace(**ptr)) {
+            ++(*ptr);
+        }
+        if (comment == **ptr || (skip_blank && '\0' == **ptr)) {
+            free(line);
+            continue;
+        }
+        return line;
+    }
+    return NULL;
+}
+
+/* one "<rank> <rank> <weight>" entry per line */
+static int read_edges(FILE *fp, char *path, aff_entries_t *ent)
+{
+    char *line, *ptr;
+    unsigned long r1, r2;
+    long long w;
+    int lineno = 0, rc;
+
+    while (NULL != (line = next_line(fp, '#', true, &lineno, &ptr))) {
+        if (3 != sscanf(ptr, "%lu %lu %lld", &r1, &r2, &w) || 0 > w) {
+            pmix_show_help("help-prte-rmaps-affinity.txt", "bad-comm-entry", true,
+                           path, lineno, ptr);
+            free(line);
+            return PRTE_ERR_SILENT;
+        }
+        free(line);
+        if (PRTE_SUCCESS != (rc = add_entry(ent, r1, r2, w))) {
+            return rc;
+        }
+    }
+    return PRTE_SUCCESS;
+}
+
+/* METIS graph format - a "<nvertices> <nedges> [fmt [ncon]]" header
+ * followed by one line per vertex listing its 1-based neighbors,
+ * each followed by the edge weight if fmt says weights are present.
+ * Vertex sizes and weights are skipped */
+static int read_metis(FILE *fp, char *path, aff_entries_t *ent)
+{
+    char *line, *ptr, *end, fmt[4] = "0";
+    unsigned long nv, ne;
+    long nbr;
+    long long w;
+    int lineno = 0, ncon = 1, f, n, v, rc = PRTE_SUCCESS;
+    bool have_ewgt, have_vwgt, have_vsize;
+
+    if (NULL == (line = next_line(fp, '%', true, &lineno, &ptr))) {
+        return PRTE_SUCCESS;
+    }
+    if (2 > sscanf(ptr, "%lu %lu %3s %d", &nv, &ne, fmt, &ncon)) {
+        goto bad;
+    }
+    free(line);
+    f = atoi(fmt);
+    have_ewgt = (0 != f % 10);
+    have_vwgt = (0 != (f / 10) % 10);
+    have_vsize = (0 != (f / 100) % 10);
+
+    for (v = 0; v < (int) nv; v++) {
+        /* an empty line is a vertex without neighbors */
+        if (NULL == (line = next_line(fp, '%', false, &lineno, &ptr))) {
+            break;
+        }
+        n = (have_vsize ? 1 : 0) + (have_vwgt ? ncon : 0);
+        for (; 0 < n; n--) {
+            (void) strtol(ptr, &end, 10);
+            if (end == ptr) {
+                goto bad;
+            }
+            ptr = end;
+        }
+        while (1) {
+            nbr = strtol(ptr, &end, 10);
+            if (end == ptr) {
+                break;
+            }
+            ptr = end;
+            w = 1;
+            if (have_ewgt) {
+                w = strtoll(ptr, &end, 10);
+                if (end == ptr || 0 > w) {
+                    goto bad;
+                }
+                ptr = end;
+            }
+            if (1 > nbr || (unsigned long) nbr > nv) {
+                goto bad;
+            }
+            /* each edge is listed by both of its ends */
+            if (nbr - 1 > v &&
+                PRTE_SUCCESS != (rc = add_entry(ent, v, nbr - 1, w))) {
+                free(line);
+                return rc;
+            }
+        }
+        while (isspace(*ptr)) {
+            ++ptr;
+        }
+        if ('\0' != *ptr) {
+            goto bad;
+        }
+        free(line);
+    }
+    return PRTE_SUCCESS;
+
+bad:
+    pmix_show_help("help-prte-rmaps-affinity.txt", "bad-comm-entry", true,
+                   path, lineno, line);
+    free(line);
+    return PRTE_ERR_SILENT;
+}
+
+static int load_comm_file(char *path, aff_comm_t *comm)
+{
+    FILE *fp;
+    aff_entries_t ent;
+    size_t n, *fill = NULL;
+    int rc;
+
+    memset(comm, 0, sizeof(aff_comm_t));
+    memset(&ent, 0, sizeof(aff_entries_t));
+
+    fp = fopen(path, "r");
+    if (NULL == fp) {
+        pmix_show_help("help-prte-rmaps-affinity.txt", "comm-file-not-found", true, path);
+        return PRTE_ERR_SILENT;
+    }
+    if (NULL != prte_mca_rmaps_affinity_component.comm_format &&
+        0 == strcasecmp(prte_mca_rmaps_affinity_component.comm_format, "metis")) {
+        rc = read_metis(fp, path, &ent);
+    } else {
+        rc = read_edges(fp, path, &ent);
+    }
+    fclose(fp);
+    if (PRTE_SUCCESS != rc) {
+        goto cleanup;
+    }
+
+    /* the matrix is symmetric, so record each entry in both rows */
+    comm->nranks = ent.nranks;
+    comm->start = (size_t *) calloc(comm->nranks + 1, sizeof(size_t));
+    comm->peer = (pmix_rank_t *) malloc((2 * ent.n + 1) * sizeof(pmix_rank_t));
+    comm->weight = (int64_t *) malloc((2 * ent.n + 1) * sizeof(int64_t));
+    fill = (size_t *) calloc(comm->nranks + 1, sizeof(size_t));
+    if (NULL == comm->start || NULL == comm->peer || NULL == comm->weight || NULL == fill) {
+        rc = PRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    for (n = 0; n < ent.n; n++) {
+        comm->start[ent.ri[n] + 1]++;
+        comm->start[ent.rj[n] + 1]++;
+    }
+    for (n = 0; n < comm->nranks; n++) {
+        comm->start[n + 1] += comm->start[n];
+        fill[n] = comm->start[n];
+    }
+    for (n = 0; n < ent.n; n++) {
+        comm->peer[fill[ent.ri[n]]] = ent.rj[n];
+        comm->weight[fill[ent.ri[n]]++] = ent.wt[n];
+        comm->peer[fill[ent.rj[n]]] = ent.ri[n];
+        comm->weight[fill[ent.rj[n]]++] = ent.wt[n];
+    }
+
+    pmix_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                        "mca:rmaps:affinity: loaded %lu communication entries for %lu ranks from %s",
+                        (unsigned long) ent.n, (unsigned long) comm->nranks, path);
+
+cleanup:
+    if (PRTE_SUCCESS != rc) {
+        if (PRTE_ERR_SILENT != rc) {
+            PRTE_ERROR_LOG(rc);
+        }
+        comm_free(comm);
+    }
+    free(fill);
+    free(ent.ri);
+    free(ent.rj);
+    free(ent.wt);
+    return rc;
+}
+
+static int get_target(prte_rmaps_options_t *options,
+                      hwloc_obj_type_t *type, bool *gpu)
+{
+    char *tgt = prte_mca_rmaps_affinity_component.target;
+
+    *gpu = false;
+    if (NULL == tgt || 0 == strcasecmp(tgt, "auto")) {
+        /* follow the binding level so each rank gets its own
+         * binding target - use cores if we aren't binding */
+        if (PRTE_BIND_TO_NONE == options->bind ||
+            HWLOC_OBJ_MACHINE == options->hwb) {
+            *type = HWLOC_OBJ_CORE;
+        } else {
+            *type = options->hwb;
+        }
+    } else if (0 == strcasecmp(tgt, "hwthread")) {
+        *type = HWLOC_OBJ_PU;
+    } else if (0 == strcasecmp(tgt, "core")) {
+        *type = HWLOC_OBJ_CORE;
+    } else if (0 == strcasecmp(tgt, "numa")) {
+        *type = HWLOC_OBJ_NUMANODE;
+    } else if (0 == strcasecmp(tgt, "package")) {
+        *type = HWLOC_OBJ_PACKAGE;
+    } else if (0 == strcasecmp(tgt, "gpu")) {
+        *type = HWLOC_OBJ_OS_DEVICE;
+        *gpu = true;
+    } else {
+        pmix_show_help("help-prte-rmaps-affinity.txt", "bad-target", true, tgt);
+        return PRTE_ERR_SILENT;
+    }
+    return PRTE_SUCCESS;
+}
+
+/* number of hops between two objects through their closest
+ * common ancestor in the topology tree */
+static int64_t hops(hwloc_topology_t topo, hwloc_obj_t a, hwloc_obj_t b)
+{
+    hwloc_obj_t anc, p;
+    int64_t n = 0;
+
+    if (a == b) {
+        return 0;
+    }
+    /* walk the parents rather than using the depths as memory
+     * objects such as NUMA nodes have a negative depth */
+    anc = hwloc_get_common_ancestor_obj(topo, a, b);
+    for (p = a; NULL != p && p != anc; p = p->parent) {
+        ++n;
+    }
+    for (p = b; NULL != p && p != anc; p = p->parent) {
+        ++n;
+    }
+    return n;
+}
+
+static int get_slots(prte_node_t *node, hwloc_obj_type_t type, bool gpu,
+                     int nprocs, prte_rmaps_options_t *options,
+                     aff_slots_t *slots)
+{
+    hwloc_topology_t topo = node->topology->topo;
+    hwloc_obj_t obj, dev = NULL;
+    hwloc_cpuset_t cpus;
+    int n, m, nobjs;
+#if HWLOC_API_VERSION >= 0x20000
+    struct hwloc_distances_s *dptr = NULL;
+    unsigned nr = 1;
+    hwloc_uint64_t v1, v2;
+#endif
+
+    memset(slots, 0, sizeof(aff_slots_t));
+
+    if (gpu) {
+        nobjs = 0;
+        while (NULL != (dev = hwloc_get_next_osdev(topo, dev))) {
+            ++nobjs;
+        }
+        dev = NULL;
+    } else {
+        nobjs = hwloc_get_nbobjs_by_type(topo, type);
+    }
+    if (0 >= nobjs) {
+        return PRTE_SUCCESS;
+    }
+    slots->objs = (hwloc_obj_t *) malloc(nobjs * sizeof(hwloc_obj_t));
+    if (NULL == slots->objs) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+
+    /* only keep objects that contain cpus this job can use - GPUs
+     * are represented by their closest object that has cpus. There
+     * is no point in considering more objects than we have ranks as
+     * the compact placement would never reach them */
+    nobjs = 0;
+    obj = NULL;
+    while (nobjs < nprocs) {
+        if (gpu) {
+            if (NULL == (dev = hwloc_get_next_osdev(topo, dev))) {
+                break;
+            }
+            if (HWLOC_OBJ_OSDEV_GPU != dev->attr->osdev.type
+#if HAVE_DECL_HWLOC_OBJ_OSDEV_COPROC
+                && HWLOC_OBJ_OSDEV_COPROC != dev->attr->osdev.type
+#endif
+                ) {
+                continue;
+            }
+            obj = hwloc_get_non_io_ancestor_obj(topo, dev);
+        } else if (NULL == (obj = hwloc_get_next_obj_by_type(topo, type, obj))) {
+            break;
+        }
+#if HWLOC_API_VERSION < 0x20000
+        cpus = obj->allowed_cpuset;
+#else
+        cpus = obj->cpuset;
+#endif
+        if (NULL == cpus ||
+            (NULL != options->target && !hwloc_bitmap_intersects(cpus, options->target))) {
+            continue;
+        }
+        slots->objs[nobjs++] = obj;
+    }
+    if (0 == nobjs) {
+        free(slots->objs);
+        slots->objs = NULL;
+        return PRTE_SUCCESS;
+    }
+
+    /* fill the objects in order, giving each the same number of
+     * slots so the compact placement is rank k -> slot k */
+    slots->nobjs = nobjs;
+    slots->cap = (nprocs + nobjs - 1) / nobjs;
+    slots->nslots = nobjs * slots->cap;
+    slots->dist = (int64_t *) malloc(nobjs * nobjs * sizeof(int64_t));
+    if (NULL == slots->dist) {
+        free(slots->objs);
+        slots->objs = NULL;
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+
+#if HWLOC_API_VERSION >= 0x20000
+    /* prefer the measured NUMA latencies when the topology has them */
+    if (HWLOC_OBJ_NUMANODE == type && !gpu) {
+        if (0 != hwloc_distances_get_by_type(topo, HWLOC_OBJ_NUMANODE, &nr, &dptr,
+                                             HWLOC_DISTANCES_KIND_MEANS_LATENCY, 0) ||
+            0 == nr) {
+            dptr = NULL;
+        }
+    }
+#endif
+    for (n = 0; n < nobjs; n++) {
+        for (m = 0; m < nobjs; m++) {
+            slots->dist[n * nobjs + m] = hops(topo, slots->objs[n], slots->objs[m]);
+#if HWLOC_API_VERSION >= 0x20000
+            if (NULL != dptr &&
+                0 == hwloc_distances_obj_pair_values(dptr, slots->objs[n], slots->objs[m],
+                                                     &v1, &v2)) {
+                slots->dist[n * nobjs + m] = (int64_t) v1;
+            }
+#endif
+        }
+    }
+#if HWLOC_API_VERSION >= 0x20000
+    if (NULL != dptr) {
+        hwloc_distances_release(topo, dptr);
+    }
+#endif
+    return PRTE_SUCCESS;
+}
+
+#define AFF_DIST(s, a, b) ((s)->dist[((a) / (s)->cap) * (s)->nobjs + ((b) / (s)->cap)])
+
+static inline int block_index(aff_block_t *blk, pmix_rank_t r)
+{
+    if (r < blk->base || r >= blk->base + blk->range) {
+        return -1;
+    }
+    return blk->local[r - blk->base];
+}
+
+/* cost of putting local rank k on slot s given where every other
+ * rank currently sits - pos entries < 0 are not yet placed */
+static int64_t slot_cost(aff_comm_t *comm, aff_slots_t *slots,
+                         aff_block_t *blk, int k, int s, int *pos)
+{
+    int64_t cost = 0;
+    pmix_rank_t r = blk->ranks[k];
+    size_t e;
+    int l;
+
+    if (r < comm->nranks) {
+        for (e = comm->start[r]; e < comm->start[r + 1]; e++) {
+            /* peers on other nodes contribute the same cost
+             * wherever we put this rank */
+            l = block_index(blk, comm->peer[e]);
+            if (0 > l || 0 > pos[l]) {
+                continue;
+            }
+            cost = aff_add(cost, aff_mul(comm->weight[e], AFF_DIST(slots, s, pos[l])));
+        }
+    }
+    return aff_add(aff_mul(cost, AFF_COMM_SCALE), AFF_DIST(slots, s, k));
+}
+
+static int64_t placement_cost(aff_comm_t *comm, aff_slots_t *slots,
+                              aff_block_t *blk, int *pos)
+{
+    int64_t cost = 0;
+    int k;
+
+    /* every pair is counted twice, which doesn't matter for comparison */
+    for (k = 0; k < blk->nprocs; k++) {
+        cost = aff_add(cost, slot_cost(comm, slots, blk, k, pos[k], pos));
+    }
+    return cost;
+}
+
+static bool have_local_traffic(aff_comm_t *comm, aff_block_t *blk)
+{
+    pmix_rank_t r;
+    size_t e;
+    int k;
+
+    for (k = 0; k < blk->nprocs; k++) {
+        r = blk->ranks[k];
+        if (r >= comm->nranks) {
+            continue;
+        }
+        for (e = comm->start[r]; e < comm->start[r + 1]; e++) {
+            if (0 <= block_index(blk, comm->peer[e])) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/* the placement cost is quadratic in the assignment, so solve a
+ * sequence of linear assignment problems - each one pricing a slot
+ * against where the peers ended up in the previous pass */
+static int solve_exact(aff_comm_t *comm, aff_slots_t *slots,
+                       aff_block_t *blk, int *pos)
+{
+    int nprocs = blk->nprocs;
+    prte_bp_graph_t *g = NULL;
+    int *trial, *match = NULL;
+    int k, s, idx, nmatch, pass, rc = PRTE_SUCCESS;
+    int64_t best, cost;
+
+    trial = (int *) malloc(nprocs * sizeof(int));
+    if (NULL == trial) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    best = placement_cost(comm, slots, blk, pos);
+
+    for (pass = 0; pass < prte_mca_rmaps_affinity_component.passes; pass++) {
+        rc = prte_bp_graph_create(NULL, NULL, &g);
+        if (PRTE_SUCCESS != rc) {
+            break;
+        }
+        for (k = 0; k < nprocs + slots->nslots; k++) {
+            rc = prte_bp_graph_add_vertex(g, NULL, &idx);
+            if (PRTE_SUCCESS != rc) {
+                goto cleanup;
+            }
+        }
+        for (k = 0; k < nprocs; k++) {
+            for (s = 0; s < slots->nslots; s++) {
+                rc = prte_bp_graph_add_edge(g, k, nprocs + s,
+                                            slot_cost(comm, slots, blk, k, s, pos),
+                                            1, NULL);
+                if (PRTE_SUCCESS != rc) {
+                    goto cleanup;
+                }
+            }
+        }
+        rc = prte_bp_graph_solve_bipartite_assignment(g, &nmatch, &match);
+        if (PRTE_SUCCESS != rc) {
+            goto cleanup;
+        }
+        if (nmatch != nprocs) {
+            /* cannot happen with a complete graph, but don't
+             * trust a partial answer */
+            free(match);
+            goto cleanup;
+        }
+        for (k = 0; k < nmatch; k++) {
+            trial[match[2 * k]] = match[2 * k + 1] - nprocs;
+        }
+        free(match);
+        prte_bp_graph_free(g);
+        g = NULL;
+
+        cost = placement_cost(comm, slots, blk, trial);
+        pmix_output_verbose(10, prte_rmaps_base_framework.framework_output,
+                            "mca:rmaps:affinity: pass %d cost %lld (best %lld)",
+                            pass, (long long) cost, (long long) best);
+        if (cost >= best) {
+            break;
+        }
+        best = cost;
+        memcpy(pos, trial, nprocs * sizeof(int));
+    }
+
+cleanup:
+    if (NULL != g) {
+        prte_bp_graph_free(g);
+    }
+    free(trial);
+    return rc;
+}
+
+/* for nodes too large for the exact solver, place the most
+ * communication-heavy ranks first, each on the free slot that is
+ * cheapest relative to the peers already placed */
+static int solve_greedy(aff_comm_t *comm, aff_slots_t *slots,
+                        aff_block_t *blk, int *pos)
+{
+    int nprocs = blk->nprocs;
+    int *trial, *order;
+    int64_t *load, c, bestc;
+    bool *used;
+    int k, m, s, best, tmp;
+    pmix_rank_t r;
+    size_t e;
+
+    trial = (int *) malloc(nprocs * sizeof(int));
+    order = (int *) malloc(nprocs * sizeof(int));
+    load = (int64_t *) calloc(nprocs, sizeof(int64_t));
+    used = (bool *) calloc(slots->nslots, sizeof(bool));
+    if (NULL == trial || NULL == order || NULL == load || NULL == used) {
+        free(trial);
+        free(order);
+        free(load);
+        free(used);
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+
+    for (k = 0; k < nprocs; k++) {
+        trial[k] = -1;
+        order[k] = k;
+        r = blk->ranks[k];
+        if (r < comm->nranks) {
+            for (e = comm->start[r]; e < comm->start[r + 1]; e++) {
+                load[k] += comm->weight[e];
+            }
+        }
+    }
+    /* insertion sort keeps equal loads in rank order */
+    for (k = 1; k < nprocs; k++) {
+        tmp = order[k];
+        for (m = k - 1; 0 <= m && load[order[m]] < load[tmp]; m--) {
+            order[m + 1] = order[m];
+        }
+        order[m + 1] = tmp;
+    }
+
+    for (m = 0; m < nprocs; m++) {
+        k = order[m];
+        best = -1;
+        bestc = 0;
+        for (s = 0; s < slots->nslots; s++) {
+            if (used[s]) {
+                continue;
+            }
+            c = slot_cost(comm, slots, blk, k, s, trial);
+            if (0 > best || c < bestc) {
+                best = s;
+                bestc = c;
+            }
+        }
+        trial[k] = best;
+        used[best] = true;
+    }
+
+    if (placement_cost(comm, slots, blk, trial) <
+        placement_cost(comm, slots, blk, pos)) {
+        memcpy(pos, trial, nprocs * sizeof(int));
+    }
+    free(trial);
+    free(order);
+    free(load);
+    free(used);
+    return PRTE_SUCCESS;
+}
+
+static int place_node(prte_job_t *jdata, prte_app_context_t *app,
+                      prte_node_t *node, aff_block_t *blk,
+                      pmix_rank_t appbase, hwloc_obj_type_t type, bool gpu,
+                      aff_comm_t *comm, prte_rmaps_options_t *options)
+{
+    int nprocs = blk->nprocs;
+    aff_slots_t slots;
+    prte_proc_t *proc;
+    hwloc_obj_t obj;
+    int *pos = NULL;
+    int k, rc;
+
+    rc = get_slots(node, type, gpu, nprocs, options, &slots);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+
+    if (NULL != slots.objs) {
+        pos = (int *) malloc(nprocs * sizeof(int));
+        if (NULL == pos) {
+            rc = PRTE_ERR_OUT_OF_RESOURCE;
+            goto done;
+        }
+        for (k = 0; k < nprocs; k++) {
+            pos[k] = k;
+        }
+        /* without traffic between the ranks on this node the
+         * compact placement is already the cheapest */
+        if (have_local_traffic(comm, blk)) {
+            if (nprocs <= prte_mca_rmaps_affinity_component.solver_limit) {
+                rc = solve_exact(comm, &slots, blk, pos);
+            } else {
+                rc = solve_greedy(comm, &slots, blk, pos);
+            }
+            if (PRTE_SUCCESS != rc) {
+                PRTE_ERROR_LOG(rc);
+                goto done;
+            }
+        }
+    }
+
+    for (k = 0; k < nprocs; k++) {
+        obj = (NULL == pos) ? NULL : slots.objs[pos[k] / slots.cap];
+        proc = prte_rmaps_base_setup_proc(jdata, app->idx, node, obj, options);
+        if (NULL == proc) {
+            pmix_show_help("help-prte-rmaps-affinity.txt", "proc-failed-to-map", true,
+                           node->name, app->app);
+            rc = PRTE_ERR_SILENT;
+            goto done;
+        }
+        proc->name.rank = blk->ranks[k];
+        proc->app_rank = blk->ranks[k] - appbase;
+        rc = prte_rmaps_base_check_oversubscribed(jdata, app, node, options);
+        PMIX_RELEASE(proc);
+        if (PRTE_SUCCESS != rc &&
+            PRTE_ERR_TAKE_NEXT_OPTION != rc) {
+            goto done;
+        }
+        rc = PRTE_SUCCESS;
+    }
+
+done:
+    if (NULL != pos) {
+        free(pos);
+    }
+    if (NULL != slots.objs) {
+        free(slots.objs);
+    }
+    if (NULL != slots.dist) {
+        free(slots.dist);
+    }
+    return rc;
+}
+
+/* check the node can take the ranks in blk and place them. Unless
+ * exact is set, the block is trimmed to what the node can hold */
+static int map_node(prte_job_t *jdata, prte_app_context_t *app,
+                    prte_node_t *node, pmix_list_t *node_list,
+                    aff_block_t *blk, bool exact, bool support,
+                    pmix_rank_t appbase, hwloc_obj_type_t type, bool gpu,
+                    aff_comm_t *comm, prte_rmaps_options_t *options)
+{
+    prte_binding_policy_t savebind = options->bind;
+    int k, rc, ncpus;
+
+    prte_rmaps_base_get_cpuset(jdata, node, options);
+    if (support && !options->donotlaunch) {
+        rc = prte_rmaps_base_check_support(jdata, node, options);
+        if (PRTE_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    options->nprocs = blk->nprocs;
+
+    /* overloaded but not oversubscribed - don't bind
+     * unless the user told us to */
+    ncpus = prte_rmaps_base_get_ncpus(node, NULL, options);
+    if (options->nprocs > ncpus &&
+        options->nprocs <= node->slots_available &&
+        !PRTE_BINDING_POLICY_IS_SET(jdata->map->binding)) {
+        options->bind = PRTE_BIND_TO_NONE;
+        jdata->map->binding = PRTE_BIND_TO_NONE;
+    }
+
+    if (!prte_rmaps_base_check_avail(jdata, app, node, node_list, NULL, options) ||
+        0 >= options->nprocs) {
+        rc = PRTE_ERR_TAKE_NEXT_OPTION;
+        goto done;
+    }
+    if (!exact && options->nprocs < blk->nprocs) {
+        blk->nprocs = options->nprocs;
+    }
+
+    pmix_output_verbose(2, prte_rmaps_base_framework.framework_output,
+                        "mca:rmaps:affinity: placing %d ranks starting at %s on node %s",
+                        blk->nprocs, PRTE_VPID_PRINT(blk->ranks[0]), node->name);
+
+    for (k = 0; k < blk->nprocs; k++) {
+        blk->local[blk->ranks[k] - blk->base] = k;
+    }
+    rc = place_node(jdata, app, node, blk, appbase, type, gpu, comm, options);
+    for (k = 0; k < blk->nprocs; k++) {
+        blk->local[blk->ranks[k] - blk->base] = -1;
+    }
+
+done:
+    options->bind = savebind;
+    if (NULL != options->target) {
+        hwloc_bitmap_free(options->target);
+        options->target = NULL;
+    }
+    return rc;
+}
+
+/* give each node a contiguous block of ranks, filling the nodes in
+ * order and spreading any oversubscription evenly across them */
+static int map_blocks(prte_job_t *jdata, prte_app_context_t *app,
+                      pmix_list_t *node_list, aff_block_t *blk,
+                      hwloc_obj_type_t type, bool gpu,
+                      aff_comm_t *comm, prte_rmaps_options_t *options)
+{
+    prte_node_t *node, *nd;
+    pmix_rank_t nmapped = 0, start;
+    bool second_pass = false;
+    int k, n, nnodes, rc;
+
+    while (nmapped < app->num_procs) {
+        nnodes = (int) pmix_list_get_size(node_list);
+        if (0 == nnodes) {
+            pmix_show_help("help-prte-rmaps-base.txt", "prte-rmaps-base:no-available-resources",
+                           true);
+            return PRTE_ERR_SILENT;
+        }
+        start = nmapped;
+        PMIX_LIST_FOREACH_SAFE(node, nd, node_list, prte_node_t)
+        {
+            if (nmapped == app->num_procs) {
+                break;
+            }
+            if (second_pass) {
+                n = (app->num_procs - nmapped + nnodes - 1) / nnodes;
+            } else {
+                n = node->slots_available;
+            }
+            if ((int) (app->num_procs - nmapped) < n) {
+                n = app->num_procs - nmapped;
+            }
+            if (0 >= n) {
+                continue;
+            }
+            blk->nprocs = n;
+            for (k = 0; k < n; k++) {
+                blk->ranks[k] = blk->base + nmapped + k;
+            }
+            rc = map_node(jdata, app, node, node_list, blk, false, !second_pass,
+                          blk->base, type, gpu, comm, options);
+            if (PRTE_ERR_TAKE_NEXT_OPTION == rc) {
+                continue;
+            }
+            if (PRTE_SUCCESS != rc) {
+                return rc;
+            }
+            nmapped += blk->nprocs;
+        }
+        if (nmapped < app->num_procs) {
+            /* oversubscription can only help if the last pass
+             * managed to place something */
+            if (!options->oversubscribe ||
+                (second_pass && start == nmapped)) {
+                pmix_show_help("help-prte-rmaps-base.txt", "prte-rmaps-base:alloc-error", true,
+                               app->num_procs, app->app, prte_process_info.nodename);
+                PRTE_UPDATE_EXIT_STATUS(PRTE_ERROR_DEFAULT_EXIT_CODE);
+                return PRTE_ERR_SILENT;
+            }
+            second_pass = true;
+        }
+    }
+    return PRTE_SUCCESS;
+}
+
+/* split the app's ranks across the nodes so as to cut as little
+ * communication as possible, then place each node's share */
+static int map_partitioned(prte_job_t *jdata, prte_app_context_t *app,
+                           pmix_list_t *node_list, aff_block_t *blk,
+                           hwloc_obj_type_t type, bool gpu,
+                           aff_comm_t *comm, prte_rmaps_options_t *options)
+{
+    prte_node_t **nodes = NULL, *node;
+    int *capacity = NULL, *part = NULL;
+    int i, k, nnodes, total = 0, extra, rc;
+
+    nnodes = (int) pmix_list_get_size(node_list);
+    nodes = (prte_node_t **) malloc(nnodes * sizeof(prte_node_t *));
+    capacity = (int *) malloc(nnodes * sizeof(int));
+    part = (int *) malloc(app->num_procs * sizeof(int));
+    if (NULL == nodes || NULL == capacity || NULL == part) {
+        rc = PRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    i = 0;
+    PMIX_LIST_FOREACH(node, node_list, prte_node_t)
+    {
+        nodes[i] = node;
+        capacity[i] = (0 < node->slots_available) ? node->slots_available : 0;
+        total += capacity[i];
+        ++i;
+    }
+    /* we only get here short of slots if oversubscription is
+     * allowed - spread the overflow evenly */
+    if (total < (int) app->num_procs) {
+        extra = app->num_procs - total;
+        for (i = 0; i < nnodes; i++) {
+            capacity[i] += extra / nnodes + ((i < extra % nnodes) ? 1 : 0);
+        }
+    }
+
+    rc = prte_rmaps_affinity_partition(comm, blk->base, app->num_procs,
+                                       nnodes, capacity, part);
+    if (PRTE_SUCCESS != rc) {
+        goto cleanup;
+    }
+
+    for (i = 0; i < nnodes; i++) {
+        blk->nprocs = 0;
+        for (k = 0; k < (int) app->num_procs; k++) {
+            if (i == part[k]) {
+                blk->ranks[blk->nprocs++] = blk->base + k;
+            }
+        }
+        if (0 == blk->nprocs) {
+            continue;
+        }
+        rc = map_node(jdata, app, nodes[i], node_list, blk, true, true,
+                      blk->base, type, gpu, comm, options);
+        if (PRTE_ERR_TAKE_NEXT_OPTION == rc) {
+            pmix_show_help("help-prte-rmaps-base.txt", "prte-rmaps-base:alloc-error", true,
+                           app->num_procs, app->app, prte_process_info.nodename);
+            PRTE_UPDATE_EXIT_STATUS(PRTE_ERROR_DEFAULT_EXIT_CODE);
+            rc = PRTE_ERR_SILENT;
+        }
+        if (PRTE_SUCCESS != rc) {
+            goto cleanup;
+        }
+    }
+
+cleanup:
+    free(nodes);
+    free(capacity);
+    free(part);
+    return rc;
+}
+
+/*
+ * Split the ranks of each app across its nodes and then place each
+ * node's share onto the node's hardware at minimum cost
+ */
+static int prte_rmaps_affinity_map(prte_job_t *jdata,
+                                   prte_rmaps_options_t *options)
+{
+    prte_app_context_t *app = NULL;
+    int i, k, rc;
+    pmix_list_t node_list;
+    int32_t num_slots;
+    pmix_rank_t vpid;
+    pmix_mca_base_component_t *c = &prte_mca_rmaps_affinity_component.super;
+    bool initial_map = true;
+    hwloc_obj_type_t type;
+    bool gpu;
+    aff_comm_t comm;
+    aff_block_t blk;
+
+    PMIX_OUTPUT_VERBOSE((1, prte_rmaps_base_framework.framework_output,
+                         "%s rmaps:affinity called on job %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                         PRTE_JOBID_PRINT(jdata->nspace)));
+
+    /* this mapper can only handle initial launch
+     * when affinity mapping is desired - allow
+     * restarting of failed apps
+     */
+    if (PRTE_FLAG_TEST(jdata, PRTE_JOB_FLAG_RESTART)) {
+        pmix_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                            "mca:rmaps:affinity: job %s is being restarted - affinity cannot map",
+                            PRTE_JOBID_PRINT(jdata->nspace));
+        return PRTE_ERR_TAKE_NEXT_OPTION;
+    }
+    if (NULL != jdata->map->req_mapper) {
+        if (0 != strcasecmp(jdata->map->req_mapper, c->pmix_mca_component_name)) {
+            /* a mapper has been specified, and it isn't me */
+            pmix_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                                "mca:rmaps:affinity: job %s not using affinity mapper",
+                                PRTE_JOBID_PRINT(jdata->nspace));
+            return PRTE_ERR_TAKE_NEXT_OPTION;
+        }
+    }
+    if (PRTE_MAPPING_AFFINITY != PRTE_GET_MAPPING_POLICY(jdata->map->mapping)) {
+        /* I don't know how to do these - defer */
+        pmix_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                            "mca:rmaps:affinity: job %s not using affinity mapper",
+                            PRTE_JOBID_PRINT(jdata->nspace));
+        return PRTE_ERR_TAKE_NEXT_OPTION;
+    }
+
+    pmix_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                        "mca:rmaps:affinity: mapping job %s",
+                        PRTE_JOBID_PRINT(jdata->nspace));
+
+    /* flag that I did the mapping */
+    if (NULL != jdata->map->last_mapper) {
+        free(jdata->map->last_mapper);
+    }
+    jdata->map->last_mapper = strdup(c->pmix_mca_component_name);
+
+    rc = get_target(options, &type, &gpu);
+    if (PRTE_SUCCESS != rc) {
+        return rc;
+    }
+    memset(&comm, 0, sizeof(aff_comm_t));
+    if (NULL != prte_mca_rmaps_affinity_component.comm_file) {
+        rc = load_comm_file(prte_mca_rmaps_affinity_component.comm_file, &comm);
+        if (PRTE_SUCCESS != rc) {
+            return rc;
+        }
+    }
+
+    /* start at the beginning... */
+    vpid = 0;
+    jdata->num_procs = 0;
+    memset(&blk, 0, sizeof(aff_block_t));
+
+    /* setup the nodelist here in case we jump to error */
+    PMIX_CONSTRUCT(&node_list, pmix_list_t);
+
+    for (i = 0; i < jdata->apps->size; i++) {
+        app = (prte_app_context_t *) pmix_pointer_array_get_item(jdata->apps, i);
+        if (NULL == app) {
+            continue;
+        }
+
+        /* for each app_context, we have to get the list of nodes that it can
+         * use since that can now be modified with a hostfile and/or -host
+         * option
+         */
+        rc = prte_rmaps_base_get_target_nodes(&node_list, &num_slots, jdata, app,
+                                              jdata->map->mapping, initial_map, false);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            goto error;
+        }
+        /* flag that all subsequent requests should not reset the node->mapped flag */
+        initial_map = false;
+
+        if (num_slots < (int) app->num_procs) {
+            if (!options->oversubscribe) {
+                pmix_show_help("help-prte-rmaps-base.txt", "prte-rmaps-base:alloc-error", true,
+                               app->num_procs, app->app, prte_process_info.nodename);
+                PRTE_UPDATE_EXIT_STATUS(PRTE_ERROR_DEFAULT_EXIT_CODE);
+                rc = PRTE_ERR_SILENT;
+                goto error;
+            }
+            if (!PRTE_BINDING_POLICY_IS_SET(jdata->map->binding)) {
+                jdata->map->binding = PRTE_BIND_TO_NONE;
+                options->bind = PRTE_BIND_TO_NONE;
+            }
+        }
+
+        /* the ranks of this app run from vpid */
+        blk.base = vpid;
+        blk.range = app->num_procs;
+        blk.ranks = (pmix_rank_t *) malloc(app->num_procs * sizeof(pmix_rank_t));
+        blk.local = (int *) malloc(app->num_procs * sizeof(int));
+        if (NULL == blk.ranks || NULL == blk.local) {
+            rc = PRTE_ERR_OUT_OF_RESOURCE;
+            goto error;
+        }
+        for (k = 0; k < (int) app->num_procs; k++) {
+            blk.local[k] = -1;
+        }
+
+        /* only worth partitioning if we know who talks to whom */
+        if (prte_mca_rmaps_affinity_component.partition &&
+            0 < comm.nranks && 1 < pmix_list_get_size(&node_list)) {
+            rc = map_partitioned(jdata, app, &node_list, &blk, type, gpu, &comm, options);
+        } else {
+            rc = map_blocks(jdata, app, &node_list, &blk, type, gpu, &comm, options);
+        }
+        free(blk.ranks);
+        free(blk.local);
+        blk.ranks = NULL;
+        blk.local = NULL;
+        if (PRTE_SUCCESS != rc) {
+            goto error;
+        }
+        vpid += app->num_procs;
+
+        /* track the total number of processes we mapped - must update
+         * this value AFTER we compute vpids so that computation
+         * is done correctly
+         */
+        jdata->num_procs += app->num_procs;
+
+        /* cleanup the node list - it can differ from one app_context
+         * to another, so we have to get it every time
+         */
+        PMIX_LIST_DESTRUCT(&node_list);
+        PMIX_CONSTRUCT(&node_list, pmix_list_t);
+    }
+    PMIX_LIST_DESTRUCT(&node_list);
+    comm_free(&comm);
+
+    /* compute local/app ranks */
+    rc = prte_rmaps_base_compute_vpids(jdata, options);
+    return rc;
+
+error:
+    PMIX_LIST_DESTRUCT(&node_list);
+    comm_free(&comm);
+    free(blk.ranks);
+    free(blk.local);
+    if (PRTE_ERR_SILENT != rc) {
+        pmix_show_help("help-prte-rmaps-base.txt",
+                       "failed-map", true,
+                       PRTE_ERROR_NAME(rc),
+                       (NULL == app) ? "N/A" : app->app,
+                       (NULL == app) ? -1 : app->num_procs,
+                       prte_rmaps_base_print_mapping(options->map),
+                       prte_hwloc_base_print_binding(options->bind));
+    }
+    return PRTE_ERR_SILENT;
+}
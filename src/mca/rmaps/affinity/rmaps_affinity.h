@@ -0,0 +1,59 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ *
+ * Affinity-aware mapper - splits the ranks across nodes so as to
+ * minimize inter-node traffic in a user-supplied rank communication
+ * graph, then places the ranks assigned to each node onto the node's
+ * hardware objects by solving a minimum-cost assignment over the
+ * hwloc topology distances.
+ */
+#ifndef PRTE_RMAPS_AFFINITY_H
+#define PRTE_RMAPS_AFFINITY_H
+
+#include "prte_config.h"
+#include "src/mca/rmaps/rmaps.h"
+
+BEGIN_C_DECLS
+
+struct prte_rmaps_affinity_component_t {
+    prte_rmaps_base_component_t super;
+    char *target;
+    char *comm_file;
+    char *comm_format;
+    bool partition;
+    int solver_limit;
+    int passes;
+};
+typedef struct prte_rmaps_affinity_component_t prte_rmaps_affinity_component_t;
+
+PRTE_MODULE_EXPORT extern prte_rmaps_affinity_component_t prte_mca_rmaps_affinity_component;
+extern prte_rmaps_base_module_t prte_rmaps_affinity_module;
+
+/* sparse, symmetric rank communication matrix stored as
+ * one row of (peer, weight) entries per rank */
+typedef struct {
+    pmix_rank_t nranks;
+    size_t *start;
+    pmix_rank_t *peer;
+    int64_t *weight;
+} prte_rmaps_affinity_comm_t;
+
+/* split ranks [base, base + nranks) into nparts parts holding no
+ * more than capacity[p] ranks each, minimizing the communication
+ * weight between parts. The part of rank base + k is returned in
+ * part[k] */
+int prte_rmaps_affinity_partition(prte_rmaps_affinity_comm_t *comm,
+                                  pmix_rank_t base, int nranks,
+                                  int nparts, const int *capacity,
+                                  int *part);
+
+END_C_DECLS
+
+#endif
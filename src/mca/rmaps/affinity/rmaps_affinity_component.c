@@ -0,0 +1,114 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include "src/mca/base/pmix_base.h"
+
+#include "rmaps_affinity.h"
+#include "src/mca/rmaps/rmaps.h"
+
+/*
+ * Local functions
+ */
+
+static int prte_rmaps_affinity_register(void);
+static int prte_rmaps_affinity_query(pmix_mca_base_module_t **module, int *priority);
+
+static int my_priority;
+
+prte_rmaps_affinity_component_t prte_mca_rmaps_affinity_component = {
+    .super = {
+        PRTE_RMAPS_BASE_VERSION_4_0_0,
+
+        .pmix_mca_component_name = "affinity",
+        PMIX_MCA_BASE_MAKE_VERSION(component,
+                                   PRTE_MAJOR_VERSION,
+                                   PRTE_MINOR_VERSION,
+                                   PMIX_RELEASE_VERSION),
+        .pmix_mca_query_component = prte_rmaps_affinity_query,
+        .pmix_mca_register_component_params = prte_rmaps_affinity_register,
+    },
+    .target = NULL,
+    .comm_file = NULL,
+    .comm_format = NULL,
+    .partition = true,
+    .solver_limit = 64,
+    .passes = 2
+};
+
+/**
+ * component register/open/close/init function
+ */
+static int prte_rmaps_affinity_register(void)
+{
+    pmix_mca_base_component_t *c = &prte_mca_rmaps_affinity_component.super;
+
+    my_priority = 65;
+    (void) pmix_mca_base_component_var_register(c, "priority",
+                                                "Priority of the affinity rmaps component",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &my_priority);
+
+    prte_mca_rmaps_affinity_component.target = "auto";
+    (void) pmix_mca_base_component_var_register(c, "target",
+                                                "Hardware object ranks are placed onto [auto | hwthread | core | "
+                                                "numa | package | gpu]. \"auto\" follows the binding level, "
+                                                "using cores if the job is not bound",
+                                                PMIX_MCA_BASE_VAR_TYPE_STRING,
+                                                &prte_mca_rmaps_affinity_component.target);
+
+    prte_mca_rmaps_affinity_component.comm_file = NULL;
+    (void) pmix_mca_base_component_var_register(c, "comm_file",
+                                                "Path to a rank communication graph used to weight placement, "
+                                                "in the format given by rmaps_affinity_comm_format",
+                                                PMIX_MCA_BASE_VAR_TYPE_STRING,
+                                                &prte_mca_rmaps_affinity_component.comm_file);
+
+    prte_mca_rmaps_affinity_component.comm_format = "edges";
+    (void) pmix_mca_base_component_var_register(c, "comm_format",
+                                                "Format of the communication graph file [edges | metis]. "
+                                                "\"edges\" holds one \"<rank> <rank> <weight>\" entry per "
+                                                "line with '#' comments; \"metis\" is the METIS graph format "
+                                                "with vertex i being rank i-1",
+                                                PMIX_MCA_BASE_VAR_TYPE_STRING,
+                                                &prte_mca_rmaps_affinity_component.comm_format);
+
+    prte_mca_rmaps_affinity_component.partition = true;
+    (void) pmix_mca_base_component_var_register(c, "partition",
+                                                "Partition the communication graph across the nodes to "
+                                                "minimize inter-node traffic, rather than giving each node "
+                                                "a contiguous block of ranks",
+                                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                                &prte_mca_rmaps_affinity_component.partition);
+
+    prte_mca_rmaps_affinity_component.solver_limit = 64;
+    (void) pmix_mca_base_component_var_register(c, "solver_limit",
+                                                "Largest number of ranks on a node for which the exact "
+                                                "min-cost assignment is solved - larger nodes use a greedy "
+                                                "heuristic (0 => always use the heuristic)",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &prte_mca_rmaps_affinity_component.solver_limit);
+
+    prte_mca_rmaps_affinity_component.passes = 2;
+    (void) pmix_mca_base_component_var_register(c, "passes",
+                                                "Number of refinement passes used when solving "
+                                                "the placement against the communication matrix",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &prte_mca_rmaps_affinity_component.passes);
+    return PRTE_SUCCESS;
+}
+
+static int prte_rmaps_affinity_query(pmix_mca_base_module_t **module, int *priority)
+{
+    *priority = my_priority;
+    *module = (pmix_mca_base_module_t *) &prte_rmaps_affinity_module;
+    return PRTE_SUCCESS;
+}
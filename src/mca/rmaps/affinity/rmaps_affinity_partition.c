@@ -0,0 +1,502 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Multilevel partitioning of the rank communication graph across
+ * nodes. The graph is repeatedly coarsened by collapsing the
+ * heaviest edges, the coarsest graph is split by greedy graph
+ * growing, and the split is then projected back through the levels
+ * with a boundary refinement pass at each one - the usual recipe
+ * of the METIS family of partitioners, restricted to what we need
+ * here: integer node capacities and minimum edge cut.
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <string.h>
+
+#include "src/mca/errmgr/errmgr.h"
+
+#include "rmaps_affinity.h"
+#include "src/mca/rmaps/base/base.h"
+
+/* stop coarsening once the graph is this many times the number of
+ * parts, or when a level fails to shrink the graph by 10% */
+#define AFF_COARSEN_RATIO  16
+#define AFF_COARSEN_MIN    64
+#define AFF_MAX_LEVELS     32
+#define AFF_REFINE_PASSES  4
+
+typedef struct {
+    int n;
+    int *xadj;
+    int *adj;
+    int64_t *ewgt;
+    int *vwgt;
+    int *cmap;      // vertex -> vertex of the next coarser level
+    int *where;     // vertex -> part
+} aff_graph_t;
+
+static void graph_free(aff_graph_t *g)
+{
+    free(g->xadj);
+    free(g->adj);
+    free(g->ewgt);
+    free(g->vwgt);
+    free(g->cmap);
+    free(g->where);
+    memset(g, 0, sizeof(aff_graph_t));
+}
+
+static int graph_alloc(aff_graph_t *g, int n, int m)
+{
+    memset(g, 0, sizeof(aff_graph_t));
+    g->n = n;
+    g->xadj = (int *) calloc(n + 1, sizeof(int));
+    g->adj = (int *) malloc((m + 1) * sizeof(int));
+    g->ewgt = (int64_t *) malloc((m + 1) * sizeof(int64_t));
+    g->vwgt = (int *) calloc(n, sizeof(int));
+    g->where = (int *) malloc(n * sizeof(int));
+    if (NULL == g->xadj || NULL == g->adj || NULL == g->ewgt ||
+        NULL == g->vwgt || NULL == g->where) {
+        graph_free(g);
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    return PRTE_SUCCESS;
+}
+
+/* extract the subgraph induced by ranks [base, base + n) */
+static int build_graph(prte_rmaps_affinity_comm_t *comm, pmix_rank_t base,
+                       int n, aff_graph_t *g)
+{
+    pmix_rank_t r, j;
+    size_t e;
+    int k, m = 0, rc;
+
+    for (k = 0; k < n; k++) {
+        r = base + k;
+        if (r >= comm->nranks) {
+            break;
+        }
+        for (e = comm->start[r]; e < comm->start[r + 1]; e++) {
+            j = comm->peer[e];
+            if (j >= base && j < base + (pmix_rank_t) n) {
+                ++m;
+            }
+        }
+    }
+    if (PRTE_SUCCESS != (rc = graph_alloc(g, n, m))) {
+        return rc;
+    }
+    m = 0;
+    for (k = 0; k < n; k++) {
+        g->vwgt[k] = 1;
+        r = base + k;
+        if (r < comm->nranks) {
+            for (e = comm->start[r]; e < comm->start[r + 1]; e++) {
+                j = comm->peer[e];
+                if (j >= base && j < base + (pmix_rank_t) n) {
+                    g->adj[m] = (int) (j - base);
+                    g->ewgt[m] = comm->weight[e];
+                    ++m;
+                }
+            }
+        }
+        g->xadj[k + 1] = m;
+    }
+    return PRTE_SUCCESS;
+}
+
+/* collapse a heavy-edge matching of g into c. Returns
+ * PRTE_ERR_TAKE_NEXT_OPTION if the graph would barely shrink */
+static int coarsen(aff_graph_t *g, int maxvwgt, aff_graph_t *c)
+{
+    int *match, *marker;
+    int v, u, e, x, best, nc = 0, cnt, start, cu, rc;
+    int64_t bw;
+
+    match = (int *) malloc(g->n * sizeof(int));
+    g->cmap = (int *) malloc(g->n * sizeof(int));
+    if (NULL == match || NULL == g->cmap) {
+        free(match);
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    for (v = 0; v < g->n; v++) {
+        match[v] = -1;
+    }
+
+    /* every vertex below v is already matched, so a partner is
+     * always above v and coarse vertices are numbered in order
+     * of their lower fine vertex */
+    for (v = 0; v < g->n; v++) {
+        if (0 <= match[v]) {
+            continue;
+        }
+        best = -1;
+        bw = -1;
+        for (e = g->xadj[v]; e < g->xadj[v + 1]; e++) {
+            u = g->adj[e];
+            if (u == v || 0 <= match[u] || g->vwgt[u] + g->vwgt[v] > maxvwgt) {
+                continue;
+            }
+            if (g->ewgt[e] > bw) {
+                best = u;
+                bw = g->ewgt[e];
+            }
+        }
+        if (0 <= best) {
+            match[v] = best;
+            match[best] = v;
+            g->cmap[v] = g->cmap[best] = nc++;
+        } else {
+            match[v] = v;
+            g->cmap[v] = nc++;
+        }
+    }
+    if (10 * nc > 9 * g->n) {
+        free(match);
+        return PRTE_ERR_TAKE_NEXT_OPTION;
+    }
+
+    if (PRTE_SUCCESS != (rc = graph_alloc(c, nc, g->xadj[g->n]))) {
+        free(match);
+        return rc;
+    }
+    marker = (int *) malloc(nc * sizeof(int));
+    if (NULL == marker) {
+        free(match);
+        graph_free(c);
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    for (u = 0; u < nc; u++) {
+        marker[u] = -1;
+    }
+
+    cnt = 0;
+    for (v = 0; v < g->n; v++) {
+        if (match[v] < v) {
+            /* already merged with its lower partner */
+            continue;
+        }
+        cu = g->cmap[v];
+        start = cnt;
+        c->vwgt[cu] = g->vwgt[v];
+        if (match[v] != v) {
+            c->vwgt[cu] += g->vwgt[match[v]];
+        }
+        for (x = v; ; x = match[v]) {
+            for (e = g->xadj[x]; e < g->xadj[x + 1]; e++) {
+                u = g->cmap[g->adj[e]];
+                if (u == cu) {
+                    continue;
+                }
+                if (marker[u] >= start) {
+                    c->ewgt[marker[u]] += g->ewgt[e];
+                } else {
+                    marker[u] = cnt;
+                    c->adj[cnt] = u;
+                    c->ewgt[cnt] = g->ewgt[e];
+                    ++cnt;
+                }
+            }
+            if (x == match[v]) {
+                break;
+            }
+        }
+        c->xadj[cu + 1] = cnt;
+    }
+    free(marker);
+    free(match);
+    return PRTE_SUCCESS;
+}
+
+/* grow each part in turn from a seed, always adding the vertex most
+ * strongly connected to the part so far */
+static int initial_partition(aff_graph_t *g, int nparts, const int *capacity,
+                             int64_t *load)
+{
+    int64_t *conn;
+    int *frontier;
+    bool *queued;
+    int p, v, u, e, k, nfront, pick, cursor = 0;
+
+    conn = (int64_t *) calloc(g->n, sizeof(int64_t));
+    frontier = (int *) malloc(g->n * sizeof(int));
+    queued = (bool *) calloc(g->n, sizeof(bool));
+    if (NULL == conn || NULL == frontier || NULL == queued) {
+        free(conn);
+        free(frontier);
+        free(queued);
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    for (v = 0; v < g->n; v++) {
+        g->where[v] = -1;
+    }
+
+    for (p = 0; p < nparts; p++) {
+        nfront = 0;
+        while (load[p] < capacity[p]) {
+            /* strongest connected vertex that still fits */
+            pick = -1;
+            for (k = 0; k < nfront; ) {
+                v = frontier[k];
+                if (0 <= g->where[v]) {
+                    frontier[k] = frontier[--nfront];
+                    queued[v] = false;
+                    continue;
+                }
+                if (load[p] + g->vwgt[v] <= capacity[p] &&
+                    (0 > pick || conn[v] > conn[pick] ||
+                     (conn[v] == conn[pick] && v < pick))) {
+                    pick = v;
+                }
+                ++k;
+            }
+            if (0 > pick) {
+                /* nothing connected fits - seed from the lowest
+                 * unassigned vertex that does */
+                while (cursor < g->n && 0 <= g->where[cursor]) {
+                    ++cursor;
+                }
+                for (v = cursor; v < g->n; v++) {
+                    if (0 > g->where[v] && load[p] + g->vwgt[v] <= capacity[p]) {
+                        pick = v;
+                        break;
+                    }
+                }
+                if (0 > pick) {
+                    break;
+                }
+            }
+            g->where[pick] = p;
+            load[p] += g->vwgt[pick];
+            for (e = g->xadj[pick]; e < g->xadj[pick + 1]; e++) {
+                u = g->adj[e];
+                if (0 <= g->where[u]) {
+                    continue;
+                }
+                conn[u] += g->ewgt[e];
+                if (!queued[u]) {
+                    queued[u] = true;
+                    frontier[nfront++] = u;
+                }
+            }
+        }
+        /* connections only count towards the part being grown */
+        for (k = 0; k < nfront; k++) {
+            conn[frontier[k]] = 0;
+            queued[frontier[k]] = false;
+        }
+    }
+
+    /* anything left over didn't fit as a whole - put it where there
+     * is the most room and let refinement rebalance it */
+    for (v = 0; v < g->n; v++) {
+        if (0 <= g->where[v]) {
+            continue;
+        }
+        pick = 0;
+        for (p = 1; p < nparts; p++) {
+            if (capacity[p] - load[p] > capacity[pick] - load[pick]) {
+                pick = p;
+            }
+        }
+        g->where[v] = pick;
+        load[pick] += g->vwgt[v];
+    }
+
+    free(conn);
+    free(frontier);
+    free(queued);
+    return PRTE_SUCCESS;
+}
+
+/* move boundary vertices to the neighboring part they are most
+ * connected to whenever that lowers the cut and the part has room,
+ * and move vertices out of overloaded parts regardless of gain */
+static void refine(aff_graph_t *g, int nparts, const int *capacity,
+                   int64_t *load, int64_t *conn, int *touched)
+{
+    int pass, v, e, p, q, k, nt, best, moved;
+    int64_t gain, bestgain;
+    bool over;
+
+    for (pass = 0; pass < AFF_REFINE_PASSES; pass++) {
+        moved = 0;
+        for (v = 0; v < g->n; v++) {
+            p = g->where[v];
+            over = load[p] > capacity[p];
+            nt = 0;
+            for (e = g->xadj[v]; e < g->xadj[v + 1]; e++) {
+                q = g->where[g->adj[e]];
+                if (0 == conn[q]) {
+                    touched[nt++] = q;
+                }
+                conn[q] += g->ewgt[e];
+            }
+            if (0 == nt && !over) {
+                continue;
+            }
+            best = -1;
+            bestgain = 0;
+            for (k = 0; k < nt; k++) {
+                q = touched[k];
+                if (q == p || load[q] + g->vwgt[v] > capacity[q]) {
+                    continue;
+                }
+                gain = conn[q] - conn[p];
+                if ((over && 0 > best) || gain > bestgain) {
+                    best = q;
+                    bestgain = gain;
+                }
+            }
+            if (over && 0 > best) {
+                for (q = 0; q < nparts; q++) {
+                    if (q != p && load[q] + g->vwgt[v] <= capacity[q] &&
+                        (0 > best || load[q] < load[best])) {
+                        best = q;
+                    }
+                }
+            }
+            for (k = 0; k < nt; k++) {
+                conn[touched[k]] = 0;
+            }
+            if (0 <= best) {
+                g->where[v] = best;
+                load[p] -= g->vwgt[v];
+                load[best] += g->vwgt[v];
+                ++moved;
+            }
+        }
+        if (0 == moved) {
+            break;
+        }
+    }
+}
+
+static int64_t edge_cut(aff_graph_t *g, int *where)
+{
+    int64_t cut = 0;
+    int v, e;
+
+    for (v = 0; v < g->n; v++) {
+        for (e = g->xadj[v]; e < g->xadj[v + 1]; e++) {
+            if (where[v] != where[g->adj[e]]) {
+                cut += g->ewgt[e];
+            }
+        }
+    }
+    return cut;
+}
+
+int prte_rmaps_affinity_partition(prte_rmaps_affinity_comm_t *comm,
+                                  pmix_rank_t base, int nranks,
+                                  int nparts, const int *capacity,
+                                  int *part)
+{
+    aff_graph_t lv[AFF_MAX_LEVELS];
+    int64_t *load = NULL, *conn = NULL, cut;
+    int *touched = NULL;
+    int nlv, l, v, p, maxvwgt, mincap = 0, target, rc;
+
+    if (1 == nparts) {
+        for (v = 0; v < nranks; v++) {
+            part[v] = 0;
+        }
+        return PRTE_SUCCESS;
+    }
+
+    memset(lv, 0, sizeof(lv));
+    if (PRTE_SUCCESS != (rc = build_graph(comm, base, nranks, &lv[0]))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* a coarse vertex must never be too big to fit in a part */
+    for (p = 0; p < nparts; p++) {
+        if (0 < capacity[p] && (0 == mincap || capacity[p] < mincap)) {
+            mincap = capacity[p];
+        }
+    }
+    maxvwgt = (1 < mincap / 2) ? mincap / 2 : 1;
+    target = AFF_COARSEN_RATIO * nparts;
+    if (target < AFF_COARSEN_MIN) {
+        target = AFF_COARSEN_MIN;
+    }
+    for (nlv = 1; nlv < AFF_MAX_LEVELS && lv[nlv - 1].n > target; nlv++) {
+        rc = coarsen(&lv[nlv - 1], maxvwgt, &lv[nlv]);
+        if (PRTE_ERR_TAKE_NEXT_OPTION == rc) {
+            break;
+        }
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            goto cleanup;
+        }
+    }
+    pmix_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                        "mca:rmaps:affinity: partitioning %d ranks into %d parts over %d levels",
+                        nranks, nparts, nlv);
+
+    load = (int64_t *) calloc(nparts, sizeof(int64_t));
+    conn = (int64_t *) calloc(nparts, sizeof(int64_t));
+    touched = (int *) malloc(nparts * sizeof(int));
+    if (NULL == load || NULL == conn || NULL == touched) {
+        rc = PRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+
+    rc = initial_partition(&lv[nlv - 1], nparts, capacity, load);
+    if (PRTE_SUCCESS != rc) {
+        goto cleanup;
+    }
+    refine(&lv[nlv - 1], nparts, capacity, load, conn, touched);
+    /* vertex weights add up, so the part loads carry over */
+    for (l = nlv - 1; 0 < l; l--) {
+        for (v = 0; v < lv[l - 1].n; v++) {
+            lv[l - 1].where[v] = lv[l].where[lv[l - 1].cmap[v]];
+        }
+        graph_free(&lv[l]);
+        refine(&lv[l - 1], nparts, capacity, load, conn, touched);
+    }
+
+    for (p = 0; p < nparts; p++) {
+        if (load[p] > capacity[p]) {
+            /* cannot happen unless the capacities don't cover
+             * the ranks */
+            rc = PRTE_ERR_OUT_OF_RESOURCE;
+            goto cleanup;
+        }
+    }
+    cut = edge_cut(&lv[0], lv[0].where);
+    memcpy(part, lv[0].where, nranks * sizeof(int));
+
+    /* rank order often already follows the structure of the problem,
+     * so also try refining plain contiguous blocks and keep that if
+     * it cuts less */
+    memset(load, 0, nparts * sizeof(int64_t));
+    for (v = 0, p = 0; v < nranks; v++) {
+        while (p < nparts - 1 && load[p] >= capacity[p]) {
+            ++p;
+        }
+        lv[0].where[v] = p;
+        ++load[p];
+    }
+    refine(&lv[0], nparts, capacity, load, conn, touched);
+    if (edge_cut(&lv[0], lv[0].where) < cut) {
+        memcpy(part, lv[0].where, nranks * sizeof(int));
+    }
+    rc = PRTE_SUCCESS;
+
+cleanup:
+    for (l = 0; l < AFF_MAX_LEVELS; l++) {
+        graph_free(&lv[l]);
+    }
+    free(load);
+    free(conn);
+    free(touched);
+    return rc;
+}
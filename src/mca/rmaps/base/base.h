@@ -79,6 +79,8 @@ typedef struct {
     char *default_mapping_policy;
     /* whether or not to require hwtcpus due to topology limitations */
     bool require_hwtcpus;
+    /* whether or not to report the time spent in each mapping phase */
+    bool report_timings;
 } prte_rmaps_base_t;
 
 /**
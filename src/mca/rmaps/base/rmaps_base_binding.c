@@ -399,11 +399,36 @@ static int bind_multiple(prte_job_t *jdata, prte_proc_t *proc,
     return PRTE_SUCCESS;
 }
 
+static int bind_proc(prte_job_t *jdata,
+                     prte_proc_t *proc,
+                     prte_node_t *node,
+                     hwloc_obj_t obj,
+                     prte_rmaps_options_t *options);
+
 int prte_rmaps_base_bind_proc(prte_job_t *jdata,
                               prte_proc_t *proc,
                               prte_node_t *node,
                               hwloc_obj_t obj,
                               prte_rmaps_options_t *options)
+{
+    double start;
+    int rc;
+
+    if (!prte_rmaps_base.report_timings) {
+        return bind_proc(jdata, proc, node, obj, options);
+    }
+    start = prte_rmaps_base_timestamp();
+    rc = bind_proc(jdata, proc, node, obj, options);
+    prte_rmaps_base_timings.binding += prte_rmaps_base_timestamp() - start;
+    prte_rmaps_base_timings.nbinds++;
+    return rc;
+}
+
+static int bind_proc(prte_job_t *jdata,
+                     prte_proc_t *proc,
+                     prte_node_t *node,
+                     hwloc_obj_t obj,
+                     prte_rmaps_options_t *options)
 {
     int rc;
 
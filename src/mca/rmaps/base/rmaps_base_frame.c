@@ -63,8 +63,10 @@ prte_rmaps_base_t prte_rmaps_base = {
     .file = NULL,
     .available = NULL,
     .baseset = NULL,
-    .default_mapping_policy = NULL
+    .default_mapping_policy = NULL,
+    .report_timings = false
 };
+prte_rmaps_base_timings_t prte_rmaps_base_timings = {0};
 
 /*
  * Local variables
@@ -81,7 +83,7 @@ static int prte_rmaps_base_register(pmix_mca_base_register_flag_t flags)
     (void) pmix_mca_base_var_register("prte", "rmaps", "default", "mapping_policy",
                                       "Default mapping Policy [slot | hwthread | core | l1cache | "
                                       "l2cache | l3cache | numa | package | node | seq | dist | ppr | "
-                                      "rankfile | likwid | pe-list=a,b (comma-delimited ranges of cpus to use for this job)],"
+                                      "rankfile | likwid | affinity | pe-list=a,b (comma-delimited ranges of cpus to use for this job)],"
                                       " with supported colon-delimited modifiers: PE=y (for multiple cpus/proc), "
                                       "SPAN, OVERSUBSCRIBE, NOOVERSUBSCRIBE, NOLOCAL, HWTCPUS, CORECPUS, "
                                       "DEVICE=dev (for dist policy), INHERIT, NOINHERIT, ORDERED, FILE=%s (path to file containing sequential "
@@ -103,6 +105,13 @@ static int prte_rmaps_base_register(pmix_mca_base_register_flag_t flags)
                                       PMIX_MCA_BASE_VAR_TYPE_BOOL,
                                       &rmaps_base_inherit);
 
+    prte_rmaps_base.report_timings = false;
+    (void) pmix_mca_base_var_register("prte", "rmaps", "base", "report_timings",
+                                      "Report the time spent finding target nodes, mapping, "
+                                      "ranking and binding each job",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &prte_rmaps_base.report_timings);
+
     return PRTE_SUCCESS;
 }
 
@@ -696,6 +705,9 @@ int prte_rmaps_base_set_mapping_policy(prte_job_t *jdata, char *inspec)
     } else if (PMIX_CHECK_CLI_OPTION(cptr, PRTE_CLI_LIKWID)) {
         PRTE_SET_MAPPING_POLICY(tmp, PRTE_MAPPING_LIKWID);
 
+    } else if (PMIX_CHECK_CLI_OPTION(cptr, PRTE_CLI_AFFINITY)) {
+        PRTE_SET_MAPPING_POLICY(tmp, PRTE_MAPPING_AFFINITY);
+
     } else {
         pmix_show_help("help-prte-rmaps-base.txt", "unrecognized-policy",
                        true, "mapping", cptr);
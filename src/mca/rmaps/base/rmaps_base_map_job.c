@@ -80,9 +80,15 @@ void prte_rmaps_base_map_job(int fd, short args, void *cbdata)
     pmix_data_array_t *darray = NULL;
     pmix_list_t nodes;
     int slots, len;
+    double start = 0.0, mapstart = 0.0, elapsed;
 
     PRTE_HIDE_UNUSED_PARAMS(fd, args);
 
+    if (prte_rmaps_base.report_timings) {
+        memset(&prte_rmaps_base_timings, 0, sizeof(prte_rmaps_base_timings_t));
+        start = prte_rmaps_base_timestamp();
+    }
+
     PMIX_ACQUIRE_OBJECT(caddy);
     jdata = caddy->jdata;
     schizo = (prte_schizo_base_module_t*)jdata->schizo;
@@ -557,6 +563,7 @@ ranking:
         case PRTE_MAPPING_BYUSER:
         case PRTE_MAPPING_SEQ:
         case PRTE_MAPPING_LIKWID:
+        case PRTE_MAPPING_AFFINITY:
             options.mapdepth = PRTE_BIND_TO_NONE;
             options.userranked = true;
             options.maptype = HWLOC_OBJ_MACHINE;
@@ -815,7 +822,13 @@ ranking:
             PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_MAP_FAILED);
             goto cleanup;
         }
+        if (prte_rmaps_base.report_timings) {
+            mapstart = prte_rmaps_base_timestamp();
+        }
         rc = map_colocate(jdata, colocate_daemons, pernode, darray, procs_per_target, &options);
+        if (prte_rmaps_base.report_timings) {
+            prte_rmaps_base_timings.mapper = prte_rmaps_base_timestamp() - mapstart;
+        }
         PMIX_DATA_ARRAY_FREE(darray);
         if (PRTE_SUCCESS != rc) {
             jdata->exit_code = PRTE_ERR_BAD_PARAM;
@@ -835,10 +848,16 @@ ranking:
                 &prte_rmaps_base.selected_modules);
             jdata->map->req_mapper = strdup(mod->component->pmix_mca_component_name);
         }
+        if (prte_rmaps_base.report_timings) {
+            mapstart = prte_rmaps_base_timestamp();
+        }
         PMIX_LIST_FOREACH(mod, &prte_rmaps_base.selected_modules, prte_rmaps_base_selected_module_t)
         {
-            if (PRTE_SUCCESS == (rc = mod->module->map_job(jdata, &options)) ||
-                PRTE_ERR_RESOURCE_BUSY == rc) {
+            rc = mod->module->map_job(jdata, &options);
+            if (prte_rmaps_base.report_timings) {
+                prte_rmaps_base_timings.mapper = prte_rmaps_base_timestamp() - mapstart;
+            }
+            if (PRTE_SUCCESS == rc || PRTE_ERR_RESOURCE_BUSY == rc) {
                 did_map = true;
                 break;
             }
@@ -901,6 +920,25 @@ ranking:
         prte_rmaps_base_report_bindings(jdata, &options);
     }
 
+    if (prte_rmaps_base.report_timings) {
+        elapsed = prte_rmaps_base_timestamp() - start;
+        pmix_output(0, "%s rmaps:timing job %s mapper %s nodes %d procs %d map %s rank %s bind %s: "
+                    "total %.3f ms, mapper %.3f ms, targets %.3f ms (%lu calls), "
+                    "vpids %.3f ms, binding %.3f ms (%lu procs)",
+                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_JOBID_PRINT(jdata->nspace),
+                    (NULL == jdata->map->last_mapper) ? "N/A" : jdata->map->last_mapper,
+                    (int) jdata->map->num_nodes, (int) jdata->num_procs,
+                    prte_rmaps_base_print_mapping(jdata->map->mapping),
+                    prte_rmaps_base_print_ranking(jdata->map->ranking),
+                    prte_hwloc_base_print_binding(jdata->map->binding),
+                    elapsed * 1000.0, prte_rmaps_base_timings.mapper * 1000.0,
+                    prte_rmaps_base_timings.targets * 1000.0,
+                    (unsigned long) prte_rmaps_base_timings.ntargets,
+                    prte_rmaps_base_timings.vpids * 1000.0,
+                    prte_rmaps_base_timings.binding * 1000.0,
+                    (unsigned long) prte_rmaps_base_timings.nbinds);
+    }
+
     /* set the job state to the next position */
     PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_MAP_COMPLETE);
 
@@ -166,6 +166,9 @@ char *prte_rmaps_base_print_mapping(prte_mapping_policy_t mapping)
     case PRTE_MAPPING_LIKWID:
         map = "LIKWID";
         break;
+    case PRTE_MAPPING_AFFINITY:
+        map = "AFFINITY";
+        break;
     default:
         map = "UNKNOWN";
     }
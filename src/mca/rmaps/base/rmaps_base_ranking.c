@@ -70,8 +70,26 @@ static void compute_app_rank(prte_job_t *jdata)
     }
 }
 
+static int compute_vpids(prte_job_t *jdata,
+                         prte_rmaps_options_t *options);
+
 int prte_rmaps_base_compute_vpids(prte_job_t *jdata,
                                   prte_rmaps_options_t *options)
+{
+    double start;
+    int rc;
+
+    if (!prte_rmaps_base.report_timings) {
+        return compute_vpids(jdata, options);
+    }
+    start = prte_rmaps_base_timestamp();
+    rc = compute_vpids(jdata, options);
+    prte_rmaps_base_timings.vpids += prte_rmaps_base_timestamp() - start;
+    return rc;
+}
+
+static int compute_vpids(prte_job_t *jdata,
+                         prte_rmaps_options_t *options)
 {
     int m, n;
     unsigned k, nobjs, pass;
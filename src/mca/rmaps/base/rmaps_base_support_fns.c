@@ -99,6 +99,12 @@ int prte_rmaps_base_filter_nodes(prte_app_context_t *app, pmix_list_t *nodes, bo
     return rc;
 }
 
+static int get_target_nodes(pmix_list_t *allocated_nodes,
+                            int32_t *total_num_slots,
+                            prte_job_t *jdata, prte_app_context_t *app,
+                            prte_mapping_policy_t policy,
+                            bool initial_map, bool silent);
+
 /*
  * Query the registry for all nodes allocated to a specified app_context
  */
@@ -107,6 +113,27 @@ int prte_rmaps_base_get_target_nodes(pmix_list_t *allocated_nodes,
                                      prte_job_t *jdata, prte_app_context_t *app,
                                      prte_mapping_policy_t policy,
                                      bool initial_map, bool silent)
+{
+    double start;
+    int rc;
+
+    if (!prte_rmaps_base.report_timings) {
+        return get_target_nodes(allocated_nodes, total_num_slots, jdata, app,
+                                policy, initial_map, silent);
+    }
+    start = prte_rmaps_base_timestamp();
+    rc = get_target_nodes(allocated_nodes, total_num_slots, jdata, app,
+                          policy, initial_map, silent);
+    prte_rmaps_base_timings.targets += prte_rmaps_base_timestamp() - start;
+    prte_rmaps_base_timings.ntargets++;
+    return rc;
+}
+
+static int get_target_nodes(pmix_list_t *allocated_nodes,
+                            int32_t *total_num_slots,
+                            prte_job_t *jdata, prte_app_context_t *app,
+                            prte_mapping_policy_t policy,
+                            bool initial_map, bool silent)
 {
     pmix_list_item_t *item;
     prte_node_t *node, *nd, *nptr, *next;
@@ -846,3 +873,70 @@ int prte_rmaps_base_check_oversubscribed(prte_job_t *jdata,
     }
     return PRTE_SUCCESS;
 }
+
+static void index_node(pmix_hash_table_t *index, prte_node_t *node)
+{
+    void *ptr;
+    int n;
+
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(index, node->name,
+                                                      strlen(node->name), &ptr)) {
+        pmix_hash_table_set_value_ptr(index, node->name, strlen(node->name), node);
+    }
+    if (NULL != node->aliases) {
+        for (n = 0; NULL != node->aliases[n]; n++) {
+            if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(index, node->aliases[n],
+                                                              strlen(node->aliases[n]), &ptr)) {
+                pmix_hash_table_set_value_ptr(index, node->aliases[n],
+                                              strlen(node->aliases[n]), node);
+            }
+        }
+    }
+}
+
+void prte_rmaps_base_index_nodes(pmix_hash_table_t *index,
+                                 pmix_list_t *node_list)
+{
+    prte_node_t *node;
+    int32_t n, size;
+
+    if (NULL != node_list) {
+        size = pmix_list_get_size(node_list);
+    } else {
+        size = prte_node_pool->size;
+    }
+    pmix_hash_table_init(index, (0 < size) ? 2 * size : 32);
+
+    if (NULL != node_list) {
+        PMIX_LIST_FOREACH(node, node_list, prte_node_t) {
+            index_node(index, node);
+        }
+        return;
+    }
+    for (n = 0; n < prte_node_pool->size; n++) {
+        node = (prte_node_t *) pmix_pointer_array_get_item(prte_node_pool, n);
+        if (NULL == node) {
+            continue;
+        }
+        index_node(index, node);
+    }
+}
+
+prte_node_t *prte_rmaps_base_lookup_node(pmix_hash_table_t *index,
+                                         const char *name)
+{
+    void *ptr;
+
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(index, name, strlen(name), &ptr)) {
+        return (prte_node_t *) ptr;
+    }
+    /* the local node can be referred to by its loopback names */
+    if (0 == strcmp(name, "localhost") || 0 == strcmp(name, "127.0.0.1")) {
+        if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(index, prte_process_info.nodename,
+                                                          strlen(prte_process_info.nodename),
+                                                          &ptr)) {
+            return (prte_node_t *) ptr;
+        }
+    }
+    return NULL;
+}
@@ -32,6 +32,11 @@
 #include "prte_config.h"
 #include "types.h"
 
+#ifdef HAVE_SYS_TIME_H
+#    include <sys/time.h>
+#endif
+
+#include "src/class/pmix_hash_table.h"
 #include "src/hwloc/hwloc-internal.h"
 #include "src/runtime/prte_globals.h"
 
@@ -40,6 +45,26 @@
 
 BEGIN_C_DECLS
 
+/* time spent in each phase while mapping the current job - only
+ * tracked when rmaps_base_report_timings is set */
+typedef struct {
+    double mapper;
+    double targets;
+    double vpids;
+    double binding;
+    size_t ntargets;
+    size_t nbinds;
+} prte_rmaps_base_timings_t;
+PRTE_EXPORT extern prte_rmaps_base_timings_t prte_rmaps_base_timings;
+
+static inline double prte_rmaps_base_timestamp(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double) tv.tv_sec + (double) tv.tv_usec / 1000000.0;
+}
+
 /*
  * Base API functions
  */
@@ -73,6 +98,18 @@ PRTE_EXPORT int prte_rmaps_base_bind_proc(prte_job_t *jdata,
 PRTE_EXPORT void prte_rmaps_base_update_local_ranks(prte_job_t *jdata, prte_node_t *oldnode,
                                                     prte_node_t *newnode, prte_proc_t *newproc);
 
+/* index nodes by name and alias so that mappers driven by a file
+ * (rank_file, seq) can resolve each entry in constant time. If
+ * node_list is NULL, the global node pool is indexed. The first
+ * node registered under a given name wins, matching the order
+ * of a linear search. The caller must construct the table
+ * and destruct it when done - nodes are not retained */
+PRTE_EXPORT void prte_rmaps_base_index_nodes(pmix_hash_table_t *index,
+                                             pmix_list_t *node_list);
+
+PRTE_EXPORT prte_node_t *prte_rmaps_base_lookup_node(pmix_hash_table_t *index,
+                                                     const char *name);
+
 END_C_DECLS
 
 #endif
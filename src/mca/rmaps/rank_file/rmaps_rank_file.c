@@ -35,6 +35,9 @@
 #ifdef HAVE_UNISTD_H
 #    include <unistd.h>
 #endif /* HAVE_UNISTD_H */
+#ifdef HAVE_ARPA_INET_H
+#    include <arpa/inet.h>
+#endif
 #include <string.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -64,6 +67,8 @@ prte_rmaps_base_module_t prte_rmaps_rank_file_module = {
 };
 
 static int prte_rmaps_rank_file_parse(const char *);
+static int prte_rmaps_rank_file_parse_binary(FILE *fp, const char *rankfile,
+                                             prte_node_t *hnp_node);
 static char *prte_rmaps_rank_file_parse_string_or_int(void);
 
 static int prte_rmaps_rf_lsf_convert_affinity_to_rankfile(char *affinity_file, char **aff_rankfile);
@@ -103,11 +108,13 @@ static int prte_rmaps_rf_map(prte_job_t *jdata,
     prte_app_context_t *app = NULL;
     int32_t i, k;
     pmix_list_t node_list;
-    prte_node_t *node, *nd, *root_node;
+    prte_node_t *node, *nd;
     pmix_rank_t rank, vpid_start;
     int32_t num_slots;
     prte_rmaps_rank_file_map_t *rfmap;
-    int32_t relative_index, tmp_cnt;
+    int32_t relative_index;
+    pmix_hash_table_t node_index;
+    pmix_pointer_array_t node_order;
     int rc;
     prte_proc_t *proc;
     pmix_mca_base_component_t *c = &prte_mca_rmaps_rank_file_component.super;
@@ -179,6 +186,8 @@ static int prte_rmaps_rf_map(prte_job_t *jdata,
 
     /* setup the node list */
     PMIX_CONSTRUCT(&node_list, pmix_list_t);
+    PMIX_CONSTRUCT(&node_index, pmix_hash_table_t);
+    PMIX_CONSTRUCT(&node_order, pmix_pointer_array_t);
 
     /* pickup the first app - there must be at least one */
     app = (prte_app_context_t *) pmix_pointer_array_get_item(jdata->apps, 0);
@@ -205,6 +214,7 @@ static int prte_rmaps_rf_map(prte_job_t *jdata,
     /* start at the beginning... */
     vpid_start = 0;
     jdata->num_procs = 0;
+    num_ranks = 0;
     PMIX_CONSTRUCT(&rankmap, pmix_pointer_array_t);
 
     /* parse the rankfile, storing its results in the rankmap */
@@ -233,6 +243,14 @@ static int prte_rmaps_rf_map(prte_job_t *jdata,
         /* flag that all subsequent requests should not reset the node->mapped flag */
         initial_map = false;
 
+        /* index the target nodes by name and by position so that
+         * absolute and relative entries resolve in constant time */
+        prte_rmaps_base_index_nodes(&node_index, &node_list);
+        pmix_pointer_array_init(&node_order, pmix_list_get_size(&node_list), INT32_MAX, 32);
+        PMIX_LIST_FOREACH(nd, &node_list, prte_node_t) {
+            pmix_pointer_array_add(&node_order, nd);
+        }
+
         /* we already checked for sanity, so it's okay to just do here */
         if (0 == app->num_procs) {
             /* set the number of procs to the number of entries in that rankfile */
@@ -302,31 +320,19 @@ static int prte_rmaps_rf_map(prte_job_t *jdata,
                 slots = rfmap->slot_list;
                 /* find the node where this proc was assigned */
                 node = NULL;
-                PMIX_LIST_FOREACH(nd, &node_list, prte_node_t)
-                {
-                    if (NULL != rfmap->node_name && 0 == strcmp(nd->name, rfmap->node_name)) {
-                        node = nd;
-                        break;
-                    } else if (NULL != rfmap->node_name
-                               && (('+' == rfmap->node_name[0])
-                                   && (('n' == rfmap->node_name[1])
-                                       || ('N' == rfmap->node_name[1])))) {
-
-                        relative_index = atoi(strtok(rfmap->node_name, "+n"));
-                        if (relative_index >= (int) pmix_list_get_size(&node_list)
-                            || (0 > relative_index)) {
-                            pmix_show_help("help-rmaps_rank_file.txt", "bad-index", true,
-                                           rfmap->node_name);
-                            PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
-                            return PRTE_ERR_BAD_PARAM;
-                        }
-                        root_node = (prte_node_t *) pmix_list_get_first(&node_list);
-                        for (tmp_cnt = 0; tmp_cnt < relative_index; tmp_cnt++) {
-                            root_node = (prte_node_t *) pmix_list_get_next(root_node);
-                        }
-                        node = root_node;
-                        break;
+                if (NULL != rfmap->node_name && '+' == rfmap->node_name[0]
+                    && ('n' == rfmap->node_name[1] || 'N' == rfmap->node_name[1])) {
+                    relative_index = atoi(&rfmap->node_name[2]);
+                    if (relative_index >= node_order.size || 0 > relative_index) {
+                        pmix_show_help("help-rmaps_rank_file.txt", "bad-index", true,
+                                       rfmap->node_name);
+                        rc = PRTE_ERR_SILENT;
+                        goto error;
                     }
+                    node = (prte_node_t *) pmix_pointer_array_get_item(&node_order,
+                                                                       relative_index);
+                } else if (NULL != rfmap->node_name) {
+                    node = prte_rmaps_base_lookup_node(&node_index, rfmap->node_name);
                 }
             }
             if (NULL == node) {
@@ -460,8 +466,14 @@ static int prte_rmaps_rf_map(prte_job_t *jdata,
          */
         PMIX_LIST_DESTRUCT(&node_list);
         PMIX_CONSTRUCT(&node_list, pmix_list_t);
+        PMIX_DESTRUCT(&node_index);
+        PMIX_CONSTRUCT(&node_index, pmix_hash_table_t);
+        PMIX_DESTRUCT(&node_order);
+        PMIX_CONSTRUCT(&node_order, pmix_pointer_array_t);
     }
     PMIX_LIST_DESTRUCT(&node_list);
+    PMIX_DESTRUCT(&node_index);
+    PMIX_DESTRUCT(&node_order);
 
     /* cleanup the rankmap */
     for (i = 0; i < rankmap.size; i++) {
@@ -479,6 +491,8 @@ static int prte_rmaps_rf_map(prte_job_t *jdata,
 
 error:
     PMIX_LIST_DESTRUCT(&node_list);
+    PMIX_DESTRUCT(&node_index);
+    PMIX_DESTRUCT(&node_order);
     if (NULL != rankfile) {
         free(rankfile);
     }
@@ -501,9 +515,16 @@ static int prte_rmaps_rank_file_parse(const char *rankfile)
     prte_rmaps_rank_file_map_t *rfmap = NULL;
     pmix_pointer_array_t *assigned_ranks_array;
     char tmp_rank_assignment[RMAPS_RANK_FILE_MAX_SLOTS];
+    char magic[PRTE_RMAPS_RF_BINARY_MAGIC_LEN];
+    pmix_hash_table_t local_hosts;
+    void *resolved;
 
     /* keep track of rank assignments */
     assigned_ranks_array = PMIX_NEW(pmix_pointer_array_t);
+    /* remember which hostnames refer to this node so each distinct
+     * name is only checked once, no matter how many ranks use it */
+    PMIX_CONSTRUCT(&local_hosts, pmix_hash_table_t);
+    pmix_hash_table_init(&local_hosts, 256);
 
     /* get the hnp node's info */
     hnp_node = (prte_node_t *) (prte_node_pool->addr[0]);
@@ -518,6 +539,17 @@ static int prte_rmaps_rank_file_parse(const char *rankfile)
         goto unlock;
     }
 
+    /* machine-generated placements may use the compact binary format */
+    if (PRTE_RMAPS_RF_BINARY_MAGIC_LEN == fread(magic, 1, PRTE_RMAPS_RF_BINARY_MAGIC_LEN,
+                                                prte_rmaps_rank_file_in)
+        && 0 == memcmp(magic, PRTE_RMAPS_RF_BINARY_MAGIC, PRTE_RMAPS_RF_BINARY_MAGIC_LEN)) {
+        rc = prte_rmaps_rank_file_parse_binary(prte_rmaps_rank_file_in, rankfile, hnp_node);
+        fclose(prte_rmaps_rank_file_in);
+        prte_rmaps_rank_file_in = NULL;
+        goto unlock;
+    }
+    rewind(prte_rmaps_rank_file_in);
+
     while (!prte_rmaps_rank_file_done) {
         token = prte_rmaps_rank_file_lex();
 
@@ -617,7 +649,13 @@ static int prte_rmaps_rank_file_parse(const char *rankfile)
                     goto unlock;
                 }
                 /* check if this is the local node */
-                if (prte_check_host_is_local(node_name)) {
+                if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&local_hosts, node_name,
+                                                                  strlen(node_name), &resolved)) {
+                    resolved = prte_check_host_is_local(node_name) ? hnp_node->name : NULL;
+                    pmix_hash_table_set_value_ptr(&local_hosts, node_name, strlen(node_name),
+                                                  resolved);
+                }
+                if (NULL != resolved) {
                     rfmap->node_name = strdup(hnp_node->name);
                 } else {
                     rfmap->node_name = strdup(node_name);
@@ -669,6 +707,129 @@ unlock:
         free(node_name);
     }
     PMIX_RELEASE(assigned_ranks_array);
+    PMIX_DESTRUCT(&local_hosts);
+    return rc;
+}
+
+static int rf_read_u32(FILE *fp, uint32_t *val)
+{
+    uint32_t nval;
+
+    if (1 != fread(&nval, sizeof(nval), 1, fp)) {
+        return PRTE_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+    }
+    *val = ntohl(nval);
+    return PRTE_SUCCESS;
+}
+
+static char *rf_read_string(FILE *fp, size_t maxlen)
+{
+    uint16_t nlen;
+    size_t len;
+    char *str;
+
+    if (1 != fread(&nlen, sizeof(nlen), 1, fp)) {
+        return NULL;
+    }
+    len = ntohs(nlen);
+    if (maxlen <= len) {
+        return NULL;
+    }
+    str = (char *) malloc(len + 1);
+    if (NULL == str) {
+        return NULL;
+    }
+    if (0 < len && 1 != fread(str, len, 1, fp)) {
+        free(str);
+        return NULL;
+    }
+    str[len] = '\0';
+    return str;
+}
+
+/* The binary format is intended for placements generated by tools. All
+ * integers are in network byte order and strings are a uint16 length
+ * followed by that many bytes, with no terminator:
+ *
+ *    magic      PRTE_RMAPS_RF_BINARY_MAGIC
+ *    nhosts     uint32
+ *    hosts      nhosts strings
+ *    nranks     uint32
+ *    entries    nranks x { uint32 rank, uint32 host index, string slot list }
+ *
+ * Each hostname is resolved once when read, and each entry goes
+ * straight into the rankmap.
+ */
+static int prte_rmaps_rank_file_parse_binary(FILE *fp, const char *rankfile,
+                                             prte_node_t *hnp_node)
+{
+    uint32_t nhosts, nranks, n, rank, hidx;
+    char **hosts = NULL;
+    char *slots, *ptr;
+    prte_rmaps_rank_file_map_t *rfmap;
+    int rc = PRTE_SUCCESS;
+
+    if (PRTE_SUCCESS != rf_read_u32(fp, &nhosts) || INT32_MAX < nhosts) {
+        goto corrupt;
+    }
+    hosts = (char **) calloc(nhosts + 1, sizeof(char *));
+    if (NULL == hosts) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    for (n = 0; n < nhosts; n++) {
+        hosts[n] = rf_read_string(fp, UINT16_MAX);
+        if (NULL == hosts[n] || 0 == strlen(hosts[n])) {
+            goto corrupt;
+        }
+        // Strip off the FQDN if present, ignore IP addresses
+        if (!prte_keep_fqdn_hostnames && !pmix_net_isaddr(hosts[n])) {
+            if (NULL != (ptr = strchr(hosts[n], '.'))) {
+                *ptr = '\0';
+            }
+        }
+        if (prte_check_host_is_local(hosts[n])) {
+            free(hosts[n]);
+            hosts[n] = strdup(hnp_node->name);
+        }
+    }
+
+    if (PRTE_SUCCESS != rf_read_u32(fp, &nranks)) {
+        goto corrupt;
+    }
+    for (n = 0; n < nranks; n++) {
+        if (PRTE_SUCCESS != rf_read_u32(fp, &rank) ||
+            PRTE_SUCCESS != rf_read_u32(fp, &hidx) ||
+            INT32_MAX < rank || nhosts <= hidx) {
+            goto corrupt;
+        }
+        slots = rf_read_string(fp, RMAPS_RANK_FILE_MAX_SLOTS);
+        if (NULL == slots) {
+            goto corrupt;
+        }
+        if (NULL != pmix_pointer_array_get_item(&rankmap, rank)) {
+            pmix_show_help("help-rmaps_rank_file.txt", "bad-assign", true, (int) rank,
+                           hosts[hidx], rankfile);
+            free(slots);
+            rc = PRTE_ERR_BAD_PARAM;
+            goto cleanup;
+        }
+        rfmap = PMIX_NEW(prte_rmaps_rank_file_map_t);
+        rfmap->node_name = strdup(hosts[hidx]);
+        pmix_string_copy(rfmap->slot_list, slots, RMAPS_RANK_FILE_MAX_SLOTS);
+        free(slots);
+        pmix_pointer_array_set_item(&rankmap, rank, rfmap);
+        num_ranks++;
+    }
+    goto cleanup;
+
+corrupt:
+    pmix_show_help("help-rmaps_rank_file.txt", "bad-binary", true, rankfile);
+    rc = PRTE_ERR_BAD_PARAM;
+
+cleanup:
+    if (NULL != hosts) {
+        PMIX_ARGV_FREE_COMPAT(hosts);
+    }
     return rc;
 }
 
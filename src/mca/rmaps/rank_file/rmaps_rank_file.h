@@ -41,6 +41,10 @@ BEGIN_C_DECLS
 
 #define RMAPS_RANK_FILE_MAX_SLOTS 64
 
+/* leading bytes identifying a binary rankfile */
+#define PRTE_RMAPS_RF_BINARY_MAGIC     "PRTERFB1"
+#define PRTE_RMAPS_RF_BINARY_MAGIC_LEN 8
+
 int prte_rmaps_rank_file_lex_destroy(void);
 
 struct prte_rmaps_rf_component_t {
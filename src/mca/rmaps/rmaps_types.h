@@ -161,6 +161,7 @@ typedef struct {
 /* convenience - declare anything <= 15 to be round-robin*/
 #define PRTE_MAPPING_RR         16
 #define PRTE_MAPPING_LIKWID     17
+#define PRTE_MAPPING_AFFINITY   18
 
 /* sequential policy */
 #define PRTE_MAPPING_SEQ        20
@@ -87,28 +87,6 @@ PMIX_CLASS_INSTANCE(seq_node_t, pmix_list_item_t, sn_con, sn_des);
 
 static int process_file(char *path, pmix_list_t *list);
 
-static bool quickmatch(prte_node_t *nd, char *name)
-{
-    int n;
-
-    if (0 == strcmp(nd->name, name)) {
-        return true;
-    }
-    if (0 == strcmp(nd->name, prte_process_info.nodename) &&
-        (0 == strcmp(name, "localhost") ||
-         0 == strcmp(name, "127.0.0.1"))) {
-        return true;
-    }
-    if (NULL != nd->aliases) {
-        for (n=0; NULL != nd->aliases[n]; n++) {
-            if (0 == strcmp(nd->aliases[n], name)) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
 #if PMIX_NUMERIC_VERSION < 0x00040205
 static char *pmix_getline(FILE *fp)
 {
@@ -136,7 +114,6 @@ static int prte_rmaps_seq_map(prte_job_t *jdata,
     prte_job_map_t *map;
     prte_app_context_t *app;
     int i, n;
-    int32_t j;
     pmix_list_item_t *item;
     prte_node_t *node, *nd;
     seq_node_t *sq, *save = NULL, *seq;
@@ -148,7 +125,7 @@ static int prte_rmaps_seq_map(prte_job_t *jdata,
     prte_proc_t *proc;
     pmix_mca_base_component_t *c = &prte_mca_rmaps_seq_component;
     char *hosts = NULL;
-    bool match;
+    pmix_hash_table_t node_index;
 
     PMIX_OUTPUT_VERBOSE((1, prte_rmaps_base_framework.framework_output,
                          "%s rmaps:seq called on job %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
@@ -204,6 +181,11 @@ static int prte_rmaps_seq_map(prte_job_t *jdata,
         }
     }
 
+    /* index the global node pool so each entry in the sequence
+     * can be resolved without scanning every node */
+    PMIX_CONSTRUCT(&node_index, pmix_hash_table_t);
+    prte_rmaps_base_index_nodes(&node_index, NULL);
+
     /* start at the beginning... */
     vpid = 0;
     jdata->num_procs = 0;
@@ -333,18 +315,8 @@ static int prte_rmaps_seq_map(prte_job_t *jdata,
              * that our mapping gets saved on that array as the objects
              * returned by the hostfile function are -not- on the array
              */
-            match = false;
-            for (j = 0; j < prte_node_pool->size; j++) {
-                node = (prte_node_t *) pmix_pointer_array_get_item(prte_node_pool, j);
-                if (NULL == node) {
-                    continue;
-                }
-                if (quickmatch(node, sq->hostname)) {
-                    match = true;
-                    break;
-                }
-            }
-            if (!match) {
+            node = prte_rmaps_base_lookup_node(&node_index, sq->hostname);
+            if (NULL == node) {
                 /* wasn't found - that is an error */
                 pmix_show_help("help-prte-rmaps-seq.txt", "prte-rmaps-seq:resource-not-found", true,
                                sq->hostname);
@@ -403,11 +375,13 @@ static int prte_rmaps_seq_map(prte_job_t *jdata,
             free(hosts);
         }
     }
+    PMIX_DESTRUCT(&node_index);
     /* compute local/app ranks */
     rc = prte_rmaps_base_compute_vpids(jdata, options);
     return rc;
 
 error:
+    PMIX_DESTRUCT(&node_index);
     PMIX_LIST_DESTRUCT(&default_seq_list);
     if (NULL != hosts) {
         free(hosts);
@@ -61,6 +61,15 @@ static int prte_schizo_base_register(pmix_mca_base_register_flag_t flags)
 
 static int prte_schizo_base_close(void)
 {
+    prte_schizo_base_active_module_t *mod;
+
+    /* give the modules a chance to cleanup */
+    PMIX_LIST_FOREACH(mod, &prte_schizo_base.active_modules, prte_schizo_base_active_module_t) {
+        if (NULL != mod->module->finalize) {
+            mod->module->finalize();
+        }
+    }
+
     /* cleanup globals */
     PMIX_LIST_DESTRUCT(&prte_schizo_base.active_modules);
 
@@ -333,6 +342,7 @@ int prte_schizo_base_sanity(pmix_cli_result_t *cmd_line)
         PRTE_CLI_RANKFILE,
         PRTE_CLI_PELIST,
         PRTE_CLI_LIKWID,
+        PRTE_CLI_AFFINITY,
         NULL
     };
     char *mapquals[] = {
@@ -37,11 +37,16 @@
 #endif
 
 #include <ctype.h>
+#include <sys/stat.h>
+#ifdef HAVE_SYS_TIME_H
+#    include <sys/time.h>
+#endif
 
 #ifdef HAVE_SYS_UTSNAME_H
 #    include <sys/utsname.h>
 #endif
 
+#include "src/class/pmix_hash_table.h"
 #include "src/util/pmix_argv.h"
 #include "src/util/name_fns.h"
 #include "src/util/pmix_os_dirpath.h"
@@ -75,6 +80,7 @@ static void job_info(pmix_cli_result_t *results,
 static int setup_app(prte_pmix_app_t *app);
 static int set_default_rto(prte_job_t *jdata,
                            prte_rmaps_options_t *options);
+static void finalize(void);
 
 prte_schizo_base_module_t prte_schizo_ompi_module = {
     .name = "ompi",
@@ -87,7 +93,8 @@ prte_schizo_base_module_t prte_schizo_ompi_module = {
     .set_default_ranking = set_default_ranking,
     .job_info = job_info,
     .set_default_rto = set_default_rto,
-    .check_sanity = prte_schizo_base_sanity
+    .check_sanity = prte_schizo_base_sanity,
+    .finalize = finalize
 };
 
 static struct option ompioptions[] = {
@@ -1064,6 +1071,10 @@ static int check_cache(char ***c1, char ***c2, char *p1, char *p2)
     return rc;
 }
 
+/* set whenever a param value is taken from our environment - such
+ * results cannot be reused once the environment changes */
+static bool env_lookup = false;
+
 static int process_envar(const char *p, char ***cache, char ***cachevals)
 {
     char *value, **tmp;
@@ -1086,6 +1097,7 @@ static int process_envar(const char *p, char ***cache, char ***cachevals)
              * that start with the string up to the '*' */
             p1[strlen(p1) - 1] = '\0';
             len = strlen(p1);
+            env_lookup = true;
             for (k = 0; NULL != environ[k]; k++) {
                 if (0 == strncmp(environ[k], p1, len)) {
                     value = strdup(environ[k]);
@@ -1103,6 +1115,7 @@ static int process_envar(const char *p, char ***cache, char ***cachevals)
                 }
             }
         } else {
+            env_lookup = true;
             value = getenv(p1);
             if (NULL != value) {
                 rc = check_cache(cache, cachevals, p1, value);
@@ -1136,6 +1149,7 @@ static int process_token(char *token, char ***cache, char ***cachevals)
     int rc;
 
     if (NULL == (ptr = strchr(token, '='))) {
+        env_lookup = true;
         value = getenv(token);
         if (NULL == value) {
             return PRTE_ERR_NOT_FOUND;
@@ -1189,7 +1203,7 @@ static int process_env_list(const char *env_list, char ***xparams, char ***xvals
     return rc;
 }
 
-static int process_tune_files(char *filename, char ***dstenv, char sep)
+static int load_tune_files(char *filename, char ***dstenv, char sep)
 {
     FILE *fp;
     char **tmp, **opts, *line, *param, *p1, *p2;
@@ -1425,6 +1439,156 @@ static int process_tune_files(char *filename, char ***dstenv, char sep)
     return PRTE_SUCCESS;
 }
 
+/* tune files already processed, keyed by the given file list and
+ * validated against the identity and modification time of each file */
+typedef struct {
+    pmix_list_item_t super;
+    char *spec;
+    int nfiles;
+    struct stat *stats;
+    char **env;
+} tune_cache_t;
+static void tccon(tune_cache_t *p)
+{
+    p->spec = NULL;
+    p->nfiles = 0;
+    p->stats = NULL;
+    p->env = NULL;
+}
+static void tcdes(tune_cache_t *p)
+{
+    if (NULL != p->spec) {
+        free(p->spec);
+    }
+    if (NULL != p->stats) {
+        free(p->stats);
+    }
+    PMIX_ARGV_FREE_COMPAT(p->env);
+}
+static PMIX_CLASS_INSTANCE(tune_cache_t, pmix_list_item_t, tccon, tcdes);
+
+static pmix_list_t tune_cache;
+static bool tune_cache_init = false;
+
+static bool tune_stat(char *file, struct stat *buf)
+{
+    char *p1;
+    int rc;
+
+    if (0 == stat(file, buf)) {
+        return true;
+    }
+    if (pmix_path_is_absolute(file)) {
+        return false;
+    }
+    p1 = pmix_os_path(false, DEFAULT_PARAM_FILE_PATH, file, NULL);
+    rc = stat(p1, buf);
+    free(p1);
+    return (0 == rc);
+}
+
+static bool tune_same(struct stat *a, struct stat *b)
+{
+    return (a->st_dev == b->st_dev && a->st_ino == b->st_ino &&
+            a->st_size == b->st_size && a->st_mtime == b->st_mtime);
+}
+
+static void tune_apply(char **env, char ***dstenv)
+{
+    char *p1, *p2;
+    int i;
+
+    for (i = 0; NULL != env && NULL != env[i]; i++) {
+        p1 = strdup(env[i]);
+        p2 = strchr(p1, '=');
+        if (NULL != p2) {
+            *p2 = '\0';
+            PMIX_SETENV_COMPAT(p1, p2 + 1, true, dstenv);
+        }
+        free(p1);
+    }
+}
+
+static int process_tune_files(char *filename, char ***dstenv, char sep)
+{
+    tune_cache_t *tc, *next;
+    struct stat *stats;
+    char **tmp, **env = NULL;
+    int i, n, rc;
+    bool cacheable = true;
+
+    if (!tune_cache_init) {
+        PMIX_CONSTRUCT(&tune_cache, pmix_list_t);
+        tune_cache_init = true;
+    }
+
+    tmp = PMIX_ARGV_SPLIT_COMPAT(filename, sep);
+    if (NULL == tmp) {
+        return PRTE_SUCCESS;
+    }
+    n = PMIX_ARGV_COUNT_COMPAT(tmp);
+    stats = (struct stat *) calloc(n, sizeof(struct stat));
+    if (NULL == stats) {
+        PMIX_ARGV_FREE_COMPAT(tmp);
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    for (i = 0; i < n; i++) {
+        if (!tune_stat(tmp[i], &stats[i])) {
+            /* let the loader report it */
+            cacheable = false;
+            break;
+        }
+    }
+    PMIX_ARGV_FREE_COMPAT(tmp);
+
+    if (cacheable) {
+        PMIX_LIST_FOREACH_SAFE(tc, next, &tune_cache, tune_cache_t) {
+            if (0 != strcmp(tc->spec, filename) || tc->nfiles != n) {
+                continue;
+            }
+            for (i = 0; i < n; i++) {
+                if (!tune_same(&tc->stats[i], &stats[i])) {
+                    break;
+                }
+            }
+            if (i == n) {
+                pmix_output_verbose(2, prte_schizo_base_framework.framework_output,
+                                    "%s schizo:ompi: using cached tune files %s",
+                                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), filename);
+                tune_apply(tc->env, dstenv);
+                free(stats);
+                return PRTE_SUCCESS;
+            }
+            /* a file has changed - drop the stale entry */
+            pmix_list_remove_item(&tune_cache, &tc->super);
+            PMIX_RELEASE(tc);
+        }
+    }
+
+    /* load the files into a scratch environment so we can keep the result */
+    env_lookup = false;
+    rc = load_tune_files(filename, &env, sep);
+    if (PRTE_SUCCESS != rc) {
+        PMIX_ARGV_FREE_COMPAT(env);
+        free(stats);
+        return rc;
+    }
+    tune_apply(env, dstenv);
+
+    if (cacheable && !env_lookup) {
+        tc = PMIX_NEW(tune_cache_t);
+        tc->spec = strdup(filename);
+        tc->nfiles = n;
+        tc->stats = stats;
+        tc->env = env;
+        pmix_list_append(&tune_cache, &tc->super);
+    } else {
+        PMIX_ARGV_FREE_COMPAT(env);
+        free(stats);
+    }
+    return PRTE_SUCCESS;
+}
+
 // These frameworks are current as of 16 Sep, 2022, and are the list
 // of frameworks that are planned to be in Open MPI v5.0.0.
 static char *ompi_frameworks_static_5_0_0[] = {
@@ -1479,35 +1643,58 @@ static char *ompi_frameworks_static_5_0_0[] = {
 };
 static char **ompi_frameworks = ompi_frameworks_static_5_0_0;
 static bool ompi_frameworks_setup = false;
+/* the framework prefixes, indexed for lookup */
+static pmix_hash_table_t ompi_framework_set;
+static size_t ompi_framework_maxlen = 0;
 
 static void setup_ompi_frameworks(void)
 {
+    size_t len;
+    int j;
+
     if (ompi_frameworks_setup) {
         return;
     }
     ompi_frameworks_setup = true;
 
     char *env = getenv("OMPI_MCA_PREFIXES");
-    if (NULL == env) {
-        return;
+    if (NULL != env) {
+        // If we found the env variable, it will be a comma-delimited list
+        // of values.  Split it into an argv-style array.
+        char **tmp = PMIX_ARGV_SPLIT_COMPAT(env, ',');
+        if (NULL != tmp) {
+            ompi_frameworks = tmp;
+        }
     }
 
-    // If we found the env variable, it will be a comma-delimited list
-    // of values.  Split it into an argv-style array.
-    char **tmp = PMIX_ARGV_SPLIT_COMPAT(env, ',');
-    if (NULL != tmp) {
-        ompi_frameworks = tmp;
+    PMIX_CONSTRUCT(&ompi_framework_set, pmix_hash_table_t);
+    pmix_hash_table_init(&ompi_framework_set, 64);
+    for (j = 0; NULL != ompi_frameworks[j]; j++) {
+        len = strlen(ompi_frameworks[j]);
+        if (0 == len) {
+            continue;
+        }
+        pmix_hash_table_set_value_ptr(&ompi_framework_set, ompi_frameworks[j], len,
+                                      ompi_frameworks[j]);
+        if (ompi_framework_maxlen < len) {
+            ompi_framework_maxlen = len;
+        }
     }
 }
 
 static bool check_generic(char *p1)
 {
+    size_t len, plen;
+    void *ptr;
+
     setup_ompi_frameworks();
 
     /* See if the parameter we were passed belongs to one of the OMPI
-       frameworks or prefixes */
-    for (int j = 0; NULL != ompi_frameworks[j]; j++) {
-        if (0 == strncmp(p1, ompi_frameworks[j], strlen(ompi_frameworks[j]))) {
+       frameworks or prefixes - check each leading substring that
+       could be one of them */
+    plen = strnlen(p1, ompi_framework_maxlen);
+    for (len = 1; len <= plen; len++) {
+        if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&ompi_framework_set, p1, len, &ptr)) {
             return true;
         }
     }
@@ -1515,8 +1702,8 @@ static bool check_generic(char *p1)
     return false;
 }
 
-static int parse_env(char **srcenv, char ***dstenv,
-                     pmix_cli_result_t *results)
+static int do_parse_env(char **srcenv, char ***dstenv,
+                        pmix_cli_result_t *results)
 {
     char *p1, *p2, *p3;
     char *env_set_flag;
@@ -1821,6 +2008,33 @@ static int parse_env(char **srcenv, char ***dstenv,
     return PRTE_SUCCESS;
 }
 
+static void report_time(const char *phase, struct timeval *start)
+{
+    struct timeval now;
+    char *t;
+
+    gettimeofday(&now, NULL);
+    t = prte_pretty_print_timing(now.tv_sec - start->tv_sec, now.tv_usec - start->tv_usec);
+    pmix_output(0, "%s [timing] schizo:ompi %s: %s",
+                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), phase, t);
+    free(t);
+}
+
+static int parse_env(char **srcenv, char ***dstenv,
+                     pmix_cli_result_t *results)
+{
+    struct timeval start;
+    int rc;
+
+    if (!prte_state_base.report_timings) {
+        return do_parse_env(srcenv, dstenv, results);
+    }
+    gettimeofday(&start, NULL);
+    rc = do_parse_env(srcenv, dstenv, results);
+    report_time("parse_env", &start);
+    return rc;
+}
+
 static bool check_prte_overlap(char *var, char *value)
 {
     char *tmp;
@@ -1924,6 +2138,37 @@ static bool check_pmix_overlap(char *var, char *value)
 //      as the translate_params() routine in the OMPI repo's
 //      opal/mca/pmix/base/pmix_base_fns.c file.  If there are
 //      changes here, there are likely to be changes there.
+/* environment entries and param files already translated - as the
+ * translation never overwrites an existing value, anything we have
+ * seen before cannot change the result and is skipped */
+static pmix_hash_table_t translated_env;
+static bool translated_init = false;
+static char *home_paramfile = NULL;
+static struct stat home_paramstat;
+static char *ompi_paramfile = NULL;
+static struct stat ompi_paramstat;
+
+static bool paramfile_changed(char *file, char **last, struct stat *laststat)
+{
+    struct stat buf;
+
+    if (0 != stat(file, &buf)) {
+        /* nothing to read */
+        memset(&buf, 0, sizeof(buf));
+    }
+    if (NULL != *last && 0 == strcmp(*last, file) &&
+        buf.st_dev == laststat->st_dev && buf.st_ino == laststat->st_ino &&
+        buf.st_size == laststat->st_size && buf.st_mtime == laststat->st_mtime) {
+        return false;
+    }
+    if (NULL != *last) {
+        free(*last);
+    }
+    *last = strdup(file);
+    *laststat = buf;
+    return true;
+}
+
 static int translate_params(void)
 {
     char *evar, *tmp, *e2;
@@ -1933,6 +2178,17 @@ static int translate_params(void)
     pmix_mca_base_var_file_value_t *fv;
     uid_t uid;
     int n, len;
+    void *ptr;
+    struct timeval start = {0, 0};
+
+    if (prte_state_base.report_timings) {
+        gettimeofday(&start, NULL);
+    }
+    if (!translated_init) {
+        PMIX_CONSTRUCT(&translated_env, pmix_hash_table_t);
+        pmix_hash_table_init(&translated_env, 256);
+        translated_init = true;
+    }
 
     /* since we are the proxy, we need to check the OMPI default
      * MCA params to see if there is something relating to PRRTE
@@ -1957,6 +2213,12 @@ static int translate_params(void)
     len = strlen("OMPI_MCA_");
     for (n=0; NULL != environ[n]; n++) {
         if (0 == strncmp(environ[n], "OMPI_MCA_", len)) {
+            if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&translated_env, environ[n],
+                                                              strlen(environ[n]), &ptr)) {
+                continue;
+            }
+            pmix_hash_table_set_value_ptr(&translated_env, environ[n], strlen(environ[n]),
+                                          &translated_env);
             e2 = strdup(environ[n]);
             evar = strrchr(e2, '=');
             *evar = '\0';
@@ -1991,7 +2253,9 @@ static int translate_params(void)
     if (NULL != home) {
         file = pmix_os_path(false, home, ".openmpi", "mca-params.conf", NULL);
         PMIX_CONSTRUCT(&params, pmix_list_t);
-        pmix_mca_base_parse_paramfile(file, &params);
+        if (paramfile_changed(file, &home_paramfile, &home_paramstat)) {
+            pmix_mca_base_parse_paramfile(file, &params);
+        }
         free(file);
         PMIX_LIST_FOREACH (fv, &params, pmix_mca_base_var_file_value_t) {
             // see if this param relates to PRRTE
@@ -2023,7 +2287,9 @@ static int translate_params(void)
         /* look for the default MCA param file */
         file = pmix_os_path(false, evar, "etc", "openmpi-mca-params.conf", NULL);
         PMIX_CONSTRUCT(&params, pmix_list_t);
-        pmix_mca_base_parse_paramfile(file, &params);
+        if (paramfile_changed(file, &ompi_paramfile, &ompi_paramstat)) {
+            pmix_mca_base_parse_paramfile(file, &params);
+        }
         free(file);
         PMIX_LIST_FOREACH (fv, &params, pmix_mca_base_var_file_value_t) {
             // see if this param relates to PRRTE
@@ -2044,6 +2310,9 @@ static int translate_params(void)
         PMIX_LIST_DESTRUCT(&params);
     }
 
+    if (prte_state_base.report_timings) {
+        report_time("translate_params", &start);
+    }
     return 100;
 }
 
@@ -2137,3 +2406,32 @@ static int set_default_rto(prte_job_t *jdata,
     PRTE_HIDE_UNUSED_PARAMS(options);
     return prte_state_base_set_runtime_options(jdata, NULL);
 }
+
+static void finalize(void)
+{
+    if (tune_cache_init) {
+        PMIX_LIST_DESTRUCT(&tune_cache);
+        tune_cache_init = false;
+    }
+    if (translated_init) {
+        PMIX_DESTRUCT(&translated_env);
+        translated_init = false;
+    }
+    if (NULL != home_paramfile) {
+        free(home_paramfile);
+        home_paramfile = NULL;
+    }
+    if (NULL != ompi_paramfile) {
+        free(ompi_paramfile);
+        ompi_paramfile = NULL;
+    }
+    if (ompi_frameworks_setup) {
+        PMIX_DESTRUCT(&ompi_framework_set);
+        if (ompi_frameworks != ompi_frameworks_static_5_0_0) {
+            PMIX_ARGV_FREE_COMPAT(ompi_frameworks);
+            ompi_frameworks = ompi_frameworks_static_5_0_0;
+        }
+        ompi_framework_maxlen = 0;
+        ompi_frameworks_setup = false;
+    }
+}
@@ -47,6 +47,7 @@ typedef struct {
     bool show_launch_progress;
     bool notifyerrors;
     bool autorestart;
+    bool report_timings;
 } prte_state_base_t;
 PRTE_EXPORT extern prte_state_base_t prte_state_base;
 
@@ -24,6 +24,9 @@
 #if HAVE_FCNTL_H
 #    include <fcntl.h>
 #endif
+#ifdef HAVE_SYS_TIME_H
+#    include <sys/time.h>
+#endif
 #include <pmix.h>
 #include <pmix_server.h>
 
@@ -43,17 +46,69 @@
 #include "src/runtime/prte_globals.h"
 #include "src/runtime/prte_wait.h"
 #include "src/threads/pmix_threads.h"
+#include "src/util/name_fns.h"
 #include "src/util/session_dir.h"
 #include "src/util/pmix_show_help.h"
 
 #include "src/mca/state/base/base.h"
 
+static void report_timing(prte_job_t *jdata, prte_job_state_t state)
+{
+    struct timeval now, start, last, *tv;
+    char *since_start, *since_last;
+
+    /* only report the major phases */
+    switch (state) {
+        case PRTE_JOB_STATE_INIT:
+        case PRTE_JOB_STATE_ALLOCATION_COMPLETE:
+        case PRTE_JOB_STATE_DAEMONS_LAUNCHED:
+        case PRTE_JOB_STATE_DAEMONS_REPORTED:
+        case PRTE_JOB_STATE_VM_READY:
+        case PRTE_JOB_STATE_MAP_COMPLETE:
+        case PRTE_JOB_STATE_LAUNCH_APPS:
+        case PRTE_JOB_STATE_RUNNING:
+        case PRTE_JOB_STATE_REGISTERED:
+        case PRTE_JOB_STATE_TERMINATED:
+            break;
+        default:
+            return;
+    }
+
+    gettimeofday(&now, NULL);
+    tv = &start;
+    if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_TIMING_START, (void **) &tv, PMIX_TIMEVAL)) {
+        start = now;
+        last = now;
+        prte_set_attribute(&jdata->attributes, PRTE_JOB_TIMING_START, PRTE_ATTR_LOCAL,
+                           &now, PMIX_TIMEVAL);
+    } else {
+        tv = &last;
+        if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_TIMING_LAST, (void **) &tv, PMIX_TIMEVAL)) {
+            last = start;
+        }
+    }
+    prte_set_attribute(&jdata->attributes, PRTE_JOB_TIMING_LAST, PRTE_ATTR_LOCAL,
+                       &now, PMIX_TIMEVAL);
+
+    since_start = prte_pretty_print_timing(now.tv_sec - start.tv_sec, now.tv_usec - start.tv_usec);
+    since_last = prte_pretty_print_timing(now.tv_sec - last.tv_sec, now.tv_usec - last.tv_usec);
+    pmix_output(0, "%s [timing] job %s reached %s: %s since start, %s since previous phase",
+                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_JOBID_PRINT(jdata->nspace),
+                prte_job_state_to_str(state), since_start, since_last);
+    free(since_start);
+    free(since_last);
+}
+
 void prte_state_base_activate_job_state(prte_job_t *jdata, prte_job_state_t state)
 {
     pmix_list_item_t *itm, *any = NULL, *error = NULL;
     prte_state_t *s;
     prte_state_caddy_t *caddy;
 
+    if (prte_state_base.report_timings && NULL != jdata && PRTE_PROC_IS_MASTER) {
+        report_timing(jdata, state);
+    }
+
     for (itm = pmix_list_get_first(&prte_job_states); itm != pmix_list_get_end(&prte_job_states);
          itm = pmix_list_get_next(itm)) {
         s = (prte_state_t *) itm;
@@ -103,6 +103,13 @@ static int prte_state_base_register(pmix_mca_base_register_flag_t flags)
                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
                                &prte_state_base.autorestart);
 
+    prte_state_base.report_timings = false;
+    pmix_mca_base_var_register("prte", "state", "base", "report_timings",
+                               "Report the time at which each job reaches the major phases of "
+                               "its lifecycle (daemons reported, launch, registration, termination)",
+                               PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                               &prte_state_base.report_timings);
+
     return PRTE_SUCCESS;
 }
 
@@ -256,6 +256,116 @@ static void init_complete(int sd, short args, void *cbdata)
     PMIX_RELEASE(caddy);
 }
 
+/* When daemons are added to a running DVM, the existing daemons
+ * already hold the node map and each other's contact info - so pass
+ * only the added nodes and the contact info for the new daemons and
+ * their ancestors in the routing tree. Anything the new daemons need
+ * about the jobs they host comes with the launch message for those
+ * jobs (see prte_odls_base_default_get_add_procs_data) */
+static int elastic_wireup(prte_job_t *jdata)
+{
+    prte_job_t *daemons;
+    prte_job_map_t *map;
+    prte_proc_t *dmn;
+    pmix_bitmap_t nodes, uris;
+    pmix_data_buffer_t buf;
+    prte_grpcomm_signature_t sig;
+    pmix_value_t *val;
+    pmix_rank_t start, v, p;
+    pmix_status_t ret;
+    int rc, nuris = 0;
+
+    daemons = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
+    map = daemons->map;
+    if (PMIX_CHECK_NSPACE(PRTE_PROC_MY_NAME->nspace, jdata->nspace) || NULL == map
+        || 0 == map->num_new_daemons || PMIX_RANK_INVALID == map->daemon_vpid_start
+        || 1 >= map->daemon_vpid_start) {
+        /* this is the initial launch of the DVM */
+        return PRTE_ERR_TAKE_NEXT_OPTION;
+    }
+    start = map->daemon_vpid_start;
+
+    PMIX_CONSTRUCT(&nodes, pmix_bitmap_t);
+    pmix_bitmap_init(&nodes, prte_node_pool->size);
+    PMIX_CONSTRUCT(&uris, pmix_bitmap_t);
+    pmix_bitmap_init(&uris, daemons->procs->size);
+    for (v = start; v < (pmix_rank_t) daemons->procs->size; v++) {
+        if (NULL == (dmn = (prte_proc_t *) pmix_pointer_array_get_item(daemons->procs, v))) {
+            continue;
+        }
+        pmix_bitmap_set_bit(&uris, v);
+        if (NULL != dmn->node) {
+            pmix_bitmap_set_bit(&nodes, dmn->node->index);
+        }
+        /* the new daemon must be able to reach its ancestors
+         * should the routing tree have to be repaired */
+        for (p = prte_rml_get_parent(v); PMIX_RANK_INVALID != p && p < start;
+             p = prte_rml_get_parent(p)) {
+            if (pmix_bitmap_is_set_bit(&uris, p)) {
+                /* already have the rest of this branch */
+                break;
+            }
+            pmix_bitmap_set_bit(&uris, p);
+        }
+    }
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    rc = prte_util_nidmap_create_delta(prte_node_pool, &nodes, &buf);
+    if (PRTE_SUCCESS != rc) {
+        goto done;
+    }
+    for (v = 0; v < (pmix_rank_t) daemons->procs->size; v++) {
+        if (!pmix_bitmap_is_set_bit(&uris, v)) {
+            continue;
+        }
+        if (NULL == (dmn = (prte_proc_t *) pmix_pointer_array_get_item(daemons->procs, v))) {
+            continue;
+        }
+        val = NULL;
+        if (PMIX_SUCCESS != (ret = PMIx_Get(&dmn->name, PMIX_PROC_URI, NULL, 0, &val)) ||
+            NULL == val) {
+            PMIX_ERROR_LOG(ret);
+            rc = PRTE_ERR_NOT_FOUND;
+            goto done;
+        }
+        rc = PMIx_Data_pack(NULL, &buf, &dmn->name, 1, PMIX_PROC);
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, &buf, &val->data.string, 1, PMIX_STRING);
+        }
+        PMIX_VALUE_RELEASE(val);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            goto done;
+        }
+        ++nuris;
+    }
+
+    pmix_output_verbose(2, prte_state_base_framework.framework_output,
+                        "%s state:dvm: elastic wireup of %d new daemons for job %s - %d contacts",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int) map->num_new_daemons,
+                        PRTE_JOBID_PRINT(jdata->nspace), nuris);
+
+    /* goes to all daemons */
+    PMIX_CONSTRUCT(&sig, prte_grpcomm_signature_t);
+    PMIX_PROC_CREATE(sig.signature, 1);
+    PMIX_LOAD_PROCID(&sig.signature[0], PRTE_PROC_MY_NAME->nspace, PMIX_RANK_WILDCARD);
+    sig.sz = 1;
+    rc = prte_grpcomm.xcast(&sig, PRTE_RML_TAG_WIREUP, &buf);
+    PMIX_PROC_FREE(sig.signature, 1);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        goto done;
+    }
+    /* the new daemons only know part of the node map */
+    prte_util_nidmap_partial = true;
+
+done:
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+    PMIX_DESTRUCT(&nodes);
+    PMIX_DESTRUCT(&uris);
+    return rc;
+}
+
 static void vm_ready(int fd, short args, void *cbdata)
 {
     prte_state_caddy_t *caddy = (prte_state_caddy_t *) cbdata;
@@ -275,7 +385,15 @@ static void vm_ready(int fd, short args, void *cbdata)
         /* if there is more than one daemon in the job, then there
          * is just a little bit to do */
         if (!prte_get_attribute(&caddy->jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PMIX_BOOL)
-            && 1 < prte_process_info.num_daemons) {
+            && 1 < prte_process_info.num_daemons && prte_elastic_expansion
+            && PRTE_ERR_TAKE_NEXT_OPTION != (rc = elastic_wireup(caddy->jdata))) {
+            if (PRTE_SUCCESS != rc) {
+                PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
+                return;
+            }
+        } else if (!prte_get_attribute(&caddy->jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH,
+                                       NULL, PMIX_BOOL)
+                   && 1 < prte_process_info.num_daemons) {
             /* send the daemon map to every daemon in this DVM - we
              * do this here so we don't have to do it for every
              * job we are going to launch */
@@ -333,6 +451,8 @@ static void vm_ready(int fd, short args, void *cbdata)
             }
             PMIX_DATA_BUFFER_DESTRUCT(&buf);
             PMIX_PROC_FREE(sig.signature, 1);
+            /* every daemon now holds the full node map */
+            prte_util_nidmap_partial = false;
         }
     }
     if (PMIX_CHECK_NSPACE(PRTE_PROC_MY_NAME->nspace, caddy->jdata->nspace)) {
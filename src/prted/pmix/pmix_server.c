@@ -87,8 +87,6 @@ static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender, pmix_data_buf
                                   prte_rml_tag_t tg, void *cbdata);
 static void pmix_server_dmdx_resp(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
                                   prte_rml_tag_t tg, void *cbdata);
-static void pmix_server_log(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
-                            prte_rml_tag_t tg, void *cbdata);
 static void pmix_server_sched(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
                               prte_rml_tag_t tg, void *cbdata);
 
@@ -440,6 +438,24 @@ void pmix_server_register_params(void)
                                       PMIX_MCA_BASE_VAR_TYPE_BOOL,
                                       &prte_pmix_server_globals.system_controller);
 
+    prte_pmix_server_globals.event_coalesce = 0;
+    (void) pmix_mca_base_var_register("prte", "pmix", NULL, "event_coalesce",
+                                      "Time window (in microseconds) over which events generated by local "
+                                      "processes are held before being sent to other daemons - identical "
+                                      "events within the window are only sent once (default: 0, send "
+                                      "immediately)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &prte_pmix_server_globals.event_coalesce);
+
+    prte_pmix_server_globals.log_batch = 10000;
+    (void) pmix_mca_base_var_register("prte", "pmix", NULL, "log_batch",
+                                      "Time window (in microseconds) over which PMIx_Log requests "
+                                      "from local processes are collected and forwarded to the DVM "
+                                      "master in a single message - identical requests from different "
+                                      "processes of a job are output once, along with the ranks that "
+                                      "made them (default: 10000, 0 => forward immediately)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &prte_pmix_server_globals.log_batch);
 }
 
 static void timeout_cbfunc(int sd, short args, void *cbdata)
@@ -586,6 +602,9 @@ int pmix_server_init(void)
     PMIX_CONSTRUCT(&prte_pmix_server_globals.remote_reqs, pmix_pointer_array_t);
     pmix_pointer_array_init(&prte_pmix_server_globals.remote_reqs, 128, INT_MAX, 2);
     PMIX_CONSTRUCT(&prte_pmix_server_globals.notifications, pmix_list_t);
+    PMIX_CONSTRUCT(&prte_pmix_server_globals.pending_events, pmix_list_t);
+    PMIX_CONSTRUCT(&prte_pmix_server_globals.pending_logs, pmix_list_t);
+    PMIX_CONSTRUCT(&prte_pmix_server_globals.pending_aggs, pmix_list_t);
     prte_pmix_server_globals.server = *PRTE_NAME_INVALID;
     prte_pmix_server_globals.scheduler_connected = false;
     prte_pmix_server_globals.scheduler_set_as_server = false;
@@ -924,6 +943,8 @@ void pmix_server_start(void)
     /* setup recv for notifications */
     PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_NOTIFICATION,
                   PRTE_RML_PERSISTENT, pmix_server_notify, NULL);
+    PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_NOTIFY_RELAY,
+                  PRTE_RML_PERSISTENT, pmix_server_notify_relay, NULL);
 
     /* setup recv for jobid return */
     PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_JOBID_RESP,
@@ -953,12 +974,17 @@ void pmix_server_finalize(void)
                         "%s Finalizing PMIX server",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
 
+    /* push out any logs and events we are still holding */
+    pmix_server_log_flush();
+    pmix_server_notify_flush();
+
     /* stop receives */
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_DIRECT_MODEX);
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_DIRECT_MODEX_RESP);
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_LAUNCH_RESP);
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_DATA_CLIENT);
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_NOTIFICATION);
+    PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_NOTIFY_RELAY);
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_SCHED_RESP);
     if (PRTE_PROC_IS_MASTER) {
         PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_LOGGING);
@@ -986,6 +1012,9 @@ void pmix_server_finalize(void)
     PMIX_DESTRUCT(&prte_pmix_server_globals.remote_reqs);
     PMIX_DESTRUCT(&prte_pmix_server_globals.local_reqs);
     PMIX_LIST_DESTRUCT(&prte_pmix_server_globals.notifications);
+    PMIX_LIST_DESTRUCT(&prte_pmix_server_globals.pending_events);
+    PMIX_LIST_DESTRUCT(&prte_pmix_server_globals.pending_logs);
+    PMIX_LIST_DESTRUCT(&prte_pmix_server_globals.pending_aggs);
     PMIX_LIST_DESTRUCT(&prte_pmix_server_globals.psets);
     PMIX_LIST_DESTRUCT(&prte_pmix_server_globals.groups);
     PMIX_LIST_DESTRUCT(&prte_pmix_server_globals.tools);
@@ -1594,158 +1623,6 @@ static void pmix_server_dmdx_resp(int status, pmix_proc_t *sender,
 }
 
 
-static void log_cbfunc(pmix_status_t status, void *cbdata)
-{
-    prte_pmix_server_op_caddy_t *scd = (prte_pmix_server_op_caddy_t *) cbdata;
-
-    if (PMIX_SUCCESS != status && PMIX_OPERATION_SUCCEEDED != status) {
-        pmix_output(prte_pmix_server_globals.output, "LOG FAILED");
-    }
-    if (NULL != scd->info) {
-        PMIX_INFO_FREE(scd->info, scd->ninfo);
-    }
-    if (NULL != scd->directives) {
-        PMIX_INFO_FREE(scd->directives, scd->ndirs);
-    }
-    PMIX_RELEASE(scd);
-}
-
-
-static void pmix_server_log(int status, pmix_proc_t *sender,
-                            pmix_data_buffer_t *buffer,
-                            prte_rml_tag_t tg, void *cbdata)
-{
-    int rc;
-    int32_t cnt;
-    size_t n, ninfo, ndirs;
-    pmix_info_t *info;
-    pmix_status_t ret;
-    pmix_byte_object_t boptr;
-    pmix_data_buffer_t pbkt;
-    prte_pmix_server_op_caddy_t *scd;
-    pmix_proc_t source;
-    prte_job_t *jdata;
-    bool noagg;
-    bool flag;
-    PRTE_HIDE_UNUSED_PARAMS(status, sender, tg, cbdata);
-
-    /* unpack the source of the request */
-    cnt = 1;
-    rc = PMIx_Data_unpack(NULL, buffer, &source, &cnt, PMIX_PROC);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return;
-    }
-    /* look up the job for this source */
-    jdata = prte_get_job_data_object(source.nspace);
-    if (NULL == jdata) {
-        /* should never happen */
-        PMIX_ERROR_LOG(PMIX_ERR_NOT_FOUND);
-        return;
-    }
-    noagg = prte_get_attribute(&jdata->attributes, PRTE_JOB_NOAGG_HELP, NULL, PMIX_BOOL);
-
-    /* unpack the number of info */
-    cnt = 1;
-    rc = PMIx_Data_unpack(NULL, buffer, &ninfo, &cnt, PMIX_SIZE);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return;
-    }
-
-   /* unpack the number of directives */
-   cnt = 1;
-   rc = PMIx_Data_unpack(NULL, buffer, &ndirs, &cnt, PMIX_SIZE);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return;
-    }
-
-    PMIX_BYTE_OBJECT_CONSTRUCT(&boptr);
-    /* unpack the info blob */
-    cnt = 1;
-    rc = PMIx_Data_unpack(NULL, buffer, &boptr, &cnt, PMIX_BYTE_OBJECT);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return;
-    }
-
-    PMIX_INFO_CREATE(info, ninfo);
-    PMIX_DATA_BUFFER_CONSTRUCT(&pbkt);
-    rc = PMIx_Data_load(&pbkt, &boptr);
-    for (n = 0; n < ninfo; n++) {
-        cnt = 1;
-        ret = PMIx_Data_unpack(NULL, &pbkt, (void *) &info[n], &cnt, PMIX_INFO);
-        if (PMIX_SUCCESS != ret) {
-            PMIX_ERROR_LOG(ret);
-            PMIX_INFO_FREE(info, ninfo);
-            PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-            PMIX_BYTE_OBJECT_DESTRUCT(&boptr);
-            return;
-        }
-    }
-    PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-    PMIX_BYTE_OBJECT_DESTRUCT(&boptr);
-
-    PMIX_BYTE_OBJECT_CONSTRUCT(&boptr);
-    /* unpack the directives blob */
-    cnt = 1;
-    rc = PMIx_Data_unpack(NULL, buffer, &boptr, &cnt, PMIX_BYTE_OBJECT);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_BYTE_OBJECT_CONSTRUCT(&boptr);
-        PMIX_ERROR_LOG(rc);
-        return;
-    }
-
-    scd = PMIX_NEW(prte_pmix_server_op_caddy_t);
-    /* if we are not going to aggregate, then indicate so */
-    if (noagg) {
-        scd->ndirs = ndirs + 3;
-    } else {
-        scd->ndirs = ndirs + 2;  // need to locally add two directives
-    }
-    PMIX_INFO_CREATE(scd->directives, scd->ndirs);
-    PMIX_DATA_BUFFER_CONSTRUCT(&pbkt);
-    rc = PMIx_Data_load(&pbkt, &boptr);
-    for (n = 0; n < ndirs; n++) {
-        cnt = 1;
-        ret = PMIx_Data_unpack(NULL, &pbkt, (void *) &scd->directives[n], &cnt, PMIX_INFO);
-        if (PMIX_SUCCESS != ret) {
-            PMIX_ERROR_LOG(ret);
-            PMIX_INFO_FREE(scd->directives, scd->ndirs);
-            PMIX_RELEASE(scd);
-            PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-            PMIX_BYTE_OBJECT_CONSTRUCT(&boptr);
-            return;
-        }
-    }
-    PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-    PMIX_BYTE_OBJECT_CONSTRUCT(&boptr);
-
-    /* indicate that only ONE PMIx log component should handle this request */
-    PMIX_INFO_LOAD(&scd->directives[ndirs], PMIX_LOG_ONCE, NULL, PMIX_BOOL);
-    /* protect against infinite loop should the PMIx server push
-     * this back up to us */
-    PMIX_INFO_LOAD(&scd->directives[ndirs+1], "prte.log.noloop", NULL, PMIX_BOOL);
-    if (noagg) {
-        flag = false;
-        PMIX_INFO_LOAD(&scd->directives[ndirs+2], PMIX_LOG_AGG, &flag, PMIX_BOOL);
-    }
-    scd->info = info;
-    scd->ninfo = ninfo;
-    /* pass the array down to be logged */
-    rc = PMIx_Log_nb(scd->info, scd->ninfo, scd->directives, scd->ndirs, log_cbfunc, scd);
-    if (PMIX_SUCCESS != rc) {
-        if (NULL != scd->info) {
-            PMIX_INFO_FREE(scd->info, scd->ninfo);
-        }
-        if (NULL != scd->directives) {
-            PMIX_INFO_FREE(scd->directives, scd->ndirs);
-        }
-        PMIX_RELEASE(scd);
-    }
-}
-
 /* alloc callback to send the results to the requesting daemon */
 static void send_alloc_resp(pmix_status_t status,
                             pmix_info_t info[], size_t ninfo,
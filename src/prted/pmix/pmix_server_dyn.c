@@ -42,6 +42,7 @@
 #include "src/util/pmix_getcwd.h"
 
 #include "src/mca/errmgr/errmgr.h"
+#include "src/mca/ess/base/base.h"
 #include "src/mca/grpcomm/base/base.h"
 #include "src/mca/rmaps/base/base.h"
 #include "src/rml/rml.h"
@@ -841,6 +842,13 @@ static void interim(int sd, short args, void *cbdata)
         }
     }
 
+    /* the rmaps framework parses the mapping directives - a daemon
+     * may not have opened it yet if it has not launched anything */
+    rc = prte_ess_base_prted_open_deferred();
+    if (PRTE_SUCCESS != rc) {
+        goto complete;
+    }
+
     /* initiate the default runtime options - had to delay this until
      * after we parsed the apps as some runtime options are for
      * the apps themselves */
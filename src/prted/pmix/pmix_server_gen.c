@@ -55,10 +55,12 @@
 #include "src/threads/pmix_threads.h"
 #include "src/util/name_fns.h"
 #include "src/util/pmix_show_help.h"
+#include "src/util/pmix_string_copy.h"
 
 #include "src/prted/pmix/pmix_server_internal.h"
 
 static void pmix_server_stdin_push(int sd, short args, void *cbdata);
+static void flush_client_logs(void);
 
 static void _client_conn(int sd, short args, void *cbdata)
 {
@@ -105,6 +107,8 @@ static void _client_finalized(int sd, short args, void *cbdata)
         p = (prte_proc_t *) cd->server_object;
         PRTE_FLAG_SET(p, PRTE_PROC_FLAG_HAS_DEREG);
     }
+    /* push out anything it logged */
+    flush_client_logs();
 
     /* release the caller */
     if (NULL != cd->cbfunc) {
@@ -132,6 +136,8 @@ static void _client_abort(int sd, short args, void *cbdata)
 
     PMIX_ACQUIRE_OBJECT(cd);
 
+    /* push out anything it logged */
+    flush_client_logs();
     if (NULL != cd->server_object) {
         p = (prte_proc_t *) cd->server_object;
         p->exit_code = cd->status;
@@ -340,15 +346,388 @@ void pmix_server_notify(int status, pmix_proc_t *sender, pmix_data_buffer_t *buf
     }
 }
 
+/* Events are only sent to the daemons hosting procs within their
+ * range. The target daemons are packed into the message and form a
+ * radix tree of their own, each relaying the event to its children
+ * in that tree before delivering it to its local clients.
+ */
+static bool mark_job(prte_job_t *jdata, bool *hit)
+{
+    prte_node_t *node;
+    int n;
+
+    if (NULL == jdata->map) {
+        return false;
+    }
+    for (n = 0; n < jdata->map->nodes->size; n++) {
+        node = (prte_node_t *) pmix_pointer_array_get_item(jdata->map->nodes, n);
+        if (NULL == node) {
+            continue;
+        }
+        if (NULL == node->daemon || node->daemon->name.rank >= prte_process_info.num_daemons) {
+            return false;
+        }
+        hit[node->daemon->name.rank] = true;
+    }
+    return true;
+}
+
+static bool mark_proc(const pmix_proc_t *proc, bool *hit)
+{
+    prte_job_t *jdata;
+    prte_proc_t *pptr;
+
+    if (NULL == (jdata = prte_get_job_data_object(proc->nspace))) {
+        return false;
+    }
+    if (PMIX_RANK_WILDCARD == proc->rank) {
+        return mark_job(jdata, hit);
+    }
+    pptr = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs, proc->rank);
+    if (NULL == pptr || NULL == pptr->node || NULL == pptr->node->daemon ||
+        pptr->node->daemon->name.rank >= prte_process_info.num_daemons) {
+        return false;
+    }
+    hit[pptr->node->daemon->name.rank] = true;
+    return true;
+}
+
+/* resolve the daemons (other than ourselves) that host procs within
+ * the range of an event. Returns false if the event must go to all
+ * daemons */
+static bool notify_targets(const pmix_proc_t *source, pmix_data_range_t range,
+                           pmix_info_t info[], size_t ninfo,
+                           pmix_rank_t **targets, int32_t *ntargets)
+{
+    prte_job_t *jdata = NULL, *jptr;
+    pmix_proc_t *procs = NULL;
+    pmix_data_array_t *darray;
+    size_t n, nprocs = 0;
+    pmix_rank_t r;
+    bool *hit, ok = true;
+    int i;
+
+    *targets = NULL;
+    *ntargets = 0;
+
+    switch (range) {
+        case PMIX_RANGE_LOCAL:
+        case PMIX_RANGE_PROC_LOCAL:
+            /* the local server has already delivered it */
+            return true;
+        case PMIX_RANGE_NAMESPACE:
+        case PMIX_RANGE_SESSION:
+            if (NULL == (jdata = prte_get_job_data_object(source->nspace))) {
+                return false;
+            }
+            break;
+        case PMIX_RANGE_CUSTOM:
+            for (n = 0; n < ninfo; n++) {
+                if (PMIX_CHECK_KEY(&info[n], PMIX_EVENT_CUSTOM_RANGE)) {
+                    if (PMIX_PROC == info[n].value.type) {
+                        procs = info[n].value.data.proc;
+                        nprocs = 1;
+                    } else if (PMIX_DATA_ARRAY == info[n].value.type) {
+                        darray = info[n].value.data.darray;
+                        if (NULL != darray && PMIX_PROC == darray->type) {
+                            procs = (pmix_proc_t *) darray->array;
+                            nprocs = darray->size;
+                        }
+                    }
+                    break;
+                }
+            }
+            if (NULL == procs) {
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+
+    hit = (bool *) calloc(prte_process_info.num_daemons, sizeof(bool));
+    if (NULL == hit) {
+        return false;
+    }
+    if (PMIX_RANGE_NAMESPACE == range) {
+        ok = mark_job(jdata, hit);
+    } else if (PMIX_RANGE_SESSION == range) {
+        for (i = 0; ok && i < prte_job_data->size; i++) {
+            jptr = (prte_job_t *) pmix_pointer_array_get_item(prte_job_data, i);
+            if (NULL == jptr || PMIX_CHECK_NSPACE(jptr->nspace, PRTE_PROC_MY_NAME->nspace)) {
+                continue;
+            }
+            if (jptr == jdata) {
+                ok = mark_job(jptr, hit);
+                continue;
+            }
+            /* session info is only tracked on the master - if we
+             * lack it, let the caller fall back to an xcast */
+            if (NULL == jdata->session || NULL == jptr->session) {
+                ok = false;
+                break;
+            }
+            if (prte_sessions_related(jdata->session, jptr->session) ||
+                prte_sessions_related(jptr->session, jdata->session)) {
+                ok = mark_job(jptr, hit);
+            }
+        }
+    } else {
+        for (n = 0; ok && n < nprocs; n++) {
+            ok = mark_proc(&procs[n], hit);
+        }
+    }
+    if (!ok) {
+        free(hit);
+        return false;
+    }
+
+    hit[PRTE_PROC_MY_NAME->rank] = false;
+    for (r = 0; r < prte_process_info.num_daemons; r++) {
+        if (hit[r]) {
+            ++(*ntargets);
+        }
+    }
+    if (0 == *ntargets) {
+        free(hit);
+        return true;
+    }
+    if (*ntargets + 1 >= (int32_t) prte_process_info.num_daemons) {
+        /* everyone else needs it - just broadcast */
+        free(hit);
+        *ntargets = 0;
+        return false;
+    }
+    *targets = (pmix_rank_t *) malloc(*ntargets * sizeof(pmix_rank_t));
+    if (NULL == *targets) {
+        free(hit);
+        *ntargets = 0;
+        return false;
+    }
+    i = 0;
+    for (r = 0; r < prte_process_info.num_daemons; r++) {
+        if (hit[r]) {
+            (*targets)[i++] = r;
+        }
+    }
+    free(hit);
+    return true;
+}
+
+/* pass the event to our children in the tree spanning the targets,
+ * where pos is our position in the target list (-1 for the origin) */
+static void relay_event(pmix_rank_t *targets, int32_t ntargets, int32_t pos,
+                        pmix_data_buffer_t *payload)
+{
+    pmix_data_buffer_t *buf;
+    int32_t child, first, last;
+    int radix = (0 < prte_rml_base.radix) ? prte_rml_base.radix : 1;
+    int rc;
+
+    first = (pos + 1) * radix;
+    last = first + radix;
+    if (last > ntargets) {
+        last = ntargets;
+    }
+    for (child = first; child < last; child++) {
+        PMIX_DATA_BUFFER_CREATE(buf);
+        rc = PMIx_Data_pack(NULL, buf, &ntargets, 1, PMIX_INT32);
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, buf, targets, ntargets, PMIX_PROC_RANK);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_copy_payload(buf, payload);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_RELEASE(buf);
+            continue;
+        }
+        PRTE_RML_SEND(rc, targets[child], buf, PRTE_RML_TAG_NOTIFY_RELAY);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_RELEASE(buf);
+        }
+    }
+}
+
+/* an event addressed to a subset of the daemons - forward it
+ * down the tree and then handle it like any other */
+void pmix_server_notify_relay(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
+                              prte_rml_tag_t tg, void *cbdata)
+{
+    pmix_rank_t *targets;
+    int32_t ntargets, pos;
+    int cnt, rc;
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &ntargets, &cnt, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    if (0 >= ntargets) {
+        PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
+        return;
+    }
+    targets = (pmix_rank_t *) malloc(ntargets * sizeof(pmix_rank_t));
+    if (NULL == targets) {
+        return;
+    }
+    cnt = ntargets;
+    rc = PMIx_Data_unpack(NULL, buffer, targets, &cnt, PMIX_PROC_RANK);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        free(targets);
+        return;
+    }
+    for (pos = 0; pos < ntargets; pos++) {
+        if (targets[pos] == PRTE_PROC_MY_NAME->rank) {
+            relay_event(targets, ntargets, pos, buffer);
+            break;
+        }
+    }
+    free(targets);
+
+    pmix_server_notify(status, sender, buffer, tg, cbdata);
+}
+
+static int send_event(pmix_data_buffer_t *pbkt, pmix_rank_t *targets, int32_t ntargets)
+{
+    prte_grpcomm_signature_t *sig;
+    int rc;
+
+    if (0 < ntargets) {
+        pmix_output_verbose(2, prte_pmix_server_globals.output,
+                            "%s sending event to %d daemons",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int) ntargets);
+        relay_event(targets, ntargets, -1, pbkt);
+        return PMIX_SUCCESS;
+    }
+
+    /* goes to all daemons */
+    sig = PMIX_NEW(prte_grpcomm_signature_t);
+    if (NULL == sig) {
+        return PMIX_ERR_NOMEM;
+    }
+    sig->signature = (pmix_proc_t *) malloc(sizeof(pmix_proc_t));
+    if (NULL == sig->signature) {
+        PMIX_RELEASE(sig);
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_LOAD_PROCID(&sig->signature[0], PRTE_PROC_MY_NAME->nspace, PMIX_RANK_WILDCARD);
+    sig->sz = 1;
+    if (PRTE_SUCCESS != (rc = prte_grpcomm.xcast(sig, PRTE_RML_TAG_NOTIFICATION, pbkt))) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_RELEASE(sig);
+        return PMIX_ERROR;
+    }
+    /* maintain accounting */
+    PMIX_RELEASE(sig);
+    return PMIX_SUCCESS;
+}
+
+/* Events generated within the coalescing window are held and identical
+ * ones dropped - a burst of the same event is delivered only once */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_data_buffer_t msg;
+    pmix_rank_t *targets;
+    int32_t ntargets;
+} notify_pending_t;
+static void npcon(notify_pending_t *p)
+{
+    PMIX_DATA_BUFFER_CONSTRUCT(&p->msg);
+    p->targets = NULL;
+    p->ntargets = 0;
+}
+static void npdes(notify_pending_t *p)
+{
+    PMIX_DATA_BUFFER_DESTRUCT(&p->msg);
+    if (NULL != p->targets) {
+        free(p->targets);
+    }
+}
+static PMIX_CLASS_INSTANCE(notify_pending_t,
+                           pmix_list_item_t,
+                           npcon, npdes);
+
+static prte_event_t notify_timer;
+static bool notify_timer_active = false;
+
+static void flush_events(int sd, short args, void *cbdata)
+{
+    notify_pending_t *p;
+    pmix_status_t rc;
+    PRTE_HIDE_UNUSED_PARAMS(sd, args, cbdata);
+
+    notify_timer_active = false;
+    while (NULL != (p = (notify_pending_t *)
+                    pmix_list_remove_first(&prte_pmix_server_globals.pending_events))) {
+        rc = send_event(&p->msg, p->targets, p->ntargets);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+        }
+        PMIX_RELEASE(p);
+    }
+}
+
+void pmix_server_notify_flush(void)
+{
+    if (notify_timer_active) {
+        prte_event_evtimer_del(&notify_timer);
+    }
+    flush_events(-1, 0, NULL);
+}
+
+static pmix_status_t queue_event(pmix_data_buffer_t *pbkt, pmix_rank_t *targets,
+                                 int32_t ntargets)
+{
+    notify_pending_t *p;
+    struct timeval tv;
+    pmix_status_t rc;
+
+    PMIX_LIST_FOREACH(p, &prte_pmix_server_globals.pending_events, notify_pending_t) {
+        if (p->msg.bytes_used == pbkt->bytes_used &&
+            0 == memcmp(p->msg.base_ptr, pbkt->base_ptr, pbkt->bytes_used)) {
+            pmix_output_verbose(2, prte_pmix_server_globals.output,
+                                "%s coalescing duplicate event",
+                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
+            free(targets);
+            return PMIX_SUCCESS;
+        }
+    }
+    p = PMIX_NEW(notify_pending_t);
+    rc = PMIx_Data_copy_payload(&p->msg, pbkt);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(p);
+        free(targets);
+        return rc;
+    }
+    p->targets = targets;
+    p->ntargets = ntargets;
+    pmix_list_append(&prte_pmix_server_globals.pending_events, &p->super);
+
+    if (!notify_timer_active) {
+        notify_timer_active = true;
+        tv.tv_sec = prte_pmix_server_globals.event_coalesce / 1000000;
+        tv.tv_usec = prte_pmix_server_globals.event_coalesce % 1000000;
+        prte_event_evtimer_set(prte_event_base, &notify_timer, flush_events, NULL);
+        prte_event_evtimer_add(&notify_timer, &tv);
+    }
+    return PMIX_SUCCESS;
+}
+
 pmix_status_t pmix_server_notify_event(pmix_status_t code, const pmix_proc_t *source,
                                        pmix_data_range_t range, pmix_info_t info[], size_t ninfo,
                                        pmix_op_cbfunc_t cbfunc, void *cbdata)
 {
     int rc;
-    prte_grpcomm_signature_t *sig;
     pmix_data_buffer_t pbkt;
     pmix_status_t ret;
     size_t n;
+    pmix_rank_t *targets;
+    int32_t ntargets;
     PRTE_HIDE_UNUSED_PARAMS(cbfunc, cbdata);
 
     pmix_output_verbose(2, prte_pmix_server_globals.output,
@@ -380,9 +759,16 @@ pmix_status_t pmix_server_notify_event(pmix_status_t code, const pmix_proc_t *so
         goto done;
     }
 
-    /* a local process has generated an event - we need to xcast it
-     * to all the daemons so it can be passed down to their local
-     * procs */
+    /* a local process has generated an event - we need to send it
+     * to the daemons hosting procs within its range so it can be
+     * passed down to their local procs */
+    if (notify_targets(source, range, info, ninfo, &targets, &ntargets) && 0 == ntargets) {
+        /* nobody else is in range */
+        pmix_output_verbose(2, prte_pmix_server_globals.output,
+                            "%s no remote daemons in range of event",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
+        goto done;
+    }
     PMIX_DATA_BUFFER_CONSTRUCT(&pbkt);
 
     /* we need to add a flag indicating this came from us as we are going to get it echoed
@@ -391,6 +777,7 @@ pmix_status_t pmix_server_notify_event(pmix_status_t code, const pmix_proc_t *so
         != (rc = PMIx_Data_pack(NULL, &pbkt, &PRTE_PROC_MY_NAME->rank, 1, PMIX_PROC_RANK))) {
         PMIX_ERROR_LOG(rc);
         PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+        free(targets);
         return rc;
     }
 
@@ -398,57 +785,49 @@ pmix_status_t pmix_server_notify_event(pmix_status_t code, const pmix_proc_t *so
     if (PMIX_SUCCESS != (ret = PMIx_Data_pack(NULL, &pbkt, &code, 1, PMIX_STATUS))) {
         PMIX_ERROR_LOG(ret);
         PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+        free(targets);
         return ret;
     }
     /* pack the source */
     if (PMIX_SUCCESS != (ret = PMIx_Data_pack(NULL, &pbkt, (pmix_proc_t *) source, 1, PMIX_PROC))) {
         PMIX_ERROR_LOG(ret);
         PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+        free(targets);
         return ret;
     }
     /* pack the range */
     if (PMIX_SUCCESS != (ret = PMIx_Data_pack(NULL, &pbkt, &range, 1, PMIX_DATA_RANGE))) {
         PMIX_ERROR_LOG(ret);
         PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+        free(targets);
         return ret;
     }
     /* pack the number of infos */
     if (PMIX_SUCCESS != (ret = PMIx_Data_pack(NULL, &pbkt, &ninfo, 1, PMIX_SIZE))) {
         PMIX_ERROR_LOG(ret);
         PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+        free(targets);
         return ret;
     }
     if (0 < ninfo) {
         if (PMIX_SUCCESS != (ret = PMIx_Data_pack(NULL, &pbkt, info, ninfo, PMIX_INFO))) {
             PMIX_ERROR_LOG(ret);
             PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+            free(targets);
             return ret;
         }
     }
 
-    /* goes to all daemons */
-    sig = PMIX_NEW(prte_grpcomm_signature_t);
-    if (NULL == sig) {
-        PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-        return PMIX_ERR_NOMEM;
-    }
-    sig->signature = (pmix_proc_t *) malloc(sizeof(pmix_proc_t));
-    if (NULL == sig->signature) {
-        PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-        PMIX_RELEASE(sig);
-        return PMIX_ERR_NOMEM;
-    }
-    PMIX_LOAD_PROCID(&sig->signature[0], PRTE_PROC_MY_NAME->nspace, PMIX_RANK_WILDCARD);
-    sig->sz = 1;
-    if (PRTE_SUCCESS != (rc = prte_grpcomm.xcast(sig, PRTE_RML_TAG_NOTIFICATION, &pbkt))) {
-        PRTE_ERROR_LOG(rc);
-        PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-        PMIX_RELEASE(sig);
-        return PMIX_ERROR;
+    if (0 < prte_pmix_server_globals.event_coalesce) {
+        ret = queue_event(&pbkt, targets, ntargets);
+    } else {
+        ret = send_event(&pbkt, targets, ntargets);
+        free(targets);
     }
     PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-    /* maintain accounting */
-    PMIX_RELEASE(sig);
+    if (PMIX_SUCCESS != ret) {
+        return ret;
+    }
 
 done:
     /* we do not need to execute a callback as we did this atomically */
@@ -704,11 +1083,675 @@ void pmix_tool_connected_fn(pmix_info_t *info, size_t ninfo,
     prte_event_active(&(cd->ev), PRTE_EV_WRITE, 1);
 }
 
+/* PMIx_Log requests from local clients are collected over the
+ * log_batch window and forwarded to the DVM master as a single
+ * (compressed) message. Identical requests from different procs of
+ * the same job are combined into one entry carrying all of their
+ * ranks - the master then does the same across the daemons before
+ * outputting them, so a message that every rank logged is only
+ * shown once along with the procs that reported it */
+#define PRTE_LOG_BATCH_MAX (64 * 1024)
+
+typedef struct {
+    pmix_list_item_t super;
+    pmix_nspace_t nspace;
+    /* procs that logged this entry */
+    pmix_rank_t *ranks;
+    uint32_t nranks;
+    /* who gave it to us - the client on a daemon, or the
+     * daemon on the master. Not sent */
+    pmix_rank_t *senders;
+    uint32_t nsenders;
+    size_t ninfo;
+    size_t ndirs;
+    pmix_byte_object_t info;
+    pmix_byte_object_t dirs;
+    bool noagg;
+} log_entry_t;
+static void lecon(log_entry_t *p)
+{
+    PMIX_LOAD_NSPACE(p->nspace, NULL);
+    p->ranks = NULL;
+    p->nranks = 0;
+    p->senders = NULL;
+    p->nsenders = 0;
+    p->ninfo = 0;
+    p->ndirs = 0;
+    PMIX_BYTE_OBJECT_CONSTRUCT(&p->info);
+    PMIX_BYTE_OBJECT_CONSTRUCT(&p->dirs);
+    p->noagg = false;
+}
+static void ledes(log_entry_t *p)
+{
+    if (NULL != p->ranks) {
+        free(p->ranks);
+    }
+    if (NULL != p->senders) {
+        free(p->senders);
+    }
+    PMIX_BYTE_OBJECT_DESTRUCT(&p->info);
+    PMIX_BYTE_OBJECT_DESTRUCT(&p->dirs);
+}
+static PMIX_CLASS_INSTANCE(log_entry_t,
+                           pmix_list_item_t,
+                           lecon, ledes);
+
+typedef struct {
+    pmix_list_t *entries;
+    size_t bytes;
+    prte_event_t timer;
+    bool timer_active;
+    void (*flush)(int sd, short args, void *cbdata);
+} log_queue_t;
+
+static void flush_log_fwd(int sd, short args, void *cbdata);
+static void flush_log_agg(int sd, short args, void *cbdata);
+
+/* entries from our local clients waiting to go to the master */
+static log_queue_t log_fwd = {
+    .entries = &prte_pmix_server_globals.pending_logs,
+    .bytes = 0,
+    .timer_active = false,
+    .flush = flush_log_fwd
+};
+/* entries waiting to be output by the master */
+static log_queue_t log_agg = {
+    .entries = &prte_pmix_server_globals.pending_aggs,
+    .bytes = 0,
+    .timer_active = false,
+    .flush = flush_log_agg
+};
+
+static void append_ranks(pmix_rank_t **array, uint32_t *n, const pmix_rank_t *add, uint32_t nadd)
+{
+    pmix_rank_t *tmp;
+
+    tmp = (pmix_rank_t *) realloc(*array, (*n + nadd) * sizeof(pmix_rank_t));
+    if (NULL == tmp) {
+        PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+        return;
+    }
+    memcpy(&tmp[*n], add, nadd * sizeof(pmix_rank_t));
+    *array = tmp;
+    *n += nadd;
+}
+
+static bool has_sender(log_entry_t *e, pmix_rank_t sender)
+{
+    uint32_t n;
+
+    for (n = 0; n < e->nsenders; n++) {
+        if (e->senders[n] == sender) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void queue_log(log_queue_t *q, log_entry_t *entry, pmix_rank_t sender)
+{
+    log_entry_t *e, *match = NULL;
+    struct timeval tv;
+
+    if (!entry->noagg) {
+        /* combining moves the new entry up to where the earlier one
+         * is queued, so it can only join one queued after the last
+         * entry from the same sender */
+        PMIX_LIST_FOREACH(e, q->entries, log_entry_t) {
+            if (has_sender(e, sender)) {
+                match = NULL;
+                continue;
+            }
+            if (NULL != match || e->noagg || e->ninfo != entry->ninfo ||
+                e->ndirs != entry->ndirs || e->info.size != entry->info.size ||
+                e->dirs.size != entry->dirs.size || !PMIX_CHECK_NSPACE(e->nspace, entry->nspace)) {
+                continue;
+            }
+            if (0 != memcmp(e->info.bytes, entry->info.bytes, entry->info.size) ||
+                0 != memcmp(e->dirs.bytes, entry->dirs.bytes, entry->dirs.size)) {
+                continue;
+            }
+            match = e;
+        }
+        if (NULL != match) {
+            pmix_output_verbose(2, prte_pmix_server_globals.output,
+                                "%s combining log entry from %u procs",
+                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), entry->nranks);
+            append_ranks(&match->ranks, &match->nranks, entry->ranks, entry->nranks);
+            append_ranks(&match->senders, &match->nsenders, &sender, 1);
+            PMIX_RELEASE(entry);
+            return;
+        }
+    }
+    append_ranks(&entry->senders, &entry->nsenders, &sender, 1);
+    pmix_list_append(q->entries, &entry->super);
+    q->bytes += entry->info.size + entry->dirs.size;
+
+    if (0 == prte_pmix_server_globals.log_batch || PRTE_LOG_BATCH_MAX <= q->bytes) {
+        q->flush(-1, 0, q);
+        return;
+    }
+    if (!q->timer_active) {
+        q->timer_active = true;
+        tv.tv_sec = prte_pmix_server_globals.log_batch / 1000000;
+        tv.tv_usec = prte_pmix_server_globals.log_batch % 1000000;
+        prte_event_evtimer_set(prte_event_base, &q->timer, q->flush, q);
+        prte_event_evtimer_add(&q->timer, &tv);
+    }
+}
+
+static void stop_timer(log_queue_t *q)
+{
+    if (q->timer_active) {
+        prte_event_evtimer_del(&q->timer);
+        q->timer_active = false;
+    }
+    q->bytes = 0;
+}
+
+static void flush_log_fwd(int sd, short args, void *cbdata)
+{
+    log_queue_t *q = (log_queue_t *) cbdata;
+    log_entry_t *e;
+    pmix_data_buffer_t pbkt, *buf;
+    pmix_byte_object_t pbo;
+    int32_t nentries;
+    bool compressed;
+    pmix_status_t rc;
+    int ret;
+    PRTE_HIDE_UNUSED_PARAMS(sd, args);
+
+    stop_timer(q);
+    if (0 == pmix_list_get_size(q->entries)) {
+        return;
+    }
+
+    /* the master has nobody to forward to */
+    if (PRTE_PROC_IS_MASTER) {
+        while (NULL != (e = (log_entry_t *) pmix_list_remove_first(q->entries))) {
+            /* senders were our own clients */
+            free(e->senders);
+            e->senders = NULL;
+            e->nsenders = 0;
+            queue_log(&log_agg, e, PRTE_PROC_MY_NAME->rank);
+        }
+        return;
+    }
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&pbkt);
+    nentries = pmix_list_get_size(q->entries);
+    rc = PMIx_Data_pack(NULL, &pbkt, &nentries, 1, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+    while (NULL != (e = (log_entry_t *) pmix_list_remove_first(q->entries))) {
+        rc = PMIx_Data_pack(NULL, &pbkt, &e->nspace, 1, PMIX_PROC_NSPACE);
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, &pbkt, &e->nranks, 1, PMIX_UINT32);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, &pbkt, e->ranks, e->nranks, PMIX_PROC_RANK);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, &pbkt, &e->ninfo, 1, PMIX_SIZE);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, &pbkt, &e->ndirs, 1, PMIX_SIZE);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, &pbkt, &e->info, 1, PMIX_BYTE_OBJECT);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, &pbkt, &e->dirs, 1, PMIX_BYTE_OBJECT);
+        }
+        PMIX_RELEASE(e);
+        if (PMIX_SUCCESS != rc) {
+            goto error;
+        }
+    }
+
+    pmix_output_verbose(2, prte_pmix_server_globals.output,
+                        "%s forwarding %d log entries",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), nentries);
+
+    if (PMIx_Data_compress((uint8_t *) pbkt.base_ptr, pbkt.bytes_used,
+                           (uint8_t **) &pbo.bytes, &pbo.size)) {
+        compressed = true;
+    } else {
+        compressed = false;
+        pbo.bytes = pbkt.base_ptr;
+        pbo.size = pbkt.bytes_used;
+        pbkt.base_ptr = NULL;
+        pbkt.bytes_used = 0;
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+
+    PMIX_DATA_BUFFER_CREATE(buf);
+    rc = PMIx_Data_pack(NULL, buf, &compressed, 1, PMIX_BOOL);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buf, &pbo, 1, PMIX_BYTE_OBJECT);
+    }
+    PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        return;
+    }
+    PRTE_RML_SEND(ret, PRTE_PROC_MY_HNP->rank, buf, PRTE_RML_TAG_LOGGING);
+    if (PRTE_SUCCESS != ret) {
+        PRTE_ERROR_LOG(ret);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+    }
+    return;
+
+error:
+    PMIX_ERROR_LOG(rc);
+    PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+    PMIX_LIST_DESTRUCT(q->entries);
+    PMIX_CONSTRUCT(q->entries, pmix_list_t);
+}
+
+/* the master's side - unpack a batch from a daemon and queue its
+ * entries so those from different daemons can be combined */
+void pmix_server_log(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
+                     prte_rml_tag_t tg, void *cbdata)
+{
+    pmix_data_buffer_t pbkt;
+    pmix_byte_object_t pbo;
+    log_entry_t *e;
+    prte_job_t *jdata;
+    int32_t cnt, nentries, n;
+    bool compressed;
+    uint8_t *raw;
+    size_t rawsz;
+    pmix_status_t rc;
+    PRTE_HIDE_UNUSED_PARAMS(status, tg, cbdata);
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &compressed, &cnt, PMIX_BOOL);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &pbo, &cnt, PMIX_BYTE_OBJECT);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    if (compressed) {
+        if (!PMIx_Data_decompress((uint8_t *) pbo.bytes, pbo.size, &raw, &rawsz)) {
+            PMIX_ERROR_LOG(PMIX_ERR_UNPACK_FAILURE);
+            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+            return;
+        }
+        PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+        pbo.bytes = (char *) raw;
+        pbo.size = rawsz;
+    }
+    PMIX_DATA_BUFFER_CONSTRUCT(&pbkt);
+    rc = PMIx_Data_load(&pbkt, &pbo);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+        return;
+    }
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, &pbkt, &nentries, &cnt, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+        return;
+    }
+    for (n = 0; n < nentries; n++) {
+        e = PMIX_NEW(log_entry_t);
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, &pbkt, &e->nspace, &cnt, PMIX_PROC_NSPACE);
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            rc = PMIx_Data_unpack(NULL, &pbkt, &e->nranks, &cnt, PMIX_UINT32);
+        }
+        if (PMIX_SUCCESS == rc && 0 < e->nranks) {
+            e->ranks = (pmix_rank_t *) malloc(e->nranks * sizeof(pmix_rank_t));
+            cnt = e->nranks;
+            rc = PMIx_Data_unpack(NULL, &pbkt, e->ranks, &cnt, PMIX_PROC_RANK);
+        }
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            rc = PMIx_Data_unpack(NULL, &pbkt, &e->ninfo, &cnt, PMIX_SIZE);
+        }
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            rc = PMIx_Data_unpack(NULL, &pbkt, &e->ndirs, &cnt, PMIX_SIZE);
+        }
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            rc = PMIx_Data_unpack(NULL, &pbkt, &e->info, &cnt, PMIX_BYTE_OBJECT);
+        }
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            rc = PMIx_Data_unpack(NULL, &pbkt, &e->dirs, &cnt, PMIX_BYTE_OBJECT);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(e);
+            break;
+        }
+        /* look up the job for this source */
+        jdata = prte_get_job_data_object(e->nspace);
+        if (NULL == jdata) {
+            /* should never happen */
+            PMIX_ERROR_LOG(PMIX_ERR_NOT_FOUND);
+            PMIX_RELEASE(e);
+            continue;
+        }
+        e->noagg = prte_get_attribute(&jdata->attributes, PRTE_JOB_NOAGG_HELP, NULL, PMIX_BOOL);
+        queue_log(&log_agg, e, sender->rank);
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+}
+
+static void log_cbfunc(pmix_status_t status, void *cbdata)
+{
+    prte_pmix_server_op_caddy_t *scd = (prte_pmix_server_op_caddy_t *) cbdata;
+
+    if (PMIX_SUCCESS != status && PMIX_OPERATION_SUCCEEDED != status) {
+        pmix_output(prte_pmix_server_globals.output, "LOG FAILED");
+    }
+    if (NULL != scd->info) {
+        PMIX_INFO_FREE(scd->info, scd->ninfo);
+    }
+    if (NULL != scd->directives) {
+        PMIX_INFO_FREE(scd->directives, scd->ndirs);
+    }
+    PMIX_RELEASE(scd);
+}
+
+static int rank_cmp(const void *a, const void *b)
+{
+    pmix_rank_t ra = *(const pmix_rank_t *) a;
+    pmix_rank_t rb = *(const pmix_rank_t *) b;
+
+    return (ra < rb) ? -1 : ((ra > rb) ? 1 : 0);
+}
+
+/* append the procs that logged a combined entry to its message */
+static char *annotate(const char *msg, log_entry_t *e)
+{
+    char ranges[128], *result;
+    size_t len = 0, mlen;
+    uint32_t n, start;
+    int rc;
+
+    qsort(e->ranks, e->nranks, sizeof(pmix_rank_t), rank_cmp);
+    ranges[0] = '\0';
+    /* only start an entry if the longest one (",<rank>-<rank>" at 22
+     * chars) plus a closing ",..." and the NUL is sure to fit */
+    for (n = 0; n < e->nranks && len + 22 + 5 <= sizeof(ranges); n++) {
+        start = n;
+        while (n + 1 < e->nranks && e->ranks[n + 1] <= e->ranks[n] + 1) {
+            ++n;
+        }
+        if (e->ranks[start] == e->ranks[n]) {
+            rc = snprintf(&ranges[len], sizeof(ranges) - len, "%s%u",
+                          (0 == len) ? "" : ",", e->ranks[n]);
+        } else {
+            rc = snprintf(&ranges[len], sizeof(ranges) - len, "%s%u-%u",
+                          (0 == len) ? "" : ",", e->ranks[start], e->ranks[n]);
+        }
+        if (0 > rc || (size_t) rc >= sizeof(ranges) - len) {
+            /* truncated - stop at what did fit */
+            len = strlen(ranges);
+            break;
+        }
+        len += rc;
+    }
+    if (n < e->nranks) {
+        pmix_string_copy(&ranges[len], ",...", sizeof(ranges) - len);
+    }
+
+    /* keep any trailing newline at the end */
+    mlen = strlen(msg);
+    if (0 < mlen && '\n' == msg[mlen - 1]) {
+        --mlen;
+    }
+    pmix_asprintf(&result, "%.*s [reported by %u procs of %s: ranks %s]%s", (int) mlen, msg,
+                  e->nranks, e->nspace, ranges, (mlen < strlen(msg)) ? "\n" : "");
+    return result;
+}
+
+/* stdout/stderr text collected from one source so it goes to
+ * the IOF in a single delivery - the IOF queues it and writes it
+ * out when the fd can take it, so the event loop never blocks */
+typedef struct {
+    pmix_iof_channel_t channel;
+    pmix_proc_t source;
+    char *text;
+    size_t len;
+    size_t size;
+} log_out_t;
+
+static void deliver_out(log_out_t *out)
+{
+    pmix_byte_object_t bo;
+
+    if (0 == out->len) {
+        return;
+    }
+    bo.bytes = out->text;
+    bo.size = out->len;
+    PMIx_server_IOF_deliver(&out->source, out->channel, &bo, NULL, 0, NULL, NULL);
+    out->len = 0;
+}
+
+static void add_out(log_out_t *out, log_entry_t *e, char *msg)
+{
+    pmix_rank_t rank;
+    size_t len = strlen(msg);
+    char *tmp;
+
+    rank = (1 == e->nranks) ? e->ranks[0] : PMIX_RANK_WILDCARD;
+    if (0 < out->len &&
+        (!PMIX_CHECK_NSPACE(out->source.nspace, e->nspace) || out->source.rank != rank)) {
+        deliver_out(out);
+    }
+    PMIX_LOAD_PROCID(&out->source, e->nspace, rank);
+    if (out->size < out->len + len) {
+        tmp = (char *) realloc(out->text, 2 * (out->len + len));
+        if (NULL == tmp) {
+            PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+            free(msg);
+            return;
+        }
+        out->text = tmp;
+        out->size = 2 * (out->len + len);
+    }
+    memcpy(&out->text[out->len], msg, len);
+    out->len += len;
+    free(msg);
+    if (PRTE_LOG_BATCH_MAX <= out->len) {
+        deliver_out(out);
+    }
+}
+
+/* directives that do not change what the stdout/stderr
+ * channels output */
+static bool plain_directive(const pmix_info_t *info)
+{
+    return (PMIX_CHECK_KEY(info, PMIX_LOG_SOURCE) ||
+            PMIX_CHECK_KEY(info, PMIX_LOG_TIMESTAMP) ||
+            PMIX_CHECK_KEY(info, PMIX_LOG_GENERATE_TIMESTAMP) ||
+            PMIX_CHECK_KEY(info, PMIX_LOG_ONCE) ||
+            PMIX_CHECK_KEY(info, PMIX_LOG_AGG));
+}
+
+static void unpack_infos(pmix_byte_object_t *bo, pmix_info_t **info, size_t ninfo,
+                         size_t extra)
+{
+    pmix_data_buffer_t pbkt;
+    pmix_byte_object_t tmp;
+    pmix_status_t rc;
+    int32_t cnt;
+    size_t n;
+
+    PMIX_INFO_CREATE(*info, ninfo + extra);
+    if (0 == ninfo) {
+        return;
+    }
+    /* load a copy as the entry retains the original */
+    PMIX_BYTE_OBJECT_CONSTRUCT(&tmp);
+    tmp.bytes = (char *) malloc(bo->size);
+    memcpy(tmp.bytes, bo->bytes, bo->size);
+    tmp.size = bo->size;
+    PMIX_DATA_BUFFER_CONSTRUCT(&pbkt);
+    rc = PMIx_Data_load(&pbkt, &tmp);
+    for (n = 0; PMIX_SUCCESS == rc && n < ninfo; n++) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, &pbkt, &(*info)[n], &cnt, PMIX_INFO);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_INFO_FREE(*info, ninfo + extra);
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+}
+
+static void deliver_log(log_entry_t *e, log_out_t *out, log_out_t *err)
+{
+    prte_pmix_server_op_caddy_t *scd;
+    pmix_info_t *info, *dirs;
+    char *msg;
+    bool plain;
+    bool flag;
+    size_t n;
+    pmix_status_t rc;
+
+    unpack_infos(&e->info, &info, e->ninfo, 0);
+    if (NULL == info) {
+        return;
+    }
+
+    if (1 < e->nranks) {
+        for (n = 0; n < e->ninfo; n++) {
+            if (PMIX_STRING != info[n].value.type || NULL == info[n].value.data.string) {
+                continue;
+            }
+            if (PMIX_CHECK_KEY(&info[n], PMIX_LOG_STDOUT) ||
+                PMIX_CHECK_KEY(&info[n], PMIX_LOG_STDERR) ||
+                PMIX_CHECK_KEY(&info[n], PMIX_LOG_SYSLOG) ||
+                PMIX_CHECK_KEY(&info[n], PMIX_LOG_LOCAL_SYSLOG) ||
+                PMIX_CHECK_KEY(&info[n], PMIX_LOG_GLOBAL_SYSLOG)) {
+                msg = annotate(info[n].value.data.string, e);
+                free(info[n].value.data.string);
+                info[n].value.data.string = msg;
+            }
+        }
+    }
+
+    /* we need room to locally add up to three directives */
+    unpack_infos(&e->dirs, &dirs, e->ndirs, 3);
+    if (NULL == dirs) {
+        PMIX_INFO_FREE(info, e->ninfo);
+        return;
+    }
+
+    /* plain stdout/stderr output is passed to the IOF directly so
+     * the whole batch goes out in a few deliveries */
+    plain = (0 < e->ninfo);
+    for (n = 0; plain && n < e->ninfo; n++) {
+        plain = (PMIX_STRING == info[n].value.type && NULL != info[n].value.data.string &&
+                 (PMIX_CHECK_KEY(&info[n], PMIX_LOG_STDOUT) ||
+                  PMIX_CHECK_KEY(&info[n], PMIX_LOG_STDERR)));
+    }
+    for (n = 0; plain && n < e->ndirs; n++) {
+        plain = plain_directive(&dirs[n]);
+    }
+    if (plain) {
+        for (n = 0; n < e->ninfo; n++) {
+            msg = info[n].value.data.string;
+            info[n].value.data.string = NULL;
+            if (PMIX_CHECK_KEY(&info[n], PMIX_LOG_STDOUT)) {
+                add_out(out, e, msg);
+            } else {
+                add_out(err, e, msg);
+            }
+        }
+        PMIX_INFO_FREE(info, e->ninfo);
+        PMIX_INFO_FREE(dirs, e->ndirs + 3);
+        return;
+    }
+
+    scd = PMIX_NEW(prte_pmix_server_op_caddy_t);
+    scd->info = info;
+    scd->ninfo = e->ninfo;
+    scd->directives = dirs;
+    /* indicate that only ONE PMIx log component should handle this request */
+    PMIX_INFO_LOAD(&dirs[e->ndirs], PMIX_LOG_ONCE, NULL, PMIX_BOOL);
+    /* protect against infinite loop should the PMIx server push
+     * this back up to us */
+    PMIX_INFO_LOAD(&dirs[e->ndirs + 1], "prte.log.noloop", NULL, PMIX_BOOL);
+    /* if we are not going to aggregate, then indicate so */
+    if (e->noagg) {
+        flag = false;
+        PMIX_INFO_LOAD(&dirs[e->ndirs + 2], PMIX_LOG_AGG, &flag, PMIX_BOOL);
+        scd->ndirs = e->ndirs + 3;
+    } else {
+        scd->ndirs = e->ndirs + 2;
+    }
+    /* pass the array down to be logged */
+    rc = PMIx_Log_nb(scd->info, scd->ninfo, scd->directives, scd->ndirs, log_cbfunc, scd);
+    if (PMIX_SUCCESS != rc) {
+        log_cbfunc(rc, scd);
+    }
+}
+
+static void flush_log_agg(int sd, short args, void *cbdata)
+{
+    log_queue_t *q = (log_queue_t *) cbdata;
+    log_out_t out, err;
+    log_entry_t *e;
+    PRTE_HIDE_UNUSED_PARAMS(sd, args);
+
+    stop_timer(q);
+    memset(&out, 0, sizeof(out));
+    out.channel = PMIX_FWD_STDOUT_CHANNEL;
+    memset(&err, 0, sizeof(err));
+    err.channel = PMIX_FWD_STDERR_CHANNEL;
+    while (NULL != (e = (log_entry_t *) pmix_list_remove_first(q->entries))) {
+        deliver_log(e, &out, &err);
+        PMIX_RELEASE(e);
+    }
+    deliver_out(&out);
+    deliver_out(&err);
+    if (NULL != out.text) {
+        free(out.text);
+    }
+    if (NULL != err.text) {
+        free(err.text);
+    }
+}
+
+void pmix_server_log_flush(void)
+{
+    flush_log_fwd(-1, 0, &log_fwd);
+    if (PRTE_PROC_IS_MASTER) {
+        flush_log_agg(-1, 0, &log_agg);
+    }
+}
+
 static void lgcbfn(int sd, short args, void *cbdata)
 {
     prte_pmix_server_op_caddy_t *cd = (prte_pmix_server_op_caddy_t *) cbdata;
+    log_entry_t *e;
     PRTE_HIDE_UNUSED_PARAMS(sd, args);
 
+    /* queue the entry before releasing the client so it is
+     * ahead of anything else the client then does */
+    if (NULL != cd->server_object) {
+        e = (log_entry_t *) cd->server_object;
+        queue_log(&log_fwd, e, e->ranks[0]);
+    }
     if (NULL != cd->cbfunc) {
         cd->cbfunc(cd->status, cd->cbdata);
     }
@@ -719,11 +1762,11 @@ void pmix_server_log_fn(const pmix_proc_t *client, const pmix_info_t data[], siz
                         const pmix_info_t directives[], size_t ndirs, pmix_op_cbfunc_t cbfunc,
                         void *cbdata)
 {
-    size_t n, cnt, dcnt;
-    pmix_data_buffer_t *buf;
+    size_t n;
     int rc = PRTE_SUCCESS;
     pmix_data_buffer_t pbuf, dbuf;
-    pmix_byte_object_t pbo, dbo;
+    log_entry_t *e = NULL;
+    prte_job_t *jdata;
     pmix_status_t ret;
 
     pmix_output_verbose(2, prte_pmix_server_globals.output,
@@ -731,12 +1774,14 @@ void pmix_server_log_fn(const pmix_proc_t *client, const pmix_info_t data[], siz
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
 
     PMIX_DATA_BUFFER_CONSTRUCT(&dbuf);
+    PMIX_DATA_BUFFER_CONSTRUCT(&pbuf);
+    e = PMIX_NEW(log_entry_t);
     /* if we are the one that passed it down, then we don't pass it back */
-    dcnt = 0;
     for (n = 0; n < ndirs; n++) {
         if (PMIX_CHECK_KEY(&directives[n], "prte.log.noloop")) {
             if (PMIX_INFO_TRUE(&directives[n])) {
-                rc = PMIX_SUCCESS;
+                PMIX_RELEASE(e);
+                e = NULL;
                 goto done;
             }
         }
@@ -745,66 +1790,55 @@ void pmix_server_log_fn(const pmix_proc_t *client, const pmix_info_t data[], siz
             if (PMIX_SUCCESS != ret) {
                 PMIX_ERROR_LOG(ret);
             }
-            dcnt++;
+            e->ndirs++;
         }
     }
 
-    PMIX_DATA_BUFFER_CONSTRUCT(&pbuf);
-    cnt = 0;
-
     for (n = 0; n < ndata; n++) {
         /* ship this to our HNP/MASTER for processing, even if that is us */
         ret = PMIx_Data_pack(NULL, &pbuf, (pmix_info_t *) &data[n], 1, PMIX_INFO);
         if (PMIX_SUCCESS != ret) {
             PMIX_ERROR_LOG(ret);
         }
-        ++cnt;
+        e->ninfo++;
     }
-    if (0 < cnt) {
-        PMIX_DATA_BUFFER_CREATE(buf);
-        /* pack the source of this log request */
-        rc = PMIx_Data_pack(NULL, buf, (void*)client, 1, PMIX_PROC);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-        }
-        /* pack number of info provided */
-        rc = PMIx_Data_pack(NULL, buf, &cnt, 1, PMIX_SIZE);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-        }
-        /* pack number of directives given */
-        rc = PMIx_Data_pack(NULL, buf, &dcnt, 1, PMIX_SIZE);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-        }
-        /* bring over the packed info blob */
-        rc = PMIx_Data_unload(&pbuf, &pbo);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-        }
-        rc = PMIx_Data_pack(NULL, buf, &pbo, 1, PMIX_BYTE_OBJECT);
-        PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-        /* pack the directives blob */
-        rc = PMIx_Data_unload(&dbuf, &dbo);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-        }
-        rc = PMIx_Data_pack(NULL, buf, &dbo, 1, PMIX_BYTE_OBJECT);
-        PMIX_BYTE_OBJECT_DESTRUCT(&dbo);
-        /* send the result to the HNP */
-        PRTE_RML_SEND(rc, PRTE_PROC_MY_HNP->rank, buf,
-                      PRTE_RML_TAG_LOGGING);
-        if (PRTE_SUCCESS != rc) {
-            PRTE_ERROR_LOG(rc);
-            PMIX_DATA_BUFFER_RELEASE(buf);
-        }
+    if (0 == e->ninfo) {
+        PMIX_RELEASE(e);
+        e = NULL;
+        goto done;
+    }
+
+    PMIX_LOAD_NSPACE(e->nspace, client->nspace);
+    append_ranks(&e->ranks, &e->nranks, &client->rank, 1);
+    /* bring over the packed blobs */
+    ret = PMIx_Data_unload(&pbuf, &e->info);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+    }
+    ret = PMIx_Data_unload(&dbuf, &e->dirs);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+    }
+    /* the job may have asked us not to aggregate its output */
+    jdata = prte_get_job_data_object(client->nspace);
+    if (NULL != jdata) {
+        e->noagg = prte_get_attribute(&jdata->attributes, PRTE_JOB_NOAGG_HELP, NULL, PMIX_BOOL);
     }
 
 done:
+    PMIX_DATA_BUFFER_DESTRUCT(&pbuf);
+    PMIX_DATA_BUFFER_DESTRUCT(&dbuf);
     /* we cannot directly execute the callback here
      * as it would threadlock - so shift to somewhere
-     * safe */
-    PRTE_SERVER_PMIX_THREADSHIFT(PRTE_NAME_WILDCARD, NULL, rc, NULL, NULL, 0, lgcbfn, cbfunc, cbdata);
+     * safe, where the entry will also be queued */
+    PRTE_SERVER_PMIX_THREADSHIFT(PRTE_NAME_WILDCARD, e, rc, NULL, NULL, 0, lgcbfn, cbfunc, cbdata);
+}
+
+/* called when a client finalizes or aborts so that everything it
+ * logged reaches the master ahead of its termination */
+static void flush_client_logs(void)
+{
+    flush_log_fwd(-1, 0, &log_fwd);
 }
 
 pmix_status_t pmix_server_job_ctrl_fn(const pmix_proc_t *requestor, const pmix_proc_t targets[],
@@ -1065,9 +2099,12 @@ static void pmix_server_stdin_push(int sd, short args, void *cbdata)
         prte_iof.push_stdin(&cd->procs[n], (uint8_t *) bo->bytes, bo->size);
     }
 
+    /* if the stdin window is full, the IOF holds the callback until
+     * the daemons have drained it so the source cannot get ahead of them */
     if (NULL == bo->bytes || 0 == bo->size) {
         cd->cbfunc(PMIX_ERR_IOF_COMPLETE, cd->cbdata);
-    } else {
+    } else if (NULL == prte_iof.stdin_wait ||
+               PRTE_SUCCESS != prte_iof.stdin_wait(cd->cbfunc, cd->cbdata)) {
         cd->cbfunc(PMIX_SUCCESS, cd->cbdata);
     }
 
@@ -313,10 +313,22 @@ PRTE_EXPORT extern void pmix_server_notify(int status, pmix_proc_t *sender,
                                            pmix_data_buffer_t *buffer, prte_rml_tag_t tg,
                                            void *cbdata);
 
+PRTE_EXPORT extern void pmix_server_notify_relay(int status, pmix_proc_t *sender,
+                                                 pmix_data_buffer_t *buffer, prte_rml_tag_t tg,
+                                                 void *cbdata);
+
 PRTE_EXPORT extern void pmix_server_jobid_return(int status, pmix_proc_t *sender,
                                            pmix_data_buffer_t *buffer, prte_rml_tag_t tg,
                                            void *cbdata);
 
+PRTE_EXPORT extern void pmix_server_log(int status, pmix_proc_t *sender,
+                                        pmix_data_buffer_t *buffer, prte_rml_tag_t tg,
+                                        void *cbdata);
+
+PRTE_EXPORT extern void pmix_server_log_flush(void);
+
+PRTE_EXPORT extern void pmix_server_notify_flush(void);
+
 PRTE_EXPORT extern int prte_pmix_server_register_tool(pmix_nspace_t nspace);
 
 PRTE_EXPORT extern int pmix_server_cache_job_info(prte_job_t *jdata, pmix_info_t *info);
@@ -378,6 +390,11 @@ typedef struct {
     char *report_uri;
     char *singleton;
     pmix_device_type_t generate_dist;
+    int event_coalesce;
+    pmix_list_t pending_events;
+    int log_batch;
+    pmix_list_t pending_logs;
+    pmix_list_t pending_aggs;
     pmix_list_t tools;
     pmix_list_t psets;
     pmix_list_t groups;
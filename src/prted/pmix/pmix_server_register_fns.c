@@ -324,9 +324,9 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
     /* pass the top-level session directory */
     PMIX_INFO_LIST_ADD(ret, info, PMIX_TMPDIR, prte_process_info.top_session_dir, PMIX_STRING);
 
-    /* create and pass a job-level session directory */
-    pproc.rank = PMIX_RANK_INVALID;
-    rc = prte_session_dir(&pproc);
+    /* create and pass a job-level session directory, along
+     * with the proc-level directories for our local procs */
+    rc = prte_job_session_dirs(jdata);
     if (PRTE_SUCCESS != rc) {
         PRTE_ERROR_LOG(rc);
         PMIX_INFO_LIST_RELEASE(info);
@@ -533,15 +533,8 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
                 PMIX_INFO_LIST_ADD(ret, pmap, PMIX_LOCALITY_STRING, NULL, PMIX_STRING);
             }
             if (PRTE_PROC_MY_NAME->rank == node->daemon->name.rank) {
-                /* create and pass a proc-level session directory */
-                rc = prte_session_dir(&pptr->name);
-                if (PRTE_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_INFO_LIST_RELEASE(info);
-                    PMIX_INFO_LIST_RELEASE(pmap);
-                    rc = prte_pmix_convert_status(rc);
-                    return rc;
-                }
+                /* pass the proc-level session directory - it was
+                 * created along with the job-level one */
                 pmix_asprintf(&tmp, "%s/%s", jdata->session_dir,
                                           PMIX_RANK_PRINT(pptr->name.rank));
                 PMIX_INFO_LIST_ADD(ret, pmap, PMIX_PROCDIR, tmp, PMIX_STRING);
@@ -53,6 +53,24 @@ PRTE_EXPORT int prun_common(pmix_cli_result_t *cli,
                             prte_schizo_base_module_t *schizo,
                             int argc, char **argv);
 
+/* stack traces of a hung job - see prted_stack.c */
+typedef void (*prte_stack_trace_cbfunc_t)(void *cbdata);
+
+/* DVM master and daemons: setup to collect stack traces */
+PRTE_EXPORT void prte_stack_trace_init(void);
+
+/* DVM master: ask all daemons for traces of the given job - the
+ * callback is executed once every daemon has reported */
+PRTE_EXPORT int prte_stack_trace_request(pmix_nspace_t nspace,
+                                         prte_stack_trace_cbfunc_t cbfunc, void *cbdata);
+
+/* daemons: handle the PRTE_DAEMON_GET_STACK_TRACES command */
+PRTE_EXPORT void prte_stack_trace_collect(pmix_data_buffer_t *buffer);
+
+/* DVM master: output the summary of whatever traces have been
+ * received for the job and stop collecting them */
+PRTE_EXPORT void prte_stack_trace_output(pmix_nspace_t nspace);
+
 END_C_DECLS
 
 #endif /* PRTED_H */
@@ -62,6 +62,7 @@
 
 #include "src/mca/errmgr/errmgr.h"
 #include "src/mca/ess/ess.h"
+#include "src/mca/ess/base/base.h"
 #include "src/mca/grpcomm/base/base.h"
 #include "src/mca/iof/base/base.h"
 #include "src/mca/odls/base/base.h"
@@ -115,15 +116,11 @@ void prte_daemon_recv(int status, pmix_proc_t *sender,
     prte_proc_t *cur_proc = NULL, *prev_proc = NULL;
     bool found = false;
     bool compressed;
-    FILE *fp;
-    char gscmd[256], path[1035], *pathptr;
-    char string[256], *string_ptr = string;
     char *coprocessors;
     prte_pmix_lock_t lk;
     pmix_proc_t pname;
     pmix_byte_object_t pbo;
     pmix_topology_t ptopo;
-    char *tmp;
     pmix_info_t info[4];
     PRTE_HIDE_UNUSED_PARAMS(status, tag, cbdata);
 
@@ -248,6 +245,13 @@ void prte_daemon_recv(int status, pmix_proc_t *sender,
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
         }
 
+        /* make sure everything needed to launch is available */
+        if (PRTE_SUCCESS != (ret = prte_ess_base_prted_open_deferred())) {
+            PRTE_UPDATE_EXIT_STATUS(PRTE_ERROR_DEFAULT_EXIT_CODE);
+            PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
+            break;
+        }
+
         /* launch the processes */
         if (PRTE_SUCCESS != (ret = prte_odls.launch_local_procs(buffer))) {
             PMIX_OUTPUT_VERBOSE((1, prte_debug_output,
@@ -581,113 +585,9 @@ void prte_daemon_recv(int status, pmix_proc_t *sender,
         break;
 
     case PRTE_DAEMON_GET_STACK_TRACES:
-        /* prep the response */
-        PMIX_DATA_BUFFER_CREATE(answer);
-        pathptr = path;
-
-        /* unpack the jobid */
-        n = 1;
-        ret = PMIx_Data_unpack(NULL, buffer, &job, &n, PMIX_PROC_NSPACE);
-        if (PMIX_SUCCESS != ret) {
-            PMIX_ERROR_LOG(ret);
-            goto CLEANUP;
-        }
-
-        // Try to find the "gstack" executable.  Failure to find the
-        // executable will be handled below, because the receiver
-        // expects to have the process name, hostname, and PID in the
-        // buffer before finding an error message.
-        char *gstack_exec;
-        gstack_exec = pmix_find_absolute_path("gstack");
-
-        /* we have to at least include the nspace of this job
-         * in the reply to ensure the DVM master knows which
-         * job we are talking about */
-        tmp = (char *) job;
-        if (PMIX_SUCCESS != PMIx_Data_pack(NULL, answer, &tmp, 1, PMIX_STRING)) {
-            if (NULL != gstack_exec) {
-                free(gstack_exec);
-            }
-            break;
-        }
-
-        /* hit each local process with a gstack command */
-        for (i = 0; i < prte_local_children->size; i++) {
-            proct = (prte_proc_t *) pmix_pointer_array_get_item(prte_local_children, i);
-            if (NULL != proct &&
-                PRTE_FLAG_TEST(proct, PRTE_PROC_FLAG_ALIVE) &&
-                PMIX_CHECK_NSPACE(proct->name.nspace, job)) {
-                PMIX_DATA_BUFFER_CONSTRUCT(&data);
-                if (PMIX_SUCCESS != PMIx_Data_pack(NULL, &data, &proct->name, 1, PMIX_PROC) ||
-                    PMIX_SUCCESS != PMIx_Data_pack(NULL, &data, &proct->node->name, 1, PMIX_STRING) ||
-                    PMIX_SUCCESS != PMIx_Data_pack(NULL, &data, &proct->pid, 1, PMIX_PID)) {
-                    PMIX_DATA_BUFFER_DESTRUCT(&data);
-                    break;
-                }
-
-                // If we were able to find the gstack executable,
-                // above, then run the command here.
-                fp = NULL;
-                if (NULL != gstack_exec) {
-                    (void) snprintf(gscmd, sizeof(gscmd), "%s %lu", gstack_exec,
-                                    (unsigned long) proct->pid);
-                    fp = popen(gscmd, "r");
-                }
-
-                // If either we weren't able to find or run the gstack
-                // exectuable, send back a nice error message here.
-                if (NULL == gstack_exec || NULL == fp) {
-                    (void) snprintf(string, sizeof(string),
-                                    "Failed to %s \"%s\" on %s to obtain stack traces",
-                                    (NULL == gstack_exec) ? "find" : "run",
-                                    (NULL == gstack_exec) ? "gstack" : gstack_exec,
-                                    proct->node->name);
-                    if (PMIX_SUCCESS == PMIx_Data_pack(NULL, &data, &string_ptr, 1, PMIX_STRING)) {
-                        ret = PMIx_Data_unload(&data, &pbo);
-                        if (PMIX_SUCCESS != ret) {
-                            PMIX_ERROR_LOG(ret);
-                            PMIX_DATA_BUFFER_DESTRUCT(&data);
-                            break;
-                        }
-                        PMIx_Data_pack(NULL, answer, &pbo, 1, PMIX_BYTE_OBJECT);
-                    }
-                    PMIX_DATA_BUFFER_DESTRUCT(&data);
-                    break;
-                }
-                /* Read the output a line at a time and pack it for transmission */
-                memset(path, 0, sizeof(path));
-                while (fgets(path, sizeof(path) - 1, fp) != NULL) {
-                    if (PMIX_SUCCESS != PMIx_Data_pack(NULL, &data, &pathptr, 1, PMIX_STRING)) {
-                        PMIX_DATA_BUFFER_DESTRUCT(&data);
-                        break;
-                    }
-                    memset(path, 0, sizeof(path));
-                }
-                /* close */
-                pclose(fp);
-                /* transfer this load */
-                ret = PMIx_Data_unload(&data, &pbo);
-                if (PMIX_SUCCESS != ret) {
-                    PMIX_ERROR_LOG(ret);
-                    PMIX_DATA_BUFFER_DESTRUCT(&data);
-                    break;
-                }
-                if (PMIX_SUCCESS != PMIx_Data_pack(NULL, answer, &pbo, 1, PMIX_BYTE_OBJECT)) {
-                    PMIX_DATA_BUFFER_DESTRUCT(&data);
-                    break;
-                }
-                PMIX_DATA_BUFFER_DESTRUCT(&data);
-            }
-        }
-        if (NULL != gstack_exec) {
-            free(gstack_exec);
-        }
-        /* always send our response */
-        PRTE_RML_SEND(ret, PRTE_PROC_MY_HNP->rank, answer, PRTE_RML_TAG_STACK_TRACE);
-        if (PRTE_SUCCESS != ret) {
-            PRTE_ERROR_LOG(ret);
-            PMIX_DATA_BUFFER_RELEASE(answer);
-        }
+        /* traces are collected in the background and sent
+         * up the routing tree once complete */
+        prte_stack_trace_collect(buffer);
         break;
 
     default:
@@ -0,0 +1,1190 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Stack traces of a hung job.
+ *
+ * Each daemon runs gstack on its local procs of the job - several at
+ * a time, with the output read from the event loop - and reduces each
+ * trace to its frames (addresses, arguments and thread ids removed)
+ * so identical stacks can be found by hash. What goes up the routing
+ * tree is one entry per distinct stack along with the ranks that
+ * share it, and every daemon merges the reports of its children into
+ * its own before passing the result on to its parent. The DVM master
+ * thus receives one report per child and outputs a summary with each
+ * distinct stack shown once.
+ *
+ * If more than one sample is requested, each proc is traced that many
+ * times and those whose stack changed between samples are listed
+ * separately - they are most likely not the ones that are hung.
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+
+#include "src/event/event-internal.h"
+#include "src/include/hash_string.h"
+#include "src/pmix/pmix-internal.h"
+#include "src/util/pmix_fd.h"
+#include "src/util/pmix_output.h"
+#include "src/util/pmix_path.h"
+#include "src/util/pmix_printf.h"
+
+#include "src/mca/errmgr/errmgr.h"
+#include "src/mca/grpcomm/grpcomm.h"
+#include "src/mca/odls/odls_types.h"
+#include "src/rml/rml.h"
+#include "src/runtime/prte_globals.h"
+#include "src/util/name_fns.h"
+#include "src/util/proc_info.h"
+
+#include "src/prted/prted.h"
+
+/* limit on the output kept from a single gstack */
+#define PRTE_STACK_TRACE_MAX (256 * 1024)
+
+/* a distinct stack and the ranks that had it */
+typedef struct {
+    pmix_list_item_t super;
+    uint32_t hash;
+    char *stack;
+    pmix_rank_t *ranks;
+    uint32_t nranks;
+    uint32_t size;
+} prte_stack_class_t;
+static void sccon(prte_stack_class_t *p)
+{
+    p->hash = 0;
+    p->stack = NULL;
+    p->ranks = NULL;
+    p->nranks = 0;
+    p->size = 0;
+}
+static void scdes(prte_stack_class_t *p)
+{
+    if (NULL != p->stack) {
+        free(p->stack);
+    }
+    if (NULL != p->ranks) {
+        free(p->ranks);
+    }
+}
+static PMIX_CLASS_INSTANCE(prte_stack_class_t,
+                           pmix_list_item_t,
+                           sccon, scdes);
+
+struct prte_stack_job_t;
+
+/* a local proc being traced */
+typedef struct {
+    pmix_list_item_t super;
+    struct prte_stack_job_t *job;
+    pmix_rank_t rank;
+    pid_t pid;
+    char *node;
+    /* the running gstack */
+    pid_t gpid;
+    int fd;
+    prte_event_t ev;
+    char *out;
+    size_t outlen;
+    int nsamples;
+    uint32_t hash;
+    bool changed;
+} prte_stack_proc_t;
+static void spcon(prte_stack_proc_t *p)
+{
+    p->job = NULL;
+    p->rank = PMIX_RANK_INVALID;
+    p->pid = 0;
+    p->node = NULL;
+    p->gpid = 0;
+    p->fd = -1;
+    p->out = NULL;
+    p->outlen = 0;
+    p->nsamples = 0;
+    p->hash = 0;
+    p->changed = false;
+}
+static void spdes(prte_stack_proc_t *p)
+{
+    if (NULL != p->node) {
+        free(p->node);
+    }
+    if (NULL != p->out) {
+        free(p->out);
+    }
+}
+static PMIX_CLASS_INSTANCE(prte_stack_proc_t,
+                           pmix_list_item_t,
+                           spcon, spdes);
+
+/* collection state for a job on this daemon */
+typedef struct prte_stack_job_t {
+    pmix_list_item_t super;
+    pmix_nspace_t nspace;
+    pmix_list_t classes;
+    /* ranks whose stack changed between samples */
+    pmix_rank_t *progressing;
+    uint32_t nprogressing;
+    uint32_t progsize;
+    /* daemons covered by what we hold, and by all
+     * we have received so far */
+    int32_t ndaemons;
+    int32_t ncovered;
+    /* daemons in our part of the routing tree, including us */
+    int32_t subtree;
+    int timeout;
+    int samples;
+    char *gstack;
+    pmix_list_t pending;
+    pmix_list_t running;
+    bool started;
+    bool expired;
+    bool forwarded;
+    prte_event_t collect_timer;
+    bool collect_active;
+    prte_event_t forward_timer;
+    bool forward_active;
+    /* the DVM master only */
+    prte_stack_trace_cbfunc_t cbfunc;
+    void *cbdata;
+} prte_stack_job_t;
+static void sjcon(prte_stack_job_t *p)
+{
+    PMIX_LOAD_NSPACE(p->nspace, NULL);
+    PMIX_CONSTRUCT(&p->classes, pmix_list_t);
+    p->progressing = NULL;
+    p->nprogressing = 0;
+    p->progsize = 0;
+    p->ndaemons = 0;
+    p->ncovered = 0;
+    p->subtree = 1;
+    p->timeout = 0;
+    p->samples = 1;
+    p->gstack = NULL;
+    PMIX_CONSTRUCT(&p->pending, pmix_list_t);
+    PMIX_CONSTRUCT(&p->running, pmix_list_t);
+    p->started = false;
+    p->expired = false;
+    p->forwarded = false;
+    p->collect_active = false;
+    p->forward_active = false;
+    p->cbfunc = NULL;
+    p->cbdata = NULL;
+}
+static void sjdes(prte_stack_job_t *p)
+{
+    if (p->collect_active) {
+        prte_event_evtimer_del(&p->collect_timer);
+    }
+    if (p->forward_active) {
+        prte_event_evtimer_del(&p->forward_timer);
+    }
+    PMIX_LIST_DESTRUCT(&p->classes);
+    if (NULL != p->progressing) {
+        free(p->progressing);
+    }
+    if (NULL != p->gstack) {
+        free(p->gstack);
+    }
+    PMIX_LIST_DESTRUCT(&p->pending);
+    PMIX_LIST_DESTRUCT(&p->running);
+}
+static PMIX_CLASS_INSTANCE(prte_stack_job_t,
+                           pmix_list_item_t,
+                           sjcon, sjdes);
+
+static pmix_list_t jobs;
+
+static void stack_trace_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
+                             prte_rml_tag_t tag, void *cbdata);
+static void launch_tracers(prte_stack_job_t *job);
+static void check_complete(prte_stack_job_t *job);
+
+void prte_stack_trace_init(void)
+{
+    PMIX_CONSTRUCT(&jobs, pmix_list_t);
+    PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_STACK_TRACE,
+                  PRTE_RML_PERSISTENT, stack_trace_recv, NULL);
+}
+
+static prte_stack_job_t *get_job(const pmix_nspace_t nspace, bool create)
+{
+    prte_stack_job_t *job;
+    prte_routed_tree_t *child;
+
+    PMIX_LIST_FOREACH(job, &jobs, prte_stack_job_t) {
+        if (PMIX_CHECK_NSPACE(job->nspace, nspace)) {
+            return job;
+        }
+    }
+    if (!create) {
+        return NULL;
+    }
+    job = PMIX_NEW(prte_stack_job_t);
+    PMIX_LOAD_NSPACE(job->nspace, nspace);
+    PMIX_LIST_FOREACH(child, &prte_rml_base.children, prte_routed_tree_t) {
+        job->subtree += 1 + pmix_bitmap_num_set_bits(&child->relatives,
+                                                     child->relatives.array_size);
+    }
+    pmix_list_append(&jobs, &job->super);
+    return job;
+}
+
+static void release_job(prte_stack_job_t *job)
+{
+    pmix_list_remove_item(&jobs, &job->super);
+    PMIX_RELEASE(job);
+}
+
+static void add_ranks(pmix_rank_t **array, uint32_t *n, uint32_t *size,
+                      const pmix_rank_t *add, uint32_t nadd)
+{
+    pmix_rank_t *tmp;
+    uint32_t sz;
+
+    if (*size < *n + nadd) {
+        sz = (0 == *size) ? 16 : *size;
+        while (sz < *n + nadd) {
+            sz *= 2;
+        }
+        tmp = (pmix_rank_t *) realloc(*array, sz * sizeof(pmix_rank_t));
+        if (NULL == tmp) {
+            PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+            return;
+        }
+        *array = tmp;
+        *size = sz;
+    }
+    memcpy(&(*array)[*n], add, nadd * sizeof(pmix_rank_t));
+    *n += nadd;
+}
+
+static void add_stack(prte_stack_job_t *job, const char *stack,
+                      const pmix_rank_t *ranks, uint32_t nranks)
+{
+    prte_stack_class_t *sc;
+    uint32_t hash;
+
+    PRTE_HASH_STR(stack, hash);
+    PMIX_LIST_FOREACH(sc, &job->classes, prte_stack_class_t) {
+        if (sc->hash == hash && 0 == strcmp(sc->stack, stack)) {
+            add_ranks(&sc->ranks, &sc->nranks, &sc->size, ranks, nranks);
+            return;
+        }
+    }
+    sc = PMIX_NEW(prte_stack_class_t);
+    sc->hash = hash;
+    sc->stack = strdup(stack);
+    add_ranks(&sc->ranks, &sc->nranks, &sc->size, ranks, nranks);
+    pmix_list_append(&job->classes, &sc->super);
+}
+
+static int rank_cmp(const void *a, const void *b)
+{
+    pmix_rank_t ra = *(const pmix_rank_t *) a;
+    pmix_rank_t rb = *(const pmix_rank_t *) b;
+
+    return (ra < rb) ? -1 : (ra > rb);
+}
+
+/* sort the ranks and drop any duplicates - a proc is
+ * listed once per sample that had this stack */
+static void sort_ranks(pmix_rank_t *ranks, uint32_t *nranks)
+{
+    uint32_t n, m;
+
+    if (*nranks < 2) {
+        return;
+    }
+    qsort(ranks, *nranks, sizeof(pmix_rank_t), rank_cmp);
+    for (n = 1, m = 0; n < *nranks; n++) {
+        if (ranks[n] != ranks[m]) {
+            ranks[++m] = ranks[n];
+        }
+    }
+    *nranks = m + 1;
+}
+
+/* reduce a frame to what identifies it, e.g.
+ *   #1  0x00000000004011d6 in compute (n=12, buf=0x1e4c2a0) at app.c:42
+ * becomes
+ *   #1  compute () at app.c:42 */
+static char *frame_line(const char *line)
+{
+    const char *p, *q, *name;
+    char *ret;
+    int depth;
+    size_t len;
+
+    /* the frame number */
+    p = line + 1;
+    while (isdigit((unsigned char) *p)) {
+        p++;
+    }
+    len = p - line;
+    while (' ' == *p) {
+        p++;
+    }
+    /* the pc - absent for frames that start on a line boundary */
+    if (0 == strncmp(p, "0x", 2)) {
+        p += 2;
+        while (isxdigit((unsigned char) *p)) {
+            p++;
+        }
+        while (' ' == *p) {
+            p++;
+        }
+        if (0 == strncmp(p, "in ", 3)) {
+            p += 3;
+        }
+    }
+    name = p;
+    q = strstr(p, " (");
+    if (NULL == q) {
+        pmix_asprintf(&ret, "%.*s  %s", (int) len, line, name);
+        return ret;
+    }
+    /* skip the arguments */
+    p = q + 1;
+    depth = 0;
+    do {
+        if ('(' == *p) {
+            depth++;
+        } else if (')' == *p) {
+            depth--;
+        }
+        p++;
+    } while ('\0' != *p && 0 < depth);
+    pmix_asprintf(&ret, "%.*s  %.*s ()%s", (int) len, line, (int) (q - name), name, p);
+    return ret;
+}
+
+/* reduce the output of gstack to a form that is the same for
+ * every proc sitting in the same place */
+static char *normalize(char *out)
+{
+    char **lines = NULL, *line, *next, *p, *ret;
+
+    for (line = out; NULL != line && '\0' != *line; line = next) {
+        next = strchr(line, '\n');
+        if (NULL != next) {
+            *next++ = '\0';
+        }
+        p = line + strlen(line);
+        while (p > line && isspace((unsigned char) p[-1])) {
+            *--p = '\0';
+        }
+        /* gdb's progress messages, e.g. "[New LWP 1234]" */
+        if ('\0' == *line || '[' == *line) {
+            continue;
+        }
+        if ('#' == *line) {
+            p = frame_line(line);
+            PMIX_ARGV_APPEND_NOSIZE_COMPAT(&lines, p);
+            free(p);
+        } else if (0 == strncmp(line, "Thread ", 7) && NULL != (p = strstr(line, " ("))) {
+            /* drop the thread's address and LWP */
+            *p = '\0';
+            pmix_asprintf(&p, "%s:", line);
+            PMIX_ARGV_APPEND_NOSIZE_COMPAT(&lines, p);
+            free(p);
+        } else {
+            PMIX_ARGV_APPEND_NOSIZE_COMPAT(&lines, line);
+        }
+    }
+    if (NULL == lines) {
+        return strdup("No stack trace was returned by gstack");
+    }
+    ret = PMIX_ARGV_JOIN_COMPAT(lines, '\n');
+    PMIX_ARGV_FREE_COMPAT(lines);
+    return ret;
+}
+
+static void stop_tracer(prte_stack_proc_t *p)
+{
+    /* gstack runs gdb in its own process group - take
+     * down the whole group so gdb is not left behind */
+    if (0 < p->gpid) {
+        kill(-p->gpid, SIGKILL);
+    }
+    if (0 <= p->fd) {
+        prte_event_del(&p->ev);
+        close(p->fd);
+        p->fd = -1;
+    }
+    p->gpid = 0;
+    if (NULL != p->out) {
+        free(p->out);
+        p->out = NULL;
+    }
+    p->outlen = 0;
+}
+
+/* done with this proc - it no longer counts toward
+ * the local traces we are waiting for */
+static void retire(prte_stack_job_t *job, prte_stack_proc_t *p)
+{
+    if (p->changed) {
+        add_ranks(&job->progressing, &job->nprogressing, &job->progsize, &p->rank, 1);
+    }
+    PMIX_RELEASE(p);
+}
+
+static void tracer_done(prte_stack_proc_t *p)
+{
+    prte_stack_job_t *job = p->job;
+    char *stack;
+    uint32_t hash;
+
+    pmix_list_remove_item(&job->running, &p->super);
+    if (NULL == p->out) {
+        p->out = strdup("");
+    } else {
+        p->out[p->outlen] = '\0';
+    }
+    stack = normalize(p->out);
+    /* gstack has exited, so there is nothing left to kill */
+    p->gpid = 0;
+    stop_tracer(p);
+    PRTE_HASH_STR(stack, hash);
+    if (0 < p->nsamples && hash != p->hash) {
+        p->changed = true;
+    }
+    p->hash = hash;
+    p->nsamples++;
+    add_stack(job, stack, &p->rank, 1);
+    free(stack);
+
+    if (p->nsamples < job->samples && !job->expired) {
+        pmix_list_append(&job->pending, &p->super);
+    } else {
+        retire(job, p);
+    }
+    launch_tracers(job);
+    check_complete(job);
+}
+
+static void tracer_read(int fd, short flags, void *cbdata)
+{
+    prte_stack_proc_t *p = (prte_stack_proc_t *) cbdata;
+    char buf[4096], *tmp;
+    ssize_t rc;
+    PRTE_HIDE_UNUSED_PARAMS(flags);
+
+    for (;;) {
+        rc = read(fd, buf, sizeof(buf));
+        if (0 > rc) {
+            if (EAGAIN == errno || EWOULDBLOCK == errno) {
+                return;
+            }
+            if (EINTR == errno) {
+                continue;
+            }
+            break;
+        }
+        if (0 == rc) {
+            break;
+        }
+        if (PRTE_STACK_TRACE_MAX <= p->outlen) {
+            /* keep draining so gstack is not blocked */
+            continue;
+        }
+        if (PRTE_STACK_TRACE_MAX < p->outlen + rc) {
+            rc = PRTE_STACK_TRACE_MAX - p->outlen;
+        }
+        tmp = (char *) realloc(p->out, p->outlen + rc + 1);
+        if (NULL == tmp) {
+            break;
+        }
+        p->out = tmp;
+        memcpy(&p->out[p->outlen], buf, rc);
+        p->outlen += rc;
+    }
+    /* gstack is done */
+    tracer_done(p);
+}
+
+static int start_tracer(prte_stack_proc_t *p)
+{
+    prte_stack_job_t *job = p->job;
+    char pidstr[32];
+    int fds[2], flags, devnull;
+    pid_t pid;
+    sigset_t sigs;
+
+    if (0 > pipe(fds)) {
+        return PRTE_ERR_SYS_LIMITS_PIPES;
+    }
+    pid = fork();
+    if (0 > pid) {
+        close(fds[0]);
+        close(fds[1]);
+        return PRTE_ERR_SYS_LIMITS_CHILDREN;
+    }
+    if (0 == pid) {
+        /* lead a process group of our own so a timeout can
+         * kill gdb along with gstack */
+        setpgid(0, 0);
+        /* gdb's complaints (e.g., about ptrace permissions)
+         * are what the user needs to see, so keep stderr */
+        devnull = open("/dev/null", O_RDONLY, 0);
+        if (0 <= devnull) {
+            dup2(devnull, 0);
+            close(devnull);
+        }
+        dup2(fds[1], 1);
+        dup2(fds[1], 2);
+        pmix_close_open_file_descriptors(-1);
+        signal(SIGCHLD, SIG_DFL);
+        signal(SIGPIPE, SIG_DFL);
+        sigprocmask(0, 0, &sigs);
+        sigprocmask(SIG_UNBLOCK, &sigs, 0);
+        snprintf(pidstr, sizeof(pidstr), "%lu", (unsigned long) p->pid);
+        execl(job->gstack, job->gstack, pidstr, (char *) NULL);
+        _exit(1);
+    }
+    /* set the group here too in case we get to kill it
+     * before the child has run */
+    setpgid(pid, pid);
+    close(fds[1]);
+    p->fd = fds[0];
+    p->gpid = pid;
+    pmix_fd_set_cloexec(p->fd);
+    flags = fcntl(p->fd, F_GETFL, 0);
+    if (0 <= flags) {
+        (void) fcntl(p->fd, F_SETFL, flags | O_NONBLOCK);
+    }
+    prte_event_set(prte_event_base, &p->ev, p->fd, PRTE_EV_READ | PRTE_EV_PERSIST,
+                   tracer_read, p);
+    prte_event_add(&p->ev, 0);
+    return PRTE_SUCCESS;
+}
+
+static void launch_tracers(prte_stack_job_t *job)
+{
+    prte_stack_proc_t *p;
+    char *msg;
+    int rc;
+
+    while ((0 >= prte_stack_trace_parallel ||
+            (int) pmix_list_get_size(&job->running) < prte_stack_trace_parallel) &&
+           NULL != (p = (prte_stack_proc_t *) pmix_list_remove_first(&job->pending))) {
+        rc = start_tracer(p);
+        if (PRTE_SUCCESS == rc) {
+            pmix_list_append(&job->running, &p->super);
+            continue;
+        }
+        if (0 == p->nsamples) {
+            pmix_asprintf(&msg, "Failed to run \"%s\" on %s to obtain stack traces: %s",
+                          job->gstack, p->node, PRTE_ERROR_NAME(rc));
+            add_stack(job, msg, &p->rank, 1);
+            free(msg);
+        }
+        retire(job, p);
+    }
+}
+
+/* pack what we hold as
+ *   [nspace][bool compressed][payload]
+ * with the payload being
+ *   [int32 ndaemons][uint32 nclasses]
+ *     nclasses x [stack][uint32 nranges][2*nranges ranks]
+ *   [uint32 nranges][2*nranges ranks] of the progressing procs
+ * where each pair of ranks is the first and last of a range */
+static int pack_ranks(pmix_data_buffer_t *buf, pmix_rank_t *ranks, uint32_t nranks)
+{
+    pmix_rank_t *pairs;
+    uint32_t n, npairs = 0;
+    pmix_status_t rc;
+
+    sort_ranks(ranks, &nranks);
+    pairs = (pmix_rank_t *) malloc((2 * nranks + 1) * sizeof(pmix_rank_t));
+    if (NULL == pairs) {
+        return PMIX_ERR_NOMEM;
+    }
+    for (n = 0; n < nranks; n++) {
+        if (0 < npairs && pairs[2 * npairs - 1] + 1 == ranks[n]) {
+            pairs[2 * npairs - 1] = ranks[n];
+        } else {
+            pairs[2 * npairs] = ranks[n];
+            pairs[2 * npairs + 1] = ranks[n];
+            npairs++;
+        }
+    }
+    rc = PMIx_Data_pack(NULL, buf, &npairs, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS == rc && 0 < npairs) {
+        rc = PMIx_Data_pack(NULL, buf, pairs, 2 * npairs, PMIX_PROC_RANK);
+    }
+    free(pairs);
+    return rc;
+}
+
+static int unpack_ranks(pmix_data_buffer_t *buf, pmix_rank_t **ranks, uint32_t *nranks)
+{
+    pmix_rank_t *pairs, r;
+    uint32_t n, npairs, size = 0;
+    int32_t cnt;
+    pmix_status_t rc;
+
+    *ranks = NULL;
+    *nranks = 0;
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buf, &npairs, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc || 0 == npairs) {
+        return rc;
+    }
+    pairs = (pmix_rank_t *) malloc(2 * npairs * sizeof(pmix_rank_t));
+    if (NULL == pairs) {
+        return PMIX_ERR_NOMEM;
+    }
+    cnt = 2 * npairs;
+    rc = PMIx_Data_unpack(NULL, buf, pairs, &cnt, PMIX_PROC_RANK);
+    if (PMIX_SUCCESS == rc) {
+        for (n = 0; n < npairs; n++) {
+            for (r = pairs[2 * n]; r <= pairs[2 * n + 1]; r++) {
+                add_ranks(ranks, nranks, &size, &r, 1);
+            }
+        }
+    }
+    free(pairs);
+    return rc;
+}
+
+static void forward(prte_stack_job_t *job)
+{
+    pmix_data_buffer_t data, *buf;
+    prte_stack_class_t *sc;
+    pmix_byte_object_t pbo;
+    uint32_t nclasses;
+    bool compressed;
+    char *nsp = job->nspace;
+    pmix_status_t rc;
+    int ret;
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&data);
+    rc = PMIx_Data_pack(NULL, &data, &job->ndaemons, 1, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+    nclasses = pmix_list_get_size(&job->classes);
+    rc = PMIx_Data_pack(NULL, &data, &nclasses, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+    PMIX_LIST_FOREACH(sc, &job->classes, prte_stack_class_t) {
+        rc = PMIx_Data_pack(NULL, &data, &sc->stack, 1, PMIX_STRING);
+        if (PMIX_SUCCESS != rc) {
+            goto error;
+        }
+        rc = pack_ranks(&data, sc->ranks, sc->nranks);
+        if (PMIX_SUCCESS != rc) {
+            goto error;
+        }
+    }
+    rc = pack_ranks(&data, job->progressing, job->nprogressing);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+
+    if (PMIx_Data_compress((uint8_t *) data.base_ptr, data.bytes_used,
+                           (uint8_t **) &pbo.bytes, &pbo.size)) {
+        compressed = true;
+    } else {
+        compressed = false;
+        pbo.bytes = data.base_ptr;
+        pbo.size = data.bytes_used;
+        data.base_ptr = NULL;
+        data.bytes_used = 0;
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&data);
+
+    PMIX_DATA_BUFFER_CREATE(buf);
+    rc = PMIx_Data_pack(NULL, buf, &nsp, 1, PMIX_STRING);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buf, &compressed, 1, PMIX_BOOL);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buf, &pbo, 1, PMIX_BYTE_OBJECT);
+    }
+    PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        return;
+    }
+
+    pmix_output_verbose(2, prte_debug_output,
+                        "%s sending %d stack traces covering %d daemons to %s",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                        (int) nclasses, (int) job->ndaemons,
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_PARENT));
+    PRTE_RML_SEND(ret, PRTE_PROC_MY_PARENT->rank, buf, PRTE_RML_TAG_STACK_TRACE);
+    if (PRTE_SUCCESS != ret) {
+        PRTE_ERROR_LOG(ret);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+    }
+
+    /* anything that arrives from here on is passed straight up */
+    PMIX_LIST_DESTRUCT(&job->classes);
+    PMIX_CONSTRUCT(&job->classes, pmix_list_t);
+    job->nprogressing = 0;
+    job->ndaemons = 0;
+    job->forwarded = true;
+    if (job->ncovered >= job->subtree) {
+        release_job(job);
+    }
+    return;
+
+error:
+    PMIX_ERROR_LOG(rc);
+    PMIX_DATA_BUFFER_DESTRUCT(&data);
+}
+
+static void check_complete(prte_stack_job_t *job)
+{
+    if (!job->started || 0 < pmix_list_get_size(&job->pending) ||
+        0 < pmix_list_get_size(&job->running)) {
+        return;
+    }
+    if (job->ncovered < job->subtree && !job->expired) {
+        return;
+    }
+    if (PRTE_PROC_IS_MASTER) {
+        if (NULL != job->cbfunc) {
+            job->cbfunc(job->cbdata);
+        }
+        return;
+    }
+    if (job->forwarded && 0 == job->ndaemons) {
+        return;
+    }
+    forward(job);
+}
+
+/* stop tracing - any proc that has yet to return a
+ * single sample is reported as having timed out */
+static void collect_timeout(int sd, short args, void *cbdata)
+{
+    prte_stack_job_t *job = (prte_stack_job_t *) cbdata;
+    prte_stack_proc_t *p;
+    pmix_list_t *lists[2] = {&job->running, &job->pending};
+    char *msg;
+    int n;
+    PRTE_HIDE_UNUSED_PARAMS(sd, args);
+
+    job->collect_active = false;
+    /* only stop our own tracers here - giving up on our
+     * children is left to the forward (or, on the DVM
+     * master, the overall) timeout */
+    pmix_asprintf(&msg, "No stack trace within %d seconds", (job->timeout + 1) / 2);
+    for (n = 0; n < 2; n++) {
+        while (NULL != (p = (prte_stack_proc_t *) pmix_list_remove_first(lists[n]))) {
+            stop_tracer(p);
+            if (0 == p->nsamples) {
+                add_stack(job, msg, &p->rank, 1);
+            }
+            retire(job, p);
+        }
+    }
+    free(msg);
+    check_complete(job);
+}
+
+/* pass on what we have without waiting any longer for our children */
+static void forward_timeout(int sd, short args, void *cbdata)
+{
+    prte_stack_job_t *job = (prte_stack_job_t *) cbdata;
+    PRTE_HIDE_UNUSED_PARAMS(sd, args);
+
+    job->forward_active = false;
+    job->expired = true;
+    check_complete(job);
+}
+
+void prte_stack_trace_collect(pmix_data_buffer_t *buffer)
+{
+    prte_stack_job_t *job;
+    prte_stack_proc_t *p;
+    prte_proc_t *proct;
+    pmix_nspace_t nspace;
+    int32_t timeout, samples, cnt;
+    struct timeval tv;
+    char *msg;
+    pmix_status_t rc;
+    int i;
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &nspace, &cnt, PMIX_PROC_NSPACE);
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &timeout, &cnt, PMIX_INT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &samples, &cnt, PMIX_INT32);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+
+    job = get_job(nspace, true);
+    if (job->started) {
+        return;
+    }
+    job->started = true;
+    job->timeout = timeout;
+    job->samples = (0 < samples) ? samples : 1;
+    job->ndaemons++;
+    job->ncovered++;
+
+    pmix_output_verbose(2, prte_debug_output,
+                        "%s collecting stack traces for job %s",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_JOBID_PRINT(nspace));
+
+    job->gstack = pmix_find_absolute_path("gstack");
+    for (i = 0; i < prte_local_children->size; i++) {
+        proct = (prte_proc_t *) pmix_pointer_array_get_item(prte_local_children, i);
+        if (NULL == proct || !PRTE_FLAG_TEST(proct, PRTE_PROC_FLAG_ALIVE) ||
+            !PMIX_CHECK_NSPACE(proct->name.nspace, nspace)) {
+            continue;
+        }
+        if (NULL == job->gstack) {
+            pmix_asprintf(&msg, "Failed to find \"gstack\" on %s to obtain stack traces",
+                          proct->node->name);
+            add_stack(job, msg, &proct->name.rank, 1);
+            free(msg);
+            continue;
+        }
+        p = PMIX_NEW(prte_stack_proc_t);
+        p->job = job;
+        p->rank = proct->name.rank;
+        p->pid = proct->pid;
+        p->node = strdup(proct->node->name);
+        pmix_list_append(&job->pending, &p->super);
+    }
+
+    /* leave time for our traces to get up the tree before the
+     * DVM master gives up on them */
+    if (0 < job->timeout) {
+        prte_event_evtimer_set(prte_event_base, &job->collect_timer, collect_timeout, job);
+        tv.tv_sec = job->timeout / 2;
+        tv.tv_usec = (job->timeout % 2) * 500000;
+        prte_event_evtimer_add(&job->collect_timer, &tv);
+        job->collect_active = true;
+        if (!PRTE_PROC_IS_MASTER) {
+            prte_event_evtimer_set(prte_event_base, &job->forward_timer, forward_timeout, job);
+            tv.tv_sec = (3 * job->timeout) / 4;
+            tv.tv_usec = ((3 * job->timeout) % 4) * 250000;
+            prte_event_evtimer_add(&job->forward_timer, &tv);
+            job->forward_active = true;
+        }
+    }
+
+    launch_tracers(job);
+    check_complete(job);
+}
+
+static void stack_trace_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
+                             prte_rml_tag_t tag, void *cbdata)
+{
+    prte_stack_job_t *job;
+    pmix_data_buffer_t data;
+    pmix_byte_object_t pbo;
+    pmix_rank_t *ranks;
+    uint32_t nclasses, nranks, n;
+    int32_t cnt, ndaemons;
+    bool compressed;
+    char *nspace = NULL, *stack;
+    pmix_status_t rc;
+    PRTE_HIDE_UNUSED_PARAMS(status, tag, cbdata);
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &nspace, &cnt, PMIX_STRING);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    /* a child may report before we have seen the request
+     * ourselves, but the master only listens once it asked */
+    job = get_job(nspace, !PRTE_PROC_IS_MASTER);
+    if (NULL == job) {
+        pmix_output_verbose(2, prte_debug_output,
+                            "%s dropping late stack traces for job %s from %s",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), nspace,
+                            PRTE_NAME_PRINT(sender));
+        free(nspace);
+        return;
+    }
+    free(nspace);
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &compressed, &cnt, PMIX_BOOL);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &pbo, &cnt, PMIX_BYTE_OBJECT);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    PMIX_DATA_BUFFER_CONSTRUCT(&data);
+    if (compressed) {
+        if (!PMIx_Data_decompress((uint8_t *) pbo.bytes, pbo.size,
+                                  (uint8_t **) &data.base_ptr, &data.bytes_used)) {
+            PMIX_ERROR_LOG(PMIX_ERR_UNPACK_FAILURE);
+            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+            return;
+        }
+        data.pack_ptr = data.base_ptr + data.bytes_used;
+        data.unpack_ptr = data.base_ptr;
+        data.bytes_allocated = data.bytes_used;
+        PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+    } else {
+        rc = PMIx_Data_load(&data, &pbo);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+            return;
+        }
+    }
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, &data, &ndaemons, &cnt, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, &data, &nclasses, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+    for (n = 0; n < nclasses; n++) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, &data, &stack, &cnt, PMIX_STRING);
+        if (PMIX_SUCCESS != rc) {
+            goto error;
+        }
+        rc = unpack_ranks(&data, &ranks, &nranks);
+        if (PMIX_SUCCESS != rc) {
+            free(stack);
+            goto error;
+        }
+        add_stack(job, stack, ranks, nranks);
+        free(stack);
+        if (NULL != ranks) {
+            free(ranks);
+        }
+    }
+    rc = unpack_ranks(&data, &ranks, &nranks);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+    if (0 < nranks) {
+        add_ranks(&job->progressing, &job->nprogressing, &job->progsize, ranks, nranks);
+        free(ranks);
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&data);
+
+    pmix_output_verbose(2, prte_debug_output,
+                        "%s received %u stack traces covering %d daemons from %s",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), nclasses, (int) ndaemons,
+                        PRTE_NAME_PRINT(sender));
+    job->ndaemons += ndaemons;
+    job->ncovered += ndaemons;
+    check_complete(job);
+    return;
+
+error:
+    PMIX_ERROR_LOG(rc);
+    PMIX_DATA_BUFFER_DESTRUCT(&data);
+}
+
+int prte_stack_trace_request(pmix_nspace_t nspace, prte_stack_trace_cbfunc_t cbfunc,
+                             void *cbdata)
+{
+    prte_daemon_cmd_flag_t command = PRTE_DAEMON_GET_STACK_TRACES;
+    prte_grpcomm_signature_t *sig;
+    prte_stack_job_t *job;
+    pmix_data_buffer_t buffer;
+    int32_t i32;
+    pmix_status_t rc;
+    int ret;
+
+    job = get_job(nspace, true);
+    job->cbfunc = cbfunc;
+    job->cbdata = cbdata;
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&buffer);
+    rc = PMIx_Data_pack(NULL, &buffer, &command, 1, PMIX_UINT8);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, &buffer, &nspace, 1, PMIX_PROC_NSPACE);
+    }
+    if (PMIX_SUCCESS == rc) {
+        i32 = prte_stack_trace_wait_timeout;
+        rc = PMIx_Data_pack(NULL, &buffer, &i32, 1, PMIX_INT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        i32 = prte_stack_trace_samples;
+        rc = PMIx_Data_pack(NULL, &buffer, &i32, 1, PMIX_INT32);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_DESTRUCT(&buffer);
+        release_job(job);
+        return prte_pmix_convert_status(rc);
+    }
+    /* goes to all daemons */
+    sig = PMIX_NEW(prte_grpcomm_signature_t);
+    sig->signature = (pmix_proc_t *) malloc(sizeof(pmix_proc_t));
+    PMIX_LOAD_PROCID(&sig->signature[0], PRTE_PROC_MY_NAME->nspace, PMIX_RANK_WILDCARD);
+    sig->sz = 1;
+    ret = prte_grpcomm.xcast(sig, PRTE_RML_TAG_DAEMON, &buffer);
+    PMIX_DATA_BUFFER_DESTRUCT(&buffer);
+    PMIX_RELEASE(sig);
+    if (PRTE_SUCCESS != ret) {
+        PRTE_ERROR_LOG(ret);
+        release_job(job);
+    }
+    return ret;
+}
+
+static char *print_ranks(pmix_rank_t *ranks, uint32_t nranks)
+{
+    char **items = NULL, *item, *ret;
+    uint32_t n, first;
+
+    for (n = 0; n < nranks; n = first + 1) {
+        first = n;
+        while (first + 1 < nranks && ranks[first] + 1 == ranks[first + 1]) {
+            first++;
+        }
+        if (first == n) {
+            pmix_asprintf(&item, "%u", ranks[n]);
+        } else {
+            pmix_asprintf(&item, "%u-%u", ranks[n], ranks[first]);
+        }
+        PMIX_ARGV_APPEND_NOSIZE_COMPAT(&items, item);
+        free(item);
+    }
+    if (NULL == items) {
+        return strdup("");
+    }
+    ret = PMIX_ARGV_JOIN_COMPAT(items, ',');
+    PMIX_ARGV_FREE_COMPAT(items);
+    return ret;
+}
+
+/* tab in each line of a stack */
+static char *indent(const char *stack)
+{
+    const char *p;
+    char *ret, *q;
+    size_t len = 2;
+
+    for (p = stack; '\0' != *p; p++) {
+        len += ('\n' == *p) ? 2 : 1;
+    }
+    ret = (char *) malloc(len);
+    if (NULL == ret) {
+        return strdup(stack);
+    }
+    q = ret;
+    *q++ = '\t';
+    for (p = stack; '\0' != *p; p++) {
+        *q++ = *p;
+        if ('\n' == *p) {
+            *q++ = '\t';
+        }
+    }
+    *q = '\0';
+    return ret;
+}
+
+static void deliver(pmix_proc_t *name, char *msg)
+{
+    pmix_byte_object_t bo;
+
+    bo.bytes = msg;
+    bo.size = strlen(msg);
+    PMIx_server_IOF_deliver(name, PMIX_FWD_STDERR_CHANNEL, &bo, NULL, 0, NULL, NULL);
+}
+
+static int class_cmp(pmix_list_item_t **a, pmix_list_item_t **b)
+{
+    prte_stack_class_t *ca = *(prte_stack_class_t **) a;
+    prte_stack_class_t *cb = *(prte_stack_class_t **) b;
+
+    /* largest first */
+    return (ca->nranks < cb->nranks) ? 1 : (ca->nranks > cb->nranks) ? -1 : 0;
+}
+
+void prte_stack_trace_output(pmix_nspace_t nspace)
+{
+    prte_stack_job_t *job;
+    prte_stack_class_t *sc;
+    pmix_proc_t name;
+    char *ranks, *stack, *msg;
+
+    job = get_job(nspace, false);
+    if (NULL == job) {
+        return;
+    }
+    PMIX_LIST_FOREACH(sc, &job->classes, prte_stack_class_t) {
+        sort_ranks(sc->ranks, &sc->nranks);
+    }
+    pmix_list_sort(&job->classes, class_cmp);
+
+    /* the output might need to go to a tool instead of just
+     * to stderr, so use the PMIx IOF deliver function */
+    PMIX_LOAD_PROCID(&name, nspace, PMIX_RANK_WILDCARD);
+    pmix_asprintf(&msg, "STACK TRACES FOR JOB %s: %d distinct stacks (%d of %d daemons reported)\n",
+                  PRTE_JOBID_PRINT(nspace), (int) pmix_list_get_size(&job->classes),
+                  (int) job->ncovered, (int) job->subtree);
+    deliver(&name, msg);
+    free(msg);
+
+    PMIX_LIST_FOREACH(sc, &job->classes, prte_stack_class_t) {
+        ranks = print_ranks(sc->ranks, sc->nranks);
+        stack = indent(sc->stack);
+        pmix_asprintf(&msg, "\n%u PROC%s: RANK%s %s\n%s\n", sc->nranks,
+                      (1 == sc->nranks) ? "" : "S", (1 == sc->nranks) ? "" : "S",
+                      ranks, stack);
+        deliver(&name, msg);
+        free(msg);
+        free(stack);
+        free(ranks);
+    }
+    if (0 < job->nprogressing) {
+        sort_ranks(job->progressing, &job->nprogressing);
+        ranks = print_ranks(job->progressing, job->nprogressing);
+        pmix_asprintf(&msg, "\nThe stack of %u proc%s changed between the %d samples taken, so "
+                      "%s most likely not hung: rank%s %s\n",
+                      job->nprogressing, (1 == job->nprogressing) ? "" : "s",
+                      job->samples, (1 == job->nprogressing) ? "it is" : "they are",
+                      (1 == job->nprogressing) ? "" : "s", ranks);
+        deliver(&name, msg);
+        free(msg);
+        free(ranks);
+    }
+    release_job(job);
+}
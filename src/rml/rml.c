@@ -23,6 +23,7 @@
 #include "src/mca/base/pmix_mca_base_component_repository.h"
 #include "src/mca/mca.h"
 #include "src/util/pmix_output.h"
+#include "src/util/output.h"
 
 #include "src/mca/errmgr/errmgr.h"
 #include "src/rml/rml.h"
@@ -40,7 +41,12 @@ prte_rml_base_t prte_rml_base = {
     .lifeline = PMIX_RANK_INVALID,
     .children = PMIX_LIST_STATIC_INIT,
     .radix = 64,
-    .static_ports = false
+    .static_ports = false,
+    .heartbeat_rate = 0,
+    .heartbeat_misses = 3,
+    .self_heal = false,
+    .heal_replay = 8,
+    .heal_msec = 0.0
 };
 
 static int verbosity = 0;
@@ -82,10 +88,40 @@ void prte_rml_register(void)
     pmix_mca_base_var_register_synonym(ret, "prte", "routed", "radix", NULL,
                                        PMIX_MCA_BASE_VAR_SYN_FLAG_DEPRECATED);
 
+    prte_rml_base.heartbeat_rate = 0;
+    pmix_mca_base_var_register("prte", "rml", "base", "heartbeat_rate",
+                               "Interval (in msec) at which daemons check their children in the "
+                               "routing tree and report liveness to their parent. Any message "
+                               "sent to the parent counts as a heartbeat (default: 0 => disabled)",
+                               PMIX_MCA_BASE_VAR_TYPE_INT,
+                               &prte_rml_base.heartbeat_rate);
+
+    prte_rml_base.heartbeat_misses = 3;
+    pmix_mca_base_var_register("prte", "rml", "base", "heartbeat_misses",
+                               "Number of consecutive heartbeat intervals a child daemon may "
+                               "remain silent before it is declared failed (default: 3)",
+                               PMIX_MCA_BASE_VAR_TYPE_INT,
+                               &prte_rml_base.heartbeat_misses);
+
+    prte_rml_base.self_heal = false;
+    pmix_mca_base_var_register("prte", "rml", "base", "self_heal",
+                               "Route around a lost daemon by re-parenting its children instead "
+                               "of terminating the DVM (default: false)",
+                               PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                               &prte_rml_base.self_heal);
+
+    prte_rml_base.heal_replay = 8;
+    pmix_mca_base_var_register("prte", "rml", "base", "heal_replay",
+                               "Number of recent xcast messages each daemon retains for replay "
+                               "to children it adopts when routing around a lost daemon (default: 8)",
+                               PMIX_MCA_BASE_VAR_TYPE_INT,
+                               &prte_rml_base.heal_replay);
 }
 
 void prte_rml_close(void)
 {
+    prte_rml_heartbeat_stop();
+    prte_rml_heal_stop();
     PMIX_LIST_DESTRUCT(&prte_rml_base.posted_recvs);
     PMIX_LIST_DESTRUCT(&prte_rml_base.unmatched_msgs);
     PMIX_LIST_DESTRUCT(&prte_rml_base.children);
@@ -106,6 +142,10 @@ void prte_rml_open(void)
     prte_rml_compute_routing_tree();
 
     prte_rml_base.lifeline = PRTE_PROC_MY_PARENT->rank;
+
+    /* start watching our children, if requested */
+    prte_rml_heartbeat_start();
+    prte_rml_heal_start();
 }
 
 void prte_rml_send_callback(int status, pmix_proc_t *peer,
@@ -116,7 +156,7 @@ void prte_rml_send_callback(int status, pmix_proc_t *peer,
     PRTE_HIDE_UNUSED_PARAMS(buffer, cbdata);
 
     if (PRTE_SUCCESS != status) {
-        pmix_output_verbose(2, prte_rml_base.rml_output,
+        prte_output_verbose(2, prte_rml_base.rml_output,
                             "%s UNABLE TO SEND MESSAGE TO %s TAG %d: %s",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(peer), tag,
                             PRTE_ERROR_NAME(status));
@@ -137,6 +177,8 @@ static void send_cons(prte_rml_send_t *ptr)
     ptr->cbdata = NULL;
     ptr->dbuf = NULL;
     ptr->seq_num = 0xFFFFFFFF;
+    ptr->flags = 0;
+    ptr->csum = 0;
 }
 static void send_des(prte_rml_send_t *ptr)
 {
@@ -200,6 +242,9 @@ static void rtcon(prte_routed_tree_t *rt)
 {
     rt->rank = PMIX_RANK_INVALID;
     PMIX_CONSTRUCT(&rt->relatives, pmix_bitmap_t);
+    rt->heard = false;
+    rt->failed = false;
+    rt->last_heard = 0.0;
 }
 static void rtdes(prte_routed_tree_t *rt)
 {
@@ -152,6 +152,11 @@ typedef struct {
     pmix_list_t children;
     int radix;
     bool static_ports;
+    int heartbeat_rate;
+    int heartbeat_misses;
+    bool self_heal;
+    int heal_replay;
+    double heal_msec;
 } prte_rml_base_t;
 
 PRTE_EXPORT extern prte_rml_base_t prte_rml_base;
@@ -169,6 +174,22 @@ PRTE_EXPORT void prte_rml_compute_routing_tree(void);
 PRTE_EXPORT int prte_rml_get_num_contributors(pmix_rank_t *dmns, size_t ndmns);
 PRTE_EXPORT int prte_rml_route_lost(pmix_rank_t route);
 PRTE_EXPORT pmix_rank_t prte_rml_get_route(pmix_rank_t target);
+/* parent of the given daemon in the routing tree - PMIX_RANK_INVALID for the HNP */
+PRTE_EXPORT pmix_rank_t prte_rml_get_parent(pmix_rank_t rank);
+/* true if the tree has been routed around the given daemon */
+PRTE_EXPORT bool prte_rml_rank_lost(pmix_rank_t rank);
+/* heartbeat support */
+PRTE_EXPORT void prte_rml_heartbeat_start(void);
+PRTE_EXPORT void prte_rml_heartbeat_stop(void);
+PRTE_EXPORT void prte_rml_heartbeat_heard(pmix_rank_t rank);
+PRTE_EXPORT void prte_rml_heartbeat_sent(pmix_rank_t rank);
+/* routing tree repair - the callback is given the lost rank and
+ * whether or not we were moved to a new parent */
+typedef void (*prte_rml_heal_cbfunc_t)(pmix_rank_t lost, bool reparented);
+PRTE_EXPORT void prte_rml_heal_start(void);
+PRTE_EXPORT void prte_rml_heal_stop(void);
+PRTE_EXPORT void prte_rml_heal_record(pmix_data_buffer_t *buffer);
+PRTE_EXPORT void prte_rml_heal_register(prte_rml_heal_cbfunc_t cbfunc);
 
 #define PRTE_RML_POST_MESSAGE(p, t, s, b, l)                                                    \
     do {                                                                                        \
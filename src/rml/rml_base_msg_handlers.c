@@ -39,6 +39,7 @@
 
 #include "src/class/pmix_list.h"
 #include "src/util/pmix_output.h"
+#include "src/util/output.h"
 
 #include "src/mca/errmgr/errmgr.h"
 #include "src/runtime/prte_globals.h"
@@ -60,7 +61,7 @@ void prte_rml_base_post_recv(int sd, short args, void *cbdata)
 
     PMIX_ACQUIRE_OBJECT(req);
 
-    pmix_output_verbose(5, prte_rml_base.rml_output,
+    prte_output_verbose(5, prte_rml_base.rml_output,
                         "%s posting recv",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
 
@@ -80,7 +81,7 @@ void prte_rml_base_post_recv(int sd, short args, void *cbdata)
         PMIX_LIST_FOREACH(recv, &prte_rml_base.posted_recvs, prte_rml_posted_recv_t)
         {
             if (PMIX_CHECK_PROCID(&post->peer, &recv->peer) && post->tag == recv->tag) {
-                pmix_output_verbose(5, prte_rml_base.rml_output,
+                prte_output_verbose(5, prte_rml_base.rml_output,
                                     "%s canceling recv %d for peer %s",
                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), post->tag,
                                     PRTE_NAME_PRINT(&recv->peer));
@@ -105,7 +106,7 @@ void prte_rml_base_post_recv(int sd, short args, void *cbdata)
         }
     }
 
-    pmix_output_verbose(5, prte_rml_base.rml_output,
+    prte_output_verbose(5, prte_rml_base.rml_output,
                         "%s posting %s recv on tag %d for peer %s",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         (post->persistent) ? "persistent" : "non-persistent", post->tag,
@@ -133,7 +134,7 @@ static void msg_match_recv(prte_rml_posted_recv_t *rcv, bool get_all)
     while (item != pmix_list_get_end(&prte_rml_base.unmatched_msgs)) {
         next = pmix_list_get_next(item);
         msg = (prte_rml_recv_t *) item;
-        pmix_output_verbose(5, prte_rml_base.rml_output,
+        prte_output_verbose(5, prte_rml_base.rml_output,
                             "%s checking recv for %s against unmatched msg from %s",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&rcv->peer),
                             PRTE_NAME_PRINT(&msg->sender));
@@ -160,10 +161,16 @@ void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
 
     PMIX_ACQUIRE_OBJECT(msg);
 
-    PMIX_OUTPUT_VERBOSE(
+    PRTE_OUTPUT_VERBOSE(
         (5, prte_rml_base.rml_output, "%s message received from %s for tag %d",
          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&msg->sender), msg->tag));
 
+    /* any message from a child in the routing tree shows it is alive */
+    if (0 < prte_rml_base.heartbeat_rate &&
+        PMIX_CHECK_NSPACE(msg->sender.nspace, PRTE_PROC_MY_NAME->nspace)) {
+        prte_rml_heartbeat_heard(msg->sender.rank);
+    }
+
     /* if this message is just to warmup the connection, then drop it */
     if (PRTE_RML_TAG_WARMUP_CONNECTION == msg->tag) {
         if (!prte_nidmap_communicated) {
@@ -202,20 +209,20 @@ void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
             /* the user must have unloaded the buffer if they wanted
              * to retain ownership of it, so release whatever remains
              */
-            PMIX_OUTPUT_VERBOSE((5, prte_rml_base.rml_output,
+            PRTE_OUTPUT_VERBOSE((5, prte_rml_base.rml_output,
                                  "%s message received %" PRIsize_t
                                  " bytes from %s for tag %d called callback",
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), msg->dbuf->bytes_used,
                                  PRTE_NAME_PRINT(&msg->sender), msg->tag));
             /* release the message */
             PMIX_RELEASE(msg);
-            PMIX_OUTPUT_VERBOSE((5, prte_rml_base.rml_output,
+            PRTE_OUTPUT_VERBOSE((5, prte_rml_base.rml_output,
                                  "%s message tag %d on released",
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), post->tag));
             /* if the recv is non-persistent, remove it */
             if (!post->persistent) {
                 pmix_list_remove_item(&prte_rml_base.posted_recvs, &post->super);
-                /*PMIX_OUTPUT_VERBOSE((5, prte_rml_base.rml_output,
+                /*PRTE_OUTPUT_VERBOSE((5, prte_rml_base.rml_output,
                                      "%s non persistent recv %p remove success releasing now",
                                      PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                      post));*/
@@ -227,7 +234,7 @@ void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
     /* we get here if no matching recv was found - we then hold
      * the message until such a recv is issued
      */
-    PMIX_OUTPUT_VERBOSE(
+    PRTE_OUTPUT_VERBOSE(
         (5, prte_rml_base.rml_output,
          "%s message received bytes from %s for tag %d Not Matched adding to unmatched msgs",
          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&msg->sender), msg->tag));
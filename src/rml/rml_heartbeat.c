@@ -0,0 +1,260 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Daemon liveness detection over the routing tree.
+ *
+ * Each daemon only watches its direct children in the routing
+ * tree, and only reports to its parent - so the work done by
+ * any daemon (including the HNP) scales with its number of
+ * children and not with the size of the DVM. Any message that
+ * a child sends to its parent counts as proof of life, so an
+ * explicit heartbeat is only sent when a daemon has had nothing
+ * else to say to its parent during the last period. Messages
+ * merely routed through the parent don't count - the OOB relays
+ * them without the parent's RML ever seeing them. Failures detected
+ * inside a subtree are carried upward in the next heartbeat,
+ * which is sent immediately rather than waiting for the timer.
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+
+#include "src/class/pmix_list.h"
+#include "src/util/pmix_output.h"
+#include "src/util/output.h"
+
+#include "src/mca/errmgr/errmgr.h"
+#include "src/mca/state/state.h"
+#include "src/rml/rml.h"
+#include "src/runtime/prte_globals.h"
+#include "src/runtime/prte_wait.h"
+#include "src/util/name_fns.h"
+
+static bool hb_active = false;
+static prte_event_t hb_ev;
+static bool hb_sent = false;
+static pmix_rank_t *hb_failed = NULL;
+static int32_t hb_nfailed = 0;
+static int32_t hb_nslots = 0;
+
+static double hb_now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double) tv.tv_sec + (double) tv.tv_usec / 1000000.0;
+}
+
+static void hb_arm(void)
+{
+    struct timeval tv;
+
+    tv.tv_sec = prte_rml_base.heartbeat_rate / 1000;
+    tv.tv_usec = (prte_rml_base.heartbeat_rate % 1000) * 1000;
+    prte_event_evtimer_add(&hb_ev, &tv);
+}
+
+static void hb_send(void)
+{
+    pmix_data_buffer_t *buf;
+    int rc;
+
+    PMIX_DATA_BUFFER_CREATE(buf);
+    rc = PMIx_Data_pack(NULL, buf, &hb_nfailed, 1, PMIX_INT32);
+    if (PMIX_SUCCESS == rc && 0 < hb_nfailed) {
+        rc = PMIx_Data_pack(NULL, buf, hb_failed, hb_nfailed, PMIX_PROC_RANK);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        return;
+    }
+    hb_nfailed = 0;
+
+    PRTE_RML_SEND(rc, PRTE_PROC_MY_PARENT->rank, buf, PRTE_RML_TAG_HEARTBEAT);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+    }
+}
+
+static void hb_failure(pmix_rank_t rank)
+{
+    prte_job_t *jdata;
+    prte_proc_t *proc;
+    pmix_proc_t name;
+    pmix_rank_t *tmp;
+
+    prte_output_verbose(1, prte_rml_base.routed_output,
+                        "%s heartbeat: daemon %s failed",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                        PRTE_VPID_PRINT(rank));
+
+    if (PRTE_PROC_IS_MASTER) {
+        /* only report daemons we still believe to be alive so
+         * a failure seen by more than one path is handled once */
+        jdata = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
+        if (NULL == jdata) {
+            return;
+        }
+        proc = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs, rank);
+        if (NULL == proc || !PRTE_FLAG_TEST(proc, PRTE_PROC_FLAG_ALIVE)) {
+            return;
+        }
+        PMIX_LOAD_PROCID(&name, PRTE_PROC_MY_NAME->nspace, rank);
+        PRTE_ACTIVATE_PROC_STATE(&name, PRTE_PROC_STATE_HEARTBEAT_FAILED);
+        return;
+    }
+
+    /* queue it for our parent */
+    if (hb_nfailed == hb_nslots) {
+        tmp = (pmix_rank_t *) realloc(hb_failed, (hb_nslots + 8) * sizeof(pmix_rank_t));
+        if (NULL == tmp) {
+            PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+            return;
+        }
+        hb_failed = tmp;
+        hb_nslots += 8;
+    }
+    hb_failed[hb_nfailed++] = rank;
+}
+
+static void hb_timer(int fd, short args, void *cbdata)
+{
+    prte_routed_tree_t *child;
+    double now, limit;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args, cbdata);
+
+    if (!hb_active) {
+        return;
+    }
+    if (prte_finalizing || prte_prteds_term_ordered || prte_abnormal_term_ordered) {
+        /* daemons are expected to go quiet now */
+        hb_active = false;
+        return;
+    }
+
+    now = hb_now();
+    limit = (double) (prte_rml_base.heartbeat_rate * prte_rml_base.heartbeat_misses) / 1000.0;
+    PMIX_LIST_FOREACH(child, &prte_rml_base.children, prte_routed_tree_t)
+    {
+        /* a child we have never heard from may still be starting -
+         * the launch timeout covers that case */
+        if (!child->heard || child->failed) {
+            continue;
+        }
+        if (limit < now - child->last_heard) {
+            child->failed = true;
+            hb_failure(child->rank);
+        }
+    }
+
+    if (!PRTE_PROC_IS_MASTER && (!hb_sent || 0 < hb_nfailed)) {
+        hb_send();
+    }
+    hb_sent = false;
+    hb_arm();
+}
+
+static void hb_recv(int status, pmix_proc_t *sender,
+                    pmix_data_buffer_t *buffer,
+                    prte_rml_tag_t tg, void *cbdata)
+{
+    int32_t n, cnt;
+    pmix_rank_t rank;
+    int rc;
+    PRTE_HIDE_UNUSED_PARAMS(status, sender, tg, cbdata);
+
+    /* the sender was already marked as heard when the
+     * message was processed - just look for failures */
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &n, &cnt, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    if (0 == n) {
+        return;
+    }
+    while (0 < n--) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &rank, &cnt, PMIX_PROC_RANK);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            break;
+        }
+        hb_failure(rank);
+    }
+    if (!PRTE_PROC_IS_MASTER && 0 < hb_nfailed) {
+        /* don't hold subtree failures until the next period */
+        hb_send();
+    }
+}
+
+void prte_rml_heartbeat_start(void)
+{
+    if (0 >= prte_rml_base.heartbeat_rate || hb_active) {
+        return;
+    }
+    if (0 >= prte_rml_base.heartbeat_misses) {
+        prte_rml_base.heartbeat_misses = 1;
+    }
+    PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_HEARTBEAT,
+                  PRTE_RML_PERSISTENT, hb_recv, NULL);
+    prte_event_evtimer_set(prte_event_base, &hb_ev, hb_timer, NULL);
+    hb_active = true;
+    hb_sent = false;
+    hb_arm();
+}
+
+void prte_rml_heartbeat_stop(void)
+{
+    if (0 >= prte_rml_base.heartbeat_rate) {
+        return;
+    }
+    if (hb_active) {
+        prte_event_evtimer_del(&hb_ev);
+        hb_active = false;
+    }
+    if (NULL != hb_failed) {
+        free(hb_failed);
+        hb_failed = NULL;
+    }
+    hb_nfailed = 0;
+    hb_nslots = 0;
+}
+
+void prte_rml_heartbeat_heard(pmix_rank_t rank)
+{
+    prte_routed_tree_t *child;
+
+    PMIX_LIST_FOREACH(child, &prte_rml_base.children, prte_routed_tree_t)
+    {
+        if (child->rank == rank) {
+            child->heard = true;
+            child->last_heard = hb_now();
+            return;
+        }
+    }
+}
+
+void prte_rml_heartbeat_sent(pmix_rank_t rank)
+{
+    /* one match per period is all we need */
+    if (hb_sent || PRTE_PROC_IS_MASTER) {
+        return;
+    }
+    /* only messages addressed to our parent are seen by its RML -
+     * anything it just relays onward would not mark us as heard */
+    if (rank == PRTE_PROC_MY_PARENT->rank) {
+        hb_sent = true;
+    }
+}
@@ -28,6 +28,7 @@
 #include "src/pmix/pmix-internal.h"
 #include "src/util/name_fns.h"
 #include "src/util/pmix_output.h"
+#include "src/util/output.h"
 #include "src/util/pmix_name_fns.h"
 
 #include "src/mca/errmgr/errmgr.h"
@@ -44,7 +45,7 @@ int prte_rml_send_buffer_nb(pmix_rank_t rank,
     prte_rml_recv_t *rcv;
     prte_rml_send_t *snd;
 
-    PMIX_OUTPUT_VERBOSE((1, prte_rml_base.rml_output,
+    PRTE_OUTPUT_VERBOSE((1, prte_rml_base.rml_output,
          "%s rml_send_buffer to peer %s at tag %d",
          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
          PMIX_RANK_PRINT(rank), tag));
@@ -64,7 +65,7 @@ int prte_rml_send_buffer_nb(pmix_rank_t rank,
      * for receipt - no need to dive into the oob
      */
     if (PRTE_PROC_MY_NAME->rank == rank) { /* local delivery */
-        PMIX_OUTPUT_VERBOSE((1, prte_rml_base.rml_output,
+        PRTE_OUTPUT_VERBOSE((1, prte_rml_base.rml_output,
                              "%s rml_send_buffer_to_self at tag %d",
                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), tag));
         /* copy the message for the recv */
@@ -79,6 +80,16 @@ int prte_rml_send_buffer_nb(pmix_rank_t rank,
         return PRTE_SUCCESS;
     }
 
+    /* anything sent to our parent doubles as a heartbeat */
+    if (0 < prte_rml_base.heartbeat_rate) {
+        prte_rml_heartbeat_sent(rank);
+    }
+    /* keep recent relays in case we have to adopt children */
+    if (prte_rml_base.self_heal && PRTE_RML_TAG_XCAST == tag &&
+        PRTE_PROC_MY_HNP->rank != rank) {
+        prte_rml_heal_record(buffer);
+    }
+
     snd = PMIX_NEW(prte_rml_send_t);
     PMIX_LOAD_PROCID(&snd->dst, PRTE_PROC_MY_NAME->nspace, rank);
     snd->origin = *PRTE_PROC_MY_NAME;
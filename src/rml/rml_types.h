@@ -224,6 +224,12 @@ typedef void (*prte_rml_buffer_callback_fn_t)(int status, pmix_proc_t *peer,
 #define PRTE_RML_TAG_SCHED                72
 #define PRTE_RML_TAG_SCHED_RESP           73
 
+/* routing tree repair notices */
+#define PRTE_RML_TAG_ROUTE_HEAL           74
+
+/* event notifications sent to a subset of the daemons */
+#define PRTE_RML_TAG_NOTIFY_RELAY         75
+
 
 #define PRTE_RML_TAG_MAX                 100
 
@@ -269,6 +275,10 @@ typedef struct {
     pmix_data_buffer_t *dbuf;
     /* msg seq number */
     uint32_t seq_num;
+    /* transport flags and payload checksum of a message
+     * being relayed for another proc */
+    uint8_t flags;
+    uint32_t csum;
 } prte_rml_send_t;
 PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_rml_send_t);
 
@@ -316,6 +326,10 @@ typedef struct {
     pmix_list_item_t super;
     pmix_rank_t rank;
     pmix_bitmap_t relatives;
+    /* heartbeat tracking */
+    bool heard;
+    bool failed;
+    double last_heard;
 } prte_routed_tree_t;
 PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_routed_tree_t);
 
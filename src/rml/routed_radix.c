@@ -24,14 +24,45 @@
 #include "constants.h"
 
 #include <stddef.h>
+#include <string.h>
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
 
 #include "src/class/pmix_bitmap.h"
 #include "src/util/pmix_output.h"
+#include "src/util/output.h"
 
+#include "src/mca/errmgr/errmgr.h"
+#include "src/mca/state/state.h"
 #include "src/rml/rml.h"
 #include "src/runtime/prte_globals.h"
 #include "src/util/name_fns.h"
 
+/* daemons lost while self-healing - the tree is routed around them */
+static pmix_bitmap_t lost;
+static bool lost_init = false;
+
+/* most recent xcast relays, replayed to any children we adopt */
+static pmix_data_buffer_t **replay = NULL;
+static int replay_next = 0;
+static bool replaying = false;
+
+/* repair time reported by the daemon that detected a loss */
+static pmix_rank_t pending_rank = PMIX_RANK_INVALID;
+static double pending_msec = 0.0;
+
+/* upper layer to be told when the tree changes */
+static prte_rml_heal_cbfunc_t heal_cbfunc = NULL;
+
+static bool rank_lost(int rank)
+{
+    return lost_init && pmix_bitmap_is_set_bit(&lost, rank);
+}
+
+static int radix_parent(int rank);
+static int heal(pmix_rank_t route, bool notify);
+
 pmix_rank_t prte_rml_get_route(pmix_rank_t target)
 {
     pmix_rank_t ret;
@@ -76,7 +107,7 @@ pmix_rank_t prte_rml_get_route(pmix_rank_t target)
     ret = PRTE_PROC_MY_PARENT->rank;
 
 found:
-    PMIX_OUTPUT_VERBOSE((1, prte_rml_base.routed_output,
+    PRTE_OUTPUT_VERBOSE((1, prte_rml_base.routed_output,
                          "%s routed_radix_get(%s) --> %s",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                          PRTE_VPID_PRINT(target),
@@ -85,22 +116,51 @@ found:
     return ret;
 }
 
+bool prte_rml_rank_lost(pmix_rank_t rank)
+{
+    return rank_lost(rank);
+}
+
+pmix_rank_t prte_rml_get_parent(pmix_rank_t rank)
+{
+    int parent;
+
+    /* skip over any daemons we have already routed around */
+    parent = radix_parent(rank);
+    while (0 < parent && rank_lost(parent)) {
+        parent = radix_parent(parent);
+    }
+    if (0 > parent) {
+        return PMIX_RANK_INVALID;
+    }
+    return parent;
+}
+
 int prte_rml_route_lost(pmix_rank_t route)
 {
     prte_routed_tree_t *child;
 
-    PMIX_OUTPUT_VERBOSE((2, prte_rml_base.routed_output,
+    PRTE_OUTPUT_VERBOSE((2, prte_rml_base.routed_output,
                          "%s route to %s lost",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                          PRTE_VPID_PRINT(route)));
 
+    /* if we are allowed to, route around the lost daemon - the
+     * HNP can never be healed around, so that remains fatal */
+    if (prte_rml_base.self_heal && !prte_finalizing &&
+        !prte_prteds_term_ordered && !prte_abnormal_term_ordered &&
+        0 != route && PRTE_PROC_MY_NAME->rank != route &&
+        route < prte_process_info.num_daemons) {
+        return heal(route, true);
+    }
+
     /* if we lose the connection to the lifeline and we are NOT already,
      * in finalize, tell the OOB to abort.
      * NOTE: we cannot call abort from here as the OOB needs to first
      * release a thread-lock - otherwise, we will hang!!
      */
     if (!prte_finalizing && route == prte_rml_base.lifeline) {
-        PMIX_OUTPUT_VERBOSE((2, prte_rml_base.routed_output,
+        PRTE_OUTPUT_VERBOSE((2, prte_rml_base.routed_output,
                              "%s routed:radix: Connection to lifeline %s lost",
                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                              PRTE_VPID_PRINT(prte_rml_base.lifeline)));
@@ -121,6 +181,287 @@ int prte_rml_route_lost(pmix_rank_t route)
     return PRTE_SUCCESS;
 }
 
+static double heal_now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double) tv.tv_sec + (double) tv.tv_usec / 1000000.0;
+}
+
+static void heal_send(pmix_rank_t target, pmix_rank_t route, double msec)
+{
+    pmix_data_buffer_t *buf;
+    int rc;
+
+    PMIX_DATA_BUFFER_CREATE(buf);
+    rc = PMIx_Data_pack(NULL, buf, &route, 1, PMIX_PROC_RANK);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buf, &msec, 1, PMIX_DOUBLE);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        return;
+    }
+    PRTE_RML_SEND(rc, target, buf, PRTE_RML_TAG_ROUTE_HEAL);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+    }
+}
+
+static void heal_replay(pmix_rank_t target)
+{
+    pmix_data_buffer_t *buf;
+    int n, idx, rc;
+
+    /* oldest first - the receiver drops anything it already has */
+    replaying = true;
+    for (n = 0; n < prte_rml_base.heal_replay; n++) {
+        idx = (replay_next + n) % prte_rml_base.heal_replay;
+        if (NULL == replay[idx]) {
+            continue;
+        }
+        PMIX_DATA_BUFFER_CREATE(buf);
+        rc = PMIx_Data_copy_payload(buf, replay[idx]);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_RELEASE(buf);
+            continue;
+        }
+        PRTE_RML_SEND(rc, target, buf, PRTE_RML_TAG_XCAST);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_RELEASE(buf);
+        }
+    }
+    replaying = false;
+}
+
+static int heal(pmix_rank_t route, bool notify)
+{
+    prte_routed_tree_t *child;
+    pmix_rank_t *prior = NULL;
+    size_t nprior = 0, n;
+    pmix_rank_t parent;
+    double start;
+    bool adopted;
+
+    if (rank_lost(route)) {
+        /* already routed around it */
+        return PRTE_SUCCESS;
+    }
+    start = heal_now();
+
+    if (!lost_init) {
+        PMIX_CONSTRUCT(&lost, pmix_bitmap_t);
+        pmix_bitmap_init(&lost, prte_process_info.num_daemons);
+        lost_init = true;
+    }
+    pmix_bitmap_set_bit(&lost, route);
+
+    /* remember our current children so we can spot the adopted ones */
+    if (0 < pmix_list_get_size(&prte_rml_base.children)) {
+        prior = (pmix_rank_t *) malloc(pmix_list_get_size(&prte_rml_base.children)
+                                       * sizeof(pmix_rank_t));
+        if (NULL == prior) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        PMIX_LIST_FOREACH(child, &prte_rml_base.children, prte_routed_tree_t)
+        {
+            prior[nprior++] = child->rank;
+        }
+    }
+
+    parent = PRTE_PROC_MY_PARENT->rank;
+    prte_rml_compute_routing_tree();
+    prte_rml_base.lifeline = PRTE_PROC_MY_PARENT->rank;
+
+    PMIX_LIST_FOREACH(child, &prte_rml_base.children, prte_routed_tree_t)
+    {
+        adopted = true;
+        for (n = 0; n < nprior; n++) {
+            if (prior[n] == child->rank) {
+                adopted = false;
+                break;
+            }
+        }
+        if (adopted && NULL != replay) {
+            /* anything the lost daemon may not have passed along */
+            heal_replay(child->rank);
+        }
+        /* pass the news down so our subtree routes around it too */
+        heal_send(child->rank, route, 0.0);
+    }
+    if (NULL != prior) {
+        free(prior);
+    }
+    /* let collectives in flight adjust to the new tree */
+    if (NULL != heal_cbfunc) {
+        heal_cbfunc(route, parent != PRTE_PROC_MY_PARENT->rank);
+    }
+
+    prte_rml_base.heal_msec = (heal_now() - start) * 1000.0;
+    if (pending_rank == route) {
+        prte_rml_base.heal_msec += pending_msec;
+        pending_rank = PMIX_RANK_INVALID;
+    }
+    prte_output_verbose(1, prte_rml_base.routed_output,
+                        "%s routed:radix: routed around lost daemon %s in %.3f msec - parent %s num_children %d",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_VPID_PRINT(route),
+                        prte_rml_base.heal_msec, PRTE_VPID_PRINT(PRTE_PROC_MY_PARENT->rank),
+                        (int) pmix_list_get_size(&prte_rml_base.children));
+
+    if (notify && !PRTE_PROC_IS_MASTER) {
+        /* let the HNP know so it can update the rest of the DVM */
+        heal_send(PRTE_PROC_MY_HNP->rank, route, prte_rml_base.heal_msec);
+    }
+    return PRTE_SUCCESS;
+}
+
+static void heal_recv(int status, pmix_proc_t *sender,
+                      pmix_data_buffer_t *buffer,
+                      prte_rml_tag_t tg, void *cbdata)
+{
+    pmix_rank_t route;
+    double msec;
+    int32_t cnt;
+    prte_job_t *jdata;
+    prte_proc_t *proc;
+    pmix_proc_t name;
+    int rc;
+    PRTE_HIDE_UNUSED_PARAMS(status, tg, cbdata);
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &route, &cnt, PMIX_PROC_RANK);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &msec, &cnt, PMIX_DOUBLE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+
+    if (!PRTE_PROC_IS_MASTER) {
+        /* notice coming down the tree */
+        heal(route, false);
+        return;
+    }
+
+    /* a daemon has detected the loss - let the errmgr deal
+     * with it unless we already know */
+    jdata = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
+    if (NULL == jdata) {
+        return;
+    }
+    proc = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs, route);
+    if (NULL == proc || !PRTE_FLAG_TEST(proc, PRTE_PROC_FLAG_ALIVE)) {
+        return;
+    }
+    prte_output_verbose(1, prte_rml_base.routed_output,
+                        "%s routed:radix: daemon %s reports loss of %s (local repair %.3f msec)",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(sender),
+                        PRTE_VPID_PRINT(route), msec);
+    pending_rank = route;
+    pending_msec = msec;
+    PMIX_LOAD_PROCID(&name, PRTE_PROC_MY_NAME->nspace, route);
+    PRTE_ACTIVATE_PROC_STATE(&name, PRTE_PROC_STATE_COMM_FAILED);
+}
+
+void prte_rml_heal_start(void)
+{
+    if (!prte_rml_base.self_heal) {
+        return;
+    }
+    if (0 < prte_rml_base.heal_replay) {
+        replay = (pmix_data_buffer_t **) calloc(prte_rml_base.heal_replay,
+                                                sizeof(pmix_data_buffer_t *));
+    }
+    replay_next = 0;
+    PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_ROUTE_HEAL,
+                  PRTE_RML_PERSISTENT, heal_recv, NULL);
+}
+
+void prte_rml_heal_stop(void)
+{
+    int n;
+
+    if (NULL != replay) {
+        for (n = 0; n < prte_rml_base.heal_replay; n++) {
+            if (NULL != replay[n]) {
+                PMIX_DATA_BUFFER_RELEASE(replay[n]);
+            }
+        }
+        free(replay);
+        replay = NULL;
+    }
+    if (lost_init) {
+        PMIX_DESTRUCT(&lost);
+        lost_init = false;
+    }
+    heal_cbfunc = NULL;
+}
+
+void prte_rml_heal_register(prte_rml_heal_cbfunc_t cbfunc)
+{
+    heal_cbfunc = cbfunc;
+}
+
+void prte_rml_heal_record(pmix_data_buffer_t *buffer)
+{
+    pmix_data_buffer_t *last, *cpy;
+    int idx, rc;
+
+    if (NULL == replay || replaying) {
+        return;
+    }
+    /* the same relay goes to each of our children - only keep one */
+    idx = (replay_next + prte_rml_base.heal_replay - 1) % prte_rml_base.heal_replay;
+    last = replay[idx];
+    if (NULL != last && last->bytes_used == buffer->bytes_used &&
+        0 == memcmp(last->base_ptr, buffer->base_ptr, buffer->bytes_used)) {
+        return;
+    }
+    PMIX_DATA_BUFFER_CREATE(cpy);
+    rc = PMIx_Data_copy_payload(cpy, buffer);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(cpy);
+        return;
+    }
+    if (NULL != replay[replay_next]) {
+        PMIX_DATA_BUFFER_RELEASE(replay[replay_next]);
+    }
+    replay[replay_next] = cpy;
+    replay_next = (replay_next + 1) % prte_rml_base.heal_replay;
+}
+
+static int radix_parent(int rank)
+{
+    int Sum, NInLevel, NInPrevLevel;
+
+    if (0 == rank) {
+        return -1;
+    }
+
+    Sum = 1;
+    NInLevel = 1;
+
+    while (Sum < (rank + 1)) {
+        NInLevel *= prte_rml_base.radix;
+        Sum += NInLevel;
+    }
+    Sum -= NInLevel;
+
+    NInPrevLevel = NInLevel / prte_rml_base.radix;
+
+    return ((rank - Sum) % NInPrevLevel) + (Sum - NInPrevLevel);
+}
+
 static void radix_tree(int rank,
                        pmix_list_t *children,
                        pmix_bitmap_t *relatives)
@@ -142,6 +483,12 @@ static void radix_tree(int rank,
     peer = rank + NInLevel;
     for (i = 0; i < prte_rml_base.radix; i++) {
         if (peer < (int) prte_process_info.num_daemons) {
+            if (NULL != children && rank_lost(peer)) {
+                /* adopt the children of a lost daemon */
+                radix_tree(peer, children, NULL);
+                peer += NInLevel;
+                continue;
+            }
             child = PMIX_NEW(prte_routed_tree_t);
             child->rank = peer;
             if (NULL != children) {
@@ -171,32 +518,16 @@ static void radix_tree(int rank,
 void prte_rml_compute_routing_tree(void)
 {
     prte_routed_tree_t *child;
-    int j;
-    int Level, Sum, NInLevel, Ii;
-    int NInPrevLevel;
+    int j, Ii;
     prte_job_t *dmns;
     prte_proc_t *d;
 
-    /* compute my parent */
+    /* compute my parent - if it was lost, step up to the
+     * first surviving ancestor */
     Ii = PRTE_PROC_MY_NAME->rank;
-    Level = 0;
-    Sum = 1;
-    NInLevel = 1;
-
-    while (Sum < (Ii + 1)) {
-        Level++;
-        NInLevel *= prte_rml_base.radix;
-        Sum += NInLevel;
-    }
-    Sum -= NInLevel;
-
-    NInPrevLevel = NInLevel / prte_rml_base.radix;
-
-    if (0 == Ii) {
-        PRTE_PROC_MY_PARENT->rank = -1;
-    } else {
-        PRTE_PROC_MY_PARENT->rank = (Ii - Sum) % NInPrevLevel;
-        PRTE_PROC_MY_PARENT->rank += (Sum - NInPrevLevel);
+    PRTE_PROC_MY_PARENT->rank = radix_parent(Ii);
+    while (0 < Ii && rank_lost(PRTE_PROC_MY_PARENT->rank)) {
+        PRTE_PROC_MY_PARENT->rank = radix_parent(PRTE_PROC_MY_PARENT->rank);
     }
 
     /* compute my direct children and the bitmap that shows which vpids
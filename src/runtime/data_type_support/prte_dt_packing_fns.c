@@ -35,6 +35,132 @@
 
 #include "src/runtime/prte_globals.h"
 
+/* Pack the procs of a job column-by-column: each field of every
+ * proc goes out in a single pack call carrying a single type tag,
+ * and the nspace - which is always the job's - is not repeated */
+static int pack_procs(pmix_data_buffer_t *bkt, prte_job_t *job)
+{
+    pmix_status_t rc;
+    int32_t j, n, nprocs;
+    prte_proc_t *proc;
+    prte_attribute_t *kv;
+    pmix_rank_t *ranks, *parents, *app_ranks;
+    uint16_t *local_ranks, *node_ranks;
+    uint32_t *states, *app_idxs;
+    int32_t *nattrs;
+    char **cpusets;
+
+    nprocs = 0;
+    for (j = 0; j < job->procs->size; j++) {
+        if (NULL != pmix_pointer_array_get_item(job->procs, j)) {
+            ++nprocs;
+        }
+    }
+    rc = PMIx_Data_pack(NULL, bkt, (void *) &nprocs, 1, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    if (0 == nprocs) {
+        return PRTE_SUCCESS;
+    }
+
+    ranks = (pmix_rank_t *) malloc(3 * nprocs * sizeof(pmix_rank_t));
+    local_ranks = (uint16_t *) malloc(2 * nprocs * sizeof(uint16_t));
+    states = (uint32_t *) malloc(2 * nprocs * sizeof(uint32_t));
+    nattrs = (int32_t *) malloc(nprocs * sizeof(int32_t));
+    cpusets = (char **) malloc(nprocs * sizeof(char *));
+    if (NULL == ranks || NULL == local_ranks || NULL == states ||
+        NULL == nattrs || NULL == cpusets) {
+        rc = PMIX_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    parents = ranks + nprocs;
+    app_ranks = parents + nprocs;
+    node_ranks = local_ranks + nprocs;
+    app_idxs = states + nprocs;
+
+    n = 0;
+    for (j = 0; j < job->procs->size && n < nprocs; j++) {
+        if (NULL == (proc = (prte_proc_t *) pmix_pointer_array_get_item(job->procs, j))) {
+            continue;
+        }
+        ranks[n] = proc->name.rank;
+        parents[n] = proc->parent;
+        app_ranks[n] = proc->app_rank;
+        local_ranks[n] = proc->local_rank;
+        node_ranks[n] = proc->node_rank;
+        states[n] = proc->state;
+        app_idxs[n] = proc->app_idx;
+        cpusets[n] = proc->cpuset;
+        nattrs[n] = 0;
+        PMIX_LIST_FOREACH(kv, &proc->attributes, prte_attribute_t)
+        {
+            if (PRTE_ATTR_GLOBAL == kv->local) {
+                ++nattrs[n];
+            }
+        }
+        ++n;
+    }
+
+    if (PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, bkt, ranks, nprocs, PMIX_PROC_RANK)) ||
+        PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, bkt, parents, nprocs, PMIX_PROC_RANK)) ||
+        PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, bkt, local_ranks, nprocs, PMIX_UINT16)) ||
+        PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, bkt, node_ranks, nprocs, PMIX_UINT16)) ||
+        PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, bkt, states, nprocs, PMIX_UINT32)) ||
+        PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, bkt, app_idxs, nprocs, PMIX_UINT32)) ||
+        PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, bkt, app_ranks, nprocs, PMIX_PROC_RANK)) ||
+        PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, bkt, cpusets, nprocs, PMIX_STRING)) ||
+        PMIX_SUCCESS != (rc = PMIx_Data_pack(NULL, bkt, nattrs, nprocs, PMIX_INT32))) {
+        goto cleanup;
+    }
+
+    /* attributes are rare on procs, so only those that have
+     * any contribute to the payload */
+    n = 0;
+    for (j = 0; j < job->procs->size && n < nprocs; j++) {
+        if (NULL == (proc = (prte_proc_t *) pmix_pointer_array_get_item(job->procs, j))) {
+            continue;
+        }
+        if (0 < nattrs[n++]) {
+            PMIX_LIST_FOREACH(kv, &proc->attributes, prte_attribute_t)
+            {
+                if (PRTE_ATTR_GLOBAL == kv->local) {
+                    rc = PMIx_Data_pack(NULL, bkt, (void *) &kv->key, 1, PMIX_UINT16);
+                    if (PMIX_SUCCESS != rc) {
+                        goto cleanup;
+                    }
+                    rc = PMIx_Data_pack(NULL, bkt, (void *) &kv->data, 1, PMIX_VALUE);
+                    if (PMIX_SUCCESS != rc) {
+                        goto cleanup;
+                    }
+                }
+            }
+        }
+    }
+
+cleanup:
+    if (NULL != ranks) {
+        free(ranks);
+    }
+    if (NULL != local_ranks) {
+        free(local_ranks);
+    }
+    if (NULL != states) {
+        free(states);
+    }
+    if (NULL != nattrs) {
+        free(nattrs);
+    }
+    if (NULL != cpusets) {
+        free(cpusets);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    return prte_pmix_convert_status(rc);
+}
+
 /*
  * JOB
  * NOTE: We do not pack all of the job object's fields as many of them have no
@@ -47,10 +173,18 @@ int prte_job_pack(pmix_data_buffer_t *bkt, prte_job_t *job)
     pmix_status_t rc;
     int32_t j, count, bookmark;
     prte_app_context_t *app;
-    prte_proc_t *proc;
     prte_attribute_t *kv;
     pmix_list_t *cache;
     prte_info_item_t *val;
+    uint8_t version = PRTE_JOB_PACK_VERSION;
+
+    /* pack the encoding version so a mismatched peer is
+     * caught up front rather than partway through */
+    rc = PMIx_Data_pack(NULL, bkt, (void *) &version, 1, PMIX_UINT8);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
 
     /* pack the nspace */
     rc = PMIx_Data_pack(NULL, bkt, (void *) &job->nspace, 1, PMIX_PROC_NSPACE);
@@ -173,17 +307,10 @@ int prte_job_pack(pmix_data_buffer_t *bkt, prte_job_t *job)
         return prte_pmix_convert_status(rc);
     }
 
-    if (0 < job->num_procs) {
-        for (j = 0; j < job->procs->size; j++) {
-            if (NULL == (proc = (prte_proc_t *) pmix_pointer_array_get_item(job->procs, j))) {
-                continue;
-            }
-            rc = prte_proc_pack(bkt, proc);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                return prte_pmix_convert_status(rc);
-            }
-        }
+    /* pack the procs */
+    rc = pack_procs(bkt, job);
+    if (PRTE_SUCCESS != rc) {
+        return rc;
     }
 
     /* pack the stdin target */
@@ -438,7 +565,7 @@ int prte_proc_pack(pmix_data_buffer_t *bkt, prte_proc_t *proc)
 int prte_app_pack(pmix_data_buffer_t *bkt, prte_app_context_t *app)
 {
     pmix_status_t rc;
-    int32_t count, j;
+    int32_t count;
     prte_attribute_t *kv;
 
     /* pack the application index (for multiapp jobs) */
@@ -478,8 +605,8 @@ int prte_app_pack(pmix_data_buffer_t *bkt, prte_app_context_t *app)
     }
 
     /* if there are entries, pack the argv entries */
-    for (j = 0; j < count; j++) {
-        rc = PMIx_Data_pack(NULL, bkt, (void *) &app->argv[j], 1, PMIX_STRING);
+    if (0 < count) {
+        rc = PMIx_Data_pack(NULL, bkt, (void *) app->argv, count, PMIX_STRING);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             return prte_pmix_convert_status(rc);
@@ -495,8 +622,8 @@ int prte_app_pack(pmix_data_buffer_t *bkt, prte_app_context_t *app)
     }
 
     /* if there are entries, pack the enviro entries */
-    for (j = 0; j < count; j++) {
-        rc = PMIx_Data_pack(NULL, bkt, (void *) &app->env[j], 1, PMIX_STRING);
+    if (0 < count) {
+        rc = PMIx_Data_pack(NULL, bkt, (void *) app->env, count, PMIX_STRING);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             return prte_pmix_convert_status(rc);
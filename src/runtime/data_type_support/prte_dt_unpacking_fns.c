@@ -34,6 +34,123 @@
 
 #include "src/runtime/prte_globals.h"
 
+/* Unpack the procs of a job - see pack_procs for the layout */
+static int unpack_procs(pmix_data_buffer_t *bkt, prte_job_t *jptr)
+{
+    pmix_status_t rc;
+    int32_t j, k, n, nprocs;
+    prte_proc_t *proc;
+    prte_attribute_t *kv;
+    pmix_rank_t *ranks, *parents, *app_ranks;
+    uint16_t *local_ranks, *node_ranks;
+    uint32_t *states, *app_idxs;
+    int32_t *nattrs;
+    char **cpusets;
+
+    n = 1;
+    rc = PMIx_Data_unpack(NULL, bkt, &nprocs, &n, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    if (0 >= nprocs) {
+        return PRTE_SUCCESS;
+    }
+
+    ranks = (pmix_rank_t *) malloc(3 * nprocs * sizeof(pmix_rank_t));
+    local_ranks = (uint16_t *) malloc(2 * nprocs * sizeof(uint16_t));
+    states = (uint32_t *) malloc(2 * nprocs * sizeof(uint32_t));
+    nattrs = (int32_t *) malloc(nprocs * sizeof(int32_t));
+    cpusets = (char **) calloc(nprocs, sizeof(char *));
+    if (NULL == ranks || NULL == local_ranks || NULL == states ||
+        NULL == nattrs || NULL == cpusets) {
+        rc = PMIX_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    parents = ranks + nprocs;
+    app_ranks = parents + nprocs;
+    node_ranks = local_ranks + nprocs;
+    app_idxs = states + nprocs;
+
+#define PRTE_UNPACK_COLUMN(c, t)                                 \
+    do {                                                         \
+        n = nprocs;                                              \
+        rc = PMIx_Data_unpack(NULL, bkt, (c), &n, (t));          \
+        if (PMIX_SUCCESS != rc) {                                \
+            goto cleanup;                                        \
+        }                                                        \
+    } while (0)
+
+    PRTE_UNPACK_COLUMN(ranks, PMIX_PROC_RANK);
+    PRTE_UNPACK_COLUMN(parents, PMIX_PROC_RANK);
+    PRTE_UNPACK_COLUMN(local_ranks, PMIX_UINT16);
+    PRTE_UNPACK_COLUMN(node_ranks, PMIX_UINT16);
+    PRTE_UNPACK_COLUMN(states, PMIX_UINT32);
+    PRTE_UNPACK_COLUMN(app_idxs, PMIX_UINT32);
+    PRTE_UNPACK_COLUMN(app_ranks, PMIX_PROC_RANK);
+    PRTE_UNPACK_COLUMN(cpusets, PMIX_STRING);
+    PRTE_UNPACK_COLUMN(nattrs, PMIX_INT32);
+#undef PRTE_UNPACK_COLUMN
+
+    for (j = 0; j < nprocs; j++) {
+        proc = PMIX_NEW(prte_proc_t);
+        PMIX_LOAD_PROCID(&proc->name, jptr->nspace, ranks[j]);
+        proc->parent = parents[j];
+        proc->local_rank = local_ranks[j];
+        proc->node_rank = node_ranks[j];
+        proc->state = states[j];
+        proc->app_idx = app_idxs[j];
+        proc->app_rank = app_ranks[j];
+        /* take ownership of the string */
+        proc->cpuset = cpusets[j];
+        cpusets[j] = NULL;
+        pmix_pointer_array_add(jptr->procs, proc);
+        for (k = 0; k < nattrs[j]; k++) {
+            kv = PMIX_NEW(prte_attribute_t);
+            n = 1;
+            rc = PMIx_Data_unpack(NULL, bkt, &kv->key, &n, PMIX_UINT16);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_RELEASE(kv);
+                goto cleanup;
+            }
+            n = 1;
+            rc = PMIx_Data_unpack(NULL, bkt, &kv->data, &n, PMIX_VALUE);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_RELEASE(kv);
+                goto cleanup;
+            }
+            kv->local = PRTE_ATTR_GLOBAL; // obviously not a local value
+            pmix_list_append(&proc->attributes, &kv->super);
+        }
+    }
+
+cleanup:
+    if (NULL != ranks) {
+        free(ranks);
+    }
+    if (NULL != local_ranks) {
+        free(local_ranks);
+    }
+    if (NULL != states) {
+        free(states);
+    }
+    if (NULL != nattrs) {
+        free(nattrs);
+    }
+    if (NULL != cpusets) {
+        for (j = 0; j < nprocs; j++) {
+            if (NULL != cpusets[j]) {
+                free(cpusets[j]);
+            }
+        }
+        free(cpusets);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    return prte_pmix_convert_status(rc);
+}
+
 /*
  * JOB
  * NOTE: We do not pack all of the job object's fields as many of them have no
@@ -53,6 +170,7 @@ int prte_job_unpack(pmix_data_buffer_t *bkt, prte_job_t **job)
     prte_info_item_t *val;
     pmix_info_t pval;
     pmix_list_t *cache;
+    uint8_t version;
 
     /* create the prte_job_t object */
     jptr = PMIX_NEW(prte_job_t);
@@ -61,6 +179,23 @@ int prte_job_unpack(pmix_data_buffer_t *bkt, prte_job_t **job)
         return PRTE_ERR_OUT_OF_RESOURCE;
     }
 
+    /* check the encoding version */
+    n = 1;
+    rc = PMIx_Data_unpack(NULL, bkt, &version, &n, PMIX_UINT8);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(jptr);
+        return prte_pmix_convert_status(rc);
+    }
+    if (PRTE_JOB_PACK_VERSION != version) {
+        pmix_output(0, "%s job object was packed with encoding version %u - expected %u",
+                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (unsigned) version,
+                    (unsigned) PRTE_JOB_PACK_VERSION);
+        PRTE_ERROR_LOG(PRTE_ERR_PACK_MISMATCH);
+        PMIX_RELEASE(jptr);
+        return PRTE_ERR_PACK_MISMATCH;
+    }
+
     /* unpack the nspace */
     n = 1;
     rc = PMIx_Data_unpack(NULL, bkt, &jptr->nspace, &n, PMIX_PROC_NSPACE);
@@ -193,17 +328,11 @@ int prte_job_unpack(pmix_data_buffer_t *bkt, prte_job_t **job)
         return prte_pmix_convert_status(rc);
     }
 
-    if (0 < jptr->num_procs) {
-        prte_proc_t *proc;
-        for (j = 0; j < jptr->num_procs; j++) {
-            rc = prte_proc_unpack(bkt, &proc);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_RELEASE(jptr);
-                return prte_pmix_convert_status(rc);
-            }
-            pmix_pointer_array_add(jptr->procs, proc);
-        }
+    /* unpack the procs */
+    rc = unpack_procs(bkt, jptr);
+    if (PRTE_SUCCESS != rc) {
+        PMIX_RELEASE(jptr);
+        return rc;
     }
 
     /* unpack stdin target */
@@ -499,7 +628,6 @@ int prte_app_unpack(pmix_data_buffer_t *bkt, prte_app_context_t **ap)
     prte_app_context_t *app;
     int32_t n, count, k;
     prte_attribute_t *kv;
-    char *tmp;
 
     /* create the app_context object */
     app = PMIX_NEW(prte_app_context_t);
@@ -552,16 +680,21 @@ int prte_app_unpack(pmix_data_buffer_t *bkt, prte_app_context_t **ap)
         PMIX_RELEASE(app);
         return prte_pmix_convert_status(rc);
     }
-    for (k = 0; k < count; k++) {
-        n = 1;
-        rc = PMIx_Data_unpack(NULL, bkt, &tmp, &n, PMIX_STRING);
+    if (0 < count) {
+        /* the strings were packed as a single array */
+        app->argv = (char **) calloc(count + 1, sizeof(char *));
+        if (NULL == app->argv) {
+            PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+            PMIX_RELEASE(app);
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        n = count;
+        rc = PMIx_Data_unpack(NULL, bkt, app->argv, &n, PMIX_STRING);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(app);
             return prte_pmix_convert_status(rc);
         }
-        PMIX_ARGV_APPEND_NOSIZE_COMPAT(&app->argv, tmp);
-        free(tmp);
     }
 
     /* get the number of env strings */
@@ -572,16 +705,21 @@ int prte_app_unpack(pmix_data_buffer_t *bkt, prte_app_context_t **ap)
         PMIX_RELEASE(app);
         return prte_pmix_convert_status(rc);
     }
-    for (k = 0; k < count; k++) {
-        n = 1;
-        rc = PMIx_Data_unpack(NULL, bkt, &tmp, &n, PMIX_STRING);
+    if (0 < count) {
+        /* the strings were packed as a single array */
+        app->env = (char **) calloc(count + 1, sizeof(char *));
+        if (NULL == app->env) {
+            PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+            PMIX_RELEASE(app);
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        n = count;
+        rc = PMIx_Data_unpack(NULL, bkt, app->env, &n, PMIX_STRING);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(app);
             return prte_pmix_convert_status(rc);
         }
-        PMIX_ARGV_APPEND_NOSIZE_COMPAT(&app->env, tmp);
-        free(tmp);
     }
 
     /* unpack the cwd */
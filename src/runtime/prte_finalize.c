@@ -43,7 +43,9 @@
 #include "src/runtime/prte_globals.h"
 #include "src/runtime/prte_locks.h"
 #include "src/runtime/runtime.h"
+#include "src/util/hostfile/hostfile.h"
 #include "src/util/name_fns.h"
+#include "src/util/output.h"
 #include "src/util/proc_info.h"
 
 int prte_finalize(void)
@@ -71,6 +73,10 @@ int prte_finalize(void)
     /* flag that we are finalizing */
     prte_finalizing = true;
 
+    /* write out any verbose output we deferred */
+    prte_output_trace_dump();
+    prte_output_trace_close();
+
     /* release the cache */
     PMIX_RELEASE(prte_cache);
 
@@ -134,6 +140,8 @@ int prte_finalize(void)
     }
     PMIX_RELEASE(prte_node_topologies);
 
+    prte_util_hostfile_finalize();
+
     /* Close the general debug stream */
     pmix_output_close(prte_debug_output);
 
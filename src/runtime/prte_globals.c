@@ -121,6 +121,8 @@ float prte_max_timeout = -1.0;
 prte_timer_t *prte_mpiexec_timeout = NULL;
 
 int prte_stack_trace_wait_timeout = 30;
+int prte_stack_trace_samples = 1;
+int prte_stack_trace_parallel = 32;
 
 /* global arrays for data storage */
 pmix_pointer_array_t *prte_sessions = NULL;
@@ -166,6 +168,9 @@ char **prte_forwarded_envars = NULL;
 /* maximum size of virtual machine - used to subdivide allocation */
 int prte_max_vm_size = -1;
 
+/* only pass what changed when the DVM grows */
+bool prte_elastic_expansion = true;
+
 int prte_debug_output = -1;
 bool prte_debug_daemons_flag = false;
 char *prte_job_ident = NULL;
@@ -630,8 +635,6 @@ static void prte_job_construct(prte_job_t *job)
     PMIX_DATA_BUFFER_CONSTRUCT(&job->launch_msg);
     PMIX_CONSTRUCT(&job->children, pmix_list_t);
     PMIX_LOAD_NSPACE(job->launcher, NULL);
-    job->ntraces = 0;
-    job->traces = NULL;
     PMIX_CONSTRUCT(&job->cli, pmix_cli_result_t);
 }
 
@@ -727,9 +730,6 @@ static void prte_job_destruct(prte_job_t *job)
         /* remove the job from the global array */
         pmix_pointer_array_set_item(prte_job_data, job->index, NULL);
     }
-    if (NULL != job->traces) {
-        PMIX_ARGV_FREE_COMPAT(job->traces);
-    }
     PMIX_DESTRUCT(&job->cli);
 }
 
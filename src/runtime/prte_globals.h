@@ -76,6 +76,8 @@ PRTE_EXPORT extern bool prte_bind_progress_thread_reqd;
 PRTE_EXPORT extern bool prte_show_launch_progress;
 PRTE_EXPORT extern bool prte_bootstrap_setup;
 PRTE_EXPORT extern bool prte_silence_shared_fs;
+PRTE_EXPORT extern bool prte_async_session_cleanup;
+PRTE_EXPORT extern bool prte_hostfile_cache;
 
 /**
  * Global indicating where this process was bound to at launch (will
@@ -386,9 +388,6 @@ typedef struct {
     pmix_list_t children;
     /* track the launcher of these jobs */
     pmix_nspace_t launcher;
-    /* track the number of stack traces recv'd */
-    uint32_t ntraces;
-    char **traces;
     // store the result of parsing this app's cmd line
     pmix_cli_result_t cli;
 } prte_job_t;
@@ -476,7 +475,9 @@ PRTE_EXPORT prte_job_t *prte_get_job_data_object(const pmix_nspace_t job);
  */
 PRTE_EXPORT int prte_set_job_data_object(prte_job_t *jdata);
 
-/** Pack/unpack a job object */
+/** Pack/unpack a job object - bump the version whenever the
+ * encoding of the job, its apps or its procs changes */
+#define PRTE_JOB_PACK_VERSION 1
 PRTE_EXPORT int prte_job_pack(pmix_data_buffer_t *bkt, prte_job_t *job);
 PRTE_EXPORT int prte_job_unpack(pmix_data_buffer_t *bkt, prte_job_t **job);
 PRTE_EXPORT int prte_job_copy(prte_job_t **dest, prte_job_t *src);
@@ -632,6 +633,9 @@ PRTE_EXPORT extern char **prte_forwarded_envars;
 /* maximum size of virtual machine - used to subdivide allocation */
 PRTE_EXPORT extern int prte_max_vm_size;
 
+/* only pass what changed when the DVM grows */
+PRTE_EXPORT extern bool prte_elastic_expansion;
+
 /* binding directives for daemons to restrict them
  * to certain cores
  */
@@ -640,6 +644,11 @@ PRTE_EXPORT extern char *prte_daemon_cores;
 /* Max time to wait for stack straces to return */
 PRTE_EXPORT extern int prte_stack_trace_wait_timeout;
 
+/* number of stack traces to take of each proc, and the
+ * max number of gstack commands a daemon runs at once */
+PRTE_EXPORT extern int prte_stack_trace_samples;
+PRTE_EXPORT extern int prte_stack_trace_parallel;
+
 /* whether or not hwloc shmem support is available */
 PRTE_EXPORT extern bool prte_hwloc_shmem_available;
 
@@ -42,6 +42,7 @@
 #include <string.h>
 #endif
 
+#include "src/util/crc.h"
 #include "src/util/error.h"
 #include "src/util/error_strings.h"
 #include "src/util/pmix_keyval_parse.h"
@@ -50,6 +51,7 @@
 #include "src/util/pmix_if.h"
 #include "src/util/pmix_net.h"
 #include "src/util/pmix_output.h"
+#include "src/util/output.h"
 #include "src/util/pmix_environ.h"
 #include "src/util/pmix_os_path.h"
 #include "src/util/proc_info.h"
@@ -115,6 +117,7 @@ static bool min_initialized = false;
 
 const char prte_version_string[] = PRTE_IDENT_STRING;
 
+#if PRTE_ENABLE_DLOPEN_SUPPORT
 static bool check_exist(char *path)
 {
     struct stat buf;
@@ -124,6 +127,7 @@ static bool check_exist(char *path)
     }
     return false;
 }
+#endif
 
 static void print_error(unsigned major,
                         unsigned minor,
@@ -186,10 +190,13 @@ int prte_init_minimum(void)
         return ret;
     }
 
-    /* initialize the MCA infrastructure */
+    /* initialize the MCA infrastructure - if we cannot load
+     * components, then there is no reason to scan for them */
+#if PRTE_ENABLE_DLOPEN_SUPPORT
     if (check_exist(prte_install_dirs.prtelibdir)) {
         pmix_asprintf(&path, "prte@%s", prte_install_dirs.prtelibdir);
     }
+#endif
     ret = pmix_init_util(NULL, 0, path);
     if (NULL != path) {
         free(path);
@@ -235,6 +242,10 @@ int prte_init_util(prte_proc_type_t flags)
     /* initialize the memory allocator */
     prte_malloc_init();
 
+    /* build the CRC32C tables and select the hardware path, if any,
+     * before any integrity checks can run on the progress threads */
+    prte_crc32c_init();
+
     /* initialize the output system */
     pmix_output_init();
 
@@ -414,6 +425,9 @@ int prte_init(int *pargc, char ***pargv, prte_proc_type_t flags)
     prte_cache = PMIX_NEW(pmix_pointer_array_t);
     pmix_pointer_array_init(prte_cache, 1, INT_MAX, 1);
 
+    /* the frameworks have all set their verbosity */
+    prte_output_verbose_refresh();
+
     /* All done */
     PMIX_ACQUIRE_THREAD(&prte_init_lock);
     prte_initialized = true;
@@ -470,16 +484,28 @@ void prte_preload_default_mca_params(void)
     pmix_list_t params, params2, pfinal;
     pmix_mca_base_var_file_value_t *fv, *fv2, *fvnext, *fvnext2;
     bool match;
+    static const char *frozen[] = {PRTE_FROZEN_MCA_PARAMS NULL};
+    int n;
 
     home = (char*)pmix_home_directory(-1);
     PMIX_CONSTRUCT(&params, pmix_list_t);
     PMIX_CONSTRUCT(&params2, pmix_list_t);
     PMIX_CONSTRUCT(&pfinal, pmix_list_t);
 
-    /* start with the system-level defaults */
-    file = pmix_os_path(false, prte_install_dirs.sysconfdir, "prte-mca-params.conf", NULL);
-    pmix_mca_base_parse_paramfile(file, &params);
-    free(file);
+    /* start with the system-level defaults - if a set was
+     * frozen into the build, then it replaces the file */
+    if (NULL != frozen[0]) {
+        for (n = 0; NULL != frozen[n]; n += 2) {
+            fv = PMIX_NEW(pmix_mca_base_var_file_value_t);
+            fv->mbvfv_var = strdup(frozen[n]);
+            fv->mbvfv_value = strdup(frozen[n + 1]);
+            pmix_list_append(&params, &fv->super);
+        }
+    } else {
+        file = pmix_os_path(false, prte_install_dirs.sysconfdir, "prte-mca-params.conf", NULL);
+        pmix_mca_base_parse_paramfile(file, &params);
+        free(file);
+    }
 
     /* now get the user-level defaults */
     file = pmix_os_path(false, home, ".prte", "mca-params.conf", NULL);
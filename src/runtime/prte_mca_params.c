@@ -41,6 +41,7 @@
 #include "src/util/pmix_argv.h"
 #include "src/util/pmix_output.h"
 #include "src/util/pmix_printf.h"
+#include "src/util/output.h"
 #include "src/util/proc_info.h"
 #include "src/util/pmix_environ.h"
 #include "src/util/pmix_show_help.h"
@@ -66,7 +67,11 @@ int prte_pmix_verbose_output = 0;
 char *prte_progress_thread_cpus = NULL;
 bool prte_bind_progress_thread_reqd = false;
 bool prte_silence_shared_fs = false;
+bool prte_async_session_cleanup = false;
+bool prte_hostfile_cache = false;
 int prte_max_thread_in_progress = 1;
+static int prte_output_trace_records = 0;
+static char *prte_output_trace_file = NULL;
 
 int prte_register_params(void)
 {
@@ -326,6 +331,29 @@ int prte_register_params(void)
         pmix_output_set_verbosity(prte_progress_thread_debug, prte_progress_thread_debug_level);
     }
 
+    prte_output_trace_records = 0;
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "output_trace",
+                                      "Capture enabled verbose output from the OOB, IOF and RML "
+                                      "message paths in a binary ring buffer of this many records, "
+                                      "deferring formatting until the buffer is dumped at finalize "
+                                      "(0 => output immediately) [default: 0]. Note that the verbosity "
+                                      "of these paths is sampled once at startup: raising a verbosity "
+                                      "after the event loop has started does not enable their output",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &prte_output_trace_records);
+
+    prte_output_trace_file = NULL;
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "output_trace_file",
+                                      "Write the verbose output trace to this file, appended with "
+                                      "'.PID', instead of stderr",
+                                      PMIX_MCA_BASE_VAR_TYPE_STRING,
+                                      &prte_output_trace_file);
+
+    ret = prte_output_trace_open(prte_output_trace_records, prte_output_trace_file);
+    if (PRTE_SUCCESS != ret) {
+        return ret;
+    }
+
     prted_debug_failure = PMIX_RANK_INVALID;
     (void) pmix_mca_base_var_register("prte", "prte", NULL, "daemon_fail",
                                       "Have the specified prted fail after init for debugging purposes",
@@ -427,6 +455,14 @@ int prte_register_params(void)
                                       PMIX_MCA_BASE_VAR_TYPE_INT,
                                       &prte_max_vm_size);
 
+    prte_elastic_expansion = true;
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "elastic_expansion",
+                                      "When new daemons are added to a running DVM, send the existing "
+                                      "daemons only the added nodes and give the new daemons only the "
+                                      "nodes and jobs of the session that caused the expansion",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &prte_elastic_expansion);
+
     local_setup_slots = NULL;
     (void) pmix_mca_base_var_register("prte", "prte", NULL, "set_default_slots",
                                       "Set the number of slots on nodes that lack such info to the"
@@ -467,6 +503,22 @@ int prte_register_params(void)
                                    PMIX_MCA_BASE_VAR_TYPE_INT,
                                    &prte_stack_trace_wait_timeout);
 
+    prte_stack_trace_samples = 1;
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "stack_trace_samples",
+                                      "Number of stack traces to take of each process when "
+                                      "collecting them from a hung job - processes whose stack "
+                                      "changes between samples are reported as likely not hung "
+                                      "(default: 1)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &prte_stack_trace_samples);
+
+    prte_stack_trace_parallel = 32;
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "stack_trace_parallel",
+                                      "Maximum number of processes each daemon obtains a stack "
+                                      "trace from at the same time (default: 32, <= 0 no limit)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &prte_stack_trace_parallel);
+
     /* register the URI of the UNIVERSAL data server */
     prte_data_server_uri = NULL;
     (void) pmix_mca_base_var_register("prte", "pmix", NULL, "server_uri",
@@ -495,6 +547,18 @@ int prte_register_params(void)
                                       PMIX_MCA_BASE_VAR_TYPE_BOOL,
                                       &prte_silence_shared_fs);
 
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "async_session_cleanup",
+                                      "Remove job-level session directories on a background thread "
+                                      "so that job termination does not wait on the file system",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &prte_async_session_cleanup);
+
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "hostfile_cache",
+                                      "Keep the parsed contents of each hostfile and reuse them "
+                                      "until the file is modified",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &prte_hostfile_cache);
+
     /* pickup the RML params */
     prte_rml_register();
 
@@ -81,6 +81,7 @@
 #include "src/util/pmix_os_dirpath.h"
 #include "src/util/pmix_os_path.h"
 #include "src/util/pmix_output.h"
+#include "src/util/output.h"
 #include "src/util/pmix_path.h"
 #include "src/util/pmix_printf.h"
 #include "src/util/pmix_environ.h"
@@ -861,6 +862,7 @@ int main(int argc, char *argv[])
      */
     PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_DAEMON,
                   PRTE_RML_PERSISTENT, prte_daemon_recv, NULL);
+    prte_stack_trace_init();
 
     /* setup to capture job-level info */
     PMIX_INFO_LIST_START(jinfo);
@@ -920,6 +922,9 @@ int main(int argc, char *argv[])
      * isn't a user-level application */
     PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_ALLOCATE);
 
+    /* pickup the verbosity of everything we opened */
+    prte_output_verbose_refresh();
+
     /* we need to loop the event library until the DVM is alive */
     while (prte_event_base_active && !prte_dvm_ready) {
         prte_event_loop(prte_event_base, PRTE_EVLOOP_ONCE);
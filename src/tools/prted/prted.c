@@ -81,6 +81,7 @@
 #include "src/threads/pmix_threads.h"
 #include "src/util/name_fns.h"
 #include "src/util/nidmap.h"
+#include "src/util/output.h"
 #include "src/util/pmix_parse_options.h"
 #include "src/util/proc_info.h"
 #include "src/util/session_dir.h"
@@ -448,6 +449,7 @@ int main(int argc, char *argv[])
     /* setup the primary daemon command receive function */
     PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_DAEMON,
                   PRTE_RML_PERSISTENT, prte_daemon_recv, NULL);
+    prte_stack_trace_init();
 
     /* output a message indicating we are alive, our name, and our pid
      * for debugging purposes
@@ -783,6 +785,9 @@ int main(int argc, char *argv[])
     }
     ret = PRTE_SUCCESS;
 
+    /* pickup the verbosity of everything we opened */
+    prte_output_verbose_refresh();
+
     /* loop the event lib until an exit event is detected */
     while (prte_event_base_active) {
         prte_event_loop(prte_event_base, PRTE_EVLOOP_ONCE);
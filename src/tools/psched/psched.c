@@ -78,6 +78,7 @@
 #include "src/util/pmix_environ.h"
 
 #include "src/util/name_fns.h"
+#include "src/util/output.h"
 #include "src/util/pmix_parse_options.h"
 #include "src/util/proc_info.h"
 #include "src/util/pmix_show_help.h"
@@ -677,6 +678,9 @@ int main(int argc, char *argv[])
     // trigger the state event to read the allocation
     PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_ALLOCATE);
 
+    /* pickup the verbosity of everything we opened */
+    prte_output_verbose_refresh();
+
     /* loop the event lib until an exit event is detected */
     while (prte_event_base_active) {
         prte_event_loop(prte_event_base, PRTE_EVLOOP_ONCE);
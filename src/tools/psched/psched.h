@@ -38,6 +38,7 @@ typedef struct {
     bool initialized;
     pmix_pointer_array_t requests;
     pmix_list_t tools;
+    pmix_list_t pending;  // requests waiting for resources
     pmix_proc_t syscontroller;
     bool controller_connected;
     int verbosity;
@@ -161,6 +162,11 @@ typedef struct {
     prte_sched_state_t state;
     // assigned session info
     uint32_t sessionID;
+    // resources assigned to the session - indices into
+    // the node pool and the number of cpus taken on each
+    int32_t *nodes;
+    int32_t *cpus;
+    size_t nnodes;
 } psched_req_t;
 PRTE_EXPORT PMIX_CLASS_DECLARATION(psched_req_t);
 
@@ -171,6 +177,14 @@ extern void psched_request_init(int fd, short args, void *cbdata);
 extern void psched_request_queue(int fd, short args, void *cbdata);
 extern void psched_session_complete(int fd, short args, void *cbdata);
 
+// resource tracking
+extern void psched_resources_register(void);
+extern int psched_resources_init(void);
+extern void psched_resources_finalize(void);
+extern pmix_status_t psched_resources_match(psched_req_t *req);
+extern void psched_resources_release(psched_req_t *req);
+extern char *psched_resources_nodelist(psched_req_t *req);
+
 
 #define PRTE_ACTIVATE_SCHED_STATE(j, s)                                             \
     do {                                                                            \
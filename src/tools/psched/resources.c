@@ -0,0 +1,655 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Resource index over the DVM node pool.
+ *
+ * Matching a request is a sequence of bitmap operations followed by a
+ * scan for nodes with enough free cpus:
+ *
+ * - "avail" holds the nodes with at least one free cpu and "idle" those
+ *   with all of their cpus free (for exclusive requests)
+ * - each partition (see prte_scheduler_base_partitions) has a bitmap
+ *   of its member nodes
+ * - memory is bucketed by powers of two - bucket b holds the nodes with
+ *   at least 2^b Mbytes, so a memory constraint is a single AND with
+ *   the bucket below the request followed by an exact check on the
+ *   nodes actually chosen
+ * - free cpu counts are kept in a segment tree holding the max and the
+ *   sum of each subtree, so the next node with at least k free cpus is
+ *   found in O(log N) and the total free cpus is always at hand
+ *
+ * All of it is updated in O(log N) per node as sessions are
+ * allocated and released.
+ */
+
+#include "prte_config.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/class/pmix_bitmap.h"
+#include "src/class/pmix_hash_table.h"
+#include "src/hwloc/hwloc-internal.h"
+#include "src/mca/base/pmix_mca_base_var.h"
+#include "src/pmix/pmix-internal.h"
+#include "src/runtime/prte_globals.h"
+#include "src/util/name_fns.h"
+#include "src/util/pmix_argv.h"
+#include "src/util/pmix_output.h"
+
+#include "src/tools/psched/psched.h"
+
+#define PSCHED_RES_MEM_BUCKETS 32
+
+typedef struct {
+    int nnodes;
+    int32_t *total;     // cpus on each node - zero if not schedulable
+    int32_t *free;      // unallocated cpus on each node
+    uint64_t *memory;   // Mbytes on each node - zero if unknown
+    pmix_bitmap_t all;  // schedulable nodes
+    pmix_bitmap_t avail;
+    pmix_bitmap_t idle;
+    pmix_bitmap_t mem[PSCHED_RES_MEM_BUCKETS];
+    int npartitions;
+    char **partnames;
+    pmix_bitmap_t *parts;
+    pmix_bitmap_t cand; // scratch for matching
+    int tsize;          // number of leaves in the tree
+    int32_t *tmax;
+    int64_t *tsum;
+    pmix_hash_table_t names;
+} psched_resources_t;
+
+static psched_resources_t res = {0};
+static bool res_initialized = false;
+static char *partitions = NULL;
+
+/* the selection made for a request */
+typedef struct {
+    size_t n;
+    int32_t *nodes;
+    int32_t *cpus;
+} psched_pick_t;
+
+static inline void bm_init(pmix_bitmap_t *bm, int size)
+{
+    PMIX_CONSTRUCT(bm, pmix_bitmap_t);
+    pmix_bitmap_init(bm, size);
+}
+
+static void tree_update(int idx)
+{
+    int t = res.tsize + idx;
+
+    res.tmax[t] = res.free[idx];
+    res.tsum[t] = res.free[idx];
+    for (t /= 2; 0 < t; t /= 2) {
+        res.tmax[t] = (res.tmax[2 * t] > res.tmax[2 * t + 1]) ? res.tmax[2 * t]
+                                                               : res.tmax[2 * t + 1];
+        res.tsum[t] = res.tsum[2 * t] + res.tsum[2 * t + 1];
+    }
+}
+
+/* return the first node at or after "from" with at least
+ * "need" free cpus, or -1 */
+static int tree_find(int from, int32_t need)
+{
+    int t;
+
+    if (from >= res.nnodes || res.tmax[1] < need) {
+        return -1;
+    }
+    t = res.tsize + from;
+    if (res.tmax[t] >= need) {
+        return from;
+    }
+    /* climb until we find a right sibling that has a candidate */
+    while (1 < t) {
+        if (0 == (t & 1) && res.tmax[t + 1] >= need) {
+            t = t + 1;
+            break;
+        }
+        t /= 2;
+    }
+    if (1 == t) {
+        return -1;
+    }
+    /* descend to the leftmost qualifying leaf */
+    while (t < res.tsize) {
+        t = (res.tmax[2 * t] >= need) ? 2 * t : 2 * t + 1;
+    }
+    t -= res.tsize;
+    return (t < res.nnodes) ? t : -1;
+}
+
+static void set_free(int idx, int32_t nfree)
+{
+    res.free[idx] = nfree;
+    if (0 < nfree) {
+        pmix_bitmap_set_bit(&res.avail, idx);
+    } else {
+        pmix_bitmap_clear_bit(&res.avail, idx);
+    }
+    if (0 < res.total[idx] && nfree == res.total[idx]) {
+        pmix_bitmap_set_bit(&res.idle, idx);
+    } else {
+        pmix_bitmap_clear_bit(&res.idle, idx);
+    }
+    tree_update(idx);
+}
+
+static int mem_bucket(uint64_t mbytes)
+{
+    int b = 0;
+
+    while (b + 1 < PSCHED_RES_MEM_BUCKETS && ((uint64_t) 1 << (b + 1)) <= mbytes) {
+        ++b;
+    }
+    return b;
+}
+
+static int lookup(const char *name)
+{
+    void *val;
+
+    if (PMIX_SUCCESS
+        != pmix_hash_table_get_value_ptr(&res.names, name, strlen(name), &val)) {
+        return -1;
+    }
+    return (int) (intptr_t) val - 1;
+}
+
+static void add_partitions(void)
+{
+    char **plist, **hosts, *cptr;
+    int n, m, idx;
+
+    if (NULL == partitions) {
+        return;
+    }
+    plist = PMIX_ARGV_SPLIT_COMPAT(partitions, ';');
+    res.npartitions = PMIX_ARGV_COUNT_COMPAT(plist);
+    res.parts = (pmix_bitmap_t *) malloc(res.npartitions * sizeof(pmix_bitmap_t));
+    for (n = 0; n < res.npartitions; n++) {
+        bm_init(&res.parts[n], res.nnodes);
+        if (NULL == (cptr = strchr(plist[n], ':'))) {
+            pmix_output(0, "%s scheduler:psched: partition \"%s\" has no node list - ignored",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), plist[n]);
+            PMIX_ARGV_APPEND_NOSIZE_COMPAT(&res.partnames, plist[n]);
+            continue;
+        }
+        *cptr = '\0';
+        ++cptr;
+        PMIX_ARGV_APPEND_NOSIZE_COMPAT(&res.partnames, plist[n]);
+        hosts = PMIX_ARGV_SPLIT_COMPAT(cptr, ',');
+        for (m = 0; NULL != hosts && NULL != hosts[m]; m++) {
+            if (0 <= (idx = lookup(hosts[m]))) {
+                pmix_bitmap_set_bit(&res.parts[n], idx);
+            }
+        }
+        PMIX_ARGV_FREE_COMPAT(hosts);
+    }
+    PMIX_ARGV_FREE_COMPAT(plist);
+}
+
+static void release_index(void)
+{
+    int n;
+
+    free(res.total);
+    free(res.free);
+    free(res.memory);
+    free(res.tmax);
+    free(res.tsum);
+    PMIX_DESTRUCT(&res.all);
+    PMIX_DESTRUCT(&res.avail);
+    PMIX_DESTRUCT(&res.idle);
+    PMIX_DESTRUCT(&res.cand);
+    for (n = 0; n < PSCHED_RES_MEM_BUCKETS; n++) {
+        PMIX_DESTRUCT(&res.mem[n]);
+    }
+    for (n = 0; n < res.npartitions; n++) {
+        PMIX_DESTRUCT(&res.parts[n]);
+    }
+    free(res.parts);
+    PMIX_ARGV_FREE_COMPAT(res.partnames);
+    PMIX_DESTRUCT(&res.names);
+    memset(&res, 0, sizeof(res));
+}
+
+void psched_resources_register(void)
+{
+    partitions = NULL;
+    pmix_mca_base_var_register("prte", "scheduler", "base", "partitions",
+                               "Semicolon-delimited list of partitions, each given as "
+                               "name:node1,node2,... - requests name a partition "
+                               "with the queue attribute",
+                               PMIX_MCA_BASE_VAR_TYPE_STRING,
+                               &partitions);
+}
+
+int psched_resources_init(void)
+{
+    prte_node_t *node;
+    hwloc_obj_t machine;
+    int32_t *used = NULL;
+    int n, b, oldn = 0;
+    uint64_t mem;
+
+    /* preserve the current allocations across a rebuild */
+    if (res_initialized) {
+        oldn = res.nnodes;
+        used = (int32_t *) calloc(oldn, sizeof(int32_t));
+        for (n = 0; n < oldn; n++) {
+            used[n] = res.total[n] - res.free[n];
+        }
+        release_index();
+    }
+    res_initialized = true;
+
+    res.nnodes = prte_node_pool->size;
+    res.total = (int32_t *) calloc(res.nnodes, sizeof(int32_t));
+    res.free = (int32_t *) calloc(res.nnodes, sizeof(int32_t));
+    res.memory = (uint64_t *) calloc(res.nnodes, sizeof(uint64_t));
+    bm_init(&res.all, res.nnodes);
+    bm_init(&res.avail, res.nnodes);
+    bm_init(&res.idle, res.nnodes);
+    bm_init(&res.cand, res.nnodes);
+    for (b = 0; b < PSCHED_RES_MEM_BUCKETS; b++) {
+        bm_init(&res.mem[b], res.nnodes);
+    }
+    for (res.tsize = 1; res.tsize < res.nnodes; res.tsize *= 2) {
+        continue;
+    }
+    res.tmax = (int32_t *) calloc(2 * res.tsize, sizeof(int32_t));
+    res.tsum = (int64_t *) calloc(2 * res.tsize, sizeof(int64_t));
+    PMIX_CONSTRUCT(&res.names, pmix_hash_table_t);
+    pmix_hash_table_init(&res.names, res.nnodes);
+
+    for (n = 0; n < res.nnodes; n++) {
+        node = (prte_node_t *) pmix_pointer_array_get_item(prte_node_pool, n);
+        if (NULL == node || PRTE_FLAG_TEST(node, PRTE_NODE_NON_USABLE)
+            || PRTE_NODE_STATE_DOWN == node->state) {
+            continue;
+        }
+        if (0 < node->slots) {
+            res.total[n] = node->slots;
+        } else if (NULL != node->topology && NULL != node->topology->topo) {
+            res.total[n] = prte_hwloc_base_get_npus(node->topology->topo, false, NULL, NULL);
+        }
+        if (0 == res.total[n]) {
+            continue;
+        }
+        pmix_bitmap_set_bit(&res.all, n);
+        pmix_hash_table_set_value_ptr(&res.names, node->name, strlen(node->name),
+                                      (void *) (intptr_t) (n + 1));
+
+        /* nodes whose memory is not yet known are assumed to satisfy
+         * any memory request */
+        mem = 0;
+        if (NULL != node->topology && NULL != node->topology->topo) {
+            machine = hwloc_get_root_obj(node->topology->topo);
+#if HWLOC_API_VERSION < 0x20000
+            mem = machine->memory.total_memory / (1024 * 1024);
+#else
+            mem = machine->total_memory / (1024 * 1024);
+#endif
+        }
+        res.memory[n] = mem;
+        b = (0 == mem) ? PSCHED_RES_MEM_BUCKETS - 1 : mem_bucket(mem);
+        for (; 0 <= b; b--) {
+            pmix_bitmap_set_bit(&res.mem[b], n);
+        }
+
+        res.free[n] = res.total[n];
+        if (n < oldn) {
+            res.free[n] -= (used[n] < res.total[n]) ? used[n] : res.total[n];
+        }
+        set_free(n, res.free[n]);
+    }
+    free(used);
+
+    add_partitions();
+
+    pmix_output_verbose(2, psched_globals.scheduler_output,
+                        "%s scheduler:psched: indexed %d nodes with %ld cpus in %d partitions",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                        pmix_bitmap_num_set_bits(&res.all, res.all.array_size),
+                        (long) res.tsum[1], res.npartitions);
+    return PRTE_SUCCESS;
+}
+
+void psched_resources_finalize(void)
+{
+    if (res_initialized) {
+        release_index();
+        res_initialized = false;
+    }
+}
+
+static inline bool has_mem(int idx, float memsize)
+{
+    return (0 == res.memory[idx] || (float) res.memory[idx] >= memsize);
+}
+
+/* add a node to the pick, taking "want" cpus or - if zero - all of them */
+static void pick_add(psched_pick_t *pk, int idx, int32_t want, bool now)
+{
+    pk->nodes[pk->n] = idx;
+    if (0 == want) {
+        want = now ? res.free[idx] : res.total[idx];
+    }
+    pk->cpus[pk->n] = want;
+    pk->n++;
+}
+
+static bool picked(psched_pick_t *pk, int idx)
+{
+    size_t n;
+
+    for (n = 0; n < pk->n; n++) {
+        if (pk->nodes[n] == idx) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Select nodes for the request. If "now" is true, select from the free
+ * resources - otherwise check whether the request could be met if the
+ * whole pool were idle. The candidate bitmap must already be filtered.
+ */
+static pmix_status_t select_nodes(psched_req_t *req, pmix_bitmap_t *cand, bool now,
+                                  int32_t *required, int nrequired, int32_t *percpu, int npercpu,
+                                  psched_pick_t *pk)
+{
+    uint64_t nnodes = req->num_nodes, ncpus = 0;
+    int32_t need, cap;
+    int n, idx, w, nwords;
+    uint64_t bits;
+
+    if (0 == nnodes) {
+        nnodes = (0 < npercpu) ? (uint64_t) npercpu : (uint64_t) nrequired;
+    }
+
+    /* cpus wanted on each node - zero means the whole node */
+    if (req->share) {
+        if (0 < nnodes && 0 < req->num_cpus) {
+            need = (int32_t) ((req->num_cpus + nnodes - 1) / nnodes);
+        } else {
+            need = 1;
+        }
+    } else {
+        need = 0;
+    }
+
+    /* the requested nodes come first */
+    for (n = 0; n < nrequired; n++) {
+        idx = required[n];
+        if (picked(pk, idx)) {
+            /* node was listed more than once */
+            continue;
+        }
+        w = (n < npercpu) ? percpu[n] : need;
+        cap = now ? res.free[idx] : res.total[idx];
+        if (!pmix_bitmap_is_set_bit(cand, idx) || cap < ((0 == w) ? 1 : w)
+            || (0 < req->memsize && !has_mem(idx, req->memsize))) {
+            return PMIX_ERR_RESOURCE_BUSY;
+        }
+        if (0 < req->num_cpus && 0 == nnodes && (uint64_t) cap > req->num_cpus - ncpus) {
+            w = (int32_t) (req->num_cpus - ncpus);
+        }
+        pick_add(pk, idx, w, now);
+        ncpus += pk->cpus[pk->n - 1];
+    }
+
+    /* then fill in from the rest of the pool */
+    nwords = cand->array_size;
+    if (now && 0 == npercpu) {
+        /* let the tree skip over the nodes without enough free cpus */
+        idx = tree_find(0, (0 < need) ? need : 1);
+        while (0 <= idx && (pk->n < nnodes || (0 < req->num_cpus && ncpus < req->num_cpus))) {
+            if (pmix_bitmap_is_set_bit(cand, idx) && !picked(pk, idx)
+                && (0 == req->memsize || has_mem(idx, req->memsize))) {
+                w = need;
+                if (req->share && 0 == req->num_nodes && 0 < req->num_cpus) {
+                    /* only a cpu count was given - take what we need */
+                    w = (res.free[idx] < (int32_t) (req->num_cpus - ncpus))
+                            ? res.free[idx] : (int32_t) (req->num_cpus - ncpus);
+                }
+                pick_add(pk, idx, w, now);
+                ncpus += pk->cpus[pk->n - 1];
+            }
+            idx = tree_find(idx + 1, (0 < need) ? need : 1);
+        }
+    } else {
+        for (w = 0; w < nwords; w++) {
+            bits = cand->bitmap[w];
+            while (0 != bits && (pk->n < nnodes || (0 < req->num_cpus && ncpus < req->num_cpus))) {
+                idx = w * 64 + __builtin_ctzll(bits);
+                bits &= bits - 1;
+                if (idx >= res.nnodes || picked(pk, idx)) {
+                    continue;
+                }
+                n = (int) pk->n;
+                cap = now ? res.free[idx] : res.total[idx];
+                need = (n < npercpu) ? percpu[n] : need;
+                if (cap < ((0 == need) ? 1 : need)
+                    || (0 < req->memsize && !has_mem(idx, req->memsize))) {
+                    continue;
+                }
+                pick_add(pk, idx, (req->share && 0 == req->num_nodes && 0 < req->num_cpus)
+                                      ? ((cap < (int32_t) (req->num_cpus - ncpus))
+                                             ? cap : (int32_t) (req->num_cpus - ncpus))
+                                      : need, now);
+                ncpus += pk->cpus[pk->n - 1];
+            }
+        }
+    }
+
+    if (pk->n < nnodes || ncpus < req->num_cpus || 0 == pk->n) {
+        return PMIX_ERR_RESOURCE_BUSY;
+    }
+    return PMIX_SUCCESS;
+}
+
+/* parse a comma-separated list of node names or positive cpu counts.
+ * Unknown node names are dropped if "skip" is set - otherwise they,
+ * and any cpu count that is not positive, fail the parse with n = -1 */
+static int32_t *parse_indices(const char *list, int *n, bool names, bool skip)
+{
+    char **argv, *end;
+    int32_t *out;
+    long val;
+    int m, cnt = 0;
+
+    argv = PMIX_ARGV_SPLIT_COMPAT(list, ',');
+    out = (int32_t *) malloc((PMIX_ARGV_COUNT_COMPAT(argv) + 1) * sizeof(int32_t));
+    for (m = 0; NULL != argv && NULL != argv[m]; m++) {
+        if (names) {
+            out[cnt] = lookup(argv[m]);
+            if (0 > out[cnt] && skip) {
+                continue;
+            }
+        } else {
+            val = strtol(argv[m], &end, 10);
+            out[cnt] = (end == argv[m] || '\0' != *end || 0 >= val || INT32_MAX < val)
+                           ? -1 : (int32_t) val;
+        }
+        if (0 > out[cnt]) {
+            PMIX_ARGV_FREE_COMPAT(argv);
+            free(out);
+            *n = -1;
+            return NULL;
+        }
+        ++cnt;
+    }
+    PMIX_ARGV_FREE_COMPAT(argv);
+    *n = cnt;
+    return out;
+}
+
+pmix_status_t psched_resources_match(psched_req_t *req)
+{
+    int32_t *required = NULL, *percpu = NULL, *excluded = NULL;
+    int nrequired = 0, npercpu = 0, nexcluded = 0, n, part = -1;
+    psched_pick_t pk;
+    pmix_status_t rc;
+    size_t k;
+
+    if (!res_initialized) {
+        return PMIX_ERR_NOT_AVAILABLE;
+    }
+
+    if (NULL != req->queue) {
+        for (n = 0; n < res.npartitions; n++) {
+            if (0 == strcmp(req->queue, res.partnames[n])) {
+                part = n;
+                break;
+            }
+        }
+        if (0 > part) {
+            return PMIX_ERR_BAD_PARAM;
+        }
+    }
+    if (NULL != req->nlist) {
+        /* an unknown required node makes the request unsatisfiable */
+        required = parse_indices(req->nlist, &nrequired, true, false);
+        if (0 > nrequired) {
+            return PMIX_ERR_NOT_FOUND;
+        }
+    }
+    if (NULL != req->exclude) {
+        /* excluding a node we don't have is harmless */
+        excluded = parse_indices(req->exclude, &nexcluded, true, true);
+    }
+    if (NULL != req->ncpulist) {
+        percpu = parse_indices(req->ncpulist, &npercpu, false, false);
+        if (0 > npercpu) {
+            free(required);
+            free(excluded);
+            return PMIX_ERR_BAD_PARAM;
+        }
+    }
+
+    k = req->num_nodes;
+    if (k < (size_t) nrequired) {
+        k = nrequired;
+    }
+    if (k < (size_t) npercpu) {
+        k = npercpu;
+    }
+    if (0 < req->num_cpus && k < req->num_cpus) {
+        k = req->num_cpus;
+    }
+    if ((size_t) res.nnodes < k) {
+        k = res.nnodes;
+    }
+    if (0 == k) {
+        k = 1;
+    }
+    pk.n = 0;
+    pk.nodes = (int32_t *) malloc(k * sizeof(int32_t));
+    pk.cpus = (int32_t *) malloc(k * sizeof(int32_t));
+
+    /* build the candidate set - try the free resources first */
+    pmix_bitmap_copy(&res.cand, req->share ? &res.avail : &res.idle);
+    if (0 <= part) {
+        pmix_bitmap_bitwise_and_inplace(&res.cand, &res.parts[part]);
+    }
+    if (0 < req->memsize) {
+        pmix_bitmap_bitwise_and_inplace(&res.cand, &res.mem[mem_bucket((uint64_t) req->memsize)]);
+    }
+    for (n = 0; n < nexcluded; n++) {
+        pmix_bitmap_clear_bit(&res.cand, excluded[n]);
+    }
+    rc = select_nodes(req, &res.cand, true, required, nrequired, percpu, npercpu, &pk);
+
+    if (PMIX_SUCCESS == rc) {
+        /* take the resources */
+        req->nodes = pk.nodes;
+        req->cpus = pk.cpus;
+        req->nnodes = pk.n;
+        for (k = 0; k < pk.n; k++) {
+            set_free(pk.nodes[k], res.free[pk.nodes[k]] - pk.cpus[k]);
+        }
+        pk.nodes = NULL;
+        pk.cpus = NULL;
+    } else {
+        /* see if the request could ever be met by this pool */
+        pk.n = 0;
+        pmix_bitmap_copy(&res.cand, &res.all);
+        if (0 <= part) {
+            pmix_bitmap_bitwise_and_inplace(&res.cand, &res.parts[part]);
+        }
+        if (0 < req->memsize) {
+            pmix_bitmap_bitwise_and_inplace(&res.cand,
+                                            &res.mem[mem_bucket((uint64_t) req->memsize)]);
+        }
+        for (n = 0; n < nexcluded; n++) {
+            pmix_bitmap_clear_bit(&res.cand, excluded[n]);
+        }
+        if (PMIX_SUCCESS != select_nodes(req, &res.cand, false, required, nrequired, percpu,
+                                         npercpu, &pk)) {
+            rc = PMIX_ERR_OUT_OF_RESOURCE;
+        }
+    }
+
+    free(pk.nodes);
+    free(pk.cpus);
+    free(required);
+    free(excluded);
+    free(percpu);
+    return rc;
+}
+
+void psched_resources_release(psched_req_t *req)
+{
+    size_t n;
+    int idx;
+    int32_t nfree;
+
+    if (!res_initialized) {
+        return;
+    }
+    for (n = 0; n < req->nnodes; n++) {
+        idx = req->nodes[n];
+        if (idx < res.nnodes && 0 < res.total[idx]) {
+            nfree = res.free[idx] + req->cpus[n];
+            set_free(idx, (nfree < res.total[idx]) ? nfree : res.total[idx]);
+        }
+    }
+    free(req->nodes);
+    free(req->cpus);
+    req->nodes = NULL;
+    req->cpus = NULL;
+    req->nnodes = 0;
+}
+
+char *psched_resources_nodelist(psched_req_t *req)
+{
+    char **names = NULL, *list;
+    prte_node_t *node;
+    size_t n;
+
+    for (n = 0; n < req->nnodes; n++) {
+        node = (prte_node_t *) pmix_pointer_array_get_item(prte_node_pool, req->nodes[n]);
+        if (NULL != node) {
+            PMIX_ARGV_APPEND_NOSIZE_COMPAT(&names, node->name);
+        }
+    }
+    if (NULL == names) {
+        return NULL;
+    }
+    list = PMIX_ARGV_JOIN_COMPAT(names, ',');
+    PMIX_ARGV_FREE_COMPAT(names);
+    return list;
+}
@@ -22,6 +22,7 @@
 
 #include "src/pmix/pmix-internal.h"
 #include "src/mca/base/pmix_mca_base_var.h"
+#include "src/prted/pmix/pmix_server_internal.h"
 
 #include "src/tools/psched/psched.h"
 
@@ -41,6 +42,7 @@ void psched_scheduler_init(void)
         PMIX_DESTRUCT(&lds);
         pmix_output_set_verbosity(psched_globals.scheduler_output, sched_base_verbose);
     }
+    psched_resources_register();
 
     pmix_output_verbose(2, psched_globals.scheduler_output,
                         "%s scheduler:psched: initialize",
@@ -50,9 +52,84 @@ void psched_scheduler_init(void)
 
 void psched_scheduler_finalize(void)
 {
+    PMIX_LIST_DESTRUCT(&psched_globals.pending);
+    psched_resources_finalize();
     return;
 }
 
+static void qrel(void *cbdata)
+{
+    prte_pmix_server_op_caddy_t *cd = (prte_pmix_server_op_caddy_t *) cbdata;
+    if (NULL != cd->info) {
+        PMIX_INFO_FREE(cd->info, cd->ninfo);
+    }
+    PMIX_RELEASE(cd);
+}
+
+/* try to assign resources to the request. Returns PMIX_SUCCESS if
+ * the request was either allocated or failed and has been answered,
+ * and PMIX_ERR_RESOURCE_BUSY if it must wait for resources to be
+ * released */
+static pmix_status_t allocate(psched_req_t *req)
+{
+    prte_pmix_server_op_caddy_t *rcd;
+    pmix_status_t rc;
+    char *nodelist;
+    int idx;
+
+    rc = psched_resources_match(req);
+    if (PMIX_ERR_RESOURCE_BUSY == rc) {
+        return rc;
+    }
+    if (PMIX_SUCCESS != rc) {
+        pmix_output_verbose(2, psched_globals.scheduler_output,
+                            "%s scheduler:psched: request %s cannot be met: %s",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                            (NULL == req->alloc_refid) ? "NO REFID" : req->alloc_refid,
+                            PMIx_Error_string(rc));
+        if (NULL != req->cbfunc) {
+            req->cbfunc(rc, NULL, 0, req->cbdata, NULL, NULL);
+        }
+        PMIX_RELEASE(req);
+        return PMIX_SUCCESS;
+    }
+
+    // track the session
+    idx = pmix_pointer_array_add(&psched_globals.requests, req);
+    if (0 > idx) {
+        psched_resources_release(req);
+        if (NULL != req->cbfunc) {
+            req->cbfunc(PMIX_ERR_OUT_OF_RESOURCE, NULL, 0, req->cbdata, NULL, NULL);
+        }
+        PMIX_RELEASE(req);
+        return PMIX_SUCCESS;
+    }
+    req->sessionID = idx;
+    nodelist = psched_resources_nodelist(req);
+
+    pmix_output_verbose(2, psched_globals.scheduler_output,
+                        "%s scheduler:psched: session %u assigned nodes %s",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), req->sessionID,
+                        (NULL == nodelist) ? "NONE" : nodelist);
+
+    if (NULL != req->cbfunc) {
+        rcd = PMIX_NEW(prte_pmix_server_op_caddy_t);
+        rcd->ninfo = (NULL == nodelist) ? 1 : 2;
+        PMIX_INFO_CREATE(rcd->info, rcd->ninfo);
+        PMIX_INFO_LOAD(&rcd->info[0], PMIX_SESSION_ID, &req->sessionID, PMIX_UINT32);
+        if (NULL != nodelist) {
+            PMIX_INFO_LOAD(&rcd->info[1], PMIX_ALLOC_NODE_LIST, nodelist, PMIX_STRING);
+        }
+        req->cbfunc(PMIX_SUCCESS, rcd->info, rcd->ninfo, req->cbdata, qrel, rcd);
+        // the requestor has been answered
+        req->cbfunc = NULL;
+    }
+    if (NULL != nodelist) {
+        free(nodelist);
+    }
+    return PMIX_SUCCESS;
+}
+
 void psched_request_init(int fd, short args, void *cbdata)
 {
     psched_req_t *req = (psched_req_t*)cbdata;
@@ -152,6 +229,8 @@ void psched_request_init(int fd, short args, void *cbdata)
         // can be told if we are accepting the request
         if (NULL != req->cbfunc) {
             req->cbfunc(rcerr, NULL, 0, req->cbdata, NULL, NULL);
+            // the requestor has been answered
+            req->cbfunc = NULL;
         }
         if (PMIX_SUCCESS == rcerr) {
             // continue to next state
@@ -183,21 +262,53 @@ void psched_request_queue(int fd, short args, void *cbdata)
                         "%s scheduler:psched: queue request",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
 
-    // need to reply to requestor so they don't hang
-    if (NULL != req->cbfunc) {
-        req->cbfunc(PMIX_ERR_NOT_SUPPORTED, NULL, 0, req->cbdata, NULL, NULL);
+    // requests are served in order, so don't let this one
+    // jump ahead of anyone already waiting
+    if (0 < pmix_list_get_size(&psched_globals.pending) ||
+        PMIX_ERR_RESOURCE_BUSY == allocate(req)) {
+        pmix_output_verbose(2, psched_globals.scheduler_output,
+                            "%s scheduler:psched: request %s waiting for resources",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                            (NULL == req->alloc_refid) ? "NO REFID" : req->alloc_refid);
+        pmix_list_append(&psched_globals.pending, &req->super);
     }
-    // cannot continue processing the request
-    PMIX_RELEASE(req);
-
 }
 
 void psched_session_complete(int fd, short args, void *cbdata)
 {
     psched_req_t *req = (psched_req_t*)cbdata;
-    PRTE_HIDE_UNUSED_PARAMS(fd, args, req);
+    psched_req_t *session, *pending, *next;
+    pmix_status_t rc = PMIX_SUCCESS;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args);
 
     pmix_output_verbose(2, psched_globals.output,
                         "%s scheduler:psched: session complete",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
+
+    session = (psched_req_t *) pmix_pointer_array_get_item(&psched_globals.requests,
+                                                           req->sessionID);
+    if (NULL == session) {
+        rc = PMIX_ERR_NOT_FOUND;
+    } else {
+        pmix_pointer_array_set_item(&psched_globals.requests, req->sessionID, NULL);
+        psched_resources_release(session);
+        PMIX_RELEASE(session);
+    }
+    if (NULL != req->cbfunc) {
+        req->cbfunc(rc, NULL, 0, req->cbdata, NULL, NULL);
+    }
+    PMIX_RELEASE(req);
+    if (PMIX_SUCCESS != rc) {
+        return;
+    }
+
+    // see who can now be served - stop at the first request that
+    // still has to wait so later arrivals cannot starve it
+    PMIX_LIST_FOREACH_SAFE(pending, next, &psched_globals.pending, psched_req_t) {
+        pmix_list_remove_item(&psched_globals.pending, &pending->super);
+        if (PMIX_ERR_RESOURCE_BUSY == allocate(pending)) {
+            pmix_list_prepend(&psched_globals.pending, &pending->super);
+            break;
+        }
+    }
 }
@@ -99,6 +99,7 @@ psched_globals_t psched_globals = {
     .initialized = false,
     .requests = PMIX_POINTER_ARRAY_STATIC_INIT,
     .tools = PMIX_LIST_STATIC_INIT,
+    .pending = PMIX_LIST_STATIC_INIT,
     .syscontroller = PMIX_PROC_STATIC_INIT,
     .controller_connected = false,
     .verbosity = -1,
@@ -311,6 +312,7 @@ int psched_server_init(pmix_cli_result_t *results)
     PMIX_CONSTRUCT(&psched_globals.requests, pmix_pointer_array_t);
     pmix_pointer_array_init(&psched_globals.requests, 128, INT_MAX, 2);
     PMIX_CONSTRUCT(&psched_globals.tools, pmix_list_t);
+    PMIX_CONSTRUCT(&psched_globals.pending, pmix_list_t);
     psched_globals.syscontroller = *PRTE_NAME_INVALID;
 
     pmix_output_verbose(2, prte_pmix_server_globals.output,
@@ -193,6 +193,8 @@ static void alloc_complete(int fd, short args, void *cbdata)
     prte_state_caddy_t *caddy = (prte_state_caddy_t *) cbdata;
     PRTE_HIDE_UNUSED_PARAMS(fd, args);
 
+    // index the node pool for matching allocation requests
+    psched_resources_init();
     PMIX_RELEASE(caddy);
 }
 
@@ -332,6 +334,9 @@ static void req_con(psched_req_t *p)
     p->begintime = NULL;
     p->state = PSCHED_STATE_UNDEF;
     p->sessionID = UINT32_MAX;
+    p->nodes = NULL;
+    p->cpus = NULL;
+    p->nnodes = 0;
 }
 static void req_des(psched_req_t *p)
 {
@@ -374,6 +379,12 @@ static void req_des(psched_req_t *p)
     if (NULL != p->begintime) {
         free(p->begintime);
     }
+    if (NULL != p->nodes) {
+        free(p->nodes);
+    }
+    if (NULL != p->cpus) {
+        free(p->cpus);
+    }
 }
 PMIX_CLASS_INSTANCE(psched_req_t,
                     pmix_list_item_t,
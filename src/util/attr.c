@@ -505,6 +505,10 @@ const char *prte_attr_key_to_str(prte_attribute_key_t key)
             return "ALLOC ID";
         case PRTE_JOB_REF_ID:
             return "ALLOC REF ID";
+        case PRTE_JOB_TIMING_START:
+            return "JOB-TIMING-START";
+        case PRTE_JOB_TIMING_LAST:
+            return "JOB-TIMING-LAST";
 
         case PRTE_PROC_NOBARRIER:
             return "PROC-NOBARRIER";
@@ -133,6 +133,43 @@ static inline unsigned int prte_uicrc(const void *source, size_t crclen)
     return prte_uicrc_partial(source, crclen, CRC_INITIAL_REGISTER);
 }
 
+/*
+ * CRC32C (Castagnoli) Support
+ *
+ * Uses the CRC32 instruction (SSE4.2 or ARMv8) when available and a
+ * slicing-by-8 table otherwise - all paths produce the same value. The
+ * partial functions carry the raw CRC register so a checksum can be
+ * accumulated over several fragments, starting from
+ * PRTE_CRC32C_INITIAL; the finished checksum is its complement.
+ */
+
+#define PRTE_CRC32C_INITIAL ((uint32_t) 0xffffffff)
+
+PRTE_EXPORT void prte_crc32c_init(void);
+
+/* true if the hardware path is available and selected */
+PRTE_EXPORT bool prte_crc32c_hw_available(void);
+
+/* force the table path (e.g., for comparison) or re-enable the hardware one */
+PRTE_EXPORT void prte_crc32c_use_hw(bool enable);
+
+PRTE_EXPORT uint32_t prte_crc32c_partial(const void *source, size_t crclen, uint32_t partial_crc);
+
+/* copy copylen bytes from source to destination while computing
+ * the CRC over them in the same pass */
+PRTE_EXPORT uint32_t prte_bcopy_crc32c_partial(const void *source, void *destination,
+                                               size_t copylen, uint32_t partial_crc);
+
+static inline uint32_t prte_crc32c(const void *source, size_t crclen)
+{
+    return ~prte_crc32c_partial(source, crclen, PRTE_CRC32C_INITIAL);
+}
+
+static inline uint32_t prte_bcopy_crc32c(const void *source, void *destination, size_t copylen)
+{
+    return ~prte_bcopy_crc32c_partial(source, destination, copylen, PRTE_CRC32C_INITIAL);
+}
+
 END_C_DECLS
 
 #endif
@@ -30,9 +30,11 @@
 #    include <unistd.h>
 #endif
 #include <errno.h>
+#include <limits.h>
 #include <string.h>
 #include <sys/stat.h>
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
 #include "src/mca/base/pmix_base.h"
 #include "src/mca/mca.h"
@@ -41,6 +43,7 @@
 #include "src/util/pmix_if.h"
 #include "src/util/pmix_net.h"
 #include "src/util/pmix_output.h"
+#include "src/util/pmix_printf.h"
 
 #include "src/mca/errmgr/errmgr.h"
 #include "src/mca/ras/base/base.h"
@@ -54,10 +57,51 @@
 
 static const char *cur_hostfile_name = NULL;
 
+/* max number of hosts a single range line may expand to */
+#define PRTE_HOSTFILE_MAX_RANGE 1000000
+
+/* parsed hostfiles, keyed by path and parse mode, kept until the file
+ * changes so that repeated jobs naming the same file skip the parse.
+ * The list is kept in least-recently-used order and holds at most
+ * PRTE_HOSTFILE_CACHE_MAX entries */
+#define PRTE_HOSTFILE_CACHE_MAX 16
+
+typedef struct {
+    pmix_list_item_t super;
+    char *path;
+    bool keep_all;
+    dev_t dev;
+    ino_t ino;
+    off_t size;
+    time_t mtime;
+    long mtime_nsec;
+    pmix_list_t updates;
+    pmix_list_t exclude;
+} hostfile_cache_t;
+static void hc_con(hostfile_cache_t *p)
+{
+    p->path = NULL;
+    PMIX_CONSTRUCT(&p->updates, pmix_list_t);
+    PMIX_CONSTRUCT(&p->exclude, pmix_list_t);
+}
+static void hc_des(hostfile_cache_t *p)
+{
+    if (NULL != p->path) {
+        free(p->path);
+    }
+    PMIX_LIST_DESTRUCT(&p->updates);
+    PMIX_LIST_DESTRUCT(&p->exclude);
+}
+static PMIX_CLASS_INSTANCE(hostfile_cache_t, pmix_list_item_t, hc_con, hc_des);
+
+static pmix_list_t hostfile_cache;
+static bool hostfile_cache_init = false;
+
 static void hostfile_parse_error(int token)
 {
     switch (token) {
     case PRTE_HOSTFILE_STRING:
+    case PRTE_HOSTFILE_RANGE:
         pmix_show_help("help-hostfile.txt", "parse_error_string", true, cur_hostfile_name,
                        prte_util_hostfile_line, token, prte_util_hostfile_value.sval);
         break;
@@ -102,124 +146,175 @@ static char *hostfile_parse_string(void)
     return strdup(prte_util_hostfile_value.sval);
 }
 
-static int hostfile_parse_line(int token, pmix_list_t *updates,
-                               pmix_list_t *exclude, bool keep_all)
+static void hostfile_index_node(pmix_hash_table_t *index, prte_node_t *node)
 {
-    int rc;
-    prte_node_t *node;
-    bool got_max = false;
-    char *value;
-    char **argv;
-    char *node_name = NULL;
-    char *username = NULL;
-    int cnt;
-    int number_of_slots = 0;
-    char buff[64];
-    char *alias = NULL;
-
-    if (PRTE_HOSTFILE_STRING == token || PRTE_HOSTFILE_HOSTNAME == token ||
-        PRTE_HOSTFILE_INT == token || PRTE_HOSTFILE_IPV4 == token ||
-        PRTE_HOSTFILE_IPV6 == token) {
+    void *ptr;
+    int n;
 
-        if (PRTE_HOSTFILE_INT == token) {
-            snprintf(buff, 64, "%d", prte_util_hostfile_value.ival);
-            value = buff;
-        } else {
-            value = prte_util_hostfile_value.sval;
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(index, node->name,
+                                                      strlen(node->name), &ptr)) {
+        pmix_hash_table_set_value_ptr(index, node->name, strlen(node->name), node);
+    }
+    if (NULL != node->aliases) {
+        for (n = 0; NULL != node->aliases[n]; n++) {
+            if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(index, node->aliases[n],
+                                                              strlen(node->aliases[n]), &ptr)) {
+                pmix_hash_table_set_value_ptr(index, node->aliases[n],
+                                              strlen(node->aliases[n]), node);
+            }
         }
-        argv = PMIX_ARGV_SPLIT_COMPAT(value, '@');
+    }
+}
 
-        cnt = PMIX_ARGV_COUNT_COMPAT(argv);
-        if (1 == cnt) {
-            node_name = strdup(argv[0]);
-        } else if (2 == cnt) {
-            username = strdup(argv[0]);
-            node_name = strdup(argv[1]);
-        } else {
-            pmix_output(0, "WARNING: Unhandled user@host-combination\n"); /* XXX */
+static void hostfile_unindex_key(pmix_hash_table_t *index, prte_node_t *node,
+                                 const char *key)
+{
+    void *ptr;
+
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(index, key, strlen(key), &ptr)
+        && ptr == (void *) node) {
+        pmix_hash_table_remove_value_ptr(index, key, strlen(key));
+    }
+}
+
+static void hostfile_unindex_node(pmix_hash_table_t *index, prte_node_t *node)
+{
+    int n;
+
+    hostfile_unindex_key(index, node, node->name);
+    if (NULL != node->aliases) {
+        for (n = 0; NULL != node->aliases[n]; n++) {
+            hostfile_unindex_key(index, node, node->aliases[n]);
         }
-        PMIX_ARGV_FREE_COMPAT(argv);
+    }
+}
 
-        // Strip off the FQDN if present, ignore IP addresses
-        if (!pmix_net_isaddr(node_name)) {
-            char *ptr;
-            alias = strdup(node_name);
-            if (NULL != (ptr = strchr(alias, '.'))) {
-                *ptr = '\0';
+/* find an indexed node that prte_nptr_match would consider
+ * the same as the given one */
+static prte_node_t *hostfile_find_node(pmix_hash_table_t *index, prte_node_t *node)
+{
+    void *ptr;
+    int n;
+
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(index, node->name,
+                                                      strlen(node->name), &ptr)) {
+        return (prte_node_t *) ptr;
+    }
+    if (NULL != node->aliases) {
+        for (n = 0; NULL != node->aliases[n]; n++) {
+            if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(index, node->aliases[n],
+                                                              strlen(node->aliases[n]), &ptr)) {
+                return (prte_node_t *) ptr;
             }
         }
+    }
+    return NULL;
+}
 
-        /* if the first letter of the name is '^', then this is a node
-         * to be excluded. Remove the ^ character so the nodename is
-         * usable, and put it on the exclude list
-         */
-        if ('^' == node_name[0]) {
-            int i, len;
-            len = strlen(node_name);
-            for (i = 1; i < len; i++) {
-                node_name[i - 1] = node_name[i];
-            }
-            node_name[len - 1] = '\0'; /* truncate */
+static void hostfile_index_list(pmix_hash_table_t *index, pmix_list_t *nodes)
+{
+    prte_node_t *node;
 
-            PMIX_OUTPUT_VERBOSE((3, prte_ras_base_framework.framework_output,
-                                 "%s hostfile: node %s is being excluded",
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), node_name));
+    pmix_hash_table_init(index, 2 * pmix_list_get_size(nodes) + 32);
+    PMIX_LIST_FOREACH(node, nodes, prte_node_t) {
+        hostfile_index_node(index, node);
+    }
+}
 
-            /* see if this is another name for us */
-            if (prte_check_host_is_local(node_name)) {
-                /* Nodename has been allocated, that is for sure */
-                free(node_name);
-                node_name = strdup(prte_process_info.nodename);
-            }
+/* the include and exclude lists being built by the current parse are
+ * indexed by name and alias so that each line is checked against the
+ * prior entries without rescanning the lists */
+static pmix_hash_table_t *cur_include = NULL;
+static pmix_hash_table_t *cur_exclude = NULL;
 
-            /* Do we need to make a new node object?  First check to see
-               if it's already in the exclude list */
-            node = prte_node_match(exclude, node_name);
-            if (NULL == node) {
-                node = PMIX_NEW(prte_node_t);
-                if (prte_keep_fqdn_hostnames || NULL == alias) {
-                    node->name = strdup(node_name);
-                } else {
-                    node->name = strdup(alias);
-                    node->rawname = strdup(node_name);
-                }
-                if (NULL != username) {
-                    prte_set_attribute(&node->attributes, PRTE_NODE_USERNAME, PRTE_ATTR_LOCAL,
-                                       username, PMIX_STRING);
-                }
-                if (NULL != alias && 0 != strcmp(alias, node->name)) {
-                    // new node object, so alias must be unique
-                    PMIX_ARGV_APPEND_NOSIZE_COMPAT(&node->aliases, alias);
-                }
-                pmix_list_append(exclude, &node->super);
-            } else {
-                /* the node name may not match the prior entry, so ensure we
-                 * keep it if necessary */
-                if (0 != strcmp(node_name, node->name)) {
-                    PMIX_ARGV_APPEND_UNIQUE_COMPAT(&node->aliases, node_name);
-                }
-                free(node_name);
-                if (NULL != alias && 0 != strcmp(alias, node->name)) {
-                    PMIX_ARGV_APPEND_UNIQUE_COMPAT(&node->aliases, alias);
-                }
-            }
-            if (NULL != alias) {
-                free(alias);
-            }
-            return PRTE_SUCCESS;
+static prte_node_t *hostfile_match(pmix_hash_table_t *index, const char *name)
+{
+    void *ptr;
+
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(index, name, strlen(name), &ptr)) {
+        return (prte_node_t *) ptr;
+    }
+    /* does the name refer to me? */
+    if (prte_check_host_is_local(name) &&
+        PMIX_SUCCESS == pmix_hash_table_get_value_ptr(index, prte_process_info.nodename,
+                                                      strlen(prte_process_info.nodename),
+                                                      &ptr)) {
+        return (prte_node_t *) ptr;
+    }
+    return NULL;
+}
+
+/**
+ * Add the host given by value to the include list - or to the exclude
+ * list if it starts with '^'. Returns the included node in *nodeout,
+ * or NULL if the host was excluded.
+ */
+static int hostfile_add_host(const char *value, pmix_list_t *updates, pmix_list_t *exclude,
+                             bool keep_all, prte_node_t **nodeout, bool *created)
+{
+    prte_node_t *node;
+    char **argv;
+    char *node_name = NULL;
+    char *username = NULL;
+    char *alias = NULL;
+    int cnt;
+
+    *nodeout = NULL;
+    if (NULL != created) {
+        *created = false;
+    }
+
+    argv = PMIX_ARGV_SPLIT_COMPAT(value, '@');
+
+    cnt = PMIX_ARGV_COUNT_COMPAT(argv);
+    if (1 == cnt) {
+        node_name = strdup(argv[0]);
+    } else if (2 == cnt) {
+        username = strdup(argv[0]);
+        node_name = strdup(argv[1]);
+    } else {
+        pmix_output(0, "WARNING: Unhandled user@host-combination\n"); /* XXX */
+        PMIX_ARGV_FREE_COMPAT(argv);
+        return PRTE_ERROR;
+    }
+    PMIX_ARGV_FREE_COMPAT(argv);
+
+    // Strip off the FQDN if present, ignore IP addresses
+    if (!pmix_net_isaddr(node_name)) {
+        char *ptr;
+        alias = strdup(node_name);
+        if (NULL != (ptr = strchr(alias, '.'))) {
+            *ptr = '\0';
         }
+    }
 
-        /* this is not a node to be excluded, so we need to process it and
-         * add it to the "include" list.
-         */
+    /* if the first letter of the name is '^', then this is a node
+     * to be excluded. Remove the ^ character so the nodename is
+     * usable, and put it on the exclude list
+     */
+    if ('^' == node_name[0]) {
+        int i, len;
+        len = strlen(node_name);
+        for (i = 1; i < len; i++) {
+            node_name[i - 1] = node_name[i];
+        }
+        node_name[len - 1] = '\0'; /* truncate */
 
         PMIX_OUTPUT_VERBOSE((3, prte_ras_base_framework.framework_output,
-                             "%s hostfile: node %s is being included - keep all is %s",
-                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), node_name,
-                             keep_all ? "TRUE" : "FALSE"));
+                             "%s hostfile: node %s is being excluded",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), node_name));
 
-        /* Do we need to make a new node object? */
-        if (keep_all || NULL == (node = prte_node_match(updates, node_name))) {
+        /* see if this is another name for us */
+        if (prte_check_host_is_local(node_name)) {
+            /* Nodename has been allocated, that is for sure */
+            free(node_name);
+            node_name = strdup(prte_process_info.nodename);
+        }
+
+        /* Do we need to make a new node object?  First check to see
+           if it's already in the exclude list */
+        node = hostfile_match(cur_exclude, node_name);
+        if (NULL == node) {
             node = PMIX_NEW(prte_node_t);
             if (prte_keep_fqdn_hostnames || NULL == alias) {
                 node->name = strdup(node_name);
@@ -227,142 +322,96 @@ static int hostfile_parse_line(int token, pmix_list_t *updates,
                 node->name = strdup(alias);
                 node->rawname = strdup(node_name);
             }
-            node->slots = 1;
             if (NULL != username) {
-                prte_set_attribute(&node->attributes, PRTE_NODE_USERNAME, PRTE_ATTR_LOCAL, username,
-                                   PMIX_STRING);
+                prte_set_attribute(&node->attributes, PRTE_NODE_USERNAME, PRTE_ATTR_LOCAL,
+                                   username, PMIX_STRING);
             }
             if (NULL != alias && 0 != strcmp(alias, node->name)) {
                 // new node object, so alias must be unique
                 PMIX_ARGV_APPEND_NOSIZE_COMPAT(&node->aliases, alias);
             }
-            pmix_list_append(updates, &node->super);
+            pmix_list_append(exclude, &node->super);
         } else {
-            /* this node was already found once - add a slot and mark slots as "given" */
-            node->slots++;
-            PRTE_FLAG_SET(node, PRTE_NODE_FLAG_SLOTS_GIVEN);
             /* the node name may not match the prior entry, so ensure we
              * keep it if necessary */
             if (0 != strcmp(node_name, node->name)) {
                 PMIX_ARGV_APPEND_UNIQUE_COMPAT(&node->aliases, node_name);
             }
-            free(node_name);
             if (NULL != alias && 0 != strcmp(alias, node->name)) {
                 PMIX_ARGV_APPEND_UNIQUE_COMPAT(&node->aliases, alias);
             }
         }
-    } else if (PRTE_HOSTFILE_RELATIVE == token) {
-        /* store this for later processing */
+        hostfile_index_node(cur_exclude, node);
+        goto cleanup;
+    }
+
+    /* this is not a node to be excluded, so we need to process it and
+     * add it to the "include" list.
+     */
+
+    PMIX_OUTPUT_VERBOSE((3, prte_ras_base_framework.framework_output,
+                         "%s hostfile: node %s is being included - keep all is %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), node_name,
+                         keep_all ? "TRUE" : "FALSE"));
+
+    /* Do we need to make a new node object? */
+    if (keep_all || NULL == (node = hostfile_match(cur_include, node_name))) {
         node = PMIX_NEW(prte_node_t);
-        // Strip off the FQDN if present, ignore IP addresses
-        if (!pmix_net_isaddr(prte_util_hostfile_value.sval)) {
-            char *ptr;
-            alias = strdup(prte_util_hostfile_value.sval);
-            if (NULL != (ptr = strchr(alias, '.'))) {
-                *ptr = '\0';
-            } else {
-                free(alias);
-                alias = NULL;
-            }
-        }
         if (prte_keep_fqdn_hostnames || NULL == alias) {
-            node->name = strdup(prte_util_hostfile_value.sval);
+            node->name = strdup(node_name);
         } else {
             node->name = strdup(alias);
-            node->rawname = strdup(prte_util_hostfile_value.sval);
+            node->rawname = strdup(node_name);
+        }
+        node->slots = 1;
+        if (NULL != username) {
+            prte_set_attribute(&node->attributes, PRTE_NODE_USERNAME, PRTE_ATTR_LOCAL, username,
+                               PMIX_STRING);
         }
         if (NULL != alias && 0 != strcmp(alias, node->name)) {
             // new node object, so alias must be unique
             PMIX_ARGV_APPEND_NOSIZE_COMPAT(&node->aliases, alias);
-            free(alias);
         }
         pmix_list_append(updates, &node->super);
-    } else if (PRTE_HOSTFILE_RANK == token) {
-        /* we can ignore the rank, but we need to extract the node name. we
-         * first need to shift over to the other side of the equal sign as
-         * this is where the node name will be
-         */
-        while (!prte_util_hostfile_done && PRTE_HOSTFILE_EQUAL != token) {
-            token = prte_util_hostfile_lex();
-        }
-        if (prte_util_hostfile_done) {
-            /* bad syntax somewhere */
-            return PRTE_ERROR;
-        }
-        /* next position should be the node name */
-        token = prte_util_hostfile_lex();
-        if (PRTE_HOSTFILE_INT == token) {
-            snprintf(buff, 64, "%d", prte_util_hostfile_value.ival);
-            value = buff;
-        } else {
-            value = prte_util_hostfile_value.sval;
-        }
-
-        argv = PMIX_ARGV_SPLIT_COMPAT(value, '@');
-
-        cnt = PMIX_ARGV_COUNT_COMPAT(argv);
-        if (1 == cnt) {
-            node_name = strdup(argv[0]);
-        } else if (2 == cnt) {
-            username = strdup(argv[0]);
-            node_name = strdup(argv[1]);
-        } else {
-            pmix_output(0, "WARNING: Unhandled user@host-combination\n"); /* XXX */
-        }
-        PMIX_ARGV_FREE_COMPAT(argv);
-
-        // Strip off the FQDN if present, ignore IP addresses
-        if (!prte_keep_fqdn_hostnames && !pmix_net_isaddr(node_name)) {
-            char *ptr;
-            alias = strdup(node_name);
-            if (NULL != (ptr = strchr(alias, '.'))) {
-                *ptr = '\0';
-            }
+        if (NULL != created) {
+            *created = true;
         }
-
-        /* Do we need to make a new node object? */
-        if (NULL == (node = prte_node_match(updates, node_name))) {
-            node = PMIX_NEW(prte_node_t);
-            node->name = strdup(node_name);
-            node->slots = 1;
-            if (NULL != username) {
-                prte_set_attribute(&node->attributes, PRTE_NODE_USERNAME,
-                                   PRTE_ATTR_LOCAL, username, PMIX_STRING);
-            }
-            pmix_list_append(updates, &node->super);
-        } else {
-            /* add a slot */
-            node->slots++;
-            /* the node name may not match the prior entry, so ensure we
-             * keep it if necessary */
-            if (0 != strcmp(node_name, node->name)) {
-                PMIX_ARGV_APPEND_UNIQUE_COMPAT(&node->aliases, node_name);
-            }
+    } else {
+        /* this node was already found once - add a slot and mark slots as "given" */
+        node->slots++;
+        PRTE_FLAG_SET(node, PRTE_NODE_FLAG_SLOTS_GIVEN);
+        /* the node name may not match the prior entry, so ensure we
+         * keep it if necessary */
+        if (0 != strcmp(node_name, node->name)) {
+            PMIX_ARGV_APPEND_UNIQUE_COMPAT(&node->aliases, node_name);
         }
-        if (NULL != alias) {
+        if (NULL != alias && 0 != strcmp(alias, node->name)) {
             PMIX_ARGV_APPEND_UNIQUE_COMPAT(&node->aliases, alias);
-            free(alias);
-            node->rawname = strdup(node_name);
-        }
-        PMIX_OUTPUT_VERBOSE((1, prte_ras_base_framework.framework_output,
-                             "%s hostfile: node %s slots %d nodes-given %s",
-                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), node->name, node->slots,
-                             PRTE_FLAG_TEST(node, PRTE_NODE_FLAG_SLOTS_GIVEN) ? "TRUE" : "FALSE"));
-        /* mark the slots as "given" since we take them as being the
-         * number specified via the rankfile
-         */
-        PRTE_FLAG_SET(node, PRTE_NODE_FLAG_SLOTS_GIVEN);
-        /* skip to end of line */
-        while (!prte_util_hostfile_done && PRTE_HOSTFILE_NEWLINE != token) {
-            token = prte_util_hostfile_lex();
         }
-        free(node_name);
-        return PRTE_SUCCESS;
-    } else {
-        hostfile_parse_error(token);
-        return PRTE_ERROR;
     }
-    free(username);
+    hostfile_index_node(cur_include, node);
+    *nodeout = node;
+
+cleanup:
+    free(node_name);
+    if (NULL != username) {
+        free(username);
+    }
+    if (NULL != alias) {
+        free(alias);
+    }
+    return PRTE_SUCCESS;
+}
+
+/**
+ * Parse the options following a host on the current line
+ */
+static int hostfile_parse_attrs(prte_node_t *node, pmix_list_t *updates)
+{
+    int rc, token;
+    bool got_max = false;
+    char *username;
+    int number_of_slots = 0;
 
     while (!prte_util_hostfile_done) {
         token = prte_util_hostfile_lex();
@@ -474,6 +523,421 @@ done:
     return PRTE_SUCCESS;
 }
 
+/**
+ * Expand a host range such as "node[0001-0004,0010]" into the
+ * individual names. Each value is zero-padded to the width of the
+ * lower bound it came from, and further bracketed ranges in the
+ * remainder of the name are expanded recursively. A typo in a
+ * range could otherwise expand to billions of names, so the total
+ * is limited to PRTE_HOSTFILE_MAX_RANGE. The names are kept in a
+ * NULL-terminated array of *count entries with room for *size, so
+ * appending does not rescan the array each time.
+ */
+static int hostfile_expand_range(const char *spec, char ***names, unsigned long *count,
+                                 unsigned long *size)
+{
+    const char *open, *close;
+    char *prefix, *list, *name, *end;
+    char **ranges, **tmp;
+    unsigned long lo, hi, val;
+    int n, width, rc = PRTE_SUCCESS;
+
+    if (NULL == (open = strchr(spec, '['))) {
+        if (PRTE_HOSTFILE_MAX_RANGE <= *count) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        if (*count + 1 >= *size) {
+            tmp = (char **) realloc(*names, 2 * (*size + 1) * sizeof(char *));
+            if (NULL == tmp) {
+                return PRTE_ERR_OUT_OF_RESOURCE;
+            }
+            *names = tmp;
+            *size = 2 * (*size + 1);
+        }
+        (*names)[(*count)++] = strdup(spec);
+        (*names)[*count] = NULL;
+        return PRTE_SUCCESS;
+    }
+    if (NULL == (close = strchr(open, ']')) || close == open + 1) {
+        return PRTE_ERR_BAD_PARAM;
+    }
+    prefix = strndup(spec, open - spec);
+    list = strndup(open + 1, close - open - 1);
+    ranges = PMIX_ARGV_SPLIT_COMPAT(list, ',');
+    free(list);
+
+    for (n = 0; NULL != ranges && NULL != ranges[n]; n++) {
+        lo = strtoul(ranges[n], &end, 10);
+        width = end - ranges[n];
+        if (0 == width) {
+            rc = PRTE_ERR_BAD_PARAM;
+            break;
+        }
+        if ('-' == *end) {
+            hi = strtoul(end + 1, &end, 10);
+        } else {
+            hi = lo;
+        }
+        /* strtoul returns ULONG_MAX on overflow */
+        if ('\0' != *end || hi < lo || ULONG_MAX == hi) {
+            rc = PRTE_ERR_BAD_PARAM;
+            break;
+        }
+        if (PRTE_HOSTFILE_MAX_RANGE - *count <= hi - lo) {
+            rc = PRTE_ERR_OUT_OF_RESOURCE;
+            break;
+        }
+        for (val = lo; val <= hi; val++) {
+            pmix_asprintf(&name, "%s%0*lu%s", prefix, width, val, close + 1);
+            rc = hostfile_expand_range(name, names, count, size);
+            free(name);
+            if (PRTE_SUCCESS != rc) {
+                break;
+            }
+        }
+        if (PRTE_SUCCESS != rc) {
+            break;
+        }
+    }
+    free(prefix);
+    PMIX_ARGV_FREE_COMPAT(ranges);
+    return rc;
+}
+
+/**
+ * Parse a line naming a range of hosts. The options on the line
+ * are parsed once and then applied to every host in the range.
+ */
+static int hostfile_parse_range(pmix_list_t *updates, pmix_list_t *exclude, bool keep_all)
+{
+    char **names = NULL;
+    char *username = NULL;
+    int port, *pptr = &port;
+    pmix_list_t tlist;
+    prte_node_t *tmpl, *node;
+    bool created;
+    int rc, n;
+    unsigned long count = 0, size = 0;
+
+    rc = hostfile_expand_range(prte_util_hostfile_value.sval, &names, &count, &size);
+    if (PRTE_ERR_OUT_OF_RESOURCE == rc) {
+        pmix_show_help("help-hostfile.txt", "range-too-large", true, cur_hostfile_name,
+                       prte_util_hostfile_line, prte_util_hostfile_value.sval,
+                       PRTE_HOSTFILE_MAX_RANGE);
+        PMIX_ARGV_FREE_COMPAT(names);
+        return PRTE_ERR_SILENT;
+    } else if (PRTE_SUCCESS != rc) {
+        hostfile_parse_error(PRTE_HOSTFILE_RANGE);
+        PMIX_ARGV_FREE_COMPAT(names);
+        return PRTE_ERROR;
+    }
+
+    PMIX_CONSTRUCT(&tlist, pmix_list_t);
+    tmpl = PMIX_NEW(prte_node_t);
+    tmpl->name = strdup(prte_util_hostfile_value.sval);
+    tmpl->slots = 1;
+    pmix_list_append(&tlist, &tmpl->super);
+    if (PRTE_SUCCESS != (rc = hostfile_parse_attrs(tmpl, &tlist))) {
+        goto cleanup;
+    }
+    prte_get_attribute(&tmpl->attributes, PRTE_NODE_USERNAME, (void **) &username, PMIX_STRING);
+    if (!prte_get_attribute(&tmpl->attributes, PRTE_NODE_PORT, (void **) &pptr, PMIX_INT)) {
+        pptr = NULL;
+    }
+
+    for (n = 0; NULL != names[n]; n++) {
+        rc = hostfile_add_host(names[n], updates, exclude, keep_all, &node, &created);
+        if (PRTE_SUCCESS != rc) {
+            goto cleanup;
+        }
+        if (NULL == node) {
+            /* excluded */
+            continue;
+        }
+        if (PRTE_FLAG_TEST(tmpl, PRTE_NODE_FLAG_SLOTS_GIVEN)) {
+            if (!created) {
+                pmix_show_help("help-hostfile.txt", "slots-given", true, cur_hostfile_name,
+                               node->name);
+                rc = PRTE_ERROR;
+                goto cleanup;
+            }
+            node->slots = tmpl->slots;
+            PRTE_FLAG_SET(node, PRTE_NODE_FLAG_SLOTS_GIVEN);
+        }
+        if (0 != tmpl->slots_max) {
+            node->slots_max = tmpl->slots_max;
+        }
+        if (NULL != username) {
+            prte_set_attribute(&node->attributes, PRTE_NODE_USERNAME, PRTE_ATTR_LOCAL,
+                               username, PMIX_STRING);
+        }
+        if (NULL != pptr) {
+            prte_set_attribute(&node->attributes, PRTE_NODE_PORT, PRTE_ATTR_LOCAL,
+                               pptr, PMIX_INT);
+        }
+    }
+
+cleanup:
+    PMIX_LIST_DESTRUCT(&tlist);
+    PMIX_ARGV_FREE_COMPAT(names);
+    if (NULL != username) {
+        free(username);
+    }
+    return rc;
+}
+
+static int hostfile_parse_line(int token, pmix_list_t *updates,
+                               pmix_list_t *exclude, bool keep_all)
+{
+    int rc;
+    prte_node_t *node;
+    char *value;
+    char **argv;
+    char *node_name = NULL;
+    char *username = NULL;
+    int cnt;
+    char buff[64];
+    char *alias = NULL;
+
+    if (PRTE_HOSTFILE_STRING == token || PRTE_HOSTFILE_HOSTNAME == token ||
+        PRTE_HOSTFILE_INT == token || PRTE_HOSTFILE_IPV4 == token ||
+        PRTE_HOSTFILE_IPV6 == token) {
+
+        if (PRTE_HOSTFILE_INT == token) {
+            snprintf(buff, 64, "%d", prte_util_hostfile_value.ival);
+            value = buff;
+        } else {
+            value = prte_util_hostfile_value.sval;
+        }
+        rc = hostfile_add_host(value, updates, exclude, keep_all, &node, NULL);
+        if (PRTE_SUCCESS != rc || NULL == node) {
+            return rc;
+        }
+    } else if (PRTE_HOSTFILE_RANGE == token) {
+        return hostfile_parse_range(updates, exclude, keep_all);
+    } else if (PRTE_HOSTFILE_RELATIVE == token) {
+        /* store this for later processing */
+        node = PMIX_NEW(prte_node_t);
+        // Strip off the FQDN if present, ignore IP addresses
+        if (!pmix_net_isaddr(prte_util_hostfile_value.sval)) {
+            char *ptr;
+            alias = strdup(prte_util_hostfile_value.sval);
+            if (NULL != (ptr = strchr(alias, '.'))) {
+                *ptr = '\0';
+            } else {
+                free(alias);
+                alias = NULL;
+            }
+        }
+        if (prte_keep_fqdn_hostnames || NULL == alias) {
+            node->name = strdup(prte_util_hostfile_value.sval);
+        } else {
+            node->name = strdup(alias);
+            node->rawname = strdup(prte_util_hostfile_value.sval);
+        }
+        if (NULL != alias && 0 != strcmp(alias, node->name)) {
+            // new node object, so alias must be unique
+            PMIX_ARGV_APPEND_NOSIZE_COMPAT(&node->aliases, alias);
+            free(alias);
+        }
+        pmix_list_append(updates, &node->super);
+        hostfile_index_node(cur_include, node);
+    } else if (PRTE_HOSTFILE_RANK == token) {
+        /* we can ignore the rank, but we need to extract the node name. we
+         * first need to shift over to the other side of the equal sign as
+         * this is where the node name will be
+         */
+        while (!prte_util_hostfile_done && PRTE_HOSTFILE_EQUAL != token) {
+            token = prte_util_hostfile_lex();
+        }
+        if (prte_util_hostfile_done) {
+            /* bad syntax somewhere */
+            return PRTE_ERROR;
+        }
+        /* next position should be the node name */
+        token = prte_util_hostfile_lex();
+        if (PRTE_HOSTFILE_INT == token) {
+            snprintf(buff, 64, "%d", prte_util_hostfile_value.ival);
+            value = buff;
+        } else {
+            value = prte_util_hostfile_value.sval;
+        }
+
+        argv = PMIX_ARGV_SPLIT_COMPAT(value, '@');
+
+        cnt = PMIX_ARGV_COUNT_COMPAT(argv);
+        if (1 == cnt) {
+            node_name = strdup(argv[0]);
+        } else if (2 == cnt) {
+            username = strdup(argv[0]);
+            node_name = strdup(argv[1]);
+        } else {
+            pmix_output(0, "WARNING: Unhandled user@host-combination\n"); /* XXX */
+        }
+        PMIX_ARGV_FREE_COMPAT(argv);
+
+        // Strip off the FQDN if present, ignore IP addresses
+        if (!prte_keep_fqdn_hostnames && !pmix_net_isaddr(node_name)) {
+            char *ptr;
+            alias = strdup(node_name);
+            if (NULL != (ptr = strchr(alias, '.'))) {
+                *ptr = '\0';
+            }
+        }
+
+        /* Do we need to make a new node object? */
+        if (NULL == (node = hostfile_match(cur_include, node_name))) {
+            node = PMIX_NEW(prte_node_t);
+            node->name = strdup(node_name);
+            node->slots = 1;
+            if (NULL != username) {
+                prte_set_attribute(&node->attributes, PRTE_NODE_USERNAME,
+                                   PRTE_ATTR_LOCAL, username, PMIX_STRING);
+            }
+            pmix_list_append(updates, &node->super);
+        } else {
+            /* add a slot */
+            node->slots++;
+            /* the node name may not match the prior entry, so ensure we
+             * keep it if necessary */
+            if (0 != strcmp(node_name, node->name)) {
+                PMIX_ARGV_APPEND_UNIQUE_COMPAT(&node->aliases, node_name);
+            }
+        }
+        if (NULL != alias) {
+            PMIX_ARGV_APPEND_UNIQUE_COMPAT(&node->aliases, alias);
+            free(alias);
+            node->rawname = strdup(node_name);
+        }
+        hostfile_index_node(cur_include, node);
+        PMIX_OUTPUT_VERBOSE((1, prte_ras_base_framework.framework_output,
+                             "%s hostfile: node %s slots %d nodes-given %s",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), node->name, node->slots,
+                             PRTE_FLAG_TEST(node, PRTE_NODE_FLAG_SLOTS_GIVEN) ? "TRUE" : "FALSE"));
+        /* mark the slots as "given" since we take them as being the
+         * number specified via the rankfile
+         */
+        PRTE_FLAG_SET(node, PRTE_NODE_FLAG_SLOTS_GIVEN);
+        /* skip to end of line */
+        while (!prte_util_hostfile_done && PRTE_HOSTFILE_NEWLINE != token) {
+            token = prte_util_hostfile_lex();
+        }
+        free(node_name);
+        if (NULL != username) {
+            free(username);
+        }
+        return PRTE_SUCCESS;
+    } else {
+        hostfile_parse_error(token);
+        return PRTE_ERROR;
+    }
+
+    return hostfile_parse_attrs(node, updates);
+}
+
+/**
+ * Parse the specified file into a node list.
+ */
+
+static prte_node_t *hostfile_node_dup(prte_node_t *src)
+{
+    prte_node_t *node;
+    char *username = NULL;
+    int port, *pptr = &port;
+
+    node = PMIX_NEW(prte_node_t);
+    node->name = strdup(src->name);
+    if (NULL != src->rawname) {
+        node->rawname = strdup(src->rawname);
+    }
+    if (NULL != src->aliases) {
+        node->aliases = PMIX_ARGV_COPY_COMPAT(src->aliases);
+    }
+    node->slots = src->slots;
+    node->slots_max = src->slots_max;
+    node->flags = src->flags;
+    if (prte_get_attribute(&src->attributes, PRTE_NODE_USERNAME, (void **) &username, PMIX_STRING)
+        && NULL != username) {
+        prte_set_attribute(&node->attributes, PRTE_NODE_USERNAME, PRTE_ATTR_LOCAL, username,
+                           PMIX_STRING);
+        free(username);
+    }
+    if (prte_get_attribute(&src->attributes, PRTE_NODE_PORT, (void **) &pptr, PMIX_INT)) {
+        prte_set_attribute(&node->attributes, PRTE_NODE_PORT, PRTE_ATTR_LOCAL, &port, PMIX_INT);
+    }
+    return node;
+}
+
+static void hostfile_copy_nodes(pmix_list_t *dest, pmix_list_t *src)
+{
+    prte_node_t *node;
+
+    PMIX_LIST_FOREACH(node, src, prte_node_t) {
+        pmix_list_append(dest, &hostfile_node_dup(node)->super);
+    }
+}
+
+static hostfile_cache_t *hostfile_cache_lookup(const char *hostfile, struct stat *buf,
+                                               bool keep_all)
+{
+    hostfile_cache_t *hc;
+
+    if (!hostfile_cache_init) {
+        PMIX_CONSTRUCT(&hostfile_cache, pmix_list_t);
+        hostfile_cache_init = true;
+    }
+    PMIX_LIST_FOREACH(hc, &hostfile_cache, hostfile_cache_t) {
+        if (hc->keep_all != keep_all || 0 != strcmp(hc->path, hostfile)) {
+            continue;
+        }
+        if (hc->dev == buf->st_dev && hc->ino == buf->st_ino &&
+            hc->size == buf->st_size && hc->mtime == buf->st_mtime &&
+            hc->mtime_nsec == PRTE_STAT_MTIME_NSEC(buf)) {
+            /* move it to the most recently used end */
+            pmix_list_remove_item(&hostfile_cache, &hc->super);
+            pmix_list_append(&hostfile_cache, &hc->super);
+            return hc;
+        }
+        /* the file has changed - discard the stale entry */
+        pmix_list_remove_item(&hostfile_cache, &hc->super);
+        PMIX_RELEASE(hc);
+        break;
+    }
+    return NULL;
+}
+
+static void hostfile_cache_store(const char *hostfile, struct stat *buf, bool keep_all,
+                                 pmix_list_t *updates, pmix_list_t *exclude)
+{
+    hostfile_cache_t *hc;
+
+    /* evict the least recently used entries to make room */
+    while (PRTE_HOSTFILE_CACHE_MAX <= pmix_list_get_size(&hostfile_cache)) {
+        hc = (hostfile_cache_t *) pmix_list_remove_first(&hostfile_cache);
+        PMIX_RELEASE(hc);
+    }
+
+    hc = PMIX_NEW(hostfile_cache_t);
+    hc->path = strdup(hostfile);
+    hc->keep_all = keep_all;
+    hc->dev = buf->st_dev;
+    hc->ino = buf->st_ino;
+    hc->size = buf->st_size;
+    hc->mtime = buf->st_mtime;
+    hc->mtime_nsec = PRTE_STAT_MTIME_NSEC(buf);
+    hostfile_copy_nodes(&hc->updates, updates);
+    hostfile_copy_nodes(&hc->exclude, exclude);
+    pmix_list_append(&hostfile_cache, &hc->super);
+}
+
+void prte_util_hostfile_finalize(void)
+{
+    if (hostfile_cache_init) {
+        PMIX_LIST_DESTRUCT(&hostfile_cache);
+        hostfile_cache_init = false;
+    }
+}
+
 /**
  * Parse the specified file into a node list.
  */
@@ -483,6 +947,25 @@ static int hostfile_parse(const char *hostfile, pmix_list_t *updates, pmix_list_
 {
     int token;
     int rc = PRTE_SUCCESS;
+    struct stat buf;
+    bool cacheable = false;
+    hostfile_cache_t *hc;
+    pmix_list_t adds, excl;
+    pmix_list_item_t *item;
+    pmix_hash_table_t include_index, exclude_index;
+
+    if (prte_hostfile_cache && 0 == stat(hostfile, &buf)) {
+        hc = hostfile_cache_lookup(hostfile, &buf, keep_all);
+        if (NULL != hc) {
+            PMIX_OUTPUT_VERBOSE((1, prte_ras_base_framework.framework_output,
+                                 "%s hostfile: using cached contents of %s",
+                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), hostfile));
+            hostfile_copy_nodes(updates, &hc->updates);
+            hostfile_copy_nodes(exclude, &hc->exclude);
+            return PRTE_SUCCESS;
+        }
+        cacheable = true;
+    }
 
     cur_hostfile_name = hostfile;
 
@@ -510,6 +993,17 @@ static int hostfile_parse(const char *hostfile, pmix_list_t *updates, pmix_list_
         goto unlock;
     }
 
+    /* parse into local lists so that the results can be cached
+     * before being handed to the caller */
+    PMIX_CONSTRUCT(&adds, pmix_list_t);
+    PMIX_CONSTRUCT(&excl, pmix_list_t);
+    PMIX_CONSTRUCT(&include_index, pmix_hash_table_t);
+    pmix_hash_table_init(&include_index, 1024);
+    PMIX_CONSTRUCT(&exclude_index, pmix_hash_table_t);
+    pmix_hash_table_init(&exclude_index, 32);
+    cur_include = &include_index;
+    cur_exclude = &exclude_index;
+
     while (!prte_util_hostfile_done) {
         token = prte_util_hostfile_lex();
 
@@ -526,29 +1020,49 @@ static int hostfile_parse(const char *hostfile, pmix_list_t *updates, pmix_list_
          *   hostname              just plain as it is, being a PRTE_HOSTFILE_STRING
          *   IP4s and user@IPv4s
          *   hostname.domain and user@hostname.domain
+         *   prefix[range]suffix   expanded into one host per value
          */
         case PRTE_HOSTFILE_STRING:
         case PRTE_HOSTFILE_INT:
         case PRTE_HOSTFILE_HOSTNAME:
         case PRTE_HOSTFILE_IPV4:
         case PRTE_HOSTFILE_IPV6:
+        case PRTE_HOSTFILE_RANGE:
         case PRTE_HOSTFILE_RELATIVE:
         case PRTE_HOSTFILE_RANK:
-            rc = hostfile_parse_line(token, updates, exclude, keep_all);
+            rc = hostfile_parse_line(token, &adds, &excl, keep_all);
             if (PRTE_SUCCESS != rc) {
-                goto unlock;
+                goto transfer;
             }
             break;
 
         default:
             hostfile_parse_error(token);
-            goto unlock;
+            goto transfer;
         }
     }
     fclose(prte_util_hostfile_in);
     prte_util_hostfile_in = NULL;
     prte_util_hostfile_lex_destroy();
 
+    if (cacheable) {
+        hostfile_cache_store(hostfile, &buf, keep_all, &adds, &excl);
+    }
+
+transfer:
+    cur_include = NULL;
+    cur_exclude = NULL;
+    PMIX_DESTRUCT(&include_index);
+    PMIX_DESTRUCT(&exclude_index);
+    while (NULL != (item = pmix_list_remove_first(&adds))) {
+        pmix_list_append(updates, item);
+    }
+    while (NULL != (item = pmix_list_remove_first(&excl))) {
+        pmix_list_append(exclude, item);
+    }
+    PMIX_DESTRUCT(&adds);
+    PMIX_DESTRUCT(&excl);
+
 unlock:
     cur_hostfile_name = NULL;
 
@@ -565,7 +1079,7 @@ int prte_util_add_hostfile_nodes(pmix_list_t *nodes, char *hostfile)
     pmix_list_item_t *item;
     int rc, i;
     prte_node_t *nd, *node;
-    bool found;
+    pmix_hash_table_t index;
 
     PMIX_OUTPUT_VERBOSE((1, prte_ras_base_framework.framework_output,
                          "%s hostfile: checking hostfile %s for nodes",
@@ -573,6 +1087,7 @@ int prte_util_add_hostfile_nodes(pmix_list_t *nodes, char *hostfile)
 
     PMIX_CONSTRUCT(&exclude, pmix_list_t);
     PMIX_CONSTRUCT(&adds, pmix_list_t);
+    PMIX_CONSTRUCT(&index, pmix_hash_table_t);
 
     /* parse the hostfile and add any new contents to the list */
     if (PRTE_SUCCESS != (rc = hostfile_parse(hostfile, &adds, &exclude, false))) {
@@ -604,16 +1119,11 @@ int prte_util_add_hostfile_nodes(pmix_list_t *nodes, char *hostfile)
     }
 
     /* transfer across all unique nodes */
+    hostfile_index_list(&index, nodes);
     while (NULL != (item = pmix_list_remove_first(&adds))) {
         nd = (prte_node_t *) item;
-        found = false;
-        PMIX_LIST_FOREACH(node, nodes, prte_node_t) {
-            if (prte_nptr_match(nd, node)) {
-                found = true;
-                break;
-            }
-        }
-        if (found) {
+        node = hostfile_find_node(&index, nd);
+        if (NULL != node) {
             /* add this node name as alias */
             PMIX_ARGV_APPEND_UNIQUE_COMPAT(&node->aliases, nd->name);
             /* ensure all other aliases are also transferred */
@@ -622,9 +1132,11 @@ int prte_util_add_hostfile_nodes(pmix_list_t *nodes, char *hostfile)
                     PMIX_ARGV_APPEND_UNIQUE_COMPAT(&node->aliases, nd->aliases[i]);
                 }
             }
-           PMIX_RELEASE(item);
+            hostfile_index_node(&index, node);
+            PMIX_RELEASE(item);
         } else {
             pmix_list_append(nodes, &nd->super);
+            hostfile_index_node(&index, nd);
             PMIX_OUTPUT_VERBOSE((1, prte_ras_base_framework.framework_output,
                                  "%s hostfile: adding node %s slots %d",
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), nd->name, nd->slots));
@@ -634,6 +1146,7 @@ int prte_util_add_hostfile_nodes(pmix_list_t *nodes, char *hostfile)
 cleanup:
     PMIX_LIST_DESTRUCT(&exclude);
     PMIX_LIST_DESTRUCT(&adds);
+    PMIX_DESTRUCT(&index);
 
     return rc;
 }
@@ -652,7 +1165,7 @@ int prte_util_filter_hostfile_nodes(pmix_list_t *nodes, char *hostfile, bool rem
     int num_empty, nodeidx;
     bool want_all_empty = false;
     pmix_list_t keep;
-    bool found;
+    pmix_hash_table_t index;
 
     PMIX_OUTPUT_VERBOSE((1, prte_ras_base_framework.framework_output,
                          "%s hostfile: filtering nodes through hostfile %s",
@@ -697,6 +1210,8 @@ int prte_util_filter_hostfile_nodes(pmix_list_t *nodes, char *hostfile, bool rem
      * destruct our hostfile list as we go since this won't be needed
      */
     PMIX_CONSTRUCT(&keep, pmix_list_t);
+    PMIX_CONSTRUCT(&index, pmix_hash_table_t);
+    hostfile_index_list(&index, nodes);
     while (NULL != (item2 = pmix_list_remove_first(&newnodes))) {
         node_from_file = (prte_node_t *) item2;
 
@@ -740,6 +1255,7 @@ int prte_util_filter_hostfile_nodes(pmix_list_t *nodes, char *hostfile, bool rem
                         }
                         if (remove) {
                             /* remove item from list */
+                            hostfile_unindex_node(&index, node_from_list);
                             pmix_list_remove_item(nodes, item1);
                             /* xfer to keep list */
                             pmix_list_append(&keep, item1);
@@ -779,6 +1295,7 @@ int prte_util_filter_hostfile_nodes(pmix_list_t *nodes, char *hostfile, bool rem
                     if (prte_nptr_match(node_from_pool, node_from_list)) {
                         if (remove) {
                             /* match - remove item from list */
+                            hostfile_unindex_node(&index, node_from_list);
                             pmix_list_remove_item(nodes, item1);
                             /* xfer to keep list */
                             pmix_list_append(&keep, item1);
@@ -801,45 +1318,39 @@ int prte_util_filter_hostfile_nodes(pmix_list_t *nodes, char *hostfile, bool rem
              * search the provided list of nodes to see if this
              * one is found
              */
-            found = false;
-            for (item1 = pmix_list_get_first(nodes); item1 != pmix_list_get_end(nodes);
-                 item1 = pmix_list_get_next(item1)) {
-                node_from_list = (prte_node_t *) item1;
-                /* we have converted all aliases for ourself
-                 * to our own detected nodename */
-                if (prte_nptr_match(node_from_file, node_from_list)) {
-                    /* if the slot count here is less than the
-                     * total slots avail on this node, set it
-                     * to the specified count - this allows people
-                     * to subdivide an allocation
-                     */
-                    if (PRTE_FLAG_TEST(node_from_file, PRTE_NODE_FLAG_SLOTS_GIVEN)
-                        && node_from_file->slots < node_from_list->slots) {
-                        node_from_list->slots = node_from_file->slots;
-                    }
-                    if (remove) {
-                        /* remove the node from the list */
-                        pmix_list_remove_item(nodes, item1);
-                        /* xfer it to keep list */
-                        pmix_list_append(&keep, item1);
-                    } else {
-                        /* mark as included */
-                        PRTE_FLAG_SET(node_from_list, PRTE_NODE_FLAG_MAPPED);
-                    }
-                    found = true;
-                    break;
-                }
-            }
+            node_from_list = hostfile_find_node(&index, node_from_file);
             /* if the host in the newnode list wasn't found,
              * then that is an error we need to report to the
              * user and abort
              */
-            if (!found) {
+            if (NULL == node_from_list) {
                 pmix_show_help("help-hostfile.txt", "hostfile:extra-node-not-found", true, hostfile,
                                node_from_file->name);
                 rc = PRTE_ERR_SILENT;
                 goto cleanup;
             }
+            /* we have converted all aliases for ourself
+             * to our own detected nodename
+             *
+             * if the slot count here is less than the
+             * total slots avail on this node, set it
+             * to the specified count - this allows people
+             * to subdivide an allocation
+             */
+            if (PRTE_FLAG_TEST(node_from_file, PRTE_NODE_FLAG_SLOTS_GIVEN)
+                && node_from_file->slots < node_from_list->slots) {
+                node_from_list->slots = node_from_file->slots;
+            }
+            if (remove) {
+                /* remove the node from the list */
+                hostfile_unindex_node(&index, node_from_list);
+                pmix_list_remove_item(nodes, &node_from_list->super);
+                /* xfer it to keep list */
+                pmix_list_append(&keep, &node_from_list->super);
+            } else {
+                /* mark as included */
+                PRTE_FLAG_SET(node_from_list, PRTE_NODE_FLAG_MAPPED);
+            }
         }
         /* cleanup the newnode list */
         PMIX_RELEASE(item2);
@@ -855,12 +1366,14 @@ int prte_util_filter_hostfile_nodes(pmix_list_t *nodes, char *hostfile, bool rem
             PMIX_RELEASE(item1);
         }
         PMIX_DESTRUCT(&newnodes);
+        PMIX_DESTRUCT(&index);
         return PRTE_ERR_SILENT;
     }
 
     if (!remove) {
         /* all done */
         PMIX_DESTRUCT(&newnodes);
+        PMIX_DESTRUCT(&index);
         return PRTE_SUCCESS;
     }
 
@@ -876,6 +1389,7 @@ int prte_util_filter_hostfile_nodes(pmix_list_t *nodes, char *hostfile, bool rem
 
 cleanup:
     PMIX_DESTRUCT(&newnodes);
+    PMIX_DESTRUCT(&index);
 
     return rc;
 }
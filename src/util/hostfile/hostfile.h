@@ -38,6 +38,9 @@ PRTE_EXPORT int prte_util_filter_hostfile_nodes(pmix_list_t *nodes, char *hostfi
 
 PRTE_EXPORT int prte_util_get_ordered_host_list(pmix_list_t *nodes, char *hostfile);
 
+/* release any hostfiles cached by prte_hostfile_cache */
+PRTE_EXPORT void prte_util_hostfile_finalize(void);
+
 END_C_DECLS
 
 #endif
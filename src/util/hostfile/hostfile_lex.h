@@ -84,5 +84,6 @@ extern int prte_util_hostfile_lex_destroy(void);
 /* ensure we can handle a rank_file input */
 #define PRTE_HOSTFILE_RANK 20
 #define PRTE_HOSTFILE_PORT 21
+#define PRTE_HOSTFILE_RANGE 22
 
 #endif
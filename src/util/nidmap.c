@@ -32,20 +32,23 @@
 
 #include "src/util/nidmap.h"
 
-int prte_util_nidmap_create(pmix_pointer_array_t *pool, pmix_data_buffer_t *buffer)
+#define PRTE_NIDMAP_FULL  0
+#define PRTE_NIDMAP_DELTA 1
+
+bool prte_util_nidmap_partial = false;
+
+static int pack_flags(pmix_data_buffer_t *buffer, uint8_t type)
 {
-    char *raw = NULL;
-    pmix_rank_t *vpids = NULL;
     uint8_t u8;
-    int n, m, ndaemons, nbytes;
-    bool compressed;
-    char **names = NULL;
-    char **aliases = NULL, **als;
-    prte_node_t *nptr;
-    pmix_byte_object_t bo;
-    size_t sz;
     pmix_status_t rc;
 
+    /* pack the type of map */
+    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &type, 1, PMIX_UINT8);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
     /* pack a flag indicating if the HNP was included in the allocation */
     if (prte_hnp_is_allocated) {
         u8 = 1;
@@ -69,6 +72,26 @@ int prte_util_nidmap_create(pmix_pointer_array_t *pool, pmix_data_buffer_t *buff
         PMIX_ERROR_LOG(rc);
         return rc;
     }
+    return PMIX_SUCCESS;
+}
+
+int prte_util_nidmap_create(pmix_pointer_array_t *pool, pmix_data_buffer_t *buffer)
+{
+    char *raw = NULL;
+    pmix_rank_t *vpids = NULL;
+    int n, m, ndaemons, nbytes;
+    bool compressed;
+    char **names = NULL;
+    char **aliases = NULL, **als;
+    prte_node_t *nptr;
+    pmix_byte_object_t bo;
+    size_t sz;
+    pmix_status_t rc;
+
+    rc = pack_flags(buffer, PRTE_NIDMAP_FULL);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
 
     /* daemon vpids start from 0 and increase linearly by one
      * up to the number of nodes in the system. The vpid is
@@ -211,6 +234,281 @@ int prte_util_nidmap_create(pmix_pointer_array_t *pool, pmix_data_buffer_t *buff
     return rc;
 }
 
+int prte_util_nidmap_create_delta(pmix_pointer_array_t *pool, pmix_bitmap_t *nodes,
+                                  pmix_data_buffer_t *buffer)
+{
+    pmix_data_buffer_t entries;
+    pmix_byte_object_t bo;
+    prte_node_t *nptr;
+    pmix_rank_t vpid;
+    char *aliases;
+    uint8_t *cmp;
+    int32_t n, cnt = 0;
+    uint32_t ndaemons;
+    bool compressed;
+    size_t sz;
+    pmix_status_t rc;
+
+    rc = pack_flags(buffer, PRTE_NIDMAP_DELTA);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+
+    /* the receiver may not know about every daemon, so we
+     * have to tell it how many there are */
+    ndaemons = prte_process_info.num_daemons;
+    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &ndaemons, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* each entry carries its pool index so the receiver
+     * can put it in the right place */
+    PMIX_DATA_BUFFER_CONSTRUCT(&entries);
+    for (n = 0; n < pool->size; n++) {
+        if (!pmix_bitmap_is_set_bit(nodes, n)) {
+            continue;
+        }
+        if (NULL == (nptr = (prte_node_t *) pmix_pointer_array_get_item(pool, n))) {
+            continue;
+        }
+        rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, &entries, &n, 1, PMIX_INT32);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_DESTRUCT(&entries);
+            return rc;
+        }
+        rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, &entries, &nptr->name, 1, PMIX_STRING);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_DESTRUCT(&entries);
+            return rc;
+        }
+        aliases = NULL;
+        if (NULL != nptr->aliases) {
+            aliases = PMIX_ARGV_JOIN_COMPAT(nptr->aliases, ',');
+        }
+        rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, &entries, &aliases, 1, PMIX_STRING);
+        if (NULL != aliases) {
+            free(aliases);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_DESTRUCT(&entries);
+            return rc;
+        }
+        if (NULL == nptr->daemon) {
+            vpid = PMIX_RANK_INVALID;
+        } else {
+            vpid = nptr->daemon->name.rank;
+        }
+        rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, &entries, &vpid, 1, PMIX_PROC_RANK);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_DESTRUCT(&entries);
+            return rc;
+        }
+        ++cnt;
+    }
+
+    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &cnt, 1, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_DESTRUCT(&entries);
+        return rc;
+    }
+    rc = PMIx_Data_unload(&entries, &bo);
+    PMIX_DATA_BUFFER_DESTRUCT(&entries);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    if (PMIx_Data_compress((uint8_t *) bo.bytes, bo.size, &cmp, &sz)) {
+        /* mark that this was compressed */
+        compressed = true;
+        free(bo.bytes);
+        bo.bytes = (char *) cmp;
+        bo.size = sz;
+    } else {
+        /* mark that this was not compressed */
+        compressed = false;
+    }
+    /* indicate compression */
+    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &compressed, 1, PMIX_BOOL);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+        return rc;
+    }
+    /* add the object */
+    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &bo, 1, PMIX_BYTE_OBJECT);
+    PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    return rc;
+}
+
+static int decode_delta(pmix_data_buffer_t *buf)
+{
+    pmix_data_buffer_t entries;
+    pmix_byte_object_t pbo;
+    uint32_t ndaemons;
+    int32_t m, cnt, idx;
+    bool compressed;
+    uint8_t *raw;
+    size_t sz;
+    char *name = NULL, *aliases = NULL;
+    pmix_rank_t vpid;
+    prte_node_t *nd;
+    prte_job_t *daemons;
+    prte_proc_t *proc;
+    prte_topology_t *t;
+    pmix_status_t rc;
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &ndaemons, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    cnt = 1;
+    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &m, &cnt, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    cnt = 1;
+    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &compressed, &cnt, PMIX_BOOL);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    cnt = 1;
+    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &pbo, &cnt, PMIX_BYTE_OBJECT);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* if we are the HNP, we don't need any of this stuff */
+    if (PRTE_PROC_IS_MASTER) {
+        PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+        return PRTE_SUCCESS;
+    }
+
+    if (compressed) {
+        if (!PMIx_Data_decompress((uint8_t *) pbo.bytes, pbo.size, &raw, &sz)) {
+            PRTE_ERROR_LOG(PRTE_ERROR);
+            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+            return PRTE_ERROR;
+        }
+        PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+        pbo.bytes = (char *) raw;
+        pbo.size = sz;
+    }
+    PMIX_DATA_BUFFER_CONSTRUCT(&entries);
+    rc = PMIx_Data_load(&entries, &pbo);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+        PMIX_DATA_BUFFER_DESTRUCT(&entries);
+        return rc;
+    }
+
+    daemons = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
+    t = (prte_topology_t *) pmix_pointer_array_get_item(prte_node_topologies, 0);
+    if (NULL == t) {
+        /* should never happen */
+        PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
+        PMIX_DATA_BUFFER_DESTRUCT(&entries);
+        return PRTE_ERR_NOT_FOUND;
+    }
+
+    for (; 0 < m; m--) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, &entries, &idx, &cnt, PMIX_INT32);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            break;
+        }
+        cnt = 1;
+        rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, &entries, &name, &cnt, PMIX_STRING);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            break;
+        }
+        cnt = 1;
+        rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, &entries, &aliases, &cnt, PMIX_STRING);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            break;
+        }
+        cnt = 1;
+        rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, &entries, &vpid, &cnt, PMIX_PROC_RANK);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            break;
+        }
+
+        nd = (prte_node_t *) pmix_pointer_array_get_item(prte_node_pool, idx);
+        if (NULL == nd) {
+            nd = PMIX_NEW(prte_node_t);
+            nd->name = name;
+            nd->index = idx;
+            pmix_pointer_array_set_item(prte_node_pool, idx, nd);
+            /* default to homogeneous */
+            nd->topology = t;
+        } else if (0 != strcmp(nd->name, name)) {
+            free(nd->name);
+            nd->name = name;
+        } else {
+            free(name);
+        }
+        name = NULL;
+        if (NULL != aliases) {
+            if (NULL != nd->aliases) {
+                PMIX_ARGV_FREE_COMPAT(nd->aliases);
+            }
+            nd->aliases = PMIX_ARGV_SPLIT_COMPAT(aliases, ',');
+            free(aliases);
+            aliases = NULL;
+        }
+        /* see if it has a daemon on it */
+        if (PMIX_RANK_INVALID != vpid && NULL == nd->daemon) {
+            proc = (prte_proc_t *) pmix_pointer_array_get_item(daemons->procs, vpid);
+            if (NULL == proc) {
+                proc = PMIX_NEW(prte_proc_t);
+                PMIX_LOAD_PROCID(&proc->name, PRTE_PROC_MY_NAME->nspace, vpid);
+                proc->state = PRTE_PROC_STATE_RUNNING;
+                PRTE_FLAG_SET(proc, PRTE_PROC_FLAG_ALIVE);
+                daemons->num_procs++;
+                pmix_pointer_array_set_item(daemons->procs, proc->name.rank, proc);
+            }
+            PMIX_RETAIN(nd);
+            proc->node = nd;
+            PMIX_RETAIN(proc);
+            nd->daemon = proc;
+        }
+    }
+    if (NULL != name) {
+        free(name);
+    }
+    if (NULL != aliases) {
+        free(aliases);
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&entries);
+
+    /* we may not hold every daemon, so take the count we were given */
+    if (PMIX_SUCCESS == rc && prte_process_info.num_daemons != ndaemons) {
+        prte_process_info.num_daemons = ndaemons;
+        /* update the routing tree */
+        prte_rml_compute_routing_tree();
+    }
+    return rc;
+}
+
 int prte_util_decode_nidmap(pmix_data_buffer_t *buf)
 {
     uint8_t u8;
@@ -224,8 +522,17 @@ int prte_util_decode_nidmap(pmix_data_buffer_t *buf)
     prte_job_t *daemons;
     prte_proc_t *proc;
     prte_topology_t *t = NULL;
+    uint8_t type;
     pmix_status_t rc;
 
+    /* unpack the type of map */
+    cnt = 1;
+    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &type, &cnt, PMIX_UINT8);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        goto cleanup;
+    }
+
     /* unpack the flag indicating if HNP is in allocation */
     cnt = 1;
     rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &u8, &cnt, PMIX_UINT8);
@@ -252,6 +559,10 @@ int prte_util_decode_nidmap(pmix_data_buffer_t *buf)
         prte_managed_allocation = false;
     }
 
+    if (PRTE_NIDMAP_DELTA == type) {
+        return decode_delta(buf);
+    }
+
     /* unpack compression flag for node names */
     cnt = 1;
     rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &compressed, &cnt, PMIX_BOOL);
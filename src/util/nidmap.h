@@ -26,6 +26,7 @@
 
 #include "prte_config.h"
 
+#include "src/class/pmix_bitmap.h"
 #include "src/class/pmix_pointer_array.h"
 #include "src/pmix/pmix-internal.h"
 #include "src/runtime/prte_globals.h"
@@ -33,6 +34,17 @@
 /* pass info about the nodes in an allocation */
 PRTE_EXPORT int prte_util_nidmap_create(pmix_pointer_array_t *pool, pmix_data_buffer_t *buf);
 
+/* pass info about only the nodes whose pool index is set in
+ * the bitmap - the receiver leaves the rest of its node pool
+ * untouched. Used to update the DVM when it is expanded */
+PRTE_EXPORT int prte_util_nidmap_create_delta(pmix_pointer_array_t *pool, pmix_bitmap_t *nodes,
+                                              pmix_data_buffer_t *buf);
+
+/* true if some daemons may hold only part of the node map
+ * because the DVM was expanded using deltas */
+PRTE_EXPORT extern bool prte_util_nidmap_partial;
+
+/* decode either form of the map */
 PRTE_EXPORT int prte_util_decode_nidmap(pmix_data_buffer_t *buf);
 
 #endif /* PRTE_NIDMAP_H */
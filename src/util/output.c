@@ -0,0 +1,524 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+
+#include "src/threads/pmix_mutex.h"
+#include "src/util/pmix_printf.h"
+#include "src/util/pmix_string_copy.h"
+
+#include "src/util/output.h"
+
+/* PMIx returns -1 for any stream id that is not open, so scanning
+ * a little past its table size is harmless */
+#define PRTE_OUTPUT_MAX_STREAMS 256
+
+/* per-record limits - anything that does not fit is formatted
+ * immediately instead */
+#define PRTE_OUTPUT_TRACE_ARGS   16
+#define PRTE_OUTPUT_TRACE_STRLEN 256
+#define PRTE_OUTPUT_TRACE_LINE   1024
+
+int prte_output_max_verbosity = INT_MAX;
+bool prte_output_trace_enabled = false;
+
+typedef enum {
+    PRTE_OUTPUT_ARG_NONE,
+    PRTE_OUTPUT_ARG_INT,
+    PRTE_OUTPUT_ARG_LONG,
+    PRTE_OUTPUT_ARG_LLONG,
+    PRTE_OUTPUT_ARG_SIZE,
+    PRTE_OUTPUT_ARG_INTMAX,
+    PRTE_OUTPUT_ARG_PTRDIFF,
+    PRTE_OUTPUT_ARG_DOUBLE,
+    PRTE_OUTPUT_ARG_LDOUBLE,
+    PRTE_OUTPUT_ARG_PTR,
+    PRTE_OUTPUT_ARG_STR,
+    PRTE_OUTPUT_ARG_BAD
+} prte_output_arg_type_t;
+
+typedef union {
+    int i;
+    long l;
+    long long ll;
+    size_t z;
+    intmax_t j;
+    ptrdiff_t t;
+    double d;
+    long double ld;
+    void *p;
+} prte_output_arg_t;
+
+typedef struct {
+    /* zero while the record is being filled */
+    uint64_t seq;
+    struct timespec ts;
+    int id;
+    int level;
+    /* NULL if the text was formatted at the call site */
+    const char *format;
+    int nargs;
+    size_t strused;
+    prte_output_arg_t args[PRTE_OUTPUT_TRACE_ARGS];
+    /* copies of the string arguments - their args[] entry holds
+     * the offset - or the whole message if format is NULL */
+    char strs[PRTE_OUTPUT_TRACE_STRLEN];
+} prte_output_trace_rec_t;
+
+static prte_output_trace_rec_t *trace_recs = NULL;
+static uint64_t trace_size = 0;
+static uint64_t trace_next = 0;
+static char *trace_filename = NULL;
+static pmix_mutex_t trace_lock = PMIX_MUTEX_STATIC_INIT;
+
+void prte_output_verbose_refresh(void)
+{
+    int n, v, max = 0;
+
+    for (n = 0; n < PRTE_OUTPUT_MAX_STREAMS; n++) {
+        v = pmix_output_get_verbosity(n);
+        if (max < v) {
+            max = v;
+        }
+    }
+    prte_output_max_verbosity = max;
+}
+
+/* parse the conversion specification that follows a '%', returning
+ * a pointer to the character after it along with the type of its
+ * argument and the number of '*' int arguments that precede it */
+static const char *parse_spec(const char *p, int *stars, prte_output_arg_type_t *type)
+{
+    int len = 0;
+
+    *stars = 0;
+    while ('\0' != *p && NULL != strchr("-+ #0'", *p)) {
+        ++p;
+    }
+    if ('*' == *p) {
+        ++*stars;
+        ++p;
+    } else {
+        while (isdigit((unsigned char) *p)) {
+            ++p;
+        }
+    }
+    if ('.' == *p) {
+        ++p;
+        if ('*' == *p) {
+            ++*stars;
+            ++p;
+        } else {
+            while (isdigit((unsigned char) *p)) {
+                ++p;
+            }
+        }
+    }
+
+    /* length modifier */
+    switch (*p) {
+    case 'h':
+        ++p;
+        if ('h' == *p) {
+            ++p;
+        }
+        break;
+    case 'l':
+        ++p;
+        len = 1;
+        if ('l' == *p) {
+            ++p;
+            len = 2;
+        }
+        break;
+    case 'q':
+        ++p;
+        len = 2;
+        break;
+    case 'z':
+        ++p;
+        len = 3;
+        break;
+    case 'j':
+        ++p;
+        len = 4;
+        break;
+    case 't':
+        ++p;
+        len = 5;
+        break;
+    case 'L':
+        ++p;
+        len = 6;
+        break;
+    default:
+        break;
+    }
+
+    switch (*p) {
+    case '%':
+        *type = PRTE_OUTPUT_ARG_NONE;
+        break;
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+    case 'c':
+        switch (len) {
+        case 1:
+            *type = PRTE_OUTPUT_ARG_LONG;
+            break;
+        case 2:
+            *type = PRTE_OUTPUT_ARG_LLONG;
+            break;
+        case 3:
+            *type = PRTE_OUTPUT_ARG_SIZE;
+            break;
+        case 4:
+            *type = PRTE_OUTPUT_ARG_INTMAX;
+            break;
+        case 5:
+            *type = PRTE_OUTPUT_ARG_PTRDIFF;
+            break;
+        default:
+            *type = PRTE_OUTPUT_ARG_INT;
+            break;
+        }
+        break;
+    case 'e':
+    case 'E':
+    case 'f':
+    case 'F':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        *type = (6 == len) ? PRTE_OUTPUT_ARG_LDOUBLE : PRTE_OUTPUT_ARG_DOUBLE;
+        break;
+    case 'p':
+        *type = PRTE_OUTPUT_ARG_PTR;
+        break;
+    case 's':
+        /* wide strings are not supported */
+        *type = (1 == len) ? PRTE_OUTPUT_ARG_BAD : PRTE_OUTPUT_ARG_STR;
+        break;
+    default:
+        /* %n, %m and anything we don't recognize must be
+         * handled while the caller's context still exists */
+        *type = PRTE_OUTPUT_ARG_BAD;
+        return p;
+    }
+    return p + 1;
+}
+
+int prte_output_trace_open(int nrecords, const char *filename)
+{
+    prte_output_trace_rec_t *recs;
+
+    if (0 >= nrecords) {
+        return PRTE_SUCCESS;
+    }
+    recs = (prte_output_trace_rec_t *) calloc(nrecords, sizeof(prte_output_trace_rec_t));
+    if (NULL == recs) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    pmix_mutex_lock(&trace_lock);
+    trace_size = nrecords;
+    trace_next = 0;
+    trace_recs = recs;
+    if (NULL != filename) {
+        trace_filename = strdup(filename);
+    }
+    pmix_mutex_unlock(&trace_lock);
+    prte_output_trace_enabled = true;
+    return PRTE_SUCCESS;
+}
+
+static bool capture(prte_output_trace_rec_t *rec, const char *format, va_list ap)
+{
+    const char *p = format;
+    prte_output_arg_type_t type;
+    prte_output_arg_t *arg;
+    const char *s;
+    size_t len;
+    int stars;
+
+    rec->nargs = 0;
+    rec->strused = 0;
+    while (NULL != (p = strchr(p, '%'))) {
+        p = parse_spec(p + 1, &stars, &type);
+        if (PRTE_OUTPUT_ARG_BAD == type ||
+            PRTE_OUTPUT_TRACE_ARGS < rec->nargs + stars + 1) {
+            return false;
+        }
+        while (0 < stars--) {
+            rec->args[rec->nargs++].i = va_arg(ap, int);
+        }
+        arg = &rec->args[rec->nargs];
+        switch (type) {
+        case PRTE_OUTPUT_ARG_NONE:
+            continue;
+        case PRTE_OUTPUT_ARG_INT:
+            arg->i = va_arg(ap, int);
+            break;
+        case PRTE_OUTPUT_ARG_LONG:
+            arg->l = va_arg(ap, long);
+            break;
+        case PRTE_OUTPUT_ARG_LLONG:
+            arg->ll = va_arg(ap, long long);
+            break;
+        case PRTE_OUTPUT_ARG_SIZE:
+            arg->z = va_arg(ap, size_t);
+            break;
+        case PRTE_OUTPUT_ARG_INTMAX:
+            arg->j = va_arg(ap, intmax_t);
+            break;
+        case PRTE_OUTPUT_ARG_PTRDIFF:
+            arg->t = va_arg(ap, ptrdiff_t);
+            break;
+        case PRTE_OUTPUT_ARG_DOUBLE:
+            arg->d = va_arg(ap, double);
+            break;
+        case PRTE_OUTPUT_ARG_LDOUBLE:
+            arg->ld = va_arg(ap, long double);
+            break;
+        case PRTE_OUTPUT_ARG_PTR:
+            arg->p = va_arg(ap, void *);
+            break;
+        case PRTE_OUTPUT_ARG_STR:
+            /* the string may live in a rotating buffer (e.g., the
+             * one behind PRTE_NAME_PRINT), so take a copy */
+            s = va_arg(ap, const char *);
+            if (NULL == s) {
+                s = "(null)";
+            }
+            len = strlen(s) + 1;
+            if (sizeof(rec->strs) - rec->strused < len) {
+                return false;
+            }
+            memcpy(&rec->strs[rec->strused], s, len);
+            arg->z = rec->strused;
+            rec->strused += len;
+            break;
+        default:
+            return false;
+        }
+        rec->nargs++;
+    }
+    return true;
+}
+
+void prte_output_trace_record(int verbose_level, int output_id, const char *format, ...)
+{
+    prte_output_trace_rec_t *rec;
+    va_list ap;
+    uint64_t seq;
+
+    if (NULL == trace_recs) {
+        return;
+    }
+
+    pmix_mutex_lock(&trace_lock);
+    /* the buffer may have been closed while we waited */
+    if (NULL == trace_recs || 0 == trace_size) {
+        pmix_mutex_unlock(&trace_lock);
+        return;
+    }
+    seq = trace_next++;
+    rec = &trace_recs[seq % trace_size];
+    rec->seq = 0;
+    clock_gettime(CLOCK_REALTIME, &rec->ts);
+    rec->id = output_id;
+    rec->level = verbose_level;
+    rec->format = format;
+
+    va_start(ap, format);
+    if (!capture(rec, format, ap)) {
+        /* fall back to formatting it now */
+        va_end(ap);
+        va_start(ap, format);
+        vsnprintf(rec->strs, sizeof(rec->strs), format, ap);
+        rec->format = NULL;
+    }
+    va_end(ap);
+    rec->seq = seq + 1;
+    pmix_mutex_unlock(&trace_lock);
+}
+
+/* regenerate the text of a record */
+static void expand(prte_output_trace_rec_t *rec, char *out, size_t outlen)
+{
+    const char *p, *q;
+    prte_output_arg_type_t type;
+    prte_output_arg_t *arg;
+    char spec[64];
+    size_t used = 0, sl;
+    int stars, n = 0, rc;
+
+    if (NULL == rec->format) {
+        pmix_string_copy(out, rec->strs, outlen);
+        return;
+    }
+
+    out[0] = '\0';
+    p = rec->format;
+    while ('\0' != *p && used + 1 < outlen) {
+        if ('%' != *p) {
+            out[used++] = *p++;
+            continue;
+        }
+        q = parse_spec(p + 1, &stars, &type);
+        if (PRTE_OUTPUT_ARG_NONE == type) {
+            out[used++] = '%';
+            p = q;
+            continue;
+        }
+
+        /* rebuild the specification with any '*' replaced by the
+         * value that was captured for it */
+        sl = 0;
+        for (; p < q && sl + 16 < sizeof(spec); p++) {
+            if ('*' == *p) {
+                sl += snprintf(&spec[sl], sizeof(spec) - sl, "%d", rec->args[n++].i);
+            } else {
+                spec[sl++] = *p;
+            }
+        }
+        spec[sl] = '\0';
+        p = q;
+
+        arg = &rec->args[n++];
+        switch (type) {
+        case PRTE_OUTPUT_ARG_INT:
+            rc = snprintf(&out[used], outlen - used, spec, arg->i);
+            break;
+        case PRTE_OUTPUT_ARG_LONG:
+            rc = snprintf(&out[used], outlen - used, spec, arg->l);
+            break;
+        case PRTE_OUTPUT_ARG_LLONG:
+            rc = snprintf(&out[used], outlen - used, spec, arg->ll);
+            break;
+        case PRTE_OUTPUT_ARG_SIZE:
+            rc = snprintf(&out[used], outlen - used, spec, arg->z);
+            break;
+        case PRTE_OUTPUT_ARG_INTMAX:
+            rc = snprintf(&out[used], outlen - used, spec, arg->j);
+            break;
+        case PRTE_OUTPUT_ARG_PTRDIFF:
+            rc = snprintf(&out[used], outlen - used, spec, arg->t);
+            break;
+        case PRTE_OUTPUT_ARG_DOUBLE:
+            rc = snprintf(&out[used], outlen - used, spec, arg->d);
+            break;
+        case PRTE_OUTPUT_ARG_LDOUBLE:
+            rc = snprintf(&out[used], outlen - used, spec, arg->ld);
+            break;
+        case PRTE_OUTPUT_ARG_PTR:
+            rc = snprintf(&out[used], outlen - used, spec, arg->p);
+            break;
+        case PRTE_OUTPUT_ARG_STR:
+            rc = snprintf(&out[used], outlen - used, spec, &rec->strs[arg->z]);
+            break;
+        default:
+            rc = 0;
+            break;
+        }
+        if (0 > rc) {
+            break;
+        }
+        used += rc;
+        if (outlen <= used) {
+            used = outlen - 1;
+        }
+    }
+    out[used] = '\0';
+}
+
+void prte_output_trace_dump(void)
+{
+    prte_output_trace_rec_t *rec;
+    uint64_t seq, first;
+    char line[PRTE_OUTPUT_TRACE_LINE];
+    char *path = NULL;
+    FILE *fp = stderr;
+    size_t n;
+
+    if (NULL == trace_recs) {
+        return;
+    }
+
+    pmix_mutex_lock(&trace_lock);
+    if (NULL != trace_filename) {
+        pmix_asprintf(&path, "%s.%lu", trace_filename, (unsigned long) getpid());
+        fp = fopen(path, "a");
+        if (NULL == fp) {
+            fprintf(stderr, "prte_output_trace: cannot open %s: %s\n", path, strerror(errno));
+            fp = stderr;
+        }
+        free(path);
+    }
+
+    first = (trace_next > trace_size) ? trace_next - trace_size : 0;
+    if (0 < first) {
+        fprintf(fp, "prte_output_trace: %lu older records were overwritten\n",
+                (unsigned long) first);
+    }
+    for (seq = first; seq < trace_next; seq++) {
+        rec = &trace_recs[seq % trace_size];
+        if (rec->seq != seq + 1) {
+            continue;
+        }
+        expand(rec, line, sizeof(line));
+        n = strlen(line);
+        if (0 < n && '\n' == line[n - 1]) {
+            line[n - 1] = '\0';
+        }
+        fprintf(fp, "[%lu.%09ld] %d:%d %s\n", (unsigned long) rec->ts.tv_sec,
+                rec->ts.tv_nsec, rec->id, rec->level, line);
+    }
+    fflush(fp);
+    if (stderr != fp) {
+        fclose(fp);
+    }
+    trace_next = 0;
+    pmix_mutex_unlock(&trace_lock);
+}
+
+void prte_output_trace_close(void)
+{
+    prte_output_trace_enabled = false;
+    pmix_mutex_lock(&trace_lock);
+    if (NULL != trace_recs) {
+        free(trace_recs);
+        trace_recs = NULL;
+    }
+    trace_size = 0;
+    trace_next = 0;
+    if (NULL != trace_filename) {
+        free(trace_filename);
+        trace_filename = NULL;
+    }
+    pmix_mutex_unlock(&trace_lock);
+}
@@ -0,0 +1,93 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/** @file
+ *
+ * Verbose output for per-message code paths.
+ *
+ * prte_output_verbose() takes the same arguments as
+ * pmix_output_verbose(), but first compares the level against the
+ * highest verbosity set on any output stream. That value is cached
+ * in a global, so a disabled call site costs a load and a
+ * predictable branch rather than a call into the PMIx library. None
+ * of the arguments (e.g., PRTE_NAME_PRINT) are evaluated unless the
+ * message is actually going to be output.
+ *
+ * The cached value starts out at INT_MAX, so nothing is filtered
+ * until prte_output_verbose_refresh() is called. It must be called
+ * again whenever the verbosity of a stream may have been raised -
+ * e.g., after opening a framework. The daemons, master and scheduler
+ * do so before entering their event loops, and nothing refreshes it
+ * after that - a verbosity raised at runtime is not seen by these
+ * call sites.
+ *
+ * If the prte_output_trace MCA param is set, enabled messages are
+ * not formatted at the call site. Instead, the format string and
+ * the raw arguments are captured in a binary ring buffer of that
+ * many records, and the text is only generated when the buffer is
+ * dumped by prte_output_trace_dump() (which prte_finalize calls).
+ */
+
+#ifndef PRTE_UTIL_OUTPUT_H
+#define PRTE_UTIL_OUTPUT_H
+
+#include "prte_config.h"
+
+#include <stdbool.h>
+
+#include "prefetch.h"
+#include "src/util/pmix_output.h"
+
+BEGIN_C_DECLS
+
+/* highest verbosity of any output stream */
+PRTE_EXPORT extern int prte_output_max_verbosity;
+
+/* true if messages are being captured in the trace buffer */
+PRTE_EXPORT extern bool prte_output_trace_enabled;
+
+#define prte_output_verbose(verbose_level, output_id, ...)                      \
+    do {                                                                        \
+        if (PMIX_UNLIKELY((verbose_level) <= prte_output_max_verbosity) &&      \
+            pmix_output_check_verbosity((verbose_level), (output_id))) {        \
+            if (prte_output_trace_enabled) {                                    \
+                prte_output_trace_record((verbose_level), (output_id),          \
+                                         __VA_ARGS__);                          \
+            } else {                                                            \
+                pmix_output((output_id), __VA_ARGS__);                          \
+            }                                                                   \
+        }                                                                       \
+    } while (0)
+
+/* like PMIX_OUTPUT_VERBOSE, but compiled out unless PRRTE itself
+ * was configured with --enable-debug */
+#if PRTE_ENABLE_DEBUG
+#    define PRTE_OUTPUT_VERBOSE(a) prte_output_verbose a
+#else
+#    define PRTE_OUTPUT_VERBOSE(a)
+#endif
+
+/* recompute prte_output_max_verbosity from the current streams */
+PRTE_EXPORT void prte_output_verbose_refresh(void);
+
+/* allocate the trace buffer - a no-op if nrecords is zero */
+PRTE_EXPORT int prte_output_trace_open(int nrecords, const char *filename);
+
+PRTE_EXPORT void prte_output_trace_record(int verbose_level, int output_id,
+                                          const char *format, ...)
+    __prte_attribute_format__(__printf__, 3, 4);
+
+/* format and write out all records in the trace buffer, oldest
+ * first, and then empty it */
+PRTE_EXPORT void prte_output_trace_dump(void);
+
+PRTE_EXPORT void prte_output_trace_close(void);
+
+END_C_DECLS
+
+#endif
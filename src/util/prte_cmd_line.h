@@ -170,6 +170,7 @@ BEGIN_C_DECLS
 #define PRTE_CLI_HWTCPUS    "hwtcpus"
 #define PRTE_CLI_PELIST     "pe-list="
 #define PRTE_CLI_LIKWID     "likwid"
+#define PRTE_CLI_AFFINITY   "affinity"
 
 // Ranking directives
 // PRTE_CLI_SLOT, PRTE_CLI_NODE, PRTE_CLI_SPAN reused here
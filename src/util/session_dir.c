@@ -39,6 +39,9 @@
 #    include <sys/types.h>
 #endif /* HAVE_SYS_TYPES_H */
 #include <sys/stat.h>
+#ifdef HAVE_SYS_TIME_H
+#    include <sys/time.h>
+#endif /* HAVE_SYS_TIME_H */
 #ifdef HAVE_UNISTD_H
 #    include <unistd.h>
 #endif /* HAVE_UNISTD_H */
@@ -63,10 +66,14 @@
 #include "src/util/proc_info.h"
 #include "src/util/pmix_show_help.h"
 
+#include "src/event/event-internal.h"
 #include "src/mca/errmgr/errmgr.h"
 #include "src/mca/ras/base/base.h"
 #include "src/runtime/prte_globals.h"
+#include "src/runtime/prte_progress_threads.h"
 #include "src/runtime/runtime.h"
+#include "src/threads/pmix_mutex.h"
+#include "src/threads/pmix_threads.h"
 
 #include "src/util/session_dir.h"
 
@@ -77,6 +84,41 @@ static bool _check_file(const char *root, const char *path);
 
 static bool setup_base_complete = false;
 
+/* background removal of job-level session directories */
+#define PRTE_SESSION_CLEANUP_THREAD "prte-sessiondir"
+
+typedef struct {
+    pmix_list_item_t super;
+    prte_event_t ev;
+    char *path;  // where the tree originally lived
+    char *tomb;  // where it was moved for removal
+    struct timeval start;
+} prte_session_cleanup_t;
+static void sccon(prte_session_cleanup_t *p)
+{
+    p->path = NULL;
+    p->tomb = NULL;
+}
+static void scdes(prte_session_cleanup_t *p)
+{
+    if (NULL != p->path) {
+        free(p->path);
+    }
+    if (NULL != p->tomb) {
+        free(p->tomb);
+    }
+}
+static PMIX_CLASS_INSTANCE(prte_session_cleanup_t,
+                           pmix_list_item_t,
+                           sccon, scdes);
+
+static prte_event_base_t *cleanup_base = NULL;
+static unsigned long cleanup_counter = 0;
+/* removals handed to the cleanup thread that it has not yet
+ * started - protected by cleanup_lock as both threads modify it */
+static pmix_list_t cleanup_pending;
+static pmix_mutex_t cleanup_lock = PMIX_MUTEX_STATIC_INIT;
+
 #define PRTE_PRINTF_FIX_STRING(a) ((NULL == a) ? "(null)" : a)
 
 /****************************
@@ -301,8 +343,130 @@ cleanup:
     return rc;
 }
 
+int prte_job_session_dirs(prte_job_t *jdata)
+{
+    int rc, n;
+    prte_proc_t *pptr;
+    char *tmp;
+
+    if (PRTE_SUCCESS != (rc = setup_base())) {
+        if (PRTE_ERR_FATAL == rc) {
+            /* this indicates we should abort quietly */
+            rc = PRTE_ERR_SILENT;
+        }
+        return rc;
+    }
+    if (PRTE_SUCCESS != (rc = _setup_job_session_dir(jdata))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* the job-level directory now exists, so each local proc
+     * only needs a single mkdir instead of a walk of the path */
+    for (n = 0; n < jdata->procs->size; n++) {
+        pptr = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs, n);
+        if (NULL == pptr || NULL == pptr->node || NULL == pptr->node->daemon ||
+            PRTE_PROC_MY_NAME->rank != pptr->node->daemon->name.rank) {
+            continue;
+        }
+        if (0 > pmix_asprintf(&tmp, "%s/%s", jdata->session_dir,
+                              PMIX_RANK_PRINT(pptr->name.rank))) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        if (0 != mkdir(tmp, S_IRWXU) && EEXIST != errno) {
+            /* let the full path logic sort it out and report */
+            rc = _create_dir(tmp);
+            if (PRTE_SUCCESS != rc) {
+                free(tmp);
+                PRTE_ERROR_LOG(rc);
+                return rc;
+            }
+        }
+        free(tmp);
+    }
+
+    if (prte_debug_flag) {
+        pmix_output(0, "jobdir: %s", PRTE_PRINTF_FIX_STRING(jdata->session_dir));
+        pmix_output(0, "top: %s", PRTE_PRINTF_FIX_STRING(prte_process_info.top_session_dir));
+        pmix_output(0, "tmp: %s", PRTE_PRINTF_FIX_STRING(prte_process_info.tmpdir_base));
+    }
+    return PRTE_SUCCESS;
+}
+
+static void _remove_tomb(prte_session_cleanup_t *sc)
+{
+    struct timeval stop;
+    char *elapsed;
+
+    pmix_os_dirpath_destroy(sc->tomb, true, _check_file);
+    if (0 != rmdir(sc->tomb)) {
+        /* something we were told to keep is still there - put
+         * it back where the user will look for it */
+        (void) rename(sc->tomb, sc->path);
+    }
+    gettimeofday(&stop, NULL);
+    elapsed = prte_pretty_print_timing(stop.tv_sec - sc->start.tv_sec,
+                                       stop.tv_usec - sc->start.tv_usec);
+    pmix_output_verbose(1, prte_debug_output,
+                        "%s session dir %s removed in %s",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), sc->path, elapsed);
+    free(elapsed);
+}
+
+static void _cleanup_dir(int fd, short args, void *cbdata)
+{
+    prte_session_cleanup_t *sc = (prte_session_cleanup_t *) cbdata;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args);
+
+    PMIX_ACQUIRE_OBJECT(sc);
+
+    pmix_mutex_lock(&cleanup_lock);
+    pmix_list_remove_item(&cleanup_pending, &sc->super);
+    pmix_mutex_unlock(&cleanup_lock);
+
+    _remove_tomb(sc);
+    PMIX_RELEASE(sc);
+}
+
+/* move the tree aside so the job's name is immediately free,
+ * then hand the actual removal to the cleanup thread */
+static int _cleanup_async(const char *path)
+{
+    prte_session_cleanup_t *sc;
+
+    if (NULL == cleanup_base) {
+        cleanup_base = prte_progress_thread_init(PRTE_SESSION_CLEANUP_THREAD);
+        if (NULL == cleanup_base) {
+            return PRTE_ERROR;
+        }
+        PMIX_CONSTRUCT(&cleanup_pending, pmix_list_t);
+    }
+
+    sc = PMIX_NEW(prte_session_cleanup_t);
+    gettimeofday(&sc->start, NULL);
+    sc->path = strdup(path);
+    if (0 > pmix_asprintf(&sc->tomb, "%s.rm.%lu", path, cleanup_counter++)) {
+        sc->tomb = NULL;
+        PMIX_RELEASE(sc);
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    if (0 != rename(sc->path, sc->tomb)) {
+        PMIX_RELEASE(sc);
+        return PRTE_ERROR;
+    }
+    pmix_mutex_lock(&cleanup_lock);
+    pmix_list_append(&cleanup_pending, &sc->super);
+    pmix_mutex_unlock(&cleanup_lock);
+    prte_event_set(cleanup_base, &sc->ev, -1, PRTE_EV_WRITE, _cleanup_dir, sc);
+    PMIX_POST_OBJECT(sc);
+    prte_event_active(&sc->ev, PRTE_EV_WRITE, 1);
+    return PRTE_SUCCESS;
+}
+
 void prte_job_session_dir_finalize(prte_job_t *jdata)
 {
+    prte_session_cleanup_t *sc;
+
     if (prte_process_info.rm_session_dirs) {
         /* RM will clean them up for us */
         return;
@@ -325,6 +489,19 @@ void prte_job_session_dir_finalize(prte_job_t *jdata)
      * session directory, but only if we are finalizing */
     if (PMIX_CHECK_NSPACE(PRTE_PROC_MY_NAME->nspace, jdata->nspace)) {
         if (prte_finalizing) {
+            if (NULL != cleanup_base) {
+                /* stop the cleanup thread and remove anything it
+                 * didn't get to here, so kept files still get put
+                 * back before the top dir is removed */
+                prte_progress_thread_finalize(PRTE_SESSION_CLEANUP_THREAD);
+                cleanup_base = NULL;
+                while (NULL != (sc = (prte_session_cleanup_t *)
+                                pmix_list_remove_first(&cleanup_pending))) {
+                    _remove_tomb(sc);
+                    PMIX_RELEASE(sc);
+                }
+                PMIX_DESTRUCT(&cleanup_pending);
+            }
             if (NULL != prte_process_info.top_session_dir) {
                 pmix_os_dirpath_destroy(prte_process_info.top_session_dir, true, _check_file);
                 rmdir(prte_process_info.top_session_dir);
@@ -335,6 +512,13 @@ void prte_job_session_dir_finalize(prte_job_t *jdata)
         return;
     }
 
+    if (prte_async_session_cleanup && !prte_finalizing &&
+        PRTE_SUCCESS == _cleanup_async(jdata->session_dir)) {
+        free(jdata->session_dir);
+        jdata->session_dir = NULL;
+        return;
+    }
+
     pmix_os_dirpath_destroy(jdata->session_dir, true, _check_file);
     /* if the job-level session dir is now empty, remove it */
     rmdir(jdata->session_dir);
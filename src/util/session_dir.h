@@ -51,8 +51,18 @@ BEGIN_C_DECLS
  */
 PRTE_EXPORT int prte_session_dir(pmix_proc_t *proc);
 
+/** Create the job-level session directory plus the proc-level
+ * directories of every proc in the job that is local to this
+ * daemon in a single pass. Equivalent to calling prte_session_dir
+ * on the job and then on each local proc, but avoids re-walking
+ * the full path for every rank.
+ */
+PRTE_EXPORT int prte_job_session_dirs(prte_job_t *jdata);
+
 /** The session_dir_finalize functions perform a cleanup of the
- * relevant session directory tree.
+ * relevant session directory tree. If prte_async_session_cleanup
+ * is set, a job-level tree is renamed out of the way and removed
+ * on a background thread.
  */
 
 PRTE_EXPORT void prte_job_session_dir_finalize(prte_job_t *jdata);
@@ -0,0 +1,44 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ *
+ * SHA-256 (FIPS 180-4) message digest, used where a collision-resistant
+ * name for a block of data is needed. Use the CRC32C routines in crc.h
+ * to detect corruption in transit.
+ */
+
+#ifndef PRTE_SHA256_H
+#define PRTE_SHA256_H
+
+#include "prte_config.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+BEGIN_C_DECLS
+
+#define PRTE_SHA256_DIGEST_LENGTH 32
+
+typedef struct {
+    uint32_t state[8];
+    uint64_t nbytes;
+    unsigned char block[64];
+    size_t nblock;
+} prte_sha256_t;
+
+PRTE_EXPORT void prte_sha256_init(prte_sha256_t *ctx);
+
+PRTE_EXPORT void prte_sha256_update(prte_sha256_t *ctx, const void *data, size_t len);
+
+PRTE_EXPORT void prte_sha256_final(prte_sha256_t *ctx,
+                                   unsigned char digest[PRTE_SHA256_DIGEST_LENGTH]);
+
+END_C_DECLS
+
+#endif /* PRTE_SHA256_H */